@@ -0,0 +1,181 @@
+//+=============================================================================
+//
+// file :               bench.h
+//
+// description :        Include for the benchmark drivers. Each driver runs one
+//			scenario against the BenchDevice devices of the benchmark
+//			device server and adds its results to the report which is
+//			finally written in JSON.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#ifndef _BENCH_H
+#define _BENCH_H
+
+#include <tango.h>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+//
+// The benchmark configuration (from the command line)
+//
+
+struct BenchConfig
+{
+	std::string					host;				// Device server host
+	int							port;				// Device server ORB port
+	int							nb_devices;			// Number of BenchDevice devices
+	long						iterations;			// Number of calls for latency measurements
+	long						warmup;				// Number of calls done before measuring
+	double						duration;			// Duration (s) of the throughput measurements
+	long						spectrum_size;		// Spectrum data size (double)
+	int							nb_threads;			// Number of client threads for throughput
+	int							nb_listeners;		// Number of event listener processes
+	long						nb_events;			// Number of events pushed for fan-out
+	long						event_size;			// Event data size (double)
+	long						storm_attributes;	// Number of subscribed attributes per device
+	std::vector<long>			poll_attributes;	// Number of polled attributes for each polling run
+	int							poll_period;		// Polling period (ms)
+	std::string					label;				// Free label stored in the report (e.g. commit id)
+	std::string					output;				// Report file name ("-" for stdout)
+	std::vector<std::string>	scenarios;			// Scenarios to run
+	std::string					listen;				// Device to listen to (listener process only)
+	std::string					self_path;			// This executable path (to start listeners)
+
+	std::string device_name(int idx) const;
+};
+
+//
+// Measured samples (in micro-seconds) of one benchmark
+//
+
+class Samples
+{
+public:
+	Samples():nb_errors(0),sorted(false) {}
+
+	void add(double us) {values.push_back(us);sorted = false;}
+	void add(const Samples &other);
+	void add_error() {nb_errors++;}
+
+	size_t size() const {return values.size();}
+	size_t get_errors() const {return nb_errors;}
+	double get_min() const;
+	double get_max() const;
+	double get_mean() const;
+	double get_percentile(double);
+	const std::vector<double> &get_values() const {return values;}
+
+private:
+	std::vector<double>		values;
+	size_t					nb_errors;
+	bool					sorted;
+};
+
+//
+// One result of the report
+//
+
+struct BenchResult
+{
+	std::string			name;
+	std::string			unit;			// Latency unit (us, or ns for the logging statements)
+	size_t				count;			// Number of samples
+	size_t				errors;			// Number of failed operations (or lost events)
+	double				min;			// Latencies
+	double				mean;
+	double				p50;
+	double				p90;
+	double				p99;
+	double				max;
+	double				rate;			// Operations (or events) per second
+};
+
+class BenchReport
+{
+public:
+	void add(const std::string &,Samples &,double rate,const std::string &unit = "us");
+	void write_json(std::ostream &,const BenchConfig &);
+
+private:
+	std::vector<BenchResult>	results;
+};
+
+//
+// Time helpers
+//
+
+inline double elapsed_us(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration<double,std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline double wall_us()
+{
+	return std::chrono::duration<double,std::micro>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+//
+// Call a function n times (after the warmup calls) and record each call latency. A DevFailed exception is counted
+// as an error. Returns the elapsed time (us) of the measured calls
+//
+
+template <typename F>
+double measure(const BenchConfig &conf,long n,Samples &samples,F f)
+{
+	for (long loop = 0;loop < conf.warmup;loop++)
+	{
+		try
+		{
+			f();
+		}
+		catch (Tango::DevFailed &)
+		{
+		}
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (long loop = 0;loop < n;loop++)
+	{
+		auto call_start = std::chrono::steady_clock::now();
+		try
+		{
+			f();
+			samples.add(elapsed_us(call_start));
+		}
+		catch (Tango::DevFailed &)
+		{
+			samples.add_error();
+		}
+	}
+	return elapsed_us(start);
+}
+
+//
+// The drivers
+//
+
+void bench_read_write(const BenchConfig &,BenchReport &);
+void bench_command(const BenchConfig &,BenchReport &);
+void bench_event_fanout(const BenchConfig &,BenchReport &);
+void bench_subscription_storm(const BenchConfig &,BenchReport &);
+void bench_polling(const BenchConfig &,BenchReport &);
+void bench_group(const BenchConfig &,BenchReport &);
+void bench_logging(const BenchConfig &,BenchReport &);
+
+int run_listener(const BenchConfig &);
+
+} // End of bench namespace
+
+#endif
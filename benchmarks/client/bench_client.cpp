@@ -0,0 +1,267 @@
+//+=============================================================================
+//
+// file :               bench_client.cpp
+//
+// description :        Benchmark drivers for the synchronous client calls:
+//			attribute read/write latency, command latency and
+//			throughput and Group operations.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#include "bench.h"
+#include <mutex>
+#include <thread>
+
+namespace bench
+{
+
+static double rate(long nb,double us)
+{
+	return us > 0.0 ? nb * 1000000.0 / us : 0.0;
+}
+
+//+----------------------------------------------------------------------------
+//
+// function : 		bench_read_write()
+//
+// description : 	Scalar and spectrum attribute read and write latency on
+//			one device
+//
+//-----------------------------------------------------------------------------
+
+void bench_read_write(const BenchConfig &conf,BenchReport &report)
+{
+	Tango::DeviceProxy dev(conf.device_name(0));
+	double us;
+
+	{
+		Samples samples;
+		us = measure(conf,conf.iterations,samples,[&](){
+			dev.read_attribute("Scalar");
+		});
+		report.add("read_scalar",samples,rate(samples.size(),us));
+	}
+
+	{
+		Samples samples;
+		Tango::DevDouble val = 0.0;
+		us = measure(conf,conf.iterations,samples,[&](){
+			Tango::DeviceAttribute da("Scalar",val);
+			dev.write_attribute(da);
+			val = val + 1.0;
+		});
+		report.add("write_scalar",samples,rate(samples.size(),us));
+	}
+
+	std::vector<Tango::DevDouble> spectrum(conf.spectrum_size,1.0);
+
+	{
+		Samples samples;
+		us = measure(conf,conf.iterations,samples,[&](){
+			Tango::DeviceAttribute da("Spectrum",spectrum);
+			dev.write_attribute(da);
+		});
+		report.add("write_spectrum",samples,rate(samples.size(),us));
+	}
+
+	{
+		Samples samples;
+		us = measure(conf,conf.iterations,samples,[&](){
+			dev.read_attribute("Spectrum");
+		});
+		report.add("read_spectrum",samples,rate(samples.size(),us));
+	}
+
+	{
+		Samples samples;
+		std::vector<std::string> names = {"Scalar","Spectrum","Counter"};
+		us = measure(conf,conf.iterations,samples,[&](){
+			std::unique_ptr<std::vector<Tango::DeviceAttribute> > das(dev.read_attributes(names));
+		});
+		report.add("read_attributes",samples,rate(samples.size(),us));
+	}
+}
+
+//+----------------------------------------------------------------------------
+//
+// function : 		bench_command()
+//
+// description : 	Command latency on one device then command throughput
+//			with several client threads (each one with its own
+//			DeviceProxy, the devices are used in turn)
+//
+//-----------------------------------------------------------------------------
+
+void bench_command(const BenchConfig &conf,BenchReport &report)
+{
+	double us;
+
+	{
+		Tango::DeviceProxy dev(conf.device_name(0));
+
+		Samples samples;
+		us = measure(conf,conf.iterations,samples,[&](){
+			dev.command_inout("Noop");
+		});
+		report.add("command_noop",samples,rate(samples.size(),us));
+
+		Tango::DeviceData din_scalar;
+		din_scalar << Tango::DevDouble(1.5);
+		Samples scalar_samples;
+		us = measure(conf,conf.iterations,scalar_samples,[&](){
+			dev.command_inout("Scale",din_scalar);
+		});
+		report.add("command_scalar_double",scalar_samples,rate(scalar_samples.size(),us));
+
+		std::vector<Tango::DevDouble> data(conf.spectrum_size,1.0);
+		Tango::DeviceData din;
+		din << data;
+		Samples echo_samples;
+		us = measure(conf,conf.iterations,echo_samples,[&](){
+			dev.command_inout("Echo",din);
+		});
+		report.add("command_echo",echo_samples,rate(echo_samples.size(),us));
+	}
+
+	Samples samples;
+	std::mutex samples_mutex;
+	std::vector<std::thread> threads;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int loop = 0;loop < conf.nb_threads;loop++)
+	{
+		threads.emplace_back([&,loop](){
+			Samples th_samples;
+			try
+			{
+				Tango::DeviceProxy dev(conf.device_name(loop % conf.nb_devices));
+				dev.ping();
+				while (elapsed_us(start) < conf.duration * 1000000.0)
+				{
+					auto call_start = std::chrono::steady_clock::now();
+					try
+					{
+						dev.command_inout("Noop");
+						th_samples.add(elapsed_us(call_start));
+					}
+					catch (Tango::DevFailed &)
+					{
+						th_samples.add_error();
+					}
+				}
+			}
+			catch (Tango::DevFailed &)
+			{
+				th_samples.add_error();
+			}
+
+			std::lock_guard<std::mutex> lo(samples_mutex);
+			samples.add(th_samples);
+		});
+	}
+	for (auto &th : threads)
+		th.join();
+	us = elapsed_us(start);
+
+	report.add("command_throughput",samples,rate(samples.size(),us));
+}
+
+//+----------------------------------------------------------------------------
+//
+// function : 		bench_group()
+//
+// description : 	Group read, write and command latency on a group of all
+//			the benchmark devices. A failed reply is counted as an error
+//
+//-----------------------------------------------------------------------------
+
+void bench_group(const BenchConfig &conf,BenchReport &report)
+{
+	Tango::Group group("bench");
+	std::vector<std::string> names;
+	for (int loop = 0;loop < conf.nb_devices;loop++)
+		names.push_back(conf.device_name(loop));
+	group.add(names);
+
+	long nb = conf.iterations / conf.nb_devices + 1;
+	double us;
+
+	{
+		Samples samples;
+		us = measure(conf,nb,samples,[&](){
+			Tango::GroupAttrReplyList rl = group.read_attribute("Scalar");
+			if (rl.has_failed() == true)
+				TANGO_THROW_EXCEPTION("Bench_GroupFailed","Group read_attribute failed");
+		});
+		report.add("group_read_attribute",samples,rate(samples.size() * conf.nb_devices,us));
+	}
+
+	{
+		Samples samples;
+		Tango::DeviceAttribute da("Scalar",static_cast<Tango::DevDouble>(1.0));
+		us = measure(conf,nb,samples,[&](){
+			Tango::GroupReplyList rl = group.write_attribute(da);
+			if (rl.has_failed() == true)
+				TANGO_THROW_EXCEPTION("Bench_GroupFailed","Group write_attribute failed");
+		});
+		report.add("group_write_attribute",samples,rate(samples.size() * conf.nb_devices,us));
+	}
+
+	{
+		Samples samples;
+		us = measure(conf,nb,samples,[&](){
+			Tango::GroupCmdReplyList rl = group.command_inout("Noop");
+			if (rl.has_failed() == true)
+				TANGO_THROW_EXCEPTION("Bench_GroupFailed","Group command_inout failed");
+		});
+		report.add("group_command_inout",samples,rate(samples.size() * conf.nb_devices,us));
+	}
+}
+
+//+----------------------------------------------------------------------------
+//
+// function : 		bench_logging()
+//
+// description : 	Cost of disabled TANGO_LOG_DEBUG and DEBUG_STREAM
+//			statements in the device server. Each LogDisabled call
+//			executes 100000 statements of each kind and returns their
+//			mean cost, which is one sample. The rate is in statements
+//			per second
+//
+//-----------------------------------------------------------------------------
+
+void bench_logging(const BenchConfig &conf,BenchReport &report)
+{
+	const Tango::DevLong nb_statements = 100000;
+	long nb = conf.iterations / 100 + 1;
+
+	Tango::DeviceProxy dev(conf.device_name(0));
+	Tango::DeviceData din;
+	din << nb_statements;
+
+	Samples tango_log_samples;
+	Samples debug_stream_samples;
+	double tango_log_ns = 0.0;
+	double debug_stream_ns = 0.0;
+	for (long loop = 0;loop < nb;loop++)
+	{
+		Tango::DeviceData dout = dev.command_inout("LogDisabled",din);
+		std::vector<Tango::DevDouble> cost;
+		dout >> cost;
+		tango_log_samples.add(cost[0]);
+		debug_stream_samples.add(cost[1]);
+		tango_log_ns = tango_log_ns + cost[0] * nb_statements;
+		debug_stream_ns = debug_stream_ns + cost[1] * nb_statements;
+	}
+
+	report.add("log_disabled_tango_log_debug",tango_log_samples,rate(nb * nb_statements,tango_log_ns / 1000.0),"ns");
+	report.add("log_disabled_debug_stream",debug_stream_samples,rate(nb * nb_statements,debug_stream_ns / 1000.0),"ns");
+}
+
+} // End of bench namespace
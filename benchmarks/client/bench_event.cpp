@@ -0,0 +1,344 @@
+//+=============================================================================
+//
+// file :               bench_event.cpp
+//
+// description :        Benchmark drivers for the events: fan-out of the events
+//			pushed by one device to several listener processes and
+//			subscription storms.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#include "bench.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace bench
+{
+
+//
+// Callback of the listener processes. The event latency is the delay between the event date (set by the server
+// when the event is pushed) and its reception. Events dated before the start date (set once subscribed) are the
+// subscription ones
+//
+
+class FanoutCallBack: public Tango::CallBack
+{
+public:
+	FanoutCallBack(long nb):expected(nb),start_date(-1.0),nb_received(0),last_date(0.0) {}
+
+	virtual void push_event(Tango::EventData *ev)
+	{
+		double now = wall_us();
+		if (ev->err == true)
+			return;
+
+		Tango::TimeVal &tv = ev->attr_value->get_date();
+		double date = tv.tv_sec * 1000000.0 + tv.tv_usec;
+		std::lock_guard<std::mutex> lo(mutex);
+		if (start_date < 0.0 || date < start_date)
+			return;
+
+		samples.add(now - date);
+		last_date = now;
+		nb_received++;
+		if (nb_received == expected)
+			cond.notify_one();
+	}
+
+	bool wait_all(double timeout)
+	{
+		std::unique_lock<std::mutex> lo(mutex);
+		return cond.wait_for(lo,std::chrono::duration<double>(timeout),[this](){return nb_received >= expected;});
+	}
+
+	long				expected;
+	double				start_date;
+	long				nb_received;
+	double				last_date;
+	Samples				samples;
+	std::mutex			mutex;
+	std::condition_variable	cond;
+};
+
+class NullCallBack: public Tango::CallBack
+{
+public:
+	virtual void push_event(Tango::EventData *) {}
+};
+
+static double rate(long nb,double us)
+{
+	return us > 0.0 ? nb * 1000000.0 / us : 0.0;
+}
+
+//+----------------------------------------------------------------------------
+//
+// function : 		run_listener()
+//
+// description : 	Main of the event listener processes. The listener
+//			subscribes to the EventSource attribute, prints "ready",
+//			waits for the events and prints its results:
+//			"result <received> <last reception date (us)>" followed by
+//			one line with the latencies
+//
+//-----------------------------------------------------------------------------
+
+int run_listener(const BenchConfig &conf)
+{
+	try
+	{
+		Tango::DeviceProxy dev(conf.listen);
+		FanoutCallBack cb(conf.nb_events);
+		int id = dev.subscribe_event("EventSource",Tango::CHANGE_EVENT,&cb);
+		{
+			std::lock_guard<std::mutex> lo(cb.mutex);
+			cb.start_date = wall_us();
+		}
+
+		std::cout << "ready" << std::endl;
+		cb.wait_all(60.0 + conf.nb_events / 1000.0);
+		dev.unsubscribe_event(id);
+
+		std::lock_guard<std::mutex> lo(cb.mutex);
+		std::cout << std::fixed << "result " << cb.nb_received << " " << cb.last_date << "\n";
+		for (auto val : cb.samples.get_values())
+			std::cout << val << " ";
+		std::cout << std::endl;
+	}
+	catch (Tango::DevFailed &e)
+	{
+		Tango::Except::print_exception(e);
+		return -1;
+	}
+
+	return 0;
+}
+
+//+----------------------------------------------------------------------------
+//
+// function : 		bench_event_fanout()
+//
+// description : 	Start the listener processes, ask the first device to
+//			push the events and gather the listeners results. The rate
+//			is the number of received events per second (all listeners)
+//
+//-----------------------------------------------------------------------------
+
+void bench_event_fanout(const BenchConfig &conf,BenchReport &report)
+{
+	std::stringstream cmd;
+	cmd << "\"" << conf.self_path << "\" --listen=\"" << conf.device_name(0) << "\" --events=" << conf.nb_events;
+
+	std::vector<FILE *> listeners;
+	char buf[256];
+	for (int loop = 0;loop < conf.nb_listeners;loop++)
+	{
+		FILE *f = popen(cmd.str().c_str(),"r");
+		if (f == NULL)
+		{
+			std::cerr << "Can't start the event listener " << cmd.str() << std::endl;
+			break;
+		}
+		listeners.push_back(f);
+	}
+
+	for (auto f : listeners)
+	{
+		if (fgets(buf,sizeof(buf),f) == NULL || std::string(buf) != "ready\n")
+			std::cerr << "Event listener not ready" << std::endl;
+	}
+
+	Tango::DeviceProxy dev(conf.device_name(0));
+	dev.set_timeout_millis(60000 + conf.nb_events);
+	std::vector<Tango::DevLong> arg = {static_cast<Tango::DevLong>(conf.nb_events),static_cast<Tango::DevLong>(conf.event_size)};
+	Tango::DeviceData din;
+	din << arg;
+
+	double start = wall_us();
+	dev.command_inout("PushEvents",din);
+	double push_us = wall_us() - start;
+
+	Samples samples;
+	long nb_received = 0;
+	double last_date = start;
+	for (auto f : listeners)
+	{
+		std::string out;
+		while (fgets(buf,sizeof(buf),f) != NULL)
+			out = out + buf;
+		pclose(f);
+
+		std::istringstream iss(out);
+		std::string tag;
+		long nb = 0;
+		double date = 0.0;
+		iss >> tag >> nb >> date;
+		if (tag != "result")
+			continue;
+
+		nb_received = nb_received + nb;
+		last_date = std::max(last_date,date);
+		double val;
+		while (iss >> val)
+			samples.add(val);
+	}
+
+	for (long loop = nb_received;loop < conf.nb_events * conf.nb_listeners;loop++)
+		samples.add_error();
+	report.add("event_fanout",samples,rate(nb_received,last_date - start));
+
+	Samples push_samples;
+	push_samples.add(push_us);
+	report.add("event_push",push_samples,rate(conf.nb_events,push_us));
+}
+
+//+----------------------------------------------------------------------------
+//
+// function : 		bench_subscription_storm()
+//
+// description : 	Subscribe to change events on many dynamic attributes of
+//			every device. First with one subscribe_event() call per
+//			attribute then with one subscribe_events() call per device.
+//			Finally, subscribe as many times to the same attribute of
+//			the first device (event channel already connected), one by
+//			one then in one subscribe_events() call
+//
+//-----------------------------------------------------------------------------
+
+void bench_subscription_storm(const BenchConfig &conf,BenchReport &report)
+{
+	std::vector<std::unique_ptr<Tango::DeviceProxy> > devs;
+	std::vector<std::string> names;
+	for (int loop = 0;loop < conf.nb_devices;loop++)
+	{
+		devs.emplace_back(new Tango::DeviceProxy(conf.device_name(loop)));
+		Tango::DeviceData din;
+		din << static_cast<Tango::DevLong>(conf.storm_attributes);
+		devs.back()->command_inout("CreateAttributes",din);
+	}
+	for (long loop = 0;loop < conf.storm_attributes;loop++)
+		names.push_back("Dyn_" + std::to_string(loop));
+
+	NullCallBack cb;
+
+	{
+		Samples samples;
+		std::vector<std::pair<Tango::DeviceProxy *,int> > ids;
+		auto start = std::chrono::steady_clock::now();
+		for (auto &dev : devs)
+		{
+			for (const auto &name : names)
+			{
+				auto call_start = std::chrono::steady_clock::now();
+				try
+				{
+					ids.push_back({dev.get(),dev->subscribe_event(name,Tango::CHANGE_EVENT,&cb)});
+					samples.add(elapsed_us(call_start));
+				}
+				catch (Tango::DevFailed &)
+				{
+					samples.add_error();
+				}
+			}
+		}
+		double us = elapsed_us(start);
+		report.add("subscribe_event",samples,rate(samples.size(),us));
+
+		for (auto &id : ids)
+			id.first->unsubscribe_event(id.second);
+	}
+
+	{
+		Samples samples;
+		long nb_subscribed = 0;
+		std::vector<std::pair<Tango::DeviceProxy *,int> > ids;
+		auto start = std::chrono::steady_clock::now();
+		for (auto &dev : devs)
+		{
+			auto call_start = std::chrono::steady_clock::now();
+			std::vector<Tango::DevErrorList> errors;
+			std::vector<int> dev_ids = dev->subscribe_events(names,Tango::CHANGE_EVENT,&cb,errors);
+			samples.add(elapsed_us(call_start));
+			for (auto id : dev_ids)
+			{
+				if (id == 0)
+					samples.add_error();
+				else
+				{
+					ids.push_back({dev.get(),id});
+					nb_subscribed++;
+				}
+			}
+		}
+		double us = elapsed_us(start);
+		report.add("subscribe_events",samples,rate(nb_subscribed,us));
+
+		for (auto &id : ids)
+			id.first->unsubscribe_event(id.second);
+	}
+
+	if (devs.empty() == true)
+		return;
+	Tango::DeviceProxy *dev = devs[0].get();
+	std::vector<std::string> same_names(conf.storm_attributes,names[0]);
+
+	{
+		Samples samples;
+		std::vector<int> ids;
+		auto start = std::chrono::steady_clock::now();
+		for (const auto &name : same_names)
+		{
+			auto call_start = std::chrono::steady_clock::now();
+			try
+			{
+				ids.push_back(dev->subscribe_event(name,Tango::CHANGE_EVENT,&cb));
+				samples.add(elapsed_us(call_start));
+			}
+			catch (Tango::DevFailed &)
+			{
+				samples.add_error();
+			}
+		}
+		double us = elapsed_us(start);
+		report.add("subscribe_event_same_attribute",samples,rate(samples.size(),us));
+
+		for (auto id : ids)
+			dev->unsubscribe_event(id);
+	}
+
+	{
+		Samples samples;
+		long nb_subscribed = 0;
+		auto start = std::chrono::steady_clock::now();
+		std::vector<Tango::DevErrorList> errors;
+		std::vector<int> ids = dev->subscribe_events(same_names,Tango::CHANGE_EVENT,&cb,errors);
+		samples.add(elapsed_us(start));
+		for (auto id : ids)
+		{
+			if (id == 0)
+				samples.add_error();
+			else
+				nb_subscribed++;
+		}
+		report.add("subscribe_events_same_attribute",samples,rate(nb_subscribed,samples.get_max()));
+
+		for (auto id : ids)
+		{
+			if (id != 0)
+				dev->unsubscribe_event(id);
+		}
+	}
+}
+
+} // End of bench namespace
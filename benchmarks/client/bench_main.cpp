@@ -0,0 +1,403 @@
+//+=============================================================================
+//
+// file :               bench_main.cpp
+//
+// description :        Main of the tango_bench benchmark driver. It decodes the
+//			command line, waits for the benchmark device server, runs
+//			the selected scenarios and writes the JSON report.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#include "bench.h"
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+namespace bench
+{
+
+static const char *all_scenarios[] = {"read_write","command","event_fanout","subscription_storm","polling","group","logging"};
+
+std::string BenchConfig::device_name(int idx) const
+{
+	std::stringstream ss;
+	ss << "tango://" << host << ":" << port << "/bench/device/" << idx + 1 << "#dbase=no";
+	return ss.str();
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		Samples statistics
+//
+// description : 	The percentiles are computed on the sorted samples using
+//			the nearest rank method
+//
+//-----------------------------------------------------------------------------
+
+void Samples::add(const Samples &other)
+{
+	values.insert(values.end(),other.values.begin(),other.values.end());
+	nb_errors = nb_errors + other.nb_errors;
+	sorted = false;
+}
+
+double Samples::get_min() const
+{
+	return values.empty() == true ? 0.0 : *std::min_element(values.begin(),values.end());
+}
+
+double Samples::get_max() const
+{
+	return values.empty() == true ? 0.0 : *std::max_element(values.begin(),values.end());
+}
+
+double Samples::get_mean() const
+{
+	return values.empty() == true ? 0.0 : std::accumulate(values.begin(),values.end(),0.0) / values.size();
+}
+
+double Samples::get_percentile(double pct)
+{
+	if (values.empty() == true)
+		return 0.0;
+
+	if (sorted == false)
+	{
+		std::sort(values.begin(),values.end());
+		sorted = true;
+	}
+
+	size_t rank = static_cast<size_t>(pct / 100.0 * values.size() + 0.5);
+	if (rank < 1)
+		rank = 1;
+	if (rank > values.size())
+		rank = values.size();
+	return values[rank - 1];
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchReport::add()
+//
+// description : 	Add one result to the report
+//
+// in : - name : The result name
+//	- samples : The measured latencies
+//	- rate : The measured rate (operations per second)
+//	- unit : The latencies unit
+//
+//-----------------------------------------------------------------------------
+
+void BenchReport::add(const std::string &name,Samples &samples,double rate,const std::string &unit)
+{
+	BenchResult res;
+	res.name = name;
+	res.unit = unit;
+	res.count = samples.size();
+	res.errors = samples.get_errors();
+	res.min = samples.get_min();
+	res.mean = samples.get_mean();
+	res.p50 = samples.get_percentile(50.0);
+	res.p90 = samples.get_percentile(90.0);
+	res.p99 = samples.get_percentile(99.0);
+	res.max = samples.get_max();
+	res.rate = rate;
+	results.push_back(res);
+
+	std::cerr << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(1)
+			  << " count=" << res.count << " errors=" << res.errors << " p50=" << res.p50 << unit << " p99=" << res.p99
+			  << unit << " rate=" << res.rate << "/s" << std::endl;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchReport::write_json()
+//
+// description : 	Write the report in JSON. The names are plain identifiers
+//			and the label is escaped
+//
+//-----------------------------------------------------------------------------
+
+static std::string json_string(const std::string &str)
+{
+	std::stringstream ss;
+	ss << '"';
+	for (auto c : str)
+	{
+		if (c == '"' || c == '\\')
+			ss << '\\' << c;
+		else if (static_cast<unsigned char>(c) < 0x20)
+			ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+		else
+			ss << c;
+	}
+	ss << '"';
+	return ss.str();
+}
+
+void BenchReport::write_json(std::ostream &o,const BenchConfig &conf)
+{
+	char date[64];
+	time_t now = time(NULL);
+	strftime(date,sizeof(date),"%Y-%m-%dT%H:%M:%SZ",gmtime(&now));
+
+	o << std::fixed << std::setprecision(3);
+	o << "{\n";
+	o << "  \"tango_version\": " << json_string(Tango::TgLibVers) << ",\n";
+	o << "  \"label\": " << json_string(conf.label) << ",\n";
+	o << "  \"date\": " << json_string(date) << ",\n";
+	o << "  \"config\": {\n";
+	o << "    \"devices\": " << conf.nb_devices << ",\n";
+	o << "    \"iterations\": " << conf.iterations << ",\n";
+	o << "    \"warmup\": " << conf.warmup << ",\n";
+	o << "    \"duration\": " << conf.duration << ",\n";
+	o << "    \"spectrum_size\": " << conf.spectrum_size << ",\n";
+	o << "    \"threads\": " << conf.nb_threads << ",\n";
+	o << "    \"listeners\": " << conf.nb_listeners << ",\n";
+	o << "    \"events\": " << conf.nb_events << ",\n";
+	o << "    \"event_size\": " << conf.event_size << ",\n";
+	o << "    \"storm_attributes\": " << conf.storm_attributes << ",\n";
+	o << "    \"poll_period\": " << conf.poll_period << "\n";
+	o << "  },\n";
+	o << "  \"results\": [";
+	for (size_t loop = 0;loop < results.size();loop++)
+	{
+		const BenchResult &res = results[loop];
+		o << (loop == 0 ? "\n" : ",\n");
+		o << "    {\"name\": " << json_string(res.name) << ", \"unit\": " << json_string(res.unit)
+		  << ", \"count\": " << res.count << ", \"errors\": " << res.errors
+		  << ", \"min\": " << res.min << ", \"mean\": " << res.mean
+		  << ", \"p50\": " << res.p50 << ", \"p90\": " << res.p90 << ", \"p99\": " << res.p99
+		  << ", \"max\": " << res.max << ", \"rate\": " << res.rate << "}";
+	}
+	o << "\n  ]\n";
+	o << "}\n";
+}
+
+//+----------------------------------------------------------------------------
+//
+// function : 		parse_args()
+//
+// description : 	Decode the command line (--<option>=<value>)
+//
+//-----------------------------------------------------------------------------
+
+static void usage(const char *name)
+{
+	std::cerr << "usage: " << name << " --port=<port> [options]\n"
+			  << "  --host=<ip>               Device server host (127.0.0.1)\n"
+			  << "  --devices=<n>             Number of bench/device/<i> devices (4)\n"
+			  << "  --iterations=<n>          Calls per latency measurement (10000)\n"
+			  << "  --warmup=<n>              Calls before measuring (100)\n"
+			  << "  --duration=<s>            Throughput measurement duration (5)\n"
+			  << "  --spectrum-size=<n>       Spectrum/Echo data size (1024)\n"
+			  << "  --threads=<n>             Client threads for throughput (4)\n"
+			  << "  --listeners=<n>           Event listener processes (4)\n"
+			  << "  --events=<n>              Events pushed for fan-out (10000)\n"
+			  << "  --event-size=<n>          Event data size (1)\n"
+			  << "  --storm-attributes=<n>    Subscribed attributes per device (100)\n"
+			  << "  --poll-attributes=<n,..>  Polled attributes for each polling run (10,100,1000)\n"
+			  << "  --poll-period=<ms>        Polling period (100)\n"
+			  << "  --scenarios=<s,..>        Scenarios (read_write,command,event_fanout,\n"
+			  << "                            subscription_storm,polling,group,logging)\n"
+			  << "  --label=<text>            Label stored in the report\n"
+			  << "  --output=<file>           JSON report file (- for stdout)" << std::endl;
+	exit(-1);
+}
+
+static std::vector<std::string> split(const std::string &str)
+{
+	std::vector<std::string> ret;
+	std::stringstream ss(str);
+	std::string item;
+	while (std::getline(ss,item,','))
+	{
+		if (item.empty() == false)
+			ret.push_back(item);
+	}
+	return ret;
+}
+
+static void parse_args(int argc,char *argv[],BenchConfig &conf)
+{
+	conf.host = "127.0.0.1";
+	conf.port = 0;
+	conf.nb_devices = 4;
+	conf.iterations = 10000;
+	conf.warmup = 100;
+	conf.duration = 5.0;
+	conf.spectrum_size = 1024;
+	conf.nb_threads = 4;
+	conf.nb_listeners = 4;
+	conf.nb_events = 10000;
+	conf.event_size = 1;
+	conf.storm_attributes = 100;
+	conf.poll_attributes = {10,100,1000};
+	conf.poll_period = 100;
+	conf.output = "-";
+	conf.scenarios.assign(std::begin(all_scenarios),std::end(all_scenarios));
+	conf.self_path = argv[0];
+
+	try
+	{
+		for (int loop = 1;loop < argc;loop++)
+		{
+			std::string arg(argv[loop]);
+			std::string::size_type pos = arg.find('=');
+			if (arg.compare(0,2,"--") != 0 || pos == std::string::npos)
+				usage(argv[0]);
+			std::string opt = arg.substr(2,pos - 2);
+			std::string val = arg.substr(pos + 1);
+
+			if (opt == "host")
+				conf.host = val;
+			else if (opt == "port")
+				conf.port = std::stoi(val);
+			else if (opt == "devices")
+				conf.nb_devices = std::stoi(val);
+			else if (opt == "iterations")
+				conf.iterations = std::stol(val);
+			else if (opt == "warmup")
+				conf.warmup = std::stol(val);
+			else if (opt == "duration")
+				conf.duration = std::stod(val);
+			else if (opt == "spectrum-size")
+				conf.spectrum_size = std::stol(val);
+			else if (opt == "threads")
+				conf.nb_threads = std::stoi(val);
+			else if (opt == "listeners")
+				conf.nb_listeners = std::stoi(val);
+			else if (opt == "events")
+				conf.nb_events = std::stol(val);
+			else if (opt == "event-size")
+				conf.event_size = std::stol(val);
+			else if (opt == "storm-attributes")
+				conf.storm_attributes = std::stol(val);
+			else if (opt == "poll-attributes")
+			{
+				conf.poll_attributes.clear();
+				for (const auto &item : split(val))
+					conf.poll_attributes.push_back(std::stol(item));
+			}
+			else if (opt == "poll-period")
+				conf.poll_period = std::stoi(val);
+			else if (opt == "scenarios")
+				conf.scenarios = split(val);
+			else if (opt == "label")
+				conf.label = val;
+			else if (opt == "output")
+				conf.output = val;
+			else if (opt == "listen")
+				conf.listen = val;
+			else
+				usage(argv[0]);
+		}
+	}
+	catch (std::exception &)
+	{
+		usage(argv[0]);
+	}
+
+	if (conf.port <= 0 && conf.listen.empty() == true)
+		usage(argv[0]);
+	if (conf.nb_devices < 1 || conf.nb_threads < 1 || conf.nb_listeners < 1 || conf.iterations < 1)
+		usage(argv[0]);
+}
+
+//+----------------------------------------------------------------------------
+//
+// function : 		wait_server()
+//
+// description : 	Wait for the benchmark device server to answer
+//
+//-----------------------------------------------------------------------------
+
+static void wait_server(const BenchConfig &conf)
+{
+	Tango::DeviceProxy dev(conf.device_name(conf.nb_devices - 1));
+	for (int loop = 0;;loop++)
+	{
+		try
+		{
+			dev.ping();
+			return;
+		}
+		catch (Tango::DevFailed &)
+		{
+			if (loop == 300)
+				throw;
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+	}
+}
+
+} // End of bench namespace
+
+int main(int argc,char *argv[])
+{
+	bench::BenchConfig conf;
+	bench::parse_args(argc,argv,conf);
+
+	if (conf.listen.empty() == false)
+		return bench::run_listener(conf);
+
+	bench::BenchReport report;
+	try
+	{
+		bench::wait_server(conf);
+
+		for (const auto &sc : conf.scenarios)
+		{
+			if (sc == "read_write")
+				bench::bench_read_write(conf,report);
+			else if (sc == "command")
+				bench::bench_command(conf,report);
+			else if (sc == "event_fanout")
+				bench::bench_event_fanout(conf,report);
+			else if (sc == "subscription_storm")
+				bench::bench_subscription_storm(conf,report);
+			else if (sc == "polling")
+				bench::bench_polling(conf,report);
+			else if (sc == "group")
+				bench::bench_group(conf,report);
+			else if (sc == "logging")
+				bench::bench_logging(conf,report);
+			else
+			{
+				std::cerr << "Unknown scenario " << sc << std::endl;
+				return -1;
+			}
+		}
+	}
+	catch (Tango::DevFailed &e)
+	{
+		Tango::Except::print_exception(e);
+		return -1;
+	}
+
+	if (conf.output == "-")
+		report.write_json(std::cout,conf);
+	else
+	{
+		std::ofstream ofs(conf.output.c_str());
+		report.write_json(ofs,conf);
+		if (!ofs)
+		{
+			std::cerr << "Can't write the report in " << conf.output << std::endl;
+			return -1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,107 @@
+//+=============================================================================
+//
+// file :               bench_poll.cpp
+//
+// description :        Benchmark driver for the polling scalability. For each
+//			requested number of attributes, the dynamic attributes
+//			of the devices are polled and the polling jitter is
+//			computed from their polling buffers.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#include "bench.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+namespace bench
+{
+
+//+----------------------------------------------------------------------------
+//
+// function : 		bench_polling()
+//
+// description : 	The samples are the differences (in absolute value)
+//			between the delay separating two successive records of the
+//			polling buffer and the polling period. A failed record is
+//			counted as an error. The rate is the number of polling
+//			executions per second (all attributes)
+//
+//-----------------------------------------------------------------------------
+
+void bench_polling(const BenchConfig &conf,BenchReport &report)
+{
+	std::vector<std::unique_ptr<Tango::DeviceProxy> > devs;
+	for (int loop = 0;loop < conf.nb_devices;loop++)
+		devs.emplace_back(new Tango::DeviceProxy(conf.device_name(loop)));
+
+	double period_us = conf.poll_period * 1000.0;
+	int depth = Tango::DefaultPollRingDepth;
+
+	for (auto nb_attr : conf.poll_attributes)
+	{
+		Tango::DeviceData din;
+		din << static_cast<Tango::DevLong>((nb_attr + conf.nb_devices - 1) / conf.nb_devices);
+		for (auto &dev : devs)
+			dev->command_inout("CreateAttributes",din);
+
+//
+// Start polling, attributes are spread over the devices
+//
+
+		std::vector<std::pair<Tango::DeviceProxy *,std::string> > polled;
+		for (long loop = 0;loop < nb_attr;loop++)
+		{
+			Tango::DeviceProxy *dev = devs[loop % conf.nb_devices].get();
+			std::string name = "Dyn_" + std::to_string(loop / conf.nb_devices);
+			dev->poll_attribute(name,conf.poll_period);
+			polled.push_back({dev,name});
+		}
+
+		double wait_ms = std::max(2000.0,(depth + 2) * static_cast<double>(conf.poll_period));
+		std::this_thread::sleep_for(std::chrono::duration<double,std::milli>(wait_ms));
+
+//
+// Analyse the polling buffers
+//
+
+		Samples samples;
+		double nb_per_s = 0.0;
+		for (auto &att : polled)
+		{
+			std::unique_ptr<std::vector<Tango::DeviceAttributeHistory> > hist(att.first->attribute_history(att.second,depth));
+
+			std::vector<double> dates;
+			for (auto &rec : *hist)
+			{
+				if (rec.has_failed() == true)
+				{
+					samples.add_error();
+					continue;
+				}
+				Tango::TimeVal &tv = rec.get_date();
+				dates.push_back(tv.tv_sec * 1000000.0 + tv.tv_usec);
+			}
+			std::sort(dates.begin(),dates.end());
+
+			for (size_t loop = 1;loop < dates.size();loop++)
+				samples.add(std::fabs(dates[loop] - dates[loop - 1] - period_us));
+			if (dates.size() > 1 && dates.back() > dates.front())
+				nb_per_s = nb_per_s + (dates.size() - 1) * 1000000.0 / (dates.back() - dates.front());
+		}
+
+		for (auto &att : polled)
+			att.first->stop_poll_attribute(att.second);
+
+		report.add("polling_" + std::to_string(nb_attr) + "_attributes",samples,nb_per_s);
+	}
+}
+
+} // End of bench namespace
@@ -0,0 +1,231 @@
+//+=============================================================================
+//
+// file :               BenchDevice.cpp
+//
+// description :        C++ source for the BenchDevice class used by the
+//			benchmark drivers.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#include "BenchDevice.h"
+#include "BenchDeviceClass.h"
+#include <chrono>
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDevice::BenchDevice(string &s)
+//
+// description : 	constructors for the BenchDevice device
+//
+// in : - cl : Pointer to the DeviceClass object
+//	- s : Device name
+//
+//-----------------------------------------------------------------------------
+
+BenchDevice::BenchDevice(Tango::DeviceClass *cl,std::string &s):TANGO_BASE_CLASS(cl,s.c_str())
+{
+	init_device();
+}
+
+BenchDevice::BenchDevice(Tango::DeviceClass *cl,const char *s):TANGO_BASE_CLASS(cl,s)
+{
+	init_device();
+}
+
+BenchDevice::BenchDevice(Tango::DeviceClass *cl,const char *s,const char *d):TANGO_BASE_CLASS(cl,s,d)
+{
+	init_device();
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDevice::init_device()
+//
+// description : 	will be called at device initialization.
+//
+//-----------------------------------------------------------------------------
+
+void BenchDevice::init_device()
+{
+	TANGO_LOG_INFO << "BenchDevice::BenchDevice() create " << device_name << std::endl;
+
+	attr_scalar = 0.0;
+	attr_spectrum.assign(1,0.0);
+	attr_counter = 0;
+	event_data.assign(1,0.0);
+	dyn_value = 0.0;
+	nb_dyn_attr = 0;
+
+	set_state(Tango::ON);
+}
+
+void BenchDevice::delete_device()
+{
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDevice attribute methods
+//
+// description : 	Read/write the attribute data. The spectrum size is the one
+//			of the last written value.
+//
+//-----------------------------------------------------------------------------
+
+void BenchDevice::read_Scalar(Tango::Attribute &att)
+{
+	att.set_value(&attr_scalar);
+}
+
+void BenchDevice::write_Scalar(Tango::WAttribute &att)
+{
+	att.get_write_value(attr_scalar);
+}
+
+void BenchDevice::read_Spectrum(Tango::Attribute &att)
+{
+	att.set_value(attr_spectrum.data(),attr_spectrum.size());
+}
+
+void BenchDevice::write_Spectrum(Tango::WAttribute &att)
+{
+	const Tango::DevDouble *ptr;
+	att.get_write_value(ptr);
+	attr_spectrum.assign(ptr,ptr + att.get_write_value_length());
+}
+
+void BenchDevice::read_Counter(Tango::Attribute &att)
+{
+	attr_counter++;
+	att.set_value(&attr_counter);
+}
+
+void BenchDevice::read_EventSource(Tango::Attribute &att)
+{
+	att.set_value(event_data.data(),event_data.size());
+}
+
+void BenchDevice::read_dyn(Tango::Attribute &att)
+{
+	dyn_value = dyn_value + 1.0;
+	att.set_value(&dyn_value);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDevice::echo()
+//
+// description : 	Return a copy of the input data
+//
+//-----------------------------------------------------------------------------
+
+Tango::DevVarDoubleArray *BenchDevice::echo(const Tango::DevVarDoubleArray *argin)
+{
+	return new Tango::DevVarDoubleArray(*argin);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDevice::push_events()
+//
+// description : 	Push change events on the EventSource attribute
+//
+// in : - argin : The number of events to push and the event data size
+//		  (in double). The first element of the pushed data is the
+//		  event number (starting at 0)
+//
+//-----------------------------------------------------------------------------
+
+void BenchDevice::push_events(const Tango::DevVarLongArray *argin)
+{
+	if (argin->length() != 2 || (*argin)[0] < 0 || (*argin)[1] < 1 || (*argin)[1] > BENCH_MAX_SPECTRUM)
+	{
+		TANGO_THROW_EXCEPTION("Bench_WrongArgument",
+				"Argument must be the number of events and the data size (1 - 1048576)");
+	}
+
+	event_data.assign((*argin)[1],0.0);
+	for (Tango::DevLong loop = 0;loop < (*argin)[0];loop++)
+	{
+		event_data[0] = static_cast<Tango::DevDouble>(loop);
+		push_change_event("EventSource",event_data.data(),event_data.size());
+	}
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDevice::create_attributes()
+//
+// description : 	Create the dynamic attributes Dyn_0 ... Dyn_<n-1>. The
+//			already created ones are kept.
+//
+// in : - argin : The number of dynamic attributes
+//
+//-----------------------------------------------------------------------------
+
+void BenchDevice::create_attributes(Tango::DevLong argin)
+{
+	if (argin < 0 || argin > BENCH_MAX_DYN_ATTR)
+	{
+		TANGO_THROW_EXCEPTION("Bench_WrongArgument","Argument must be between 0 and 10000");
+	}
+
+	for (;nb_dyn_attr < argin;nb_dyn_attr++)
+	{
+		std::stringstream ss;
+		ss << "Dyn_" << nb_dyn_attr;
+		Tango::Attr *at = new BenchDynAttr(ss.str());
+		at->set_change_event(true,false);
+		add_attribute(at);
+	}
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDevice::log_disabled()
+//
+// description : 	Execute disabled TANGO_LOG_DEBUG then DEBUG_STREAM
+//			statements. This is the cost paid on the request path
+//			when the DEBUG level is compiled in but not enabled
+//
+// in : - argin : The number of statements of each kind
+//
+// returns : The TANGO_LOG_DEBUG and the DEBUG_STREAM statement cost (ns)
+//
+//-----------------------------------------------------------------------------
+
+Tango::DevVarDoubleArray *BenchDevice::log_disabled(Tango::DevLong argin)
+{
+	if (argin < 1)
+	{
+		TANGO_THROW_EXCEPTION("Bench_WrongArgument","Argument must be a positive number of statements");
+	}
+
+	if ((API_LOGGER != NULL && API_LOGGER->is_debug_enabled() == true) || get_logger()->is_debug_enabled() == true)
+	{
+		TANGO_THROW_EXCEPTION("Bench_WrongLoggingLevel","The DEBUG logging level must be disabled (no -v5 option)");
+	}
+
+	Tango::DevVarDoubleArray *argout = new Tango::DevVarDoubleArray(2);
+	argout->length(2);
+
+	auto start = std::chrono::steady_clock::now();
+	for (Tango::DevLong loop = 0;loop < argin;loop++)
+		TANGO_LOG_DEBUG << "Disabled statement " << loop << " of " << device_name << std::endl;
+	std::chrono::duration<double,std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	(*argout)[0] = elapsed.count() / argin;
+
+	start = std::chrono::steady_clock::now();
+	for (Tango::DevLong loop = 0;loop < argin;loop++)
+		DEBUG_STREAM << "Disabled statement " << loop << " of " << device_name << std::endl;
+	elapsed = std::chrono::steady_clock::now() - start;
+	(*argout)[1] = elapsed.count() / argin;
+
+	return argout;
+}
@@ -0,0 +1,69 @@
+//+=============================================================================
+//
+// file :               BenchDevice.h
+//
+// description :        Include for the BenchDevice class. This is the lightweight
+//			device used by the benchmark drivers. Its attributes and
+//			commands do (almost) nothing else than moving data so that
+//			the measured times are the Tango library ones.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#ifndef _BENCH_DEVICE_H
+#define _BENCH_DEVICE_H
+
+#include <tango.h>
+
+const long BENCH_MAX_SPECTRUM	= 1048576;	// Max size of the spectrum attributes
+const long BENCH_MAX_DYN_ATTR	= 10000;	// Max number of dynamic attributes
+
+class BenchDevice : public TANGO_BASE_CLASS
+{
+public :
+	BenchDevice(Tango::DeviceClass *,std::string &);
+	BenchDevice(Tango::DeviceClass *,const char *);
+	BenchDevice(Tango::DeviceClass *,const char *,const char *);
+	~BenchDevice() {delete_device();}
+
+	virtual void init_device();
+	virtual void delete_device();
+
+//
+// Attribute related methods
+//
+
+	void read_Scalar(Tango::Attribute &);
+	void write_Scalar(Tango::WAttribute &);
+	void read_Spectrum(Tango::Attribute &);
+	void write_Spectrum(Tango::WAttribute &);
+	void read_Counter(Tango::Attribute &);
+	void read_EventSource(Tango::Attribute &);
+	void read_dyn(Tango::Attribute &);
+
+//
+// Command related methods
+//
+
+	void noop() {}
+	Tango::DevDouble scale(Tango::DevDouble argin) {return argin * 2;}
+	Tango::DevVarDoubleArray *echo(const Tango::DevVarDoubleArray *);
+	void push_events(const Tango::DevVarLongArray *);
+	void create_attributes(Tango::DevLong);
+	Tango::DevVarDoubleArray *log_disabled(Tango::DevLong);
+
+protected :
+	Tango::DevDouble				attr_scalar;
+	std::vector<Tango::DevDouble>	attr_spectrum;
+	Tango::DevLong					attr_counter;
+	std::vector<Tango::DevDouble>	event_data;
+	Tango::DevDouble				dyn_value;
+	Tango::DevLong					nb_dyn_attr;
+};
+
+#endif
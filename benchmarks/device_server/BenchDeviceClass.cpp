@@ -0,0 +1,207 @@
+//+=============================================================================
+//
+// file :               BenchDeviceClass.cpp
+//
+// description :        C++ source for the BenchDeviceClass and for the
+//			BenchDevice command classes. The class is a singleton
+//			holding the command and attribute definitions.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#include "BenchDeviceClass.h"
+
+BenchDeviceClass *BenchDeviceClass::_instance = NULL;
+
+//+----------------------------------------------------------------------------
+//
+// method : 		<command>::execute()
+//
+// description : 	Extract the input data, call the BenchDevice method and
+//			insert the output data
+//
+// in : - device : The device on which the command must be executed
+//	- in_any : The command input data
+//
+// returns : The command output data (packed in the Any object)
+//
+//-----------------------------------------------------------------------------
+
+CORBA::Any *NoopCmd::execute(Tango::DeviceImpl *device,TANGO_UNUSED(const CORBA::Any &in_any))
+{
+	(static_cast<BenchDevice *>(device))->noop();
+	return insert();
+}
+
+CORBA::Any *EchoCmd::execute(Tango::DeviceImpl *device,const CORBA::Any &in_any)
+{
+	const Tango::DevVarDoubleArray *argin;
+	extract(in_any,argin);
+	return insert((static_cast<BenchDevice *>(device))->echo(argin));
+}
+
+CORBA::Any *PushEventsCmd::execute(Tango::DeviceImpl *device,const CORBA::Any &in_any)
+{
+	const Tango::DevVarLongArray *argin;
+	extract(in_any,argin);
+	(static_cast<BenchDevice *>(device))->push_events(argin);
+	return insert();
+}
+
+CORBA::Any *CreateAttributesCmd::execute(Tango::DeviceImpl *device,const CORBA::Any &in_any)
+{
+	Tango::DevLong argin;
+	extract(in_any,argin);
+	(static_cast<BenchDevice *>(device))->create_attributes(argin);
+	return insert();
+}
+
+CORBA::Any *LogDisabledCmd::execute(Tango::DeviceImpl *device,const CORBA::Any &in_any)
+{
+	Tango::DevLong argin;
+	extract(in_any,argin);
+	return insert((static_cast<BenchDevice *>(device))->log_disabled(argin));
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDeviceClass::BenchDeviceClass()
+//
+// description : 	constructor for the BenchDeviceClass
+//
+// in : - s : The class name
+//
+//-----------------------------------------------------------------------------
+
+BenchDeviceClass::BenchDeviceClass(std::string &s):Tango::DeviceClass(s)
+{
+	TANGO_LOG_INFO << "Entering BenchDeviceClass constructor" << std::endl;
+
+	set_type("BenchDevice");
+
+	TANGO_LOG_INFO << "Leaving BenchDeviceClass constructor" << std::endl;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDeviceClass::init
+//
+// description : 	Create the object if not already done. Otherwise, just
+//			return a pointer to the object
+//
+// in : - name : The class name
+//
+//-----------------------------------------------------------------------------
+
+BenchDeviceClass *BenchDeviceClass::init(const char *name)
+{
+	if (_instance == NULL)
+	{
+		std::string s(name);
+		_instance = new BenchDeviceClass(s);
+	}
+	return _instance;
+}
+
+BenchDeviceClass *BenchDeviceClass::instance()
+{
+	if (_instance == NULL)
+	{
+		std::cerr << "Class is not initialised !!" << std::endl;
+		exit(-1);
+	}
+	return _instance;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDeviceClass::command_factory
+//
+// description : 	Create the command object(s) and store them in the
+//			command list
+//
+//-----------------------------------------------------------------------------
+
+void BenchDeviceClass::command_factory()
+{
+	command_list.push_back(new NoopCmd("Noop",
+					   Tango::DEV_VOID,
+					   Tango::DEV_VOID,
+					   "void",
+					   "void"));
+	command_list.push_back(new EchoCmd("Echo",
+					   Tango::DEVVAR_DOUBLEARRAY,
+					   Tango::DEVVAR_DOUBLEARRAY,
+					   "Data",
+					   "The same data"));
+	command_list.push_back(new PushEventsCmd("PushEvents",
+					   Tango::DEVVAR_LONGARRAY,
+					   Tango::DEV_VOID,
+					   "Event number, event data size",
+					   "void"));
+	command_list.push_back(new CreateAttributesCmd("CreateAttributes",
+					   Tango::DEV_LONG,
+					   Tango::DEV_VOID,
+					   "Dynamic attribute number",
+					   "void"));
+	command_list.push_back(new LogDisabledCmd("LogDisabled",
+					   Tango::DEV_LONG,
+					   Tango::DEVVAR_DOUBLEARRAY,
+					   "Statement number",
+					   "TANGO_LOG_DEBUG and DEBUG_STREAM statement cost (ns)"));
+	command_list.push_back(new Tango::TemplCommandInOut<Tango::DevDouble,Tango::DevDouble>("Scale",
+					   static_cast<Tango::Db_CmdMethPtr_Db>(&BenchDevice::scale)));
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDeviceClass::attribute_factory
+//
+// description : 	Create the attribute object(s) and store them in the
+//			attribute list
+//
+//-----------------------------------------------------------------------------
+
+void BenchDeviceClass::attribute_factory(std::vector<Tango::Attr *> &att_list)
+{
+	att_list.push_back(new BenchScalarAttr());
+	att_list.push_back(new BenchSpectrumAttr());
+	att_list.push_back(new BenchCounterAttr());
+	att_list.push_back(new BenchEventSourceAttr());
+	att_list.back()->set_change_event(true,false);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		BenchDeviceClass::device_factory
+//
+// description : 	Create the device object(s) and store them in the
+//			device list
+//
+// in :			Tango_DevVarStringArray *devlist_ptr :
+//			The device name list
+//
+//-----------------------------------------------------------------------------
+
+void BenchDeviceClass::device_factory(const Tango::DevVarStringArray *devlist_ptr)
+{
+	size_t first = device_list.size();
+	try
+	{
+		create_devices(devlist_ptr,[this](const char *name) -> Tango::DeviceImpl * {
+			return new BenchDevice(this,name);
+		});
+	}
+	catch (...)
+	{
+		export_devices(first);
+		throw;
+	}
+
+	export_devices(first);
+}
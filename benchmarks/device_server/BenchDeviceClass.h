@@ -0,0 +1,158 @@
+//+=============================================================================
+//
+// file :               BenchDeviceClass.h
+//
+// description :        Include for the BenchDeviceClass root class and for the
+//			BenchDevice attributes and commands classes.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#ifndef _BENCH_DEVICE_CLASS_H
+#define _BENCH_DEVICE_CLASS_H
+
+#include <tango.h>
+#include "BenchDevice.h"
+
+//
+// Attributes related classes
+//
+
+class BenchScalarAttr: public Tango::Attr
+{
+public:
+	BenchScalarAttr():Attr("Scalar", Tango::DEV_DOUBLE, Tango::READ_WRITE) {}
+	~BenchScalarAttr() {}
+
+	virtual void read(Tango::DeviceImpl *dev,Tango::Attribute &att)
+	{(static_cast<BenchDevice *>(dev))->read_Scalar(att);}
+	virtual void write(Tango::DeviceImpl *dev,Tango::WAttribute &att)
+	{(static_cast<BenchDevice *>(dev))->write_Scalar(att);}
+};
+
+class BenchSpectrumAttr: public Tango::SpectrumAttr
+{
+public:
+	BenchSpectrumAttr():Tango::SpectrumAttr("Spectrum", Tango::DEV_DOUBLE, Tango::READ_WRITE, BENCH_MAX_SPECTRUM) {}
+	~BenchSpectrumAttr() {}
+
+	virtual void read(Tango::DeviceImpl *dev,Tango::Attribute &att)
+	{(static_cast<BenchDevice *>(dev))->read_Spectrum(att);}
+	virtual void write(Tango::DeviceImpl *dev,Tango::WAttribute &att)
+	{(static_cast<BenchDevice *>(dev))->write_Spectrum(att);}
+};
+
+class BenchCounterAttr: public Tango::Attr
+{
+public:
+	BenchCounterAttr():Attr("Counter", Tango::DEV_LONG, Tango::READ) {}
+	~BenchCounterAttr() {}
+
+	virtual void read(Tango::DeviceImpl *dev,Tango::Attribute &att)
+	{(static_cast<BenchDevice *>(dev))->read_Counter(att);}
+};
+
+class BenchEventSourceAttr: public Tango::SpectrumAttr
+{
+public:
+	BenchEventSourceAttr():Tango::SpectrumAttr("EventSource", Tango::DEV_DOUBLE, Tango::READ, BENCH_MAX_SPECTRUM) {}
+	~BenchEventSourceAttr() {}
+
+	virtual void read(Tango::DeviceImpl *dev,Tango::Attribute &att)
+	{(static_cast<BenchDevice *>(dev))->read_EventSource(att);}
+};
+
+class BenchDynAttr: public Tango::Attr
+{
+public:
+	BenchDynAttr(const std::string &name):Attr(name.c_str(), Tango::DEV_DOUBLE, Tango::READ) {}
+	~BenchDynAttr() {}
+
+	virtual void read(Tango::DeviceImpl *dev,Tango::Attribute &att)
+	{(static_cast<BenchDevice *>(dev))->read_dyn(att);}
+};
+
+//
+// Commands related classes
+//
+
+class NoopCmd : public Tango::Command
+{
+public:
+	NoopCmd(const char *name,Tango::CmdArgType in,Tango::CmdArgType out,const char *in_desc,const char *out_desc)
+	:Command(name,in,out,in_desc,out_desc) {}
+	~NoopCmd() {}
+
+	virtual CORBA::Any *execute (Tango::DeviceImpl *,const CORBA::Any &);
+};
+
+class EchoCmd : public Tango::Command
+{
+public:
+	EchoCmd(const char *name,Tango::CmdArgType in,Tango::CmdArgType out,const char *in_desc,const char *out_desc)
+	:Command(name,in,out,in_desc,out_desc) {}
+	~EchoCmd() {}
+
+	virtual CORBA::Any *execute (Tango::DeviceImpl *,const CORBA::Any &);
+};
+
+class PushEventsCmd : public Tango::Command
+{
+public:
+	PushEventsCmd(const char *name,Tango::CmdArgType in,Tango::CmdArgType out,const char *in_desc,const char *out_desc)
+	:Command(name,in,out,in_desc,out_desc) {}
+	~PushEventsCmd() {}
+
+	virtual CORBA::Any *execute (Tango::DeviceImpl *,const CORBA::Any &);
+};
+
+class CreateAttributesCmd : public Tango::Command
+{
+public:
+	CreateAttributesCmd(const char *name,Tango::CmdArgType in,Tango::CmdArgType out,const char *in_desc,const char *out_desc)
+	:Command(name,in,out,in_desc,out_desc) {}
+	~CreateAttributesCmd() {}
+
+	virtual CORBA::Any *execute (Tango::DeviceImpl *,const CORBA::Any &);
+};
+
+class LogDisabledCmd : public Tango::Command
+{
+public:
+	LogDisabledCmd(const char *name,Tango::CmdArgType in,Tango::CmdArgType out,const char *in_desc,const char *out_desc)
+	:Command(name,in,out,in_desc,out_desc) {}
+	~LogDisabledCmd() {}
+
+	virtual CORBA::Any *execute (Tango::DeviceImpl *,const CORBA::Any &);
+};
+
+//
+// The BenchDeviceClass singleton definition
+//
+
+class BenchDeviceClass : public Tango::DeviceClass
+{
+public:
+
+// Method prototypes
+
+	static BenchDeviceClass *init(const char *);
+	static BenchDeviceClass *instance();
+	~BenchDeviceClass() {_instance = NULL;}
+
+protected:
+	BenchDeviceClass(std::string &);
+	static BenchDeviceClass *_instance;
+	void command_factory();
+	void attribute_factory(std::vector<Tango::Attr *> &);
+
+private:
+	void device_factory(const Tango::DevVarStringArray *);
+};
+
+#endif
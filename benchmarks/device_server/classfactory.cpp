@@ -0,0 +1,30 @@
+//+=============================================================================
+//
+// file :               classfactory.cpp
+//
+// description :        C++ source for the class_factory method of the DServer
+//			device class. This method is responsible to create
+//			all class singleton for a device server. It is called
+//			at device server startup
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#include <tango.h>
+#include "BenchDeviceClass.h"
+
+void Tango::DServer::class_factory()
+{
+
+//
+// Create BenchDeviceClass singleton and store it in DServer object
+//
+
+	add_class(BenchDeviceClass::init("BenchDevice"));
+
+}
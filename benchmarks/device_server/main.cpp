@@ -0,0 +1,52 @@
+//+=============================================================================
+//
+// file :               main.cpp
+//
+// description :        C++ source for the benchmark device server main.
+//			The server is started with a file database (-file=) and
+//			a loopback ORB end point by the run_benchmarks.sh script.
+//
+// project :            TANGO
+//
+// copyleft :           European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+//-=============================================================================
+
+#include <tango.h>
+
+
+int main(int argc,char *argv[])
+{
+	Tango::Util *tg = nullptr;
+	try
+	{
+		tg = Tango::Util::init(argc,argv);
+
+		tg->server_init();
+
+		std::cout << "Ready to accept request" << std::endl;
+		tg->server_run();
+	}
+	catch (std::bad_alloc&)
+	{
+		std::cout << "Can't allocate memory to store device object !!!" << std::endl;
+		std::cout << "Exiting" << std::endl;
+	}
+	catch (Tango::DevFailed &e)
+	{
+		Tango::Except::print_exception(e);
+	}
+	catch (CORBA::Exception &e)
+	{
+		Tango::Except::print_exception(e);
+
+		std::cout << "Received a CORBA_Exception" << std::endl;
+		std::cout << "Exiting" << std::endl;
+	}
+
+	if (tg != nullptr)
+		tg->server_cleanup();
+	return(0);
+}
@@ -0,0 +1,57 @@
+#!/usr/bin/env bash
+# vim: syntax=sh
+
+# Start the benchmark device server with a file database on loopback, run the
+# benchmark driver and stop the server. The results are written in JSON in
+# ${TANGO_BENCH_OUTPUT} (default: benchmark_results.json in the build tree).
+# Arguments are forwarded to tango_bench (e.g. --scenarios=read_write,command).
+
+export SHELLOPTS
+
+set -o errexit
+set -o nounset
+
+port="${TANGO_BENCH_PORT:-@TANGO_BENCH_PORT@}"
+nb_devices="${TANGO_BENCH_DEVICES:-@TANGO_BENCH_DEVICES@}"
+output="${TANGO_BENCH_OUTPUT:-@CMAKE_CURRENT_BINARY_DIR@/benchmark_results.json}"
+label="${TANGO_BENCH_LABEL:-$(git -C "@PROJECT_SOURCE_DIR@" describe --always --dirty 2>/dev/null || true)}"
+
+work_dir="$(mktemp -d)"
+server_pid=""
+
+cleanup() {
+    if [ -n "$server_pid" ]; then
+        kill -s TERM "$server_pid" &>/dev/null || true
+        wait "$server_pid" &>/dev/null || true
+    fi
+    rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+# The file database: all the devices and (optionally) the polling threads pool size.
+{
+    printf 'BenchDS/bench/DEVICE/BenchDevice: '
+    for ((i = 1; i <= nb_devices; i++)); do
+        if [ "$i" -gt 1 ]; then
+            printf ',\\\n                                  '
+        fi
+        printf '"bench/device/%d"' "$i"
+    done
+    printf '\n'
+    if [ -n "${TANGO_BENCH_POLL_THREADS:-}" ]; then
+        printf 'dserver/BenchDS/bench->polling_threads_pool_size: %d\n' "$TANGO_BENCH_POLL_THREADS"
+    fi
+} > "$work_dir/bench.db"
+
+"@CMAKE_CURRENT_BINARY_DIR@/BenchDS" bench -file="$work_dir/bench.db" \
+    -ORBendPoint "giop:tcp:127.0.0.1:$port" > "$work_dir/BenchDS.log" 2>&1 &
+server_pid="$!"
+
+if ! "@CMAKE_CURRENT_BINARY_DIR@/tango_bench" --host=127.0.0.1 --port="$port" \
+    --devices="$nb_devices" --label="$label" --output="$output" "$@"; then
+    echo "Benchmark failed, server output:"
+    cat "$work_dir/BenchDS.log"
+    exit 1
+fi
+
+echo "Benchmark results written in $output"
@@ -38,6 +38,20 @@
  * 																						*
  ***************************************************************************************/
 
+//
+// One entry of the device import cache. The IDL version is 0 until a connection has been built with this IOR
+//
+
+struct ImportCacheEntry
+{
+	std::string								ior;
+	bool									acc_checked;
+	AccessControlType						access;
+	long									version;
+	bool									has_alt_adr;
+	std::chrono::steady_clock::time_point	date;
+};
+
 /**
  * Miscellaneous utility methods usefull in a Tango client.
  *
@@ -133,6 +147,62 @@ public:
  * @return The asynchronous callback sub-model
  */
 	cb_sub_model get_asynch_cb_sub_model() {return auto_cb;}
+/**
+ * Set the device import cache time to live
+ *
+ * The device import cache keeps, for each device, the data returned by the database when a DeviceProxy instance
+ * is created (device IOR and access right) and the device IDL version. Other DeviceProxy instances to the same
+ * device created within the cache time to live do not send any request to the database and do not check the
+ * device IDL version. A cache entry is removed as soon as a DeviceProxy instance has to reconnect to its device.
+ * Each DeviceProxy instance still has its own CORBA object (the call timeout is per instance).
+ * The cache is disabled by default (time to live set to 0). It is also possible to set its time to live with
+ * the TANGO_IMPORT_CACHE_TTL environment variable.
+ *
+ * @param [in] ttl The cache time to live (in mS). Set it to 0 to disable (and clear) the cache
+ */
+	void set_import_cache_ttl(long ttl);
+/**
+ * Get the device import cache time to live
+ *
+ * Get the device import cache time to live (in mS). 0 means that the cache is disabled
+ *
+ * @return The device import cache time to live
+ */
+	long get_import_cache_ttl();
+/**
+ * Clear the device import cache
+ *
+ * Remove all the entries from the device import cache
+ */
+	void clear_import_cache();
+/**
+ * Get the device import cache size
+ *
+ * Get the number of entries in the device import cache
+ *
+ * @return The device import cache entry number
+ */
+	size_t get_import_cache_size();
+/**
+ * Import a list of devices in the device import cache
+ *
+ * Import all the devices with one call to the Database::import_device() method (device list version) and store
+ * the result in the device import cache. The DeviceProxy or AttributeProxy instances created later on for these
+ * devices do not send any request to the database. The device names must be defined in the control system
+ * specified by the TANGO_HOST environment variable. Devices not defined or not exported are ignored.
+ * This method does nothing if the device import cache is disabled (see set_import_cache_ttl()).
+ * @code
+ * ApiUtil *au = ApiUtil::instance();
+ * au->set_import_cache_ttl(60000);
+ * au->import_devices(names);
+ * for (auto &name : names)
+ *     proxies.push_back(new DeviceProxy(name));
+ * @endcode
+ *
+ * @param [in] dev_names The device name list
+ * @throws ConnectionFailed, CommunicationFailed, DevFailed
+ */
+	void import_devices(const std::vector<std::string> &dev_names);
 
 /// @privatesection
 
@@ -171,6 +241,16 @@ public:
 
 	void set_sig_handler();
 
+//
+// Device import cache related methods
+//
+
+	bool get_import_cache(const std::string &,ImportCacheEntry &);
+	void set_import_cache(const std::string &,const std::string &,bool,AccessControlType);
+	void set_import_cache_version(const std::string &,const std::string &,long,bool);
+	void set_import_cache_access(const std::string &,const std::string &,AccessControlType);
+	void remove_import_cache(const std::string &);
+
 //
 // EventConsumer related methods
 //
@@ -232,7 +312,11 @@ private:
     class ApiUtilExt
     {
     public:
-        ApiUtilExt() {}
+        ApiUtilExt():import_cache_ttl(0) {}
+
+        omni_mutex                              import_mutex;
+        std::map<std::string,ImportCacheEntry>  import_cache;   // Key is db_host:db_port/device_name
+        long                                    import_cache_ttl; // Protected by import_mutex
     };
 
 	TANGO_IMP static ApiUtil 	*_instance;
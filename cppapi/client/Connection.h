@@ -105,10 +105,22 @@ protected :
 	long add_asyn_request(CORBA::Request_ptr,TgRequest::ReqType);
 	void remove_asyn_request(long);
 
+	void add_batch_request(const DeviceAttribute &);
+	virtual long batch_write_asynch(const DeviceAttribute &);
+	virtual void batch_write_reply(long);
+
 	void add_asyn_cb_request(CORBA::Request_ptr,CallBack *,Connection *,TgRequest::ReqType);
 	void remove_asyn_cb_request(Connection *,CORBA::Request_ptr);
 	long get_pasyn_cb_ctr();
 
+    struct BatchRequest
+    {
+        bool            write;              // true for a write_attribute, false for a command_inout
+        std::string     name;
+        DeviceData      argin;
+        DeviceAttribute attr;
+    };
+
     class ConnectionExt
     {
     public:
@@ -117,6 +129,7 @@ protected :
         ConnectionExt & operator=(const ConnectionExt &);
 
         bool            has_alt_adr;
+        std::vector<BatchRequest>   batch;  // Operations queued for the next execute_batch() call
     };
 
     std::unique_ptr<ConnectionExt>   ext;
@@ -429,6 +442,70 @@ public :
 	virtual void cancel_all_polling_asynch_request();
 //@}
 
+/** @name Batch oriented methods */
+//@{
+/**
+ * Add a command (without input data) to the batch
+ *
+ * Add a command which takes no input argument to the device batch. The command is executed by the next call
+ * to the execute_batch() method.
+ *
+ * @param [in] cmd_name The command name
+ */
+	void batch_command_inout(const std::string &cmd_name);
+/**
+ * Add a command (with input data) to the batch
+ *
+ * Add a command to the device batch. The input data are copied in the batch. The command is executed by the next
+ * call to the execute_batch() method.
+ *
+ * @param [in] cmd_name The command name
+ * @param [in] argin Command input data
+ */
+	void batch_command_inout(const std::string &cmd_name,const DeviceData &argin);
+/**
+ * Execute the batch
+ *
+ * Send all the batch operations to the device without waiting for any reply (the requests are pipelined) and then
+ * wait for all the replies. The batch is empty after this call. The replies are returned in the order used to fill
+ * the batch. An operation which failed does not stop the batch: its reply contains the error stack.
+ * The operations of a batch must not depend on each other: several requests may be sent on
+ * different network connections and the device may execute them in a different order.
+ * @code
+ * DeviceProxy dev("my/device/1");
+ * for (int i = 0;i < 40;i++)
+ * {
+ *     DeviceData din;
+ *     din << i;
+ *     dev.batch_command_inout("ConfigureChannel",din);
+ * }
+ * std::vector<BatchReply> replies = dev.execute_batch();
+ * for (auto &rep : replies)
+ * {
+ *     if (rep.has_failed() == true)
+ *         Except::print_error_stack(rep.get_err_stack());
+ * }
+ * @endcode
+ *
+ * @return The operation replies
+ */
+	std::vector<BatchReply> execute_batch();
+/**
+ * Clear the batch
+ *
+ * Remove all the operations from the batch without executing them
+ */
+	void clear_batch() {ext->batch.clear();}
+/**
+ * Get the batch size
+ *
+ * Get the number of operations in the batch
+ *
+ * @return The batch operation number
+ */
+	size_t get_batch_size() {return ext->batch.size();}
+//@}
+
 ///@privatesection
 	virtual std::string dev_name()=0;
 
@@ -449,6 +526,7 @@ public :
 	std::string &get_dev_port() {return port;}
 
 	void connect(const std::string &name);
+	void connect_known_version(const std::string &name,long idl_vers,bool alt_adr);
 	virtual void reconnect(bool);
 	bool is_connected();
 
@@ -56,12 +56,27 @@ private :
 	virtual int get_lock_ctr() {return 0;}
 	virtual void set_lock_ctr(int) {}
 
+    struct PropCacheEntry
+    {
+        CORBA::Any                              value;      // The db server reply
+        std::chrono::steady_clock::time_point   date;
+        std::list<std::string>::iterator        lru_pos;
+    };
+
     class DatabaseExt
     {
     public:
-        DatabaseExt() {}
+        DatabaseExt():prop_ttl(0),prop_max_entries(0),prop_hits(0),prop_misses(0) {}
 
 		std::string	orig_tango_host;
+
+		omni_mutex                              prop_mutex;
+		long                                    prop_ttl;           // Property cache disabled if 0
+		size_t                                  prop_max_entries;
+		std::map<std::string,PropCacheEntry>    prop_cache;         // Key is object name, command and property names
+		std::list<std::string>                  prop_lru;           // Most recently used key first
+		unsigned long long                      prop_hits;
+		unsigned long long                      prop_misses;
     };
 
     std::unique_ptr<DatabaseExt>     ext;
@@ -89,6 +104,9 @@ private :
 	std::vector<DbHistory> make_history_array(bool, CORBA::Any_var &);
 
 	void check_access();
+	void get_prop_from_db(const char *,CORBA::Any &,CORBA::Any_var &);
+	void invalidate_prop_cache(const std::string &);
+	void fill_import_info(const std::string &,const DevVarLongStringArray *,DbDevImportInfo &);
 	inline std::string dev_name();
 	void set_server_release();
 	void check_access_and_get();
@@ -200,6 +218,30 @@ public :
  * @exception ConnectionFailed, CommunicationFailed, DevFailed
  */
 	DbDevImportInfo import_device(const std::string &dev_name);
+/**
+ * Import a list of devices from the database.
+ *
+ * Query the database for the export info of all the specified devices. All the queries are sent to the database
+ * server before waiting for the first reply (see Connection::execute_batch()). Therefore, importing thousands of
+ * devices costs about the same time than a few import_device() calls. The info are returned in a vector with one
+ * element per device, in the same order than the device name list. A device which is not defined in the
+ * database is returned with its exported flag set to 0 and an empty IOR. With a file database, this method simply
+ * calls import_device() for each device. Example :
+ * @code
+ * std::vector<std::string> names = {“my/own/device”,“my/own/device2”};
+ *
+ * DbDevImportInfos imports = db->import_device(names);
+ *
+ * for (auto &imp : imports)
+ *     std::cout << imp.name << “ exported ” << imp.exported << std::endl;
+ * @endcode
+ *
+ * @param [in] dev_names The device name list
+ * @return The DbDevImportInfo for each device
+ *
+ * @exception ConnectionFailed, CommunicationFailed, DevFailed
+ */
+	DbDevImportInfos import_device(const std::vector<std::string> &dev_names);
 /**
  * Export a device into the database.
  *
@@ -1392,6 +1434,50 @@ public :
 	void delete_attribute_alias(const std::string &att_alias);
 //@}
 
+/**@name Property cache related methods */
+//@{
+/**
+ * Enable the client property cache
+ *
+ * Enable the in-process cache of the replies to the get_device_property(), get_device_attribute_property(),
+ * get_class_property() and get_class_attribute_property() calls. A reply is kept for the time to live. When
+ * the cache is full, the least recently used reply is removed. All the cached replies for a device or a class
+ * are removed when one of the put_xxx_property() or delete_xxx_property() method is called for this device or class
+ * through this Database instance. Property changes done by other processes are seen only when the cached reply
+ * is older than the time to live. The cache is disabled by default. Example :
+ * @code
+ * Database *db = new Database();
+ * db->set_property_cache(10000,5000);
+ * @endcode
+ *
+ * @param [in] ttl The cache time to live (in mS). Set it to 0 to disable (and clear) the cache
+ * @param [in] max_entries The maximum number of replies kept in the cache
+ */
+	void set_property_cache(long ttl,size_t max_entries);
+/**
+ * Clear the client property cache
+ *
+ * Remove all the replies from the client property cache. The hit and miss counters are not reset.
+ */
+	void clear_property_cache();
+/**
+ * Get the client property cache hit counter
+ *
+ * Get the number of property requests answered by the client property cache
+ *
+ * @return The cache hit number
+ */
+	unsigned long long get_property_cache_hits();
+/**
+ * Get the client property cache miss counter
+ *
+ * Get the number of property requests sent to the database server while the client property cache is enabled
+ *
+ * @return The cache miss number
+ */
+	unsigned long long get_property_cache_misses();
+//@}
+
 /**@name Database browsing oriented methods */
 //@{
 /**
@@ -114,6 +114,8 @@ protected :
 	virtual std::string build_corba_name();
 	virtual int get_lock_ctr() {return lock_ctr;}
 	virtual void set_lock_ctr(int lo) {lock_ctr=lo;}
+	virtual long batch_write_asynch(const DeviceAttribute &da) {return write_attribute_asynch(da);}
+	virtual void batch_write_reply(long id) {write_attribute_reply(id,0);}
 
 	enum polled_object
 	{
@@ -130,6 +132,7 @@ protected :
 	void get_locker_host(const std::string &,std::string &);
 
 	void same_att_name(const std::vector<std::string> &,const char *);
+	std::string get_import_cache_key() {return db_host + ':' + db_port + '/' + device_name;}
 
 private:
     class DeviceProxyExt
@@ -1177,6 +1180,20 @@ public :
 			else return (pasyn_ctr + pasyn_cb_ctr);}
 //@}
 
+/** @name Batch related methods */
+//@{
+/**
+ * Add an attribute writing to the batch
+ *
+ * Add the writing of a single attribute to the device batch. The attribute name and value are copied in the batch.
+ * The attribute is written by the next call to the execute_batch() method. Command and attribute writing
+ * operations may be mixed in the same batch.
+ *
+ * @param [in] argin The attribute name and value
+ */
+	void batch_write_attribute(const DeviceAttribute &argin) {add_batch_request(argin);}
+//@}
+
 /** @name Polling related methods */
 //@{
 /**
@@ -1479,6 +1496,25 @@ public :
  * @throws EventSystemFailed
  */
 	virtual int subscribe_event(EventType event,int event_queue_size,bool stateless = false);
+/**
+ * Subscribe for event reception on several attributes
+ *
+ * Subscribe for the same event type on several attributes of the device with a single call to the device
+ * server admin device. The callback and stateless parameters are similar to those described in
+ * DeviceProxy::subscribe_event(const string &,EventType,CallBack *,bool). An error for one attribute does not
+ * stop the subscription of the other ones. It is returned in the errors vector and the corresponding event
+ * identifier is 0. To subscribe to events of several devices in one go, use the EventConsumer::subscribe_events()
+ * method.
+ *
+ * @param [in] att_names The attribute names
+ * @param [in] event The event type
+ * @param [in] cb The callback object
+ * @param [out] errors The subscription error for each attribute (empty when successful)
+ * @param [in] stateless The stateless flag
+ * @return The event identifier for each attribute
+ */
+	virtual std::vector<int> subscribe_events(const std::vector<std::string> &att_names, EventType event, CallBack *cb,
+											  std::vector<DevErrorList> &errors, bool stateless = false);
 /**
  * Unsubscribe for event reception
  *
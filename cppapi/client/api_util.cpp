@@ -155,6 +155,22 @@ ApiUtil::ApiUtil()
             user_sub_hwm = sub_hwm;
         }
     }
+
+//
+// Check if the user wants the device import cache
+//
+
+    var.clear();
+    if (get_env_var("TANGO_IMPORT_CACHE_TTL", var) == 0)
+    {
+        long ttl = 0;
+        std::istringstream iss(var);
+        iss >> ttl;
+        if (iss && ttl > 0)
+        {
+            ext->import_cache_ttl = ttl;
+        }
+    }
 }
 
 //+----------------------------------------------------------------------------------------------------------------
@@ -343,6 +359,16 @@ void ApiUtil::create_orb()
 
     free(_argv);
 
+//
+// Propagate the trace id in the requests if the tracing is enabled
+//
+
+    Tracer::init();
+    if (Tracer::is_enabled() == true)
+    {
+        Tracer::install_interceptors(false);
+    }
+
 //
 // Restore SIGPIPE handler
 //
@@ -749,6 +775,264 @@ void ApiUtil::set_asynch_cb_sub_model(cb_sub_model mode)
 
 }
 
+//-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ApiUtil::set_import_cache_ttl() and ApiUtil::get_import_cache_ttl()
+//
+// description :
+//		Set or get the device import cache time to live. A null time to live disables the cache and removes all
+//		its entries
+//
+// arg(s) :
+//		in :
+//			- ttl : The new time to live (in mS)
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ApiUtil::set_import_cache_ttl(long ttl)
+{
+    omni_mutex_lock guard(ext->import_mutex);
+    if (ttl <= 0)
+    {
+        ext->import_cache_ttl = 0;
+        ext->import_cache.clear();
+    }
+    else
+    {
+        ext->import_cache_ttl = ttl;
+    }
+}
+
+long ApiUtil::get_import_cache_ttl()
+{
+    omni_mutex_lock guard(ext->import_mutex);
+    return ext->import_cache_ttl;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ApiUtil::clear_import_cache() and ApiUtil::get_import_cache_size()
+//
+// description :
+//		Remove all the device import cache entries or get their number
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ApiUtil::clear_import_cache()
+{
+    omni_mutex_lock guard(ext->import_mutex);
+    ext->import_cache.clear();
+}
+
+size_t ApiUtil::get_import_cache_size()
+{
+    omni_mutex_lock guard(ext->import_mutex);
+    return ext->import_cache.size();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ApiUtil::import_devices()
+//
+// description :
+//		Import a list of devices from the default database with one bulk query and store the result in the
+//		device import cache. The device access right is not checked here. It is checked (and stored in the cache)
+//		by the first DeviceProxy built with the cached IOR
+//
+// arg(s) :
+//		in :
+//			- dev_names : The device name list
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ApiUtil::import_devices(const std::vector<std::string> &dev_names)
+{
+    if (get_import_cache_ttl() == 0)
+    {
+        return;
+    }
+
+    std::vector<std::string> names(dev_names);
+    for (auto &name : names)
+    {
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    }
+
+    Database *db = db_vect[get_db_ind()];
+    DbDevImportInfos imports = db->import_device(names);
+
+    std::string prefix = db->get_db_host() + ':' + db->get_db_port() + '/';
+    for (const auto &imp : imports)
+    {
+        if (imp.exported != 1)
+        {
+            continue;
+        }
+        set_import_cache(prefix + imp.name, imp.ior, false, ACCESS_READ);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ApiUtil::get_import_cache()
+//
+// description :
+//		Get one device import cache entry. An entry older than the cache time to live is removed
+//
+// arg(s) :
+//		in :
+//			- key : The entry key (db_host:db_port/device_name)
+//		out :
+//			- entry : The entry
+//
+// return :
+//		True if the entry has been found
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+bool ApiUtil::get_import_cache(const std::string &key, ImportCacheEntry &entry)
+{
+    omni_mutex_lock guard(ext->import_mutex);
+    if (ext->import_cache_ttl == 0)
+    {
+        return false;
+    }
+
+    auto ite = ext->import_cache.find(key);
+    if (ite == ext->import_cache.end())
+    {
+        return false;
+    }
+
+    if (std::chrono::steady_clock::now() - ite->second.date > std::chrono::milliseconds(ext->import_cache_ttl))
+    {
+        ext->import_cache.erase(ite);
+        return false;
+    }
+
+    entry = ite->second;
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ApiUtil::set_import_cache()
+//
+// description :
+//		Store the data returned by the database for one device. The IDL version already known for the same IOR
+//		is kept
+//
+// arg(s) :
+//		in :
+//			- key : The entry key (db_host:db_port/device_name)
+//			- ior : The device IOR
+//			- acc_checked : Set to true if the access right has been checked
+//			- access : The device access right
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ApiUtil::set_import_cache(const std::string &key, const std::string &ior, bool acc_checked, AccessControlType access)
+{
+    omni_mutex_lock guard(ext->import_mutex);
+    if (ext->import_cache_ttl == 0)
+    {
+        return;
+    }
+
+    ImportCacheEntry &entry = ext->import_cache[key];
+    if (entry.ior != ior)
+    {
+        entry.ior = ior;
+        entry.version = 0;
+        entry.has_alt_adr = false;
+    }
+    entry.acc_checked = acc_checked;
+    entry.access = access;
+    entry.date = std::chrono::steady_clock::now();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ApiUtil::set_import_cache_version()
+//
+// description :
+//		Store the IDL version of a device once a connection has been built with the cached IOR
+//
+// arg(s) :
+//		in :
+//			- key : The entry key (db_host:db_port/device_name)
+//			- ior : The IOR used to build the connection
+//			- version : The device IDL version
+//			- alt_adr : Set to true if the device has several network addresses
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ApiUtil::set_import_cache_version(const std::string &key, const std::string &ior, long version, bool alt_adr)
+{
+    omni_mutex_lock guard(ext->import_mutex);
+
+    auto ite = ext->import_cache.find(key);
+    if (ite != ext->import_cache.end() && ite->second.ior == ior)
+    {
+        ite->second.version = version;
+        ite->second.has_alt_adr = alt_adr;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ApiUtil::set_import_cache_access()
+//
+// description :
+//		Store the device access right once it has been checked for an entry stored without it
+//
+// arg(s) :
+//		in :
+//			- key : The entry key (db_host:db_port/device_name)
+//			- ior : The IOR used to build the connection
+//			- access : The device access right
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ApiUtil::set_import_cache_access(const std::string &key, const std::string &ior, AccessControlType access)
+{
+    omni_mutex_lock guard(ext->import_mutex);
+
+    auto ite = ext->import_cache.find(key);
+    if (ite != ext->import_cache.end() && ite->second.ior == ior)
+    {
+        ite->second.acc_checked = true;
+        ite->second.access = access;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ApiUtil::remove_import_cache()
+//
+// description :
+//		Remove one device import cache entry
+//
+// arg(s) :
+//		in :
+//			- key : The entry key (db_host:db_port/device_name)
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ApiUtil::remove_import_cache(const std::string &key)
+{
+    omni_mutex_lock guard(ext->import_mutex);
+    ext->import_cache.erase(key);
+}
+
 //-----------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -0,0 +1,206 @@
+//===================================================================================================================
+//
+// file :               byteswap.cpp
+//
+// description :        Bulk byte swapping of 16, 32 and 64 bits data sequences. Used to unmarshal event data sent by
+//						a device server running on a host with a different endianness
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//===================================================================================================================
+
+
+#include <tango.h>
+#include <eventconsumer.h>
+
+#if defined __SSE2__
+#include <emmintrin.h>
+#elif defined __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+
+namespace Tango
+{
+
+#ifdef __SSE2__
+
+//
+// Swap the two bytes of each 16 bits word of a vector. The 32 and 64 bits swaps first reverse the 16 bits words
+// order within each element then use this one.
+//
+
+static inline __m128i swap_bytes_in_words(__m128i v)
+{
+	return _mm_or_si128(_mm_slli_epi16(v,8),_mm_srli_epi16(v,8));
+}
+
+#endif
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// function :
+//		byte_swap_16
+//
+// description :
+//		Swap (in place) the bytes of a sequence of 16 bits data. The buffer has to be aligned on the element size
+//		(as CDR data are). The vector loop handles 16 elements per iteration and the remaining ones are done one by
+//		one.
+//
+// argument :
+//		in :
+//			- buf : The data buffer
+//			- nb : The number of 16 bits elements in the buffer
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void byte_swap_16(void *buf,size_t nb)
+{
+	_CORBA_UShort *ptr = (_CORBA_UShort *)buf;
+	size_t i = 0;
+
+#if defined __SSE2__
+	for (;i + 16 <= nb;i = i + 16)
+	{
+		__m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i));
+		__m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i + 8));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr + i),swap_bytes_in_words(v0));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr + i + 8),swap_bytes_in_words(v1));
+	}
+#elif defined __ARM_NEON
+	for (;i + 16 <= nb;i = i + 16)
+	{
+		uint8x16_t v0 = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr + i));
+		uint8x16_t v1 = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr + i + 8));
+		vst1q_u8(reinterpret_cast<uint8_t *>(ptr + i),vrev16q_u8(v0));
+		vst1q_u8(reinterpret_cast<uint8_t *>(ptr + i + 8),vrev16q_u8(v1));
+	}
+#endif
+
+	for (;i < nb;i++)
+	{
+		_CORBA_UShort tt = ptr[i];
+		ptr[i] = Swap16(tt);
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// function :
+//		byte_swap_32
+//
+// description :
+//		Swap (in place) the bytes of a sequence of 32 bits data. The buffer has to be aligned on the element size
+//		(as CDR data are). The vector loop handles 8 elements per iteration and the remaining ones are done one by
+//		one.
+//
+// argument :
+//		in :
+//			- buf : The data buffer
+//			- nb : The number of 32 bits elements in the buffer
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void byte_swap_32(void *buf,size_t nb)
+{
+	CORBA::ULong *ptr = (CORBA::ULong *)buf;
+	size_t i = 0;
+
+#if defined __SSE2__
+	for (;i + 8 <= nb;i = i + 8)
+	{
+		__m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i));
+		__m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i + 4));
+		v0 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v0,0xB1),0xB1);
+		v1 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v1,0xB1),0xB1);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr + i),swap_bytes_in_words(v0));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr + i + 4),swap_bytes_in_words(v1));
+	}
+#elif defined __ARM_NEON
+	for (;i + 8 <= nb;i = i + 8)
+	{
+		uint8x16_t v0 = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr + i));
+		uint8x16_t v1 = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr + i + 4));
+		vst1q_u8(reinterpret_cast<uint8_t *>(ptr + i),vrev32q_u8(v0));
+		vst1q_u8(reinterpret_cast<uint8_t *>(ptr + i + 4),vrev32q_u8(v1));
+	}
+#endif
+
+	for (;i < nb;i++)
+	{
+		CORBA::ULong t = ptr[i];
+		ptr[i] = Swap32(t);
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// function :
+//		byte_swap_64
+//
+// description :
+//		Swap (in place) the bytes of a sequence of 64 bits data. The buffer has to be aligned on the element size
+//		(as CDR data are). The vector loop handles 4 elements per iteration and the remaining ones are done one by
+//		one (as two 32 bits words)
+//
+// argument :
+//		in :
+//			- buf : The data buffer
+//			- nb : The number of 64 bits elements in the buffer
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void byte_swap_64(void *buf,size_t nb)
+{
+	CORBA::ULong *ptr = (CORBA::ULong *)buf;
+	size_t i = 0;
+
+#if defined __SSE2__
+	for (;i + 4 <= nb;i = i + 4)
+	{
+		__m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + (i * 2)));
+		__m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + (i * 2) + 4));
+		v0 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v0,0x1B),0x1B);
+		v1 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v1,0x1B),0x1B);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr + (i * 2)),swap_bytes_in_words(v0));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr + (i * 2) + 4),swap_bytes_in_words(v1));
+	}
+#elif defined __ARM_NEON
+	for (;i + 4 <= nb;i = i + 4)
+	{
+		uint8x16_t v0 = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr + (i * 2)));
+		uint8x16_t v1 = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr + (i * 2) + 4));
+		vst1q_u8(reinterpret_cast<uint8_t *>(ptr + (i * 2)),vrev64q_u8(v0));
+		vst1q_u8(reinterpret_cast<uint8_t *>(ptr + (i * 2) + 4),vrev64q_u8(v1));
+	}
+#endif
+
+	for (;i < nb;i++)
+	{
+		CORBA::ULong tl1 = ptr[(i * 2) + 1];
+		CORBA::ULong tl2 = ptr[i * 2];
+		ptr[i * 2] = Swap32(tl1);
+		ptr[(i * 2) + 1] = Swap32(tl2);
+	}
+}
+
+} // End of Tango namespace
@@ -28,6 +28,9 @@
 #define _DBAPI_H
 
 #include <vector>
+#include <string>
+#include <unordered_map>
+#include <list>
 #include <errno.h>
 #include <devapi.h>
 
@@ -876,6 +879,48 @@ public :
 };
 
 
+/****************************************************************************************
+ * 																						*
+ * 					The DbCacheSnapshot class											*
+ * 					------------------													*
+ * 																						*
+ ***************************************************************************************/
+
+//
+// Local copy of the data used to fill a DbServerCache. It is stored in a binary file which is
+// memory mapped when it is read back. The strings are never copied: the data sequence elements
+// point into the mapped file. The stamp is a hash of the configuration part of the data (import
+// data excluded) computed on the client side and is used to check that the snapshot is up to date
+//
+
+class DbCacheSnapshot
+{
+public:
+	DbCacheSnapshot(const std::string &);
+	~DbCacheSnapshot();
+
+	bool is_valid() {return valid;}
+	const std::string &get_stamp() {return stamp;}
+	const std::string &get_ds_name() {return ds_name;}
+	const std::string &get_host() {return host;}
+	DevVarStringArray *get_data();
+
+	static std::string compute_stamp(const DevVarStringArray &);
+	static void write(const std::string &,const std::string &,const std::string &,const DevVarStringArray &);
+
+private:
+	bool read_header(size_t &,std::string &);
+
+	char					*map;
+	size_t					map_size;
+	std::vector<char>		buffer;
+	std::vector<char *>		strings;
+	bool					valid;
+	std::string				stamp;
+	std::string				ds_name;
+	std::string				host;
+};
+
 /****************************************************************************************
  * 																						*
  * 					The DbServerCache class												*
@@ -931,6 +976,8 @@ public:
 	}ClassEltIdx;
 
 	DbServerCache(Database *,const std::string &,const std::string &);
+	DbServerCache(const DevVarStringArray &);
+	DbServerCache(DbCacheSnapshot *);
 	~DbServerCache();
 
 	const DevVarLongStringArray *import_adm_dev();
@@ -950,6 +997,7 @@ public:
 	const EltIdx &get_imp_dat() {return imp_adm;}
 	const EltIdx &get_imp_notifd_event() {return imp_notifd_event;}
 	const EltIdx &get_imp_adm_event() {return imp_adm_event;}
+	const EltIdx &get_config() {return config;}
 	const PropEltIdx &get_DServer_class_prop() {return DServer_class_prop;}
 	const PropEltIdx &get_Default_prop() {return Default_prop;}
 	const PropEltIdx &get_adm_dev_prop() {return adm_dev_prop;}
@@ -957,18 +1005,75 @@ public:
 	int get_class_nb() {return class_nb;}
 	const ClassEltIdx *get_classes_elt() {return classes_idx;}
 	int get_data_nb() {return n_data;}
+	const DevVarStringArray *get_data() {return data_list;}
+	bool from_snapshot() {return snapshot.get() != nullptr;}
+	DbCacheSnapshot *get_snapshot() {return snapshot.get();}
+	omni_mutex &get_cache_mutex() {return cache_mutex;}
 
 private:
+//
+// Hashed indexes on the received data. Keys are pointers to the strings in the received array (never copied) and
+// are compared without case
+//
+
+	struct NameHash
+	{
+		size_t operator()(const char *) const;
+	};
+
+	struct NameEqual
+	{
+		bool operator()(const char *,const char *) const;
+	};
+
+	struct EltKey
+	{
+		int				block;					// first_idx of the block the element belongs to
+		const char		*name;
+	};
+
+	struct EltKeyHash
+	{
+		size_t operator()(const EltKey &) const;
+	};
+
+	struct EltKeyEqual
+	{
+		bool operator()(const EltKey &,const EltKey &) const;
+	};
+
+//
+// Storage behind the returned sequences. Elements point into the received data. Only the names given by the
+// caller (the in_param is deleted once the call returns) and the property number are stored here
+//
+
+	struct RetBuffer
+	{
+		std::vector<char *>			elts;
+		std::vector<std::string>	names;
+		char						nb_str[32];
+	};
+
+	void build_indexes();
 	void prop_indexes(int &,int &,PropEltIdx &,const DevVarStringArray *);
 	void prop_att_indexes(int &,int &,AttPropEltIdx &,const DevVarStringArray *);
 	void prop_pipe_indexes(int &,int &,AttPropEltIdx &,const DevVarStringArray *);
-	void get_obj_prop(DevVarStringArray *,PropEltIdx &,bool dev_prop=false);
+	void get_obj_prop(DevVarStringArray *,const char *,PropEltIdx &,bool dev_prop=false);
 	int find_class(DevString );
 	int find_dev_att(DevString,int &,int &);
 	int find_obj(DevString obj_name,int &);
 	void get_obj_prop_list(DevVarStringArray *,PropEltIdx &);
-
+	void get_obj_att_prop(DevVarStringArray *,AttPropEltIdx &,DevVarStringArray &,RetBuffer &);
+	int find_prop(const PropEltIdx &,const char *);
+	int find_att(const AttPropEltIdx &,const char *);
+	char *data_elt(int idx) {return const_cast<char *>(data_buffer[idx]);}
+	void init_ret(RetBuffer &,const char *,int);
+	char *ret_name(RetBuffer &,const char *);
+	void set_ret(DevVarStringArray &,RetBuffer &,int);
+
+	std::unique_ptr<DbCacheSnapshot>	snapshot;
 	CORBA::Any_var			received;
+	const char * const		*data_buffer;
 	const DevVarStringArray *data_list;
 	int 					n_data;
 	int						proc_release;
@@ -977,6 +1082,7 @@ private:
 	EltIdx					imp_notifd_event;
 	EltIdx					imp_adm_event;
 	EltIdx                  imp_tac;
+	EltIdx					config;					// Properties and device list blocks (no import data)
 	PropEltIdx				ctrl_serv_prop;
 	PropEltIdx				DServer_class_prop;
 	PropEltIdx				Default_prop;
@@ -993,6 +1099,37 @@ private:
 	DevVarStringArray		ret_obj_att_prop;
 	DevVarStringArray		ret_obj_pipe_prop;
 	DevVarStringArray		ret_prop_list;
+
+	RetBuffer				obj_prop_buf;
+	RetBuffer				dev_list_buf;
+	RetBuffer				obj_att_prop_buf;
+	RetBuffer				obj_pipe_prop_buf;
+	RetBuffer				prop_list_buf;
+
+	std::unordered_map<const char *,int,NameHash,NameEqual>					class_map;	// Class name -> classes_idx index
+	std::unordered_map<const char *,std::pair<int,int>,NameHash,NameEqual>	dev_map;	// Device name -> class and device index
+	std::unordered_map<EltKey,int,EltKeyHash,EltKeyEqual>					elt_map;	// Prop/att/pipe -> block index position
+
+	omni_mutex				cache_mutex;			// Protect the returned data (devices may be created in parallel)
+};
+
+//
+// Lock the cache (if any) while the data it returned are used. The lock is released by the
+// destructor or before falling back to a db server call
+//
+
+class DbServerCacheLock
+{
+public:
+	DbServerCacheLock(DbServerCache *dsc):cache(dsc),locked(false) {}
+	~DbServerCacheLock() {unlock();}
+
+	void lock() {if (cache != NULL && locked == false) {cache->get_cache_mutex().lock();locked = true;}}
+	void unlock() {if (locked == true) {cache->get_cache_mutex().unlock();locked = false;}}
+
+private:
+	DbServerCache			*cache;
+	bool					locked;
 };
 
 
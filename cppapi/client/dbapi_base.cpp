@@ -784,40 +784,202 @@ DbDevImportInfo Database::import_device(const std::string &dev)
 			throw;
 		}
 
-		dev_import.exported = 0;
-		dev_import.name = dev;
-		dev_import.ior = std::string((dev_import_list->svalue)[1]);
-		dev_import.version = std::string((dev_import_list->svalue)[2]);
-		dev_import.exported = dev_import_list->lvalue[0];
+		try
+		{
+			fill_import_info(dev,dev_import_list,dev_import);
+		}
+		catch (Tango::DevFailed &)
+		{
+			access = tmp_access;
+			throw;
+		}
+
+		access = tmp_access;
+	}
 
+	return(dev_import);
+}
+
+//-----------------------------------------------------------------------------
 //
-// If the db server returns the device class,
-// store device class in cache if not already there
+// Database::import_device() - public method to import a list of devices.
+// All the DbImportDevice commands are sent to the db server before waiting
+// for the first reply. As in the single device method, only the TAC device
+// may be taken from the DS startup cache (the cache has no import data for
+// the other devices). With a file database, the devices are imported one by
+// one.
+//
+//-----------------------------------------------------------------------------
+
+DbDevImportInfos Database::import_device(const std::vector<std::string> &dev_names)
+{
+	DbDevImportInfos dev_imports;
+
+	if (filedb != 0)
+	{
+		for (const auto &dev : dev_names)
+			dev_imports.push_back(import_device(dev));
+		return dev_imports;
+	}
+
+	AutoConnectTimeout act(DB_RECONNECT_TIMEOUT);
+	dev_imports.resize(dev_names.size());
+
 //
+// Import device is allways possible whatever access rights are.
+// Keep aside the operations the user may have stored in the batch
+//
+
+	{
+		WriterLock guard(con_to_mon);
+
+		AccessControlType tmp_access = access;
+		access = ACCESS_WRITE;
+
+		std::vector<BatchRequest> user_batch;
+		user_batch.swap(Connection::ext->batch);
 
-		if (dev_import_list->svalue.length() == 6)
+		DbServerCache *dsc = NULL;
+		if (ApiUtil::instance()->in_server() == true && db_tg != NULL)
+			dsc = db_tg->get_db_cache();
+
+		std::vector<size_t> from_db;
+		std::vector<BatchReply> replies;
+
+		try
 		{
-			omni_mutex_lock guard(map_mutex);
+			for (size_t loop = 0;loop < dev_names.size();loop++)
+			{
+				dev_imports[loop].name = dev_names[loop];
+				dev_imports[loop].exported = 0;
 
-			std::map<std::string,std::string>::iterator pos = dev_class_cache.find(dev);
-			if (pos == dev_class_cache.end())
+				if (dsc != NULL)
+				{
+					try
+					{
+						const DevVarLongStringArray *dev_import_list = dsc->import_tac_dev(dev_names[loop]);
+						fill_import_info(dev_names[loop],dev_import_list,dev_imports[loop]);
+						continue;
+					}
+					catch (Tango::DevFailed &) {}
+				}
+
+				from_db.push_back(loop);
+			}
+
+//
+// As with the CALL_DB_SERVER macro, the timed out imports are sent again during the server startup phase
+//
+
+			long db_retries = 0;
+			if (db_tg != NULL)
 			{
-				std::string dev_class((dev_import_list->svalue)[5]);
-        std::pair<std::map<std::string,std::string>::iterator,bool> status;
-				status = dev_class_cache.insert(std::make_pair(dev,dev_class));
-				if (status.second == false)
+				if (db_tg->is_svr_starting() == true)
+					db_retries = DB_START_PHASE_RETRIES;
+			}
+
+			while (from_db.empty() == false)
+			{
+				for (auto ind : from_db)
+				{
+					DeviceData send_name;
+					send_name << dev_names[ind];
+					batch_command_inout("DbImportDevice",send_name);
+				}
+
+				replies = execute_batch();
+
+//
+// A device not defined in db is not an error for the whole list. Any other error is thrown
+//
+
+				std::vector<size_t> timed_out;
+				DevErrorList timeout_errs;
+				for (size_t loop = 0;loop < replies.size();loop++)
+				{
+					DbDevImportInfo &dev_import = dev_imports[from_db[loop]];
+					if (replies[loop].has_failed() == true)
+					{
+						const DevErrorList &errs = replies[loop].get_err_stack();
+						if (errs.length() != 0 && ::strcmp(errs[0].reason.in(),DB_DeviceNotDefined) == 0)
+							continue;
+						if (errs.length() >= 2 && ::strcmp(errs[1].reason.in(),API_DeviceTimedOut) == 0)
+						{
+							if (timed_out.empty() == true)
+								timeout_errs = errs;
+							timed_out.push_back(from_db[loop]);
+							continue;
+						}
+						throw DevFailed(errs);
+					}
+
+					const DevVarLongStringArray *dev_import_list = NULL;
+					replies[loop].get_data() >> dev_import_list;
+					fill_import_info(dev_import.name,dev_import_list,dev_import);
+				}
+
+				if (timed_out.empty() == false)
 				{
-					TangoSys_OMemStream o;
-					o << "Can't insert device class for device " << dev << " in device class cache" << std::ends;
-					TANGO_THROW_EXCEPTION(API_CantStoreDeviceClass, o.str());
+					if (db_retries != 0)
+						db_retries--;
+					if (db_retries == 0)
+						throw CommunicationFailed(timeout_errs);
 				}
+				from_db.swap(timed_out);
 			}
 		}
+		catch (Tango::DevFailed &)
+		{
+			Connection::ext->batch.swap(user_batch);
+			access = tmp_access;
+			throw;
+		}
 
+		Connection::ext->batch.swap(user_batch);
 		access = tmp_access;
 	}
 
-	return(dev_import);
+	return dev_imports;
+}
+
+//-----------------------------------------------------------------------------
+//
+// Database::fill_import_info() - private method to build the import info
+// from the data returned by the db server DbImportDevice command
+//
+//-----------------------------------------------------------------------------
+
+void Database::fill_import_info(const std::string &dev,const DevVarLongStringArray *dev_import_list,DbDevImportInfo &dev_import)
+{
+	dev_import.exported = 0;
+	dev_import.name = dev;
+	dev_import.ior = std::string((dev_import_list->svalue)[1]);
+	dev_import.version = std::string((dev_import_list->svalue)[2]);
+	dev_import.exported = dev_import_list->lvalue[0];
+
+//
+// If the db server returns the device class,
+// store device class in cache if not already there
+//
+
+	if (dev_import_list->svalue.length() == 6)
+	{
+		omni_mutex_lock guard(map_mutex);
+
+		std::map<std::string,std::string>::iterator pos = dev_class_cache.find(dev);
+		if (pos == dev_class_cache.end())
+		{
+			std::string dev_class((dev_import_list->svalue)[5]);
+			std::pair<std::map<std::string,std::string>::iterator,bool> status;
+			status = dev_class_cache.insert(std::make_pair(dev,dev_class));
+			if (status.second == false)
+			{
+				TangoSys_OMemStream o;
+				o << "Can't insert device class for device " << dev << " in device class cache" << std::ends;
+				TANGO_THROW_EXCEPTION(API_CantStoreDeviceClass, o.str());
+			}
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -925,6 +1087,7 @@ void Database::delete_device(std::string dev)
 	else
 		CALL_DB_SERVER_NO_RET("DbDeleteDevice",send);
 
+	invalidate_prop_cache(dev);
 	return;
 }
 
@@ -1079,6 +1242,154 @@ DbServerInfo Database::get_server_info(const std::string &server)
 
 	return(server_info);
 }
+//-----------------------------------------------------------------------------
+//
+// Database::set_property_cache() - public method to enable the client
+//                                  property cache
+//
+//-----------------------------------------------------------------------------
+
+void Database::set_property_cache(long ttl,size_t max_entries)
+{
+	omni_mutex_lock guard(ext->prop_mutex);
+
+	if (ttl <= 0 || max_entries == 0)
+	{
+		ext->prop_ttl = 0;
+		ext->prop_max_entries = 0;
+	}
+	else
+	{
+		ext->prop_ttl = ttl;
+		ext->prop_max_entries = max_entries;
+	}
+
+	while (ext->prop_lru.size() > ext->prop_max_entries)
+	{
+		ext->prop_cache.erase(ext->prop_lru.back());
+		ext->prop_lru.pop_back();
+	}
+}
+
+//-----------------------------------------------------------------------------
+//
+// Database::clear_property_cache() - public method to remove all the replies
+//                                    from the client property cache
+//
+//-----------------------------------------------------------------------------
+
+void Database::clear_property_cache()
+{
+	omni_mutex_lock guard(ext->prop_mutex);
+	ext->prop_cache.clear();
+	ext->prop_lru.clear();
+}
+
+unsigned long long Database::get_property_cache_hits()
+{
+	omni_mutex_lock guard(ext->prop_mutex);
+	return ext->prop_hits;
+}
+
+unsigned long long Database::get_property_cache_misses()
+{
+	omni_mutex_lock guard(ext->prop_mutex);
+	return ext->prop_misses;
+}
+
+//-----------------------------------------------------------------------------
+//
+// Database::get_prop_from_db() - private method to execute one of the db
+// server get property commands using the client property cache. The first
+// element of the sent array is the object (device or class) name.
+//
+//-----------------------------------------------------------------------------
+
+void Database::get_prop_from_db(const char *cmd,CORBA::Any &send,CORBA::Any_var &received)
+{
+	std::string key;
+	bool cache_used;
+	{
+		omni_mutex_lock guard(ext->prop_mutex);
+		cache_used = (ext->prop_ttl != 0);
+
+		if (cache_used == true)
+		{
+			const DevVarStringArray *names = NULL;
+			send >>= names;
+
+			std::string obj((*names)[0].in());
+			std::transform(obj.begin(),obj.end(),obj.begin(),::tolower);
+			key = obj + '\n' + cmd;
+			for (unsigned int loop = 1;loop < names->length();loop++)
+			{
+				key = key + '\n' + (*names)[loop].in();
+			}
+
+			auto ite = ext->prop_cache.find(key);
+			if (ite != ext->prop_cache.end())
+			{
+				if (std::chrono::steady_clock::now() - ite->second.date <= std::chrono::milliseconds(ext->prop_ttl))
+				{
+					ext->prop_lru.splice(ext->prop_lru.begin(),ext->prop_lru,ite->second.lru_pos);
+					ext->prop_hits++;
+					received = new CORBA::Any(ite->second.value);
+					return;
+				}
+				ext->prop_lru.erase(ite->second.lru_pos);
+				ext->prop_cache.erase(ite);
+			}
+			ext->prop_misses++;
+		}
+	}
+
+	CALL_DB_SERVER(cmd,send,received);
+
+	if (cache_used == true)
+	{
+		omni_mutex_lock guard(ext->prop_mutex);
+		if (ext->prop_ttl != 0 && ext->prop_cache.find(key) == ext->prop_cache.end())
+		{
+			ext->prop_lru.push_front(key);
+			PropCacheEntry &entry = ext->prop_cache[key];
+			entry.value = received.in();
+			entry.date = std::chrono::steady_clock::now();
+			entry.lru_pos = ext->prop_lru.begin();
+
+			if (ext->prop_lru.size() > ext->prop_max_entries)
+			{
+				ext->prop_cache.erase(ext->prop_lru.back());
+				ext->prop_lru.pop_back();
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//
+// Database::invalidate_prop_cache() - private method to remove from the
+// client property cache all the replies for one device or class
+//
+//-----------------------------------------------------------------------------
+
+void Database::invalidate_prop_cache(const std::string &obj)
+{
+	omni_mutex_lock guard(ext->prop_mutex);
+	if (ext->prop_cache.empty() == true)
+		return;
+
+	std::string prefix(obj);
+	std::transform(prefix.begin(),prefix.end(),prefix.begin(),::tolower);
+	prefix = prefix + '\n';
+
+	auto ite = ext->prop_cache.lower_bound(prefix);
+	while (ite != ext->prop_cache.end() && ite->first.compare(0,prefix.size(),prefix) == 0)
+	{
+		ext->prop_lru.erase(ite->second.lru_pos);
+		ite = ext->prop_cache.erase(ite);
+	}
+}
+
 //-----------------------------------------------------------------------------
 //
 // Database::get_device_property() - public method to get a device property from
@@ -1091,6 +1402,7 @@ void Database::get_device_property(std::string dev, DbData &db_data,DbServerCach
 	unsigned int i;
 	Any_var received;
 	const DevVarStringArray *property_values = NULL;
+	DbServerCacheLock cache_lock(db_cache);
 
 	check_access_and_get();
 
@@ -1117,7 +1429,7 @@ void Database::get_device_property(std::string dev, DbData &db_data,DbServerCach
 		if (filedb != 0)
 			received = filedb->DbGetDeviceProperty(send);
 		else
-			CALL_DB_SERVER("DbGetDeviceProperty",send,received);
+			get_prop_from_db("DbGetDeviceProperty",send,received);
 
 		received.inout() >>= property_values;
 	}
@@ -1130,6 +1442,7 @@ void Database::get_device_property(std::string dev, DbData &db_data,DbServerCach
 
 		try
 		{
+			cache_lock.lock();
 			property_values = db_cache->get_dev_property(property_names);
 			delete property_names;
 		}
@@ -1137,6 +1450,7 @@ void Database::get_device_property(std::string dev, DbData &db_data,DbServerCach
 		{
 			if (::strcmp(e.errors[0].reason.in(),DB_DeviceNotFoundInCache) == 0)
 			{
+				cache_lock.unlock();
 
 //
 // The device is not defined in the cache, call DB server
@@ -1150,7 +1464,7 @@ void Database::get_device_property(std::string dev, DbData &db_data,DbServerCach
 				if (filedb != 0)
 					received = filedb->DbGetDeviceProperty(send);
 				else
-					CALL_DB_SERVER("DbGetDeviceProperty",send,received);
+					get_prop_from_db("DbGetDeviceProperty",send,received);
 				received.inout() >>= property_values;
 			}
 			else
@@ -1245,6 +1559,7 @@ void Database::put_device_property(std::string dev, const DbData &db_data)
 	else
 		CALL_DB_SERVER_NO_RET("DbPutDeviceProperty",send);
 
+	invalidate_prop_cache(dev);
 	return;
 }
 
@@ -1276,6 +1591,7 @@ void Database::delete_device_property(std::string dev, const DbData &db_data)
 	else
 		CALL_DB_SERVER_NO_RET("DbDeleteDeviceProperty",send);
 
+	invalidate_prop_cache(dev);
 	return;
 }
 
@@ -1291,6 +1607,7 @@ void Database::get_device_attribute_property(std::string dev, DbData &db_data, D
 	unsigned int i,j;
 	Any_var received;
 	const DevVarStringArray *property_values = NULL;
+	DbServerCacheLock cache_lock(db_cache);
 
 	check_access_and_get();
 
@@ -1324,10 +1641,10 @@ void Database::get_device_attribute_property(std::string dev, DbData &db_data, D
 			{
 				if (serv_version >= 230)
 				{
-					CALL_DB_SERVER("DbGetDeviceAttributeProperty2",send,received);
+					get_prop_from_db("DbGetDeviceAttributeProperty2",send,received);
 				}
 				else
-					CALL_DB_SERVER("DbGetDeviceAttributeProperty",send,received);
+					get_prop_from_db("DbGetDeviceAttributeProperty",send,received);
 			}
 			catch (Tango::DevFailed &)
 			{
@@ -1345,6 +1662,7 @@ void Database::get_device_attribute_property(std::string dev, DbData &db_data, D
 
 		try
 		{
+			cache_lock.lock();
 			property_values = db_cache->get_dev_att_property(property_names);
 			delete property_names;
 		}
@@ -1352,6 +1670,7 @@ void Database::get_device_attribute_property(std::string dev, DbData &db_data, D
 		{
 			if (::strcmp(e.errors[0].reason.in(),DB_DeviceNotFoundInCache) == 0)
 			{
+				cache_lock.unlock();
 
 //
 // The device is not in cache, ask the db server
@@ -1368,7 +1687,7 @@ void Database::get_device_attribute_property(std::string dev, DbData &db_data, D
 				}
 				else
 				{
-					CALL_DB_SERVER("DbGetDeviceAttributeProperty2",send,received);
+					get_prop_from_db("DbGetDeviceAttributeProperty2",send,received);
 				}
 				received.inout() >>= property_values;
 			}
@@ -1588,6 +1907,7 @@ void Database::put_device_attribute_property(std::string dev, const DbData &db_d
 		}
 	}
 
+	invalidate_prop_cache(dev);
 	return;
 }
 
@@ -1620,6 +1940,7 @@ void Database::delete_device_attribute_property(std::string dev, const DbData &d
 	else
 		CALL_DB_SERVER_NO_RET("DbDeleteDeviceAttributeProperty",send);
 
+	invalidate_prop_cache(dev);
 	return;
 }
 
@@ -1634,6 +1955,7 @@ void Database::get_class_property(std::string device_class, DbData &db_data, DbS
 {
 	unsigned int i;
 	const DevVarStringArray *property_values = NULL;
+	DbServerCacheLock cache_lock(db_cache);
 	Any_var received;
 
 //
@@ -1662,6 +1984,7 @@ void Database::get_class_property(std::string device_class, DbData &db_data, DbS
 
 		try
 		{
+			cache_lock.lock();
 			property_values = db_cache->get_class_property(property_names);
 			delete property_names;
 		}
@@ -1669,6 +1992,7 @@ void Database::get_class_property(std::string device_class, DbData &db_data, DbS
 		{
 			if (::strcmp(e.errors[0].reason.in(),DB_ClassNotFoundInCache) == 0)
 			{
+				cache_lock.unlock();
 
 //
 // The class is not defined in cache, try in DB server
@@ -1682,7 +2006,7 @@ void Database::get_class_property(std::string device_class, DbData &db_data, DbS
 				if (filedb != 0)
 					received = filedb->DbGetClassProperty(send);
 				else
-					CALL_DB_SERVER("DbGetClassProperty",send,received);
+					get_prop_from_db("DbGetClassProperty",send,received);
 
 				received.inout() >>= property_values;
 			}
@@ -1708,7 +2032,7 @@ void Database::get_class_property(std::string device_class, DbData &db_data, DbS
 		if (filedb != 0)
 			received = filedb->DbGetClassProperty(send);
 		else
-			CALL_DB_SERVER("DbGetClassProperty",send,received);
+			get_prop_from_db("DbGetClassProperty",send,received);
 
 		received.inout() >>= property_values;
 	}
@@ -1793,6 +2117,7 @@ void Database::put_class_property(std::string device_class, const DbData &db_dat
 	else
 		CALL_DB_SERVER_NO_RET("DbPutClassProperty",send);
 
+	invalidate_prop_cache(device_class);
 	return;
 }
 
@@ -1821,6 +2146,7 @@ void Database::delete_class_property(std::string device_class, const DbData &db_
 	else
 		CALL_DB_SERVER_NO_RET("DbDeleteClassProperty",send);
 
+	invalidate_prop_cache(device_class);
 	return;
 }
 
@@ -1836,6 +2162,7 @@ void Database::get_class_attribute_property(std::string device_class, DbData &db
 	unsigned int i;
 	Any_var received;
 	const DevVarStringArray *property_values = NULL;
+	DbServerCacheLock cache_lock(db_cache);
 
 	check_access_and_get();
 
@@ -1869,11 +2196,11 @@ void Database::get_class_attribute_property(std::string device_class, DbData &db
 			{
 				if (serv_version >= 230)
 				{
-					CALL_DB_SERVER("DbGetClassAttributeProperty2",send,received);
+					get_prop_from_db("DbGetClassAttributeProperty2",send,received);
 				}
 				else
 				{
-					CALL_DB_SERVER("DbGetClassAttributeProperty",send,received);
+					get_prop_from_db("DbGetClassAttributeProperty",send,received);
 				}
 			}
 			catch (Tango::DevFailed &)
@@ -1892,6 +2219,7 @@ void Database::get_class_attribute_property(std::string device_class, DbData &db
 
 		try
 		{
+			cache_lock.lock();
 			property_values = db_cache->get_class_att_property(property_names);
 			delete property_names;
 		}
@@ -1899,6 +2227,7 @@ void Database::get_class_attribute_property(std::string device_class, DbData &db
 		{
 			if (::strcmp(e.errors[0].reason.in(),DB_ClassNotFoundInCache) == 0)
 			{
+				cache_lock.unlock();
 
 //
 // The class is not defined in cache, get property(ies) from DB server
@@ -1915,7 +2244,7 @@ void Database::get_class_attribute_property(std::string device_class, DbData &db
 				}
 				else
 				{
-					CALL_DB_SERVER("DbGetClassAttributeProperty2",send,received);
+					get_prop_from_db("DbGetClassAttributeProperty2",send,received);
 				}
 				received.inout() >>= property_values;
 			}
@@ -2127,6 +2456,7 @@ void Database::put_class_attribute_property(std::string device_class, const DbDa
 		}
 	}
 
+	invalidate_prop_cache(device_class);
 	return;
 }
 
@@ -2159,6 +2489,7 @@ void Database::delete_class_attribute_property(std::string device_class, const D
 	else
 		CALL_DB_SERVER_NO_RET("DbDeleteClassAttributeProperty",send);
 
+	invalidate_prop_cache(device_class);
 	return;
 }
 
@@ -2178,6 +2509,7 @@ DbDatum Database::get_device_name(const std::string &device_server,const  std::s
 {
 	Any_var received;
 	const DevVarStringArray *device_names = NULL;
+	DbServerCacheLock cache_lock(db_cache);
 
 	check_access_and_get();
 
@@ -2201,6 +2533,7 @@ DbDatum Database::get_device_name(const std::string &device_server,const  std::s
 	}
 	else
 	{
+		cache_lock.lock();
 		device_names = db_cache->get_dev_list(device_server_class);
 		delete device_server_class;
 	}
@@ -2423,6 +2756,7 @@ void Database::get_property(std::string obj, DbData &db_data,DbServerCache *db_c
 	unsigned int i;
 	Any_var received;
 	const DevVarStringArray *property_values = NULL;
+	DbServerCacheLock cache_lock(db_cache);
 
 	{
 		WriterLock guard(con_to_mon);
@@ -2462,6 +2796,7 @@ void Database::get_property(std::string obj, DbData &db_data,DbServerCache *db_c
 
 		try
 		{
+			cache_lock.lock();
 			property_values = db_cache->get_obj_property(property_names);
 			delete property_names;
 		}
@@ -2469,6 +2804,7 @@ void Database::get_property(std::string obj, DbData &db_data,DbServerCache *db_c
 		{
 			if (::strcmp(e.errors[0].reason.in(),DB_DeviceNotFoundInCache) == 0)
 			{
+				cache_lock.unlock();
 
 //
 // The object is not defined in the cache, call DB server
@@ -2859,6 +3195,7 @@ void Database::get_device_property_list(std::string &dev, const std::string &wil
 
 		try
 		{
+			omni_mutex_lock guard(db_cache->get_cache_mutex());
 			const DevVarStringArray *recev;
 			recev = db_cache->get_device_property_list(&send_seq);
 			prop_list << *recev;
@@ -4257,6 +4594,8 @@ void Database::delete_all_device_attribute_property(std::string dev_name,const D
 	}
 	else
 		CALL_DB_SERVER_NO_RET("DbDeleteAllDeviceAttributeProperty",send);
+
+	invalidate_prop_cache(dev_name);
 }
 
 
@@ -4697,6 +5036,7 @@ void Database::get_class_pipe_property(std::string device_class, DbData &db_data
 	unsigned int i;
 	Any_var received;
 	const DevVarStringArray *property_values = NULL;
+	DbServerCacheLock cache_lock(db_cache);
 
 	check_access_and_get();
 
@@ -4746,6 +5086,7 @@ void Database::get_class_pipe_property(std::string device_class, DbData &db_data
 
 		try
 		{
+			cache_lock.lock();
 			property_values = db_cache->get_class_pipe_property(property_names);
 			delete property_names;
 		}
@@ -4755,6 +5096,7 @@ void Database::get_class_pipe_property(std::string device_class, DbData &db_data
 
 			if (err_reason == DB_ClassNotFoundInCache || err_reason == DB_TooOldStoredProc)
 			{
+				cache_lock.unlock();
 
 				if (err_reason == DB_TooOldStoredProc)
 				{
@@ -4857,6 +5199,7 @@ void Database::get_device_pipe_property(std::string dev, DbData &db_data, DbServ
 	unsigned int i,j;
 	Any_var received;
 	const DevVarStringArray *property_values = NULL;
+	DbServerCacheLock cache_lock(db_cache);
 
 	check_access_and_get();
 
@@ -4906,6 +5249,7 @@ void Database::get_device_pipe_property(std::string dev, DbData &db_data, DbServ
 
 		try
 		{
+			cache_lock.lock();
 			property_values = db_cache->get_dev_pipe_property(property_names);
 			delete property_names;
 		}
@@ -4915,6 +5259,7 @@ void Database::get_device_pipe_property(std::string dev, DbData &db_data, DbServ
 
 			if (err_reason == DB_DeviceNotFoundInCache || err_reason == DB_TooOldStoredProc)
 			{
+				cache_lock.unlock();
 				if (err_reason == DB_TooOldStoredProc)
 				{
 					TANGO_LOG << "WARNING: You database stored procedure is too old to support device pipe" << std::endl;
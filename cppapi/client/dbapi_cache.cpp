@@ -36,6 +36,18 @@ using namespace CORBA;
 namespace Tango
 {
 
+namespace
+{
+
+//
+// Constant strings returned for undefined property/attribute/pipe
+//
+
+char zero_str[] = "0";
+char blank_str[] = " ";
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------------------------------------------
 //
 // method:
@@ -70,8 +82,73 @@ DbServerCache::DbServerCache(Database *db,const std::string &ds_name,const std::
 		throw;
 	}
 
+	build_indexes();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method:
+// 		DbServerCache::DbServerCache()
+//
+// description:
+//		Constructor of the DbServerCache class from data already received from the database server (or built by
+//		the caller). The data are copied.
+//
+// arguments:
+// 		in :
+//			- data : The data as returned by the DbGetDataForServerCache command
+//
+//------------------------------------------------------------------------------------------------------------------
+
+DbServerCache::DbServerCache(const DevVarStringArray &data)
+{
+	received = new CORBA::Any();
+	received.inout() <<= data;
+
+	build_indexes();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method:
+// 		DbServerCache::DbServerCache()
+//
+// description:
+//		Constructor of the DbServerCache class from a local snapshot. The data are not copied, the cache keeps
+//		the snapshot until it is deleted
+//
+// arguments:
+// 		in :
+//			- snap : The snapshot (valid). The cache takes its ownership
+//
+//------------------------------------------------------------------------------------------------------------------
+
+DbServerCache::DbServerCache(DbCacheSnapshot *snap):snapshot(snap)
+{
+	received = new CORBA::Any();
+	received.inout() <<= snapshot->get_data();
+
+	build_indexes();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method:
+// 		DbServerCache::build_indexes()
+//
+// description:
+//		Compute the index of each block within the received data and fill the hashed indexes used to find
+//		classes, devices, properties, attributes and pipes. All this is done in one pass on the data.
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void DbServerCache::build_indexes()
+{
 	received.inout() >>= data_list;
 	n_data = data_list->length();
+	data_buffer = data_list->get_buffer();
+	class_nb = 0;
+	classes_idx = NULL;
 
 //
 // Extract the different blocks from the big list. First the stored procedure release nb
@@ -121,6 +198,9 @@ DbServerCache::DbServerCache(Database *db,const std::string &ds_name,const std::
 		Default_prop.first_idx = -1;
 		adm_dev_prop.first_idx = -1;
 
+		config.first_idx = -1;
+		config.last_idx = -1;
+
 		return;
 	}
 
@@ -161,9 +241,10 @@ DbServerCache::DbServerCache(Database *db,const std::string &ds_name,const std::
 	imp_adm_event.last_idx = stop_idx;
 
 //
-// DServer class prop
+// DServer class prop. This is the first block of the configuration data (the previous blocks are import data)
 //
 
+	config.first_idx = stop_idx + 1;
 	prop_indexes(start_idx,stop_idx,DServer_class_prop,data_list);
 
 //
@@ -186,6 +267,7 @@ DbServerCache::DbServerCache(Database *db,const std::string &ds_name,const std::
 	class_nb = ::atoi((*data_list)[start_idx + 1]);
 	stop_idx = stop_idx  + 2;
 	classes_idx = new ClassEltIdx [class_nb];
+	class_map.reserve(class_nb);
 
 	for (int cl_loop = 0;cl_loop < class_nb;cl_loop++)
 	{
@@ -195,6 +277,7 @@ DbServerCache::DbServerCache(Database *db,const std::string &ds_name,const std::
 //
 
 		prop_indexes(start_idx,stop_idx,classes_idx[cl_loop].class_prop,data_list);
+		class_map.emplace(data_buffer[classes_idx[cl_loop].class_prop.first_idx],cl_loop);
 
 //
 // Embedded class attribute prop
@@ -226,6 +309,7 @@ DbServerCache::DbServerCache(Database *db,const std::string &ds_name,const std::
 
 		for (int loop = 0;loop < nb_dev;loop++)
 		{
+			dev_map.emplace(data_buffer[classes_idx[cl_loop].dev_list.first_idx + 2 + loop],std::make_pair(cl_loop,loop));
 
 //
 // Device properties
@@ -255,6 +339,7 @@ DbServerCache::DbServerCache(Database *db,const std::string &ds_name,const std::
 //
 
 	prop_indexes(start_idx,stop_idx,ctrl_serv_prop,data_list);
+	config.last_idx = stop_idx;
 
 //
 // Tac device import info
@@ -401,31 +486,20 @@ const DevVarLongStringArray *DbServerCache::import_adm_event()
 
 const DevVarStringArray *DbServerCache::get_class_property(DevVarStringArray *in_param)
 {
-	int ret_length = 2;
-
 	if (TG_strcasecmp((*in_param)[0],"DServer") == 0)
 	{
-		ret_obj_prop.length(ret_length);
-		ret_obj_prop[0] = Tango::string_dup("DServer");
-
-		get_obj_prop(in_param,DServer_class_prop);
+		get_obj_prop(in_param,"DServer",DServer_class_prop);
 	}
 	else if (TG_strcasecmp((*in_param)[0],"Default") == 0)
 	{
-		ret_obj_prop.length(ret_length);
-		ret_obj_prop[0] = Tango::string_dup("Default");
-
-		get_obj_prop(in_param,Default_prop);
+		get_obj_prop(in_param,"Default",Default_prop);
 	}
 	else
 	{
-		ret_obj_prop.length(ret_length);
-		ret_obj_prop[0] = Tango::string_dup((*in_param)[0]);
-
 		int cl_idx = find_class((*in_param)[0]);
 		if (cl_idx != -1)
 		{
-			get_obj_prop(in_param,classes_idx[cl_idx].class_prop);
+			get_obj_prop(in_param,(*in_param)[0],classes_idx[cl_idx].class_prop);
 		}
 		else
 		{
@@ -446,69 +520,49 @@ const DevVarStringArray *DbServerCache::get_class_property(DevVarStringArray *in
 //
 // description :
 //		This method searches the index(es) of the object wanted property within all the data returne by the DB server.
-// 		A structure will be initialised with the indexes
+// 		The returned sequence is initialised with the object name followed by the wanted properties. Property values
+//		are not copied, the sequence elements point into the data received from the DB server
 //
 // argument :
 // 		in :
 //			- in_param : The object name followed by the wanted property names
+//			- obj_name : The object name to be returned
+//			- obj : Reference to the structure with the object property indexes
 //			- dev_prop : Boolean set to true in case of device property. For device property, a undefined prop is
 //						 returned with a value set to " " !
-//  	out :
-//			- obj : Reference to the structure which will be initialsed by this method
 //
 //------------------------------------------------------------------------------------------------------------------
 
-void DbServerCache::get_obj_prop(DevVarStringArray *in_param,PropEltIdx &obj,bool dev_prop)
+void DbServerCache::get_obj_prop(DevVarStringArray *in_param,const char *obj_name,PropEltIdx &obj,bool dev_prop)
 {
-	int ret_length = 2;
 	int found_prop = 0;
-	char n_prop_str[256];
-
 	int nb_wanted_prop = in_param->length() - 1;
-	int obj_prop = obj.prop_nb;
+
+	init_ret(obj_prop_buf,obj_name,nb_wanted_prop);
 
 	for (int loop = 0;loop < nb_wanted_prop;loop++)
 	{
-		int lo;
-		for (lo = 0;lo < obj_prop * 2;lo = lo + 2)
+		int lo = find_prop(obj,(*in_param)[loop + 1]);
+		if (lo != -1)
 		{
-			if (TG_strcasecmp((*in_param)[loop + 1],(*data_list)[obj.props_idx[lo]]) == 0)
-			{
-				int old_ret_length = ret_length;
-				int nb_elt = obj.props_idx[lo + 1];
-
-				ret_length = ret_length + 2 + nb_elt;
+			int prop_index = obj.props_idx[lo];
+			int nb_elt = obj.props_idx[lo + 1];
 
-				ret_obj_prop.length(ret_length);
-				ret_obj_prop[old_ret_length] = Tango::string_dup((*in_param)[loop + 1]);
-				ret_obj_prop[old_ret_length + 1] = Tango::string_dup((*data_list)[obj.props_idx[lo] + 1]);
-
-				for (int k = 0;k < nb_elt;k++)
-				{
-					ret_obj_prop[old_ret_length + 2 + k] = Tango::string_dup((*data_list)[obj.props_idx[lo] + 2 + k]);
-				}
-				found_prop++;
-				break;
-			}
+			obj_prop_buf.elts.push_back(ret_name(obj_prop_buf,(*in_param)[loop + 1]));
+			for (int k = 0;k < nb_elt + 1;k++)
+				obj_prop_buf.elts.push_back(data_elt(prop_index + 1 + k));
 		}
-		if (lo >= (obj_prop * 2))
+		else
 		{
-			int old_length = ret_length;
-			ret_length = ret_length + 2;
-			if (dev_prop == true)
-				ret_length++;
-
-			ret_obj_prop.length(ret_length);
-			ret_obj_prop[old_length] = Tango::string_dup((*in_param)[loop + 1]);
-			ret_obj_prop[old_length + 1] = Tango::string_dup("0");
+			obj_prop_buf.elts.push_back(ret_name(obj_prop_buf,(*in_param)[loop + 1]));
+			obj_prop_buf.elts.push_back(zero_str);
 			if (dev_prop == true)
-				ret_obj_prop[old_length + 2] = Tango::string_dup(" ");
-			found_prop++;
-
+				obj_prop_buf.elts.push_back(blank_str);
 		}
+		found_prop++;
 	}
-	std::snprintf(n_prop_str, sizeof(n_prop_str),"%d",found_prop);
-	ret_obj_prop[1] = Tango::string_dup(n_prop_str);
+
+	set_ret(ret_obj_prop,obj_prop_buf,found_prop);
 
 //	TANGO_LOG_DEBUG << "DbCache --> Data returned for a get_obj_property for object " << (*in_param)[0] << std::endl;
 //	for (unsigned int ll=0;ll< ret_obj_prop.length();ll++)
@@ -536,7 +590,6 @@ void DbServerCache::get_obj_prop(DevVarStringArray *in_param,PropEltIdx &obj,boo
 
 const DevVarStringArray *DbServerCache::get_dev_property(DevVarStringArray *in_param)
 {
-	int ret_length = 2;
 
 //
 // There is a special case for the dserver admin device
@@ -551,10 +604,7 @@ const DevVarStringArray *DbServerCache::get_dev_property(DevVarStringArray *in_p
 
 			TANGO_THROW_EXCEPTION(DB_DeviceNotFoundInCache, o.str());
 	    }
-		ret_obj_prop.length(ret_length);
-		ret_obj_prop[0] = Tango::string_dup((*in_param)[0]);
-
-		get_obj_prop(in_param,adm_dev_prop,true);
+		get_obj_prop(in_param,(*in_param)[0],adm_dev_prop,true);
 	}
 	else
 	{
@@ -569,10 +619,7 @@ const DevVarStringArray *DbServerCache::get_dev_property(DevVarStringArray *in_p
 		}
 		else
 		{
-			ret_obj_prop.length(ret_length);
-			ret_obj_prop[0] = Tango::string_dup((*in_param)[0]);
-
-			get_obj_prop(in_param,classes_idx[class_ind].devs_idx[dev_ind].dev_prop,true);
+			get_obj_prop(in_param,(*in_param)[0],classes_idx[class_ind].devs_idx[dev_ind].dev_prop,true);
 		}
 	}
 
@@ -598,15 +645,16 @@ const DevVarStringArray *DbServerCache::get_dev_property(DevVarStringArray *in_p
 
 const DevVarStringArray *DbServerCache::get_dev_list(DevVarStringArray *in_param)
 {
+	dev_list_buf.elts.clear();
+
 	int cl_idx = find_class((*in_param)[1]);
 	if (cl_idx != -1)
 	{
-		ret_dev_list.length(classes_idx[cl_idx].dev_nb);
 		for (int loop = 0;loop < classes_idx[cl_idx].dev_nb;loop++)
-			ret_dev_list[loop] = Tango::string_dup((*data_list)[classes_idx[cl_idx].dev_list.first_idx + 2 + loop]);
+			dev_list_buf.elts.push_back(data_elt(classes_idx[cl_idx].dev_list.first_idx + 2 + loop));
 	}
-	else
-		ret_dev_list.length(0);
+
+	ret_dev_list.replace(dev_list_buf.elts.size(),dev_list_buf.elts.size(),dev_list_buf.elts.data(),false);
 
 	return &ret_dev_list;
 }
@@ -626,11 +674,9 @@ const DevVarStringArray *DbServerCache::get_dev_list(DevVarStringArray *in_param
 
 int DbServerCache::find_class(DevString cl_name)
 {
-	for (int loop = 0;loop < class_nb;loop++)
-	{
-		if (TG_strcasecmp((*data_list)[classes_idx[loop].class_prop.first_idx],cl_name) == 0)
-			return loop;
-	}
+	auto ite = class_map.find(cl_name);
+	if (ite != class_map.end())
+		return ite->second;
 	return -1;
 }
 
@@ -653,66 +699,10 @@ int DbServerCache::find_class(DevString cl_name)
 
 const DevVarStringArray *DbServerCache::get_class_att_property(DevVarStringArray *in_param)
 {
-	char n_att_str[256];
-
-	ret_obj_att_prop.length(2);
-	ret_obj_att_prop[0] = Tango::string_dup((*in_param)[0]);
-
 	int cl_idx = find_class((*in_param)[0]);
 	if (cl_idx != -1)
 	{
-		int found_att = 0;
-
-//
-// The class is found
-//
-
-		int wanted_att_nb = in_param->length() - 1;
-		int class_att_nb = classes_idx[cl_idx].class_att_prop.att_nb;
-		for (int loop = 0;loop < wanted_att_nb;loop++)
-		{
-			int ll;
-			for (ll = 0;ll < class_att_nb;ll++)
-			{
-				if (TG_strcasecmp((*in_param)[loop + 1],(*data_list)[classes_idx[cl_idx].class_att_prop.atts_idx[ll]]) == 0)
-				{
-
-//
-// The attribute is found, copy all its properties
-//
-
-					int att_index = classes_idx[cl_idx].class_att_prop.atts_idx[ll];
-					int nb_prop = ::atoi((*data_list)[att_index + 1]);
-					int nb_elt = 0;
-					int nb_to_copy = 0;
-					int tmp_idx = att_index + 2;
-					nb_to_copy = 2;
-					for (int k = 0;k < nb_prop;k++)
-					{
-						nb_elt = ::atoi((*data_list)[tmp_idx + 1]);
-						tmp_idx = tmp_idx + nb_elt + 2;
-						nb_to_copy = nb_to_copy + 2 + nb_elt;
-					}
-
-					int old_length = ret_obj_att_prop.length();
-					ret_obj_att_prop.length(old_length + nb_to_copy);
-					for (int j = 0;j < nb_to_copy;j++)
-						ret_obj_att_prop[old_length + j] = Tango::string_dup((*data_list)[att_index + j]);
-					found_att++;
-					break;
-				}
-			}
-			if (ll == class_att_nb)
-			{
-				found_att++;
-				int old_length = ret_obj_att_prop.length();
-				ret_obj_att_prop.length(old_length + 2);
-				ret_obj_att_prop[old_length] = Tango::string_dup((*in_param)[loop + 1]);
-				ret_obj_att_prop[old_length + 1] = Tango::string_dup("0");
-			}
-		}
-		std::snprintf(n_att_str, sizeof(n_att_str),"%d",found_att);
-		ret_obj_att_prop[1] = Tango::string_dup(n_att_str);
+		get_obj_att_prop(in_param,classes_idx[cl_idx].class_att_prop,ret_obj_att_prop,obj_att_prop_buf);
 	}
 	else
 	{
@@ -748,59 +738,12 @@ const DevVarStringArray *DbServerCache::get_class_att_property(DevVarStringArray
 
 const DevVarStringArray *DbServerCache::get_dev_att_property(DevVarStringArray *in_param)
 {
-	int found_att = 0;
-	char n_att_str[256];
-
-	ret_obj_att_prop.length(2);
-	ret_obj_att_prop[0] = Tango::string_dup((*in_param)[0]);
-
 	int class_ind,dev_ind;
 
 	int ret_value = find_dev_att((*in_param)[0],class_ind,dev_ind);
 	if (ret_value != -1)
 	{
-		int wanted_att_nb = in_param->length() - 1;
-		int dev_att_nb = classes_idx[class_ind].devs_idx[dev_ind].dev_att_prop.att_nb;
-		for (int loop = 0;loop < wanted_att_nb;loop++)
-		{
-			int ll;
-			for (ll = 0;ll < dev_att_nb;ll++)
-			{
-				if (TG_strcasecmp((*in_param)[loop + 1],(*data_list)[classes_idx[class_ind].devs_idx[dev_ind].dev_att_prop.atts_idx[ll]]) == 0)
-				{
-					int att_index = classes_idx[class_ind].devs_idx[dev_ind].dev_att_prop.atts_idx[ll];
-					int nb_prop = ::atoi((*data_list)[att_index + 1]);
-					int nb_elt = 0;
-					int nb_to_copy = 0;
-					int tmp_idx = att_index + 2;
-					nb_to_copy = 2;
-					for (int k = 0;k < nb_prop;k++)
-					{
-						nb_elt = ::atoi((*data_list)[tmp_idx + 1]);
-						tmp_idx = tmp_idx + nb_elt + 2;
-						nb_to_copy = nb_to_copy + 2 + nb_elt;
-					}
-
-					int old_length = ret_obj_att_prop.length();
-					ret_obj_att_prop.length(old_length + nb_to_copy);
-					for (int j = 0;j < nb_to_copy;j++)
-						ret_obj_att_prop[old_length + j] = Tango::string_dup((*data_list)[att_index + j]);
-					found_att++;
-					break;
-				}
-			}
-			if (ll == dev_att_nb)
-			{
-				found_att++;
-				int old_length = ret_obj_att_prop.length();
-
-				ret_obj_att_prop.length(old_length + 2);
-				ret_obj_att_prop[old_length] = Tango::string_dup((*in_param)[loop + 1]);
-				ret_obj_att_prop[old_length + 1] = Tango::string_dup("0");
-			}
-		}
-		std::snprintf(n_att_str, sizeof(n_att_str),"%d",found_att);
-		ret_obj_att_prop[1] = Tango::string_dup(n_att_str);
+		get_obj_att_prop(in_param,classes_idx[class_ind].devs_idx[dev_ind].dev_att_prop,ret_obj_att_prop,obj_att_prop_buf);
 	}
 	else
 	{
@@ -813,8 +756,8 @@ const DevVarStringArray *DbServerCache::get_dev_att_property(DevVarStringArray *
 		}
 		else
 		{
-			std::snprintf(n_att_str, sizeof(n_att_str),"%d",found_att);
-			ret_obj_att_prop[1] = Tango::string_dup(n_att_str);
+			init_ret(obj_att_prop_buf,(*in_param)[0],0);
+			set_ret(ret_obj_att_prop,obj_att_prop_buf,0);
 		}
 	}
 
@@ -848,17 +791,12 @@ const DevVarStringArray *DbServerCache::get_dev_att_property(DevVarStringArray *
 
 int DbServerCache::find_dev_att(DevString dev_name,int &class_ind,int &dev_ind)
 {
-	for (int loop = 0;loop < class_nb;loop++)
+	auto ite = dev_map.find(dev_name);
+	if (ite != dev_map.end())
 	{
-		for (int ll = 0;ll < classes_idx[loop].dev_nb;ll++)
-		{
-			if (TG_strcasecmp((*data_list)[classes_idx[loop].dev_list.first_idx + 2 + ll],dev_name) == 0)
-			{
-				class_ind = loop;
-				dev_ind = ll;
-				return 0;
-			}
-		}
+		class_ind = ite->second.first;
+		dev_ind = ite->second.second;
+		return 0;
 	}
 	return -1;
 }
@@ -898,6 +836,238 @@ int DbServerCache::find_obj(DevString obj_name,int &obj_ind)
 	return -1;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//  	DbServerCache::find_prop()
+//
+// description :
+//		This method searches a property within an object property block
+//
+// argument :
+// 		in :
+//			- obj : The object property block
+//			- prop_name : The property name
+//
+// return :
+//		This method returns the position of the property in the block props_idx array or -1 if not found
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+int DbServerCache::find_prop(const PropEltIdx &obj,const char *prop_name)
+{
+	if (obj.prop_nb == 0)
+		return -1;
+
+	auto ite = elt_map.find(EltKey{obj.first_idx,prop_name});
+	if (ite != elt_map.end())
+		return ite->second;
+	return -1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//  	DbServerCache::find_att()
+//
+// description :
+//		This method searches an attribute (or a pipe) within an object attribute (or pipe) property block
+//
+// argument :
+// 		in :
+//			- obj : The object attribute (or pipe) property block
+//			- att_name : The attribute (or pipe) name
+//
+// return :
+//		This method returns the position of the attribute in the block atts_idx array or -1 if not found
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+int DbServerCache::find_att(const AttPropEltIdx &obj,const char *att_name)
+{
+	if (obj.att_nb == 0)
+		return -1;
+
+	auto ite = elt_map.find(EltKey{obj.first_idx,att_name});
+	if (ite != elt_map.end())
+		return ite->second;
+	return -1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//  	DbServerCache::get_obj_att_prop()
+//
+// description :
+//		This method initialises the returned sequence with the object name followed by the properties of the wanted
+//		attributes (or pipes). Property names and values are not copied, the sequence elements point into the data
+//		received from the DB server
+//
+// argument :
+// 		in :
+//			- in_param : The object name followed by the wanted attribute (or pipe) names
+//			- obj : The object attribute (or pipe) property block
+//		out :
+//			- ret : The returned sequence
+//			- buf : The storage behind the returned sequence
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void DbServerCache::get_obj_att_prop(DevVarStringArray *in_param,AttPropEltIdx &obj,DevVarStringArray &ret,RetBuffer &buf)
+{
+	int found_att = 0;
+	int wanted_att_nb = in_param->length() - 1;
+
+	init_ret(buf,(*in_param)[0],wanted_att_nb);
+
+	for (int loop = 0;loop < wanted_att_nb;loop++)
+	{
+		int ll = find_att(obj,(*in_param)[loop + 1]);
+		if (ll != -1)
+		{
+
+//
+// The attribute is found, copy all its properties
+//
+
+			int att_index = obj.atts_idx[ll];
+			int nb_prop = ::atoi(data_buffer[att_index + 1]);
+			int nb_to_copy = 2;
+			int tmp_idx = att_index + 2;
+			for (int k = 0;k < nb_prop;k++)
+			{
+				int nb_elt = ::atoi(data_buffer[tmp_idx + 1]);
+				tmp_idx = tmp_idx + nb_elt + 2;
+				nb_to_copy = nb_to_copy + 2 + nb_elt;
+			}
+
+			for (int j = 0;j < nb_to_copy;j++)
+				buf.elts.push_back(data_elt(att_index + j));
+		}
+		else
+		{
+			buf.elts.push_back(ret_name(buf,(*in_param)[loop + 1]));
+			buf.elts.push_back(zero_str);
+		}
+		found_att++;
+	}
+
+	set_ret(ret,buf,found_att);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//  	DbServerCache::init_ret()
+//
+// description :
+//		This method clears a returned data storage and stores the object name followed by the place holder of
+//		the element number
+//
+// argument :
+// 		in :
+//			- buf : The storage
+//			- obj_name : The object name
+//			- nb_name : The number of names which will be stored by ret_name() (object name excluded)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void DbServerCache::init_ret(RetBuffer &buf,const char *obj_name,int nb_name)
+{
+	buf.elts.clear();
+	buf.names.clear();
+
+//
+// Names are referenced by the returned sequence: the vector must not reallocate
+//
+
+	buf.names.reserve(nb_name + 1);
+
+	buf.elts.push_back(ret_name(buf,obj_name));
+	buf.elts.push_back(buf.nb_str);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//  	DbServerCache::ret_name()
+//
+// description :
+//		This method stores a name coming from the caller in a returned data storage
+//
+// argument :
+// 		in :
+//			- buf : The storage
+//			- name : The name
+//
+// return :
+//		This method returns a pointer to the stored name
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+char *DbServerCache::ret_name(RetBuffer &buf,const char *name)
+{
+	buf.names.push_back(name);
+	return const_cast<char *>(buf.names.back().c_str());
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//  	DbServerCache::set_ret()
+//
+// description :
+//		This method sets the element number and initialises the returned sequence with the storage content.
+//		The sequence does not own its elements
+//
+// argument :
+// 		in :
+//			- buf : The storage
+//			- nb : The element number
+//		out :
+//			- ret : The returned sequence
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void DbServerCache::set_ret(DevVarStringArray &ret,RetBuffer &buf,int nb)
+{
+	std::snprintf(buf.nb_str,sizeof(buf.nb_str),"%d",nb);
+	ret.replace(buf.elts.size(),buf.elts.size(),buf.elts.data(),false);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//
+// Hash and comparison functors for the hashed indexes. Names are case independent
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+size_t DbServerCache::NameHash::operator()(const char *name) const
+{
+	size_t hash = 2166136261U;
+	for (const unsigned char *ptr = reinterpret_cast<const unsigned char *>(name);*ptr != '\0';++ptr)
+	{
+		hash = hash ^ static_cast<size_t>(::tolower(*ptr));
+		hash = hash * 16777619U;
+	}
+	return hash;
+}
+
+bool DbServerCache::NameEqual::operator()(const char *lhs,const char *rhs) const
+{
+	return TG_strcasecmp(lhs,rhs) == 0;
+}
+
+size_t DbServerCache::EltKeyHash::operator()(const EltKey &key) const
+{
+	return NameHash()(key.name) ^ (static_cast<size_t>(key.block) * 0x9e3779b1U);
+}
+
+bool DbServerCache::EltKeyEqual::operator()(const EltKey &lhs,const EltKey &rhs) const
+{
+	return lhs.block == rhs.block && TG_strcasecmp(lhs.name,rhs.name) == 0;
+}
+
 //------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -973,6 +1143,7 @@ void DbServerCache::prop_indexes(int &start,int &stop,PropEltIdx &obj,const DevV
 	obj.props_idx = new int[nb_prop * 2];
 	for (int loop = 0;loop < nb_prop;loop++)
 	{
+		elt_map.emplace(EltKey{start,data_buffer[stop + 1]},id);
 		obj.props_idx[id++] = stop + 1;
 		int nb_elt = atoi((*list)[stop + 2]);
 		obj.props_idx[id++] = nb_elt;
@@ -1025,6 +1196,7 @@ void DbServerCache::prop_att_indexes(int &start,int &stop,AttPropEltIdx &obj,con
 
 	for (int ll = 0;ll < nb_att;ll++)
 	{
+		elt_map.emplace(EltKey{start,data_buffer[stop]},id);
 		obj.atts_idx[id++] = stop;
 		int nb_prop = atoi((*list)[stop + 1]);
 		stop = stop + 2;
@@ -1082,6 +1254,7 @@ void DbServerCache::prop_pipe_indexes(int &start,int &stop,AttPropEltIdx &obj,co
 
 	for (int ll = 0;ll < nb_att;ll++)
 	{
+		elt_map.emplace(EltKey{start,data_buffer[stop]},id);
 		obj.atts_idx[id++] = stop;
 		int nb_prop = atoi((*list)[stop + 1]);
 		stop = stop + 2;
@@ -1131,12 +1304,7 @@ const DevVarStringArray *DbServerCache::get_obj_property(DevVarStringArray *in_p
 	}
 	else
 	{
-	    int ret_length = 2;
-
-		ret_obj_prop.length(ret_length);
-		ret_obj_prop[0] = Tango::string_dup((*in_param)[0]);
-
-		get_obj_prop(in_param,ctrl_serv_prop,true);
+		get_obj_prop(in_param,(*in_param)[0],ctrl_serv_prop,true);
 	}
 
 	return &ret_obj_prop;
@@ -1170,7 +1338,6 @@ const DevVarStringArray *DbServerCache::get_device_property_list(DevVarStringArr
 
 	if (TG_strncasecmp((*in_param)[0],"dserver/",8) == 0)
 	{
-		ret_prop_list.length(0);
 		get_obj_prop_list(in_param,adm_dev_prop);
 	}
 	else
@@ -1186,7 +1353,6 @@ const DevVarStringArray *DbServerCache::get_device_property_list(DevVarStringArr
 		}
 		else
 		{
-			ret_prop_list.length(0);
 			get_obj_prop_list(in_param,classes_idx[class_ind].devs_idx[dev_ind].dev_prop);
 		}
 	}
@@ -1260,8 +1426,8 @@ void DbServerCache::get_obj_prop_list(DevVarStringArray *in_param,PropEltIdx &ob
 	else
 		wildcard_used = false;
 
-	int ret_length = 1;
 	int obj_prop = obj.prop_nb;
+	prop_list_buf.elts.clear();
 
 	int lo;
 	std::string::size_type pos_after,pos_before;
@@ -1330,12 +1496,10 @@ void DbServerCache::get_obj_prop_list(DevVarStringArray *in_param,PropEltIdx &ob
 //
 
 		if (store == true)
-		{
-			ret_prop_list.length(ret_length);
-			ret_prop_list[ret_length - 1] = Tango::string_dup((*data_list)[obj.props_idx[lo]]);
-			ret_length = ret_length + 1;
-		}
+			prop_list_buf.elts.push_back(data_elt(obj.props_idx[lo]));
 	}
+
+	ret_prop_list.replace(prop_list_buf.elts.size(),prop_list_buf.elts.size(),prop_list_buf.elts.data(),false);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -1443,66 +1607,10 @@ const DevVarStringArray *DbServerCache::get_class_pipe_property(DevVarStringArra
 		TANGO_THROW_EXCEPTION(DB_TooOldStoredProc, mess);
 	}
 
-	int found_pipe = 0;
-	char n_pipe_str[256];
-
-	ret_obj_pipe_prop.length(2);
-	ret_obj_pipe_prop[0] = Tango::string_dup((*in_param)[0]);
-
 	int cl_idx = find_class((*in_param)[0]);
 	if (cl_idx != -1)
 	{
-
-//
-// The class is found
-//
-
-		int wanted_pipe_nb = in_param->length() - 1;
-		int class_pipe_nb = classes_idx[cl_idx].class_pipe_prop.att_nb;
-		for (int loop = 0;loop < wanted_pipe_nb;loop++)
-		{
-			int ll;
-			for (ll = 0;ll < class_pipe_nb;ll++)
-			{
-				if (TG_strcasecmp((*in_param)[loop + 1],(*data_list)[classes_idx[cl_idx].class_pipe_prop.atts_idx[ll]]) == 0)
-				{
-
-//
-// The pipe is found, copy all its properties
-//
-
-					int pipe_index = classes_idx[cl_idx].class_pipe_prop.atts_idx[ll];
-					int nb_prop = ::atoi((*data_list)[pipe_index + 1]);
-					int nb_elt = 0;
-					int nb_to_copy = 0;
-					int tmp_idx = pipe_index + 2;
-					nb_to_copy = 2;
-					for (int k = 0;k < nb_prop;k++)
-					{
-						nb_elt = ::atoi((*data_list)[tmp_idx + 1]);
-						tmp_idx = tmp_idx + nb_elt + 2;
-						nb_to_copy = nb_to_copy + 2 + nb_elt;
-					}
-
-					int old_length = ret_obj_pipe_prop.length();
-					ret_obj_pipe_prop.length(old_length + nb_to_copy);
-					for (int j = 0;j < nb_to_copy;j++)
-						ret_obj_pipe_prop[old_length + j] = Tango::string_dup((*data_list)[pipe_index + j]);
-					found_pipe++;
-					break;
-				}
-			}
-			if (ll == class_pipe_nb)
-			{
-				found_pipe++;
-				int old_length = ret_obj_pipe_prop.length();
-				ret_obj_pipe_prop.length(old_length + 2);
-				ret_obj_pipe_prop[old_length] = Tango::string_dup((*in_param)[loop + 1]);
-				ret_obj_pipe_prop[old_length + 1] = Tango::string_dup("0");
-			}
-		}
-		std::snprintf(n_pipe_str, sizeof(n_pipe_str),"%d",found_pipe);
-		ret_obj_pipe_prop[1] = Tango::string_dup(n_pipe_str);
+		get_obj_att_prop(in_param,classes_idx[cl_idx].class_pipe_prop,ret_obj_pipe_prop,obj_pipe_prop_buf);
 	}
 	else
 	{
@@ -1550,59 +1658,12 @@ const DevVarStringArray *DbServerCache::get_dev_pipe_property(DevVarStringArray
 		TANGO_THROW_EXCEPTION(DB_TooOldStoredProc, mess);
 	}
 
-	int found_pipe = 0;
-	char n_pipe_str[256];
-
-	ret_obj_pipe_prop.length(2);
-	ret_obj_pipe_prop[0] = Tango::string_dup((*in_param)[0]);
-
 	int class_ind,dev_ind;
 
 	int ret_value = find_dev_att((*in_param)[0],class_ind,dev_ind);
 	if (ret_value != -1)
 	{
-		int wanted_pipe_nb = in_param->length() - 1;
-		int dev_pipe_nb = classes_idx[class_ind].devs_idx[dev_ind].dev_pipe_prop.att_nb;
-		for (int loop = 0;loop < wanted_pipe_nb;loop++)
-		{
-			int ll;
-			for (ll = 0;ll < dev_pipe_nb;ll++)
-			{
-				if (TG_strcasecmp((*in_param)[loop + 1],(*data_list)[classes_idx[class_ind].devs_idx[dev_ind].dev_pipe_prop.atts_idx[ll]]) == 0)
-				{
-					int pipe_index = classes_idx[class_ind].devs_idx[dev_ind].dev_pipe_prop.atts_idx[ll];
-					int nb_prop = ::atoi((*data_list)[pipe_index + 1]);
-					int nb_elt = 0;
-					int nb_to_copy = 0;
-					int tmp_idx = pipe_index + 2;
-					nb_to_copy = 2;
-					for (int k = 0;k < nb_prop;k++)
-					{
-						nb_elt = ::atoi((*data_list)[tmp_idx + 1]);
-						tmp_idx = tmp_idx + nb_elt + 2;
-						nb_to_copy = nb_to_copy + 2 + nb_elt;
-					}
-
-					int old_length = ret_obj_pipe_prop.length();
-					ret_obj_pipe_prop.length(old_length + nb_to_copy);
-					for (int j = 0;j < nb_to_copy;j++)
-						ret_obj_pipe_prop[old_length + j] = Tango::string_dup((*data_list)[pipe_index + j]);
-					found_pipe++;
-					break;
-				}
-			}
-			if (ll == dev_pipe_nb)
-			{
-				found_pipe++;
-				int old_length = ret_obj_pipe_prop.length();
-
-				ret_obj_pipe_prop.length(old_length + 2);
-				ret_obj_pipe_prop[old_length] = Tango::string_dup((*in_param)[loop + 1]);
-				ret_obj_pipe_prop[old_length + 1] = Tango::string_dup("0");
-			}
-		}
-		std::snprintf(n_pipe_str, sizeof(n_pipe_str),"%d",found_pipe);
-		ret_obj_pipe_prop[1] = Tango::string_dup(n_pipe_str);
+		get_obj_att_prop(in_param,classes_idx[class_ind].devs_idx[dev_ind].dev_pipe_prop,ret_obj_pipe_prop,obj_pipe_prop_buf);
 	}
 	else
 	{
@@ -1615,8 +1676,8 @@ const DevVarStringArray *DbServerCache::get_dev_pipe_property(DevVarStringArray
 		}
 		else
 		{
-			std::snprintf(n_pipe_str, sizeof(n_pipe_str),"%d",found_pipe);
-			ret_obj_pipe_prop[1] = Tango::string_dup(n_pipe_str);
+			init_ret(obj_pipe_prop_buf,(*in_param)[0],0);
+			set_ret(ret_obj_pipe_prop,obj_pipe_prop_buf,0);
 		}
 	}
 
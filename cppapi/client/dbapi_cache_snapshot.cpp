@@ -0,0 +1,374 @@
+//+=================================================================================================================
+//
+// file :			dbapi_cache_snapshot.cpp
+//
+// description :	C++ source code for the DbCacheSnapshot class
+//
+// project :		TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//-================================================================================================================
+
+#include <tango.h>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+
+#ifndef _TG_WINDOWS_
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Tango
+{
+
+namespace
+{
+
+//
+// Snapshot file layout (native byte order, checked with the byte order mark):
+//		- magic (8 bytes)
+//		- version (4 bytes), byte order mark (4 bytes)
+//		- stamp, ds name and host (each one as a 4 bytes length followed by the characters)
+//		- string number (4 bytes)
+//		- string offsets in the string area (4 bytes each)
+//		- string area (null terminated strings)
+//
+
+const char SNAP_MAGIC[8] = {'T','G','D','S','S','N','A','P'};
+const uint32_t SNAP_VERSION = 1;
+const uint32_t SNAP_BYTE_ORDER_MARK = 0x01020304;
+
+void put_uint(std::string &out,uint32_t value)
+{
+	out.append(reinterpret_cast<const char *>(&value),sizeof(value));
+}
+
+void put_str(std::string &out,const std::string &str)
+{
+	put_uint(out,static_cast<uint32_t>(str.size()));
+	out.append(str);
+}
+
+bool get_uint(const char *data,size_t size,size_t &offset,uint32_t &value)
+{
+	if (offset + sizeof(value) > size)
+		return false;
+	::memcpy(&value,data + offset,sizeof(value));
+	offset = offset + sizeof(value);
+	return true;
+}
+
+bool get_str(const char *data,size_t size,size_t &offset,std::string &str)
+{
+	uint32_t length;
+	if (get_uint(data,size,offset,length) == false || offset + length > size)
+		return false;
+	str.assign(data + offset,length);
+	offset = offset + length;
+	return true;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method:
+// 		DbCacheSnapshot::DbCacheSnapshot()
+//
+// description:
+//		Constructor of the DbCacheSnapshot class. Map the snapshot file and check it. Use is_valid() to know if the
+//		file is usable
+//
+// arguments:
+// 		in :
+//			- file_name : The snapshot file name
+//
+//------------------------------------------------------------------------------------------------------------------
+
+DbCacheSnapshot::DbCacheSnapshot(const std::string &file_name):map(nullptr),map_size(0),valid(false)
+{
+#ifndef _TG_WINDOWS_
+	int fd = ::open(file_name.c_str(),O_RDONLY);
+	if (fd < 0)
+		return;
+
+	struct stat st;
+	if (::fstat(fd,&st) == 0 && st.st_size > 0)
+	{
+		void *addr = ::mmap(NULL,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+		if (addr != MAP_FAILED)
+		{
+			map = static_cast<char *>(addr);
+			map_size = st.st_size;
+		}
+	}
+	::close(fd);
+#else
+	std::ifstream in(file_name.c_str(),std::ios::in | std::ios::binary);
+	if (!in)
+		return;
+	buffer.assign(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+	if (buffer.empty() == false)
+	{
+		map = buffer.data();
+		map_size = buffer.size();
+	}
+#endif
+
+	if (map == nullptr)
+		return;
+
+	size_t offset = 0;
+	std::string err;
+	valid = read_header(offset,err);
+	if (valid == false)
+		TANGO_LOG_DEBUG << "DS cache snapshot " << file_name << " not used: " << err << std::endl;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method:
+// 		DbCacheSnapshot::~DbCacheSnapshot()
+//
+// description:
+//		Destructor of the DbCacheSnapshot class. The data returned by get_data() must not be used any more
+//
+//------------------------------------------------------------------------------------------------------------------
+
+DbCacheSnapshot::~DbCacheSnapshot()
+{
+#ifndef _TG_WINDOWS_
+	if (map != nullptr)
+		::munmap(map,map_size);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method:
+// 		DbCacheSnapshot::read_header()
+//
+// description:
+//		Check the mapped file and compute the address of each string
+//
+// arguments:
+// 		out :
+//			- offset : Index of the first byte after the header
+//			- err : Reason why the file is not valid (if any)
+//
+// return:
+//		This method returns true if the file is valid
+//
+//------------------------------------------------------------------------------------------------------------------
+
+bool DbCacheSnapshot::read_header(size_t &offset,std::string &err)
+{
+	if (map_size < sizeof(SNAP_MAGIC) || ::memcmp(map,SNAP_MAGIC,sizeof(SNAP_MAGIC)) != 0)
+	{
+		err = "Not a DS cache snapshot file";
+		return false;
+	}
+	offset = sizeof(SNAP_MAGIC);
+
+	uint32_t version,bom,nb_str;
+	if (get_uint(map,map_size,offset,version) == false || get_uint(map,map_size,offset,bom) == false ||
+		version != SNAP_VERSION || bom != SNAP_BYTE_ORDER_MARK)
+	{
+		err = "Unsupported DS cache snapshot version or byte order";
+		return false;
+	}
+
+	if (get_str(map,map_size,offset,stamp) == false || get_str(map,map_size,offset,ds_name) == false ||
+		get_str(map,map_size,offset,host) == false || get_uint(map,map_size,offset,nb_str) == false)
+	{
+		err = "Truncated DS cache snapshot file";
+		return false;
+	}
+
+//
+// The string area must be terminated by a null character. Then, any offset within the area is a valid string
+//
+
+	size_t area = offset + (static_cast<size_t>(nb_str) * sizeof(uint32_t));
+	if (nb_str == 0 || area >= map_size || map[map_size - 1] != '\0')
+	{
+		err = "Truncated DS cache snapshot file";
+		return false;
+	}
+
+	size_t area_size = map_size - area;
+	strings.resize(nb_str);
+	for (uint32_t loop = 0;loop < nb_str;loop++)
+	{
+		uint32_t str_offset = 0;
+		get_uint(map,map_size,offset,str_offset);
+		if (str_offset >= area_size)
+		{
+			err = "Corrupted DS cache snapshot file";
+			strings.clear();
+			return false;
+		}
+		strings[loop] = map + area + str_offset;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method:
+// 		DbCacheSnapshot::get_data()
+//
+// description:
+//		Build a sequence with the snapshot data. The sequence elements point into the snapshot (they are not
+//		copied) and must not be used once the snapshot is deleted
+//
+// return:
+//		This method returns a pointer to a sequence allocated with new. The caller has to delete it
+//
+//------------------------------------------------------------------------------------------------------------------
+
+DevVarStringArray *DbCacheSnapshot::get_data()
+{
+	if (valid == false)
+	{
+		TANGO_THROW_EXCEPTION(API_DatabaseCacheAccess, "Invalid DS cache snapshot");
+	}
+
+	return new DevVarStringArray(strings.size(),strings.size(),strings.data(),false);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method:
+// 		DbCacheSnapshot::compute_stamp()
+//
+// description:
+//		Compute the stamp of data returned by the database server DbGetDataForServerCache command. The database
+//		does not provide any configuration version, the stamp is computed here: it is the number of strings of the
+//		configuration blocks (properties and device lists) followed by a hash of these strings. The import blocks
+//		(admin device, event and TAC device import data) change each time the server is started and are not part
+//		of the stamp
+//
+// arguments:
+// 		in :
+//			- data : The data
+//
+// return:
+//		This method returns the stamp
+//
+//------------------------------------------------------------------------------------------------------------------
+
+std::string DbCacheSnapshot::compute_stamp(const DevVarStringArray &data)
+{
+	DbServerCache cache(data);
+	const DbServerCache::EltIdx &config = cache.get_config();
+
+	unsigned long long hash = 14695981039346656037ULL;
+	unsigned int nb_str = 0;
+	for (int loop = config.first_idx;loop >= 0 && loop <= config.last_idx;loop++)
+	{
+		for (const unsigned char *ptr = reinterpret_cast<const unsigned char *>(data[loop].in());*ptr != '\0';++ptr)
+		{
+			hash = hash ^ *ptr;
+			hash = hash * 1099511628211ULL;
+		}
+		hash = hash ^ 0xff;
+		hash = hash * 1099511628211ULL;
+		nb_str++;
+	}
+
+	std::stringstream ss;
+	ss << nb_str << '-' << std::hex << std::setw(16) << std::setfill('0') << hash;
+	return ss.str();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method:
+// 		DbCacheSnapshot::write()
+//
+// description:
+//		Write a snapshot file. The file is first written with a temporary name and then renamed. Therefore,
+//		a process reading the snapshot never sees a partially written file
+//
+// arguments:
+// 		in :
+//			- file_name : The snapshot file name
+//			- ds_name : The device server name (exec_name/inst_name)
+//			- host : The host name
+//			- data : The data returned by the database server DbGetDataForServerCache command
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void DbCacheSnapshot::write(const std::string &file_name,const std::string &ds_name,const std::string &host,
+							const DevVarStringArray &data)
+{
+	std::string header(SNAP_MAGIC,sizeof(SNAP_MAGIC));
+	put_uint(header,SNAP_VERSION);
+	put_uint(header,SNAP_BYTE_ORDER_MARK);
+	put_str(header,compute_stamp(data));
+	put_str(header,ds_name);
+	put_str(header,host);
+	put_uint(header,data.length());
+
+	std::string area;
+	for (unsigned int loop = 0;loop < data.length();loop++)
+	{
+		put_uint(header,static_cast<uint32_t>(area.size()));
+		area.append(data[loop].in());
+		area.append(1,'\0');
+	}
+
+	std::string tmp_name = file_name + ".tmp";
+	{
+		std::ofstream out(tmp_name.c_str(),std::ios::out | std::ios::binary | std::ios::trunc);
+		out.write(header.data(),header.size());
+		out.write(area.data(),area.size());
+		out.close();
+		if (!out)
+		{
+			::remove(tmp_name.c_str());
+
+			TangoSys_OMemStream o;
+			o << "Can't write the DS cache snapshot file " << tmp_name << std::ends;
+			TANGO_THROW_EXCEPTION(API_CannotOpenFile, o.str());
+		}
+	}
+
+#ifdef _TG_WINDOWS_
+	::remove(file_name.c_str());
+#endif
+	if (::rename(tmp_name.c_str(),file_name.c_str()) != 0)
+	{
+		::remove(tmp_name.c_str());
+
+		TangoSys_OMemStream o;
+		o << "Can't rename the DS cache snapshot file " << tmp_name << " to " << file_name << std::ends;
+		TANGO_THROW_EXCEPTION(API_CannotOpenFile, o.str());
+	}
+}
+
+} // End of Tango namespace
@@ -696,6 +696,67 @@ private:
     std::unique_ptr<DeviceAttributeHistoryExt>   ext_hist;
 };
 
+/**
+ * Reply of one operation executed within a device batch
+ *
+ * One instance of this class is returned by the Connection::execute_batch() method for each operation
+ * queued in the batch. It contains the operation name, a flag indicating if the operation has failed
+ * and, depending on this flag, the command output data or the error stack.
+ *
+ * @headerfile tango.h
+ * @ingroup Client
+ */
+class BatchReply
+{
+public :
+///@privatesection
+	BatchReply():fail(false) {}
+	BatchReply(const std::string &na):name(na),fail(false) {}
+
+	void set_data(DeviceData &dd) {data = dd;}
+	void set_error(const DevErrorList &del) {fail = true;err = del;}
+///@publicsection
+/**
+ * Get the operation name
+ *
+ * Returns the command or attribute name used when the operation was added to the batch
+ *
+ * @return The operation name
+ */
+	const std::string &get_name() {return name;}
+/**
+ * Check if the operation has failed
+ *
+ * Returns a boolean set to true if the operation has failed
+ *
+ * @return A boolean set to true if the operation has failed
+ */
+	bool has_failed() {return fail;}
+/**
+ * Get the operation error stack
+ *
+ * Returns the error stack of a failed operation. The stack is empty if the operation succeeded
+ *
+ * @return The error stack
+ */
+	const DevErrorList &get_err_stack() {return err;}
+/**
+ * Get the command output data
+ *
+ * Returns the data sent back by the command. For a write_attribute operation or for a failed operation,
+ * the returned instance is empty
+ *
+ * @return The command output data
+ */
+	DeviceData &get_data() {return data;}
+
+private:
+	std::string			name;
+	bool				fail;
+	DevErrorList		err;
+	DeviceData			data;
+};
+
 
 /****************************************************************************************
  * 																						*
@@ -608,6 +608,97 @@ void Connection::connect(const std::string &corba_name)
 }
 
 
+//-----------------------------------------------------------------------------
+//
+// Connection::connect_known_version() - connect to a CORBA object for which
+// the IDL version is already known (from the device import cache). No
+// remote call is done to check the IDL version nor the connection. If the
+// object cannot be narrowed to this version, use the classical connect()
+//
+//-----------------------------------------------------------------------------
+
+void Connection::connect_known_version(const std::string &corba_name, long idl_vers, bool alt_adr)
+{
+    bool narrowed = false;
+
+    try
+    {
+        CORBA::ORB_var orb = ApiUtil::instance()->get_orb();
+        Object_var obj = orb->string_to_object(corba_name.c_str());
+
+        switch (idl_vers)
+        {
+            case 5:
+                device_5 = Device_5::_narrow(obj);
+                if (CORBA::is_nil(device_5) == false)
+                {
+                    device_4 = Device_5::_duplicate(device_5);
+                    device_3 = Device_5::_duplicate(device_5);
+                    device_2 = Device_5::_duplicate(device_5);
+                    device = Device_5::_duplicate(device_5);
+                    narrowed = true;
+                }
+                break;
+
+            case 4:
+                device_4 = Device_4::_narrow(obj);
+                if (CORBA::is_nil(device_4) == false)
+                {
+                    device_3 = Device_4::_duplicate(device_4);
+                    device_2 = Device_4::_duplicate(device_4);
+                    device = Device_4::_duplicate(device_4);
+                    narrowed = true;
+                }
+                break;
+
+            case 3:
+                device_3 = Device_3::_narrow(obj);
+                if (CORBA::is_nil(device_3) == false)
+                {
+                    device_2 = Device_3::_duplicate(device_3);
+                    device = Device_3::_duplicate(device_3);
+                    narrowed = true;
+                }
+                break;
+
+            case 2:
+                device_2 = Device_2::_narrow(obj);
+                if (CORBA::is_nil(device_2) == false)
+                {
+                    device = Device_2::_duplicate(device_2);
+                    narrowed = true;
+                }
+                break;
+
+            case 1:
+                device = Device::_narrow(obj);
+                narrowed = (CORBA::is_nil(device) == false);
+                break;
+
+            default:
+                break;
+        }
+    }
+    catch (CORBA::SystemException &)
+    {
+        narrowed = false;
+    }
+
+    if (narrowed == false)
+    {
+        connect(corba_name);
+        return;
+    }
+
+    version = idl_vers;
+    ext->has_alt_adr = alt_adr;
+    connection_state = CONNECTION_OK;
+    if (timeout != CLNT_TIMEOUT)
+    {
+        set_timeout_millis(timeout);
+    }
+}
+
 //-----------------------------------------------------------------------------
 //
 // Connection::toIOR() - Convert string IOR to omniORB IOR object
@@ -1195,6 +1286,16 @@ DeviceData Connection::command_inout(const std::string &command, const DeviceDat
     DevSource local_source;
     AccessControlType local_act;
 
+//
+// When the requests are traced, the call is the parent span of the server request
+//
+
+    TraceSpan trace_span(TRACE_CLIENT_CALL);
+    if (trace_span.is_active() == true)
+    {
+        trace_span.set_name(dev_name().c_str(), command.c_str());
+    }
+
     while (ctr < 2)
     {
         try
@@ -1730,7 +1831,22 @@ void DeviceProxy::real_constructor(const std::string &name, bool need_check_acc)
     {
         if (exported == true)
         {
-            connect(corba_name);
+            ImportCacheEntry entry;
+            ApiUtil *au = ApiUtil::instance();
+            if (dbase_used == true && is_alias == false &&
+                au->get_import_cache(get_import_cache_key(), entry) == true &&
+                entry.ior == corba_name && entry.version != 0)
+            {
+                connect_known_version(corba_name, entry.version, entry.has_alt_adr);
+            }
+            else
+            {
+                connect(corba_name);
+                if (dbase_used == true && is_alias == false)
+                {
+                    au->set_import_cache_version(get_import_cache_key(), corba_name, version, ext->has_alt_adr);
+                }
+            }
 
             if (is_alias == true)
             {
@@ -2363,9 +2479,42 @@ std::string DeviceProxy::get_corba_name(bool need_check_acc)
 //
 
     DbDevImportInfo import_info;
+    ApiUtil *au = ApiUtil::instance();
 
     if (local_ior.size() == 0)
     {
+
+//
+// Data already in the device import cache?
+//
+
+        ImportCacheEntry entry;
+        if (is_alias == false && au->get_import_cache(get_import_cache_key(), entry) == true)
+        {
+            if (need_check_acc == true)
+            {
+
+//
+// Entries stored by ApiUtil::import_devices() do not have the access right. Check it once and keep it in the cache
+//
+
+                if (entry.acc_checked == true)
+                {
+                    access = entry.access;
+                }
+                else
+                {
+                    access = db_dev->check_access_control();
+                    au->set_import_cache_access(get_import_cache_key(), entry.ior, access);
+                }
+            }
+            else
+            {
+                check_acc = false;
+            }
+            return entry.ior;
+        }
+
         import_info = db_dev->import_device();
 
         if (import_info.exported != 1)
@@ -2397,6 +2546,10 @@ std::string DeviceProxy::get_corba_name(bool need_check_acc)
     }
     else
     {
+        if (is_alias == false)
+        {
+            au->set_import_cache(get_import_cache_key(), import_info.ior, need_check_acc, access);
+        }
         return import_info.ior;
     }
 }
@@ -2429,6 +2582,16 @@ std::string DeviceProxy::build_corba_name()
 
 void DeviceProxy::reconnect(bool db_used)
 {
+
+//
+// The device import cache entry is not valid any more if the connection failed
+//
+
+    if (connection_state != CONNECTION_OK && db_used == true && is_alias == false)
+    {
+        ApiUtil::instance()->remove_import_cache(get_import_cache_key());
+    }
+
     Connection::reconnect(db_used);
 
     if (connection_state == CONNECTION_OK)
@@ -7869,6 +8032,53 @@ int DeviceProxy::subscribe_event(EventType event, int event_queue_size, bool sta
     return ret;
 }
 
+//--------------------------------------------------------------------------------------------------------------------
+//
+// method :
+// 		DeviceProxy::subscribe_events
+//
+// description :
+//		Subscribe to the same event on several attributes with one call to the device server admin device.
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+std::vector<int> DeviceProxy::subscribe_events(const std::vector<std::string> &att_names, EventType event,
+                                               CallBack *callback, std::vector<DevErrorList> &errors, bool stateless)
+{
+    if (callback == NULL)
+    {
+        TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_InvalidArgs, "Callback pointer NULL");
+    }
+
+    ApiUtil *api_ptr = ApiUtil::instance();
+    if (api_ptr->get_zmq_event_consumer() == NULL)
+    {
+        api_ptr->create_zmq_event_consumer();
+    }
+
+    std::vector<EventSubscriptionRequest> requests(att_names.size());
+    for (size_t loop = 0; loop < att_names.size(); loop++)
+    {
+        requests[loop].device = this;
+        requests[loop].obj_name = att_names[loop];
+        requests[loop].event = event;
+        requests[loop].callback = callback;
+        requests[loop].event_queue_size = 0;
+    }
+
+    api_ptr->get_zmq_event_consumer()->subscribe_events(requests, stateless);
+
+    std::vector<int> event_ids;
+    errors.clear();
+    for (auto &req : requests)
+    {
+        event_ids.push_back(req.event_id);
+        errors.push_back(req.errors);
+    }
+
+    return event_ids;
+}
+
 //--------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -51,6 +51,7 @@ EventConsumerKeepAliveThread *EventConsumer::keep_alive_thread = NULL;
 std::map<std::string,std::string> EventConsumer::device_channel_map;
 std::map<std::string,EventChannelStruct> EventConsumer::channel_map;
 std::map<std::string,EventCallBackStruct> EventConsumer::event_callback_map;
+std::unordered_map<int,std::string> EventConsumer::event_id_map;
 ReadersWritersLock 	EventConsumer::map_modification_lock;
 
 std::vector<EventNotConnected> EventConsumer::event_not_connected;
@@ -1213,51 +1214,72 @@ int EventConsumer::subscribe_event (DeviceProxy *device,
 // A dead lock could happen if we don't do this (really experienced!)
 //
 
-    DelayEvent de(this);
-	WriterLock w(map_modification_lock);
-
-	try
-	{
-		int event_id = connect_event (device,attribute,event,callback,ev_queue,filters,event_name);
-		return event_id;
-	}
-	catch (Tango::DevFailed &e)
+	int event_id;
+	bool new_entry;
 	{
-	    std::string reason(e.errors[0].reason.in());
-		// if the stateless flag is not true, rethrow the exception
-		if ((stateless == false) || (reason == API_CommandNotFound))
+		DelayEvent de(this);
+		WriterLock w(map_modification_lock);
+
+		try
 		{
-			throw;
+			size_t nb_entries = event_callback_map.size();
+			event_id = connect_event (device,attribute,event,callback,ev_queue,filters,event_name);
+			new_entry = event_callback_map.size() != nb_entries;
 		}
+		catch (Tango::DevFailed &e)
+		{
+		    std::string reason(e.errors[0].reason.in());
+			// if the stateless flag is not true, rethrow the exception
+			if ((stateless == false) || (reason == API_CommandNotFound))
+			{
+				throw;
+			}
 
-		// when the subscribe event has not worked, store the connection data in a vector of not
-		// yet connected events.
-		// Retry to connect in the next heartbeat period.
-
-		EventNotConnected conn_params;
-		conn_params.device           = device;
-		conn_params.attribute        = attribute;
-		conn_params.event_type       = event;
-		conn_params.event_name       = event_name;
-		conn_params.callback         = callback;
-		conn_params.ev_queue         = ev_queue;
-		conn_params.filters          = filters;
-		conn_params.last_heartbeat   = time(NULL);
-		if (env_var_fqdn_prefix.empty() == false)
-			conn_params.prefix			 = env_var_fqdn_prefix[0];
-		// protect the vector as the other maps!
-
-		// create and save the unique event ID
-		subscribe_event_id++;
-		conn_params.event_id = subscribe_event_id;
+			// when the subscribe event has not worked, store the connection data in a vector of not
+			// yet connected events.
+			// Retry to connect in the next heartbeat period.
+
+			EventNotConnected conn_params;
+			conn_params.device           = device;
+			conn_params.attribute        = attribute;
+			conn_params.event_type       = event;
+			conn_params.event_name       = event_name;
+			conn_params.callback         = callback;
+			conn_params.ev_queue         = ev_queue;
+			conn_params.filters          = filters;
+			conn_params.last_heartbeat   = time(NULL);
+			if (env_var_fqdn_prefix.empty() == false)
+				conn_params.prefix			 = env_var_fqdn_prefix[0];
+			// protect the vector as the other maps!
+
+			// create and save the unique event ID
+			subscribe_event_id++;
+			conn_params.event_id = subscribe_event_id;
+
+			event_not_connected.push_back (conn_params);
+
+			std::vector<EventNotConnected>::iterator vpos = event_not_connected.end() - 1;
+			time_t now = time(NULL);
+			keep_alive_thread->stateless_subscription_failed(vpos,e,now);
+			return subscribe_event_id;
+		}
+	}
 
-		event_not_connected.push_back (conn_params);
+//
+// Sleep for some mS in order to give to ZMQ some times to propagate the subscription to the publisher. This is done
+// once the map lock and the ZMQ thread are released, not to block the other threads subscribing or receiving events
+//
 
-		std::vector<EventNotConnected>::iterator vpos = event_not_connected.end() - 1;
-		time_t now = time(NULL);
-		keep_alive_thread->stateless_subscription_failed(vpos,e,now);
-		return subscribe_event_id;
+	if (new_entry == true)
+	{
+#ifndef _TG_WINDOWS_
+		std::this_thread::sleep_for(std::chrono::nanoseconds(1000000));
+#else
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+#endif
 	}
+
+	return event_id;
 }
 
 //+------------------------------------------------------------------------------------------------------------------
@@ -1310,6 +1332,286 @@ int EventConsumer::subscribe_event (DeviceProxy *device,
 	EventQueue *ev_queue = new EventQueue(event_queue_size);
 	return (subscribe_event(device,"dummy",event,NULL,ev_queue,filters,stateless));
 }
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventConsumer::subscribe_events()
+//
+// description :
+//		Subscribe to a list of events. The requests are grouped by device server and the subscriptions of one group
+//		are registered in the server with a single ZmqEventSubscriptionChanges command. The requests which cannot
+//		use this command (server without this command, notifd event, subscription within an event callback,...)
+//		are done one by one. An error for one request does not stop the other ones. It is returned in the request
+//		errors member.
+//
+// argument :
+//		in :
+//			- requests : The subscription requests. Their event_id and errors members are set by this method
+//			- stateless : Flag to enable the stateless connection when set to true
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void EventConsumer::subscribe_events(std::vector<EventSubscriptionRequest> &requests,bool stateless)
+{
+	std::string cmd_name;
+	get_subscription_command_name(cmd_name);
+	bool bulk_cmd = cmd_name.find("Zmq") != std::string::npos;
+
+	if (thread_id != 0)
+	{
+		omni_thread::ensure_self se;
+		if (omni_thread::self()->id() == thread_id)
+			bulk_cmd = false;
+	}
+
+//
+// Group the requests by admin device
+//
+
+	std::vector<size_t> single_reqs;
+	std::map<std::string,std::vector<size_t> > server_reqs;
+	std::map<DeviceProxy *,std::string> adm_names;
+
+	for (size_t loop = 0;loop < requests.size();loop++)
+	{
+		EventSubscriptionRequest &req = requests[loop];
+		req.event_id = 0;
+		req.errors.length(0);
+
+		if ((bulk_cmd == false) || (req.device == NULL) ||
+			(req.event == QUALITY_EVENT) || (req.event == INTERFACE_CHANGE_EVENT) ||
+			((req.callback == NULL) && (req.event_queue_size < 0)))
+		{
+			single_reqs.push_back(loop);
+			continue;
+		}
+
+		std::map<DeviceProxy *,std::string>::iterator pos = adm_names.find(req.device);
+		if (pos == adm_names.end())
+		{
+			std::string adm_name;
+			try
+			{
+				adm_name = req.device->adm_name();
+			}
+			catch (Tango::DevFailed &) {}
+			pos = adm_names.insert(std::make_pair(req.device,adm_name)).first;
+		}
+
+		if (pos->second.empty() == true)
+			single_reqs.push_back(loop);
+		else
+			server_reqs[pos->second].push_back(loop);
+	}
+
+//
+// One command per server
+//
+
+	std::stringstream ss;
+	ss << DevVersion;
+	std::vector<std::string> filters;
+	bool new_entry = false;
+
+	for (auto &server : server_reqs)
+	{
+		std::vector<size_t> &reqs = server.second;
+
+		std::vector<std::string> subscriber_info;
+		for (auto ind : reqs)
+		{
+			std::string obj_name(requests[ind].obj_name);
+			std::transform(obj_name.begin(),obj_name.end(),obj_name.begin(),::tolower);
+
+			subscriber_info.push_back(requests[ind].device->dev_name());
+			subscriber_info.push_back(obj_name);
+			subscriber_info.push_back("subscribe");
+			subscriber_info.push_back(EventName[requests[ind].event]);
+			subscriber_info.push_back(ss.str());
+		}
+
+		PrefetchedSubscription prefetched;
+		prefetched.adm_name = server.first;
+		prefetched.adm_device = NULL;
+
+		DeviceData subscriber_in,subscriber_out;
+		const DevVarLongStringArray *dvlsa = NULL;
+		subscriber_in << subscriber_info;
+
+		try
+		{
+			prefetched.adm_device = new DeviceProxy(server.first);
+			subscriber_out = prefetched.adm_device->command_inout("ZmqEventSubscriptionChanges",subscriber_in);
+			if ((subscriber_out >> dvlsa) == false || dvlsa->lvalue.length() != reqs.size() * SUB_CHANGES_LG_NB)
+				dvlsa = NULL;
+		}
+		catch (Tango::DevFailed &e)
+		{
+			std::string reason(e.errors[0].reason.in());
+			if ((stateless == false) && (reason != API_CommandNotFound))
+			{
+				for (auto ind : reqs)
+					requests[ind].errors = e.errors;
+				delete prefetched.adm_device;
+				continue;
+			}
+			dvlsa = NULL;
+		}
+
+//
+// Server without the bulk command: Subscribe one by one
+//
+
+		if (dvlsa == NULL)
+		{
+			single_reqs.insert(single_reqs.end(),reqs.begin(),reqs.end());
+			delete prefetched.adm_device;
+			continue;
+		}
+
+		CORBA::ULong str_ind = 0;
+		for (size_t loop = 0;loop < reqs.size();loop++)
+		{
+			EventSubscriptionRequest &req = requests[reqs[loop]];
+			const DevLong *lg = dvlsa->lvalue.get_buffer() + (loop * SUB_CHANGES_LG_NB);
+			CORBA::ULong nb_str = lg[1];
+			if (str_ind + nb_str > dvlsa->svalue.length())
+			{
+				single_reqs.push_back(reqs[loop]);
+				continue;
+			}
+
+//
+// Subscription refused by the server. Stateless subscriptions and devices using the notifd event system are done
+// one by one
+//
+
+			if (lg[0] != 0)
+			{
+				if ((stateless == true) || (nb_str == 0) || (::strcmp(dvlsa->svalue[str_ind].in(),API_CommandNotFound) == 0))
+					single_reqs.push_back(reqs[loop]);
+				else
+				{
+					req.errors.length(nb_str / 3);
+					for (CORBA::ULong i = 0;i < nb_str / 3;i++)
+					{
+						req.errors[i].reason = Tango::string_dup(dvlsa->svalue[str_ind + (i * 3)].in());
+						req.errors[i].desc = Tango::string_dup(dvlsa->svalue[str_ind + (i * 3) + 1].in());
+						req.errors[i].origin = Tango::string_dup(dvlsa->svalue[str_ind + (i * 3) + 2].in());
+						req.errors[i].severity = Tango::ERR;
+					}
+				}
+				str_ind = str_ind + nb_str;
+				continue;
+			}
+
+//
+// Connect the event with the result of the subscription command
+//
+
+			DevVarLongStringArray *sub_out = new DevVarLongStringArray();
+			sub_out->lvalue.length(SUB_CHANGES_LG_NB - 2);
+			for (int i = 0;i < SUB_CHANGES_LG_NB - 2;i++)
+				sub_out->lvalue[i] = lg[i + 2];
+			sub_out->svalue.length(nb_str);
+			for (CORBA::ULong i = 0;i < nb_str;i++)
+				sub_out->svalue[i] = Tango::string_dup(dvlsa->svalue[str_ind + i].in());
+			prefetched.reply << sub_out;
+			str_ind = str_ind + nb_str;
+
+			EventQueue *ev_queue = NULL;
+			if (req.callback == NULL)
+				ev_queue = new EventQueue(req.event_queue_size);
+
+			std::string event_name(EventName[req.event]);
+			try
+			{
+				DelayEvent de(this);
+				WriterLock w(map_modification_lock);
+
+				size_t nb_entries = event_callback_map.size();
+				req.event_id = connect_event(req.device,req.obj_name,req.event,req.callback,ev_queue,filters,event_name,0,&prefetched);
+				if (event_callback_map.size() != nb_entries)
+					new_entry = true;
+			}
+			catch (Tango::DevFailed &e)
+			{
+				delete ev_queue;
+				if (stateless == true)
+					single_reqs.push_back(reqs[loop]);
+				else
+					req.errors = e.errors;
+			}
+		}
+
+		delete prefetched.adm_device;
+	}
+
+//
+// Give some time to ZMQ to propagate the subscriptions to the publishers (once for all the requests)
+//
+
+	if (new_entry == true)
+	{
+#ifndef _TG_WINDOWS_
+		std::this_thread::sleep_for(std::chrono::nanoseconds(1000000));
+#else
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+#endif
+	}
+
+	for (auto ind : single_reqs)
+		subscribe_single_event(requests[ind],stateless);
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventConsumer::subscribe_single_event()
+//
+// description :
+//		Subscribe to one event of a bulk subscription request using the DeviceProxy methods (with the fallback to the
+//		notifd event system). The error is stored in the request
+//
+// argument :
+//		in :
+//			- req : The subscription request
+//			- stateless : Flag to enable the stateless connection when set to true
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void EventConsumer::subscribe_single_event(EventSubscriptionRequest &req,bool stateless)
+{
+	std::vector<std::string> filters;
+
+	try
+	{
+		if (req.device == NULL)
+		{
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_InvalidArgs, "Device pointer NULL");
+		}
+		else if (req.event == INTERFACE_CHANGE_EVENT)
+		{
+			if (req.callback != NULL)
+				req.event_id = req.device->subscribe_event(req.event,req.callback,stateless);
+			else
+				req.event_id = req.device->subscribe_event(req.event,req.event_queue_size,stateless);
+		}
+		else
+		{
+			if (req.callback != NULL)
+				req.event_id = req.device->subscribe_event(req.obj_name,req.event,req.callback,filters,stateless);
+			else
+				req.event_id = req.device->subscribe_event(req.obj_name,req.event,req.event_queue_size,filters,stateless);
+		}
+	}
+	catch (Tango::DevFailed &e)
+	{
+		req.event_id = 0;
+		req.errors = e.errors;
+	}
+}
+
 //+-------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -1328,6 +1630,8 @@ int EventConsumer::subscribe_event (DeviceProxy *device,
 //			- filters : Eventual event filter strings
 //			- event_name : The event name
 //          - event_id  : the unique event ID
+//			- prefetched : The admin device subscription command result when it has already been executed (bulk
+//						   subscription). NULL otherwise
 //
 //--------------------------------------------------------------------------------------------------------------------
 
@@ -1338,7 +1642,8 @@ int EventConsumer::connect_event(DeviceProxy *device,
 				   EventQueue *ev_queue,
 				   const std::vector<std::string> &filters,
 				   std::string &event_name,
-				   int event_id)
+				   int event_id,
+				   PrefetchedSubscription *prefetched)
 {
 	int ret_event_id = event_id;
 	device_name = device->dev_name();//TODO convert to local
@@ -1435,7 +1740,12 @@ int EventConsumer::connect_event(DeviceProxy *device,
 
     std::string adm_name;
 
-	if (ipos == device_channel_map.end())
+	if (ipos == device_channel_map.end() && prefetched != NULL)
+	{
+		adm_name = prefetched->adm_name;
+		adm_dev = prefetched->adm_device;
+	}
+	else if (ipos == device_channel_map.end())
 	{
 		try
 		{
@@ -1485,8 +1795,13 @@ int EventConsumer::connect_event(DeviceProxy *device,
 			subscriber_info.push_back(ss.str());
 		}
 
-		subscriber_in << subscriber_info;
-    	dd = adm_dev->command_inout(cmd_name,subscriber_in);
+		if (prefetched != NULL)
+			dd = prefetched->reply;
+		else
+		{
+			subscriber_in << subscriber_info;
+    		dd = adm_dev->command_inout(cmd_name,subscriber_in);
+		}
 
 		dd.reset_exceptions(DeviceData::isempty_flag);
 
@@ -1632,10 +1947,15 @@ int EventConsumer::connect_event(DeviceProxy *device,
 
 			if (new_entry_in_channel_map == true)
 			{
+				if (adm_dev == NULL)
+					adm_dev = new DeviceProxy(adm_name);
+
 				AutoTangoMonitor _mon(evt_it->second.channel_monitor);
 				evt_it->second.adm_device_proxy = adm_dev;
+				if (prefetched != NULL)
+					prefetched->adm_device = NULL;
 			}
-			else
+			else if (allocated == true)
 				delete adm_dev;
 		}
 	}
@@ -1762,6 +2082,7 @@ int EventConsumer::connect_event(DeviceProxy *device,
         TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_NotificationServiceFailed, o.str());
     }
     iter = ret.first;
+    event_id_map[ret_event_id] = iter->first;
 
 //
 // Read the attribute/pipe by a simple synchronous call.This is necessary for the first point in "change" mode
@@ -1770,16 +2091,6 @@ int EventConsumer::connect_event(DeviceProxy *device,
 
 	get_fire_sync_event(device,callback,ev_queue,event,event_name,obj_name,iter->second,local_callback_key);
 
-//
-// Sleep for some mS in order to give to ZMQ some times to propagate the subscription to the publisher
-//
-
-#ifndef _TG_WINDOWS_
-	std::this_thread::sleep_for(std::chrono::nanoseconds(1000000));
-#else
-	std::this_thread::sleep_for(std::chrono::milliseconds(20));
-#endif
-
 	return ret_event_id;
 }
 
@@ -1825,32 +2136,26 @@ void EventConsumer::unsubscribe_event(int event_id)
 
 	{
 		ReaderLock r(map_modification_lock);
-		for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+		if (find_event_id(event_id,epos,esspos) == true)
 		{
-			for (esspos = epos->second.callback_list.begin(); esspos != epos->second.callback_list.end(); ++esspos)
-			{
-				if(esspos->id == event_id)
-				{
 
 //
 // If the unsubscribe is done while the callback is being executed, mark the callback as unusable (event_id < 0)
 // and start a thread which will do the unsubscribe when the callback execution will be finished
 //
 
-                    if (thread_id != 0)
-                    {
-                        omni_thread::ensure_self se;
-                        if (omni_thread::self()->id() == thread_id)
-                        {
- //                           TANGO_LOG << event_id << ": Unsubscribing for an event while it is in its callback !!!!!!!!!!" << endl;
-                            esspos->id = -event_id;
+			if (thread_id != 0)
+			{
+				omni_thread::ensure_self se;
+				if (omni_thread::self()->id() == thread_id)
+				{
+ //					TANGO_LOG << event_id << ": Unsubscribing for an event while it is in its callback !!!!!!!!!!" << endl;
+					esspos->id = -event_id;
 
-                            DelayedEventUnsubThread *th = new DelayedEventUnsubThread(this,event_id,epos->second.callback_monitor);
-                            th->start();
+					DelayedEventUnsubThread *th = new DelayedEventUnsubThread(this,event_id,epos->second.callback_monitor);
+					th->start();
 
-                            return;
-                        }
-					}
+					return;
 				}
 			}
 		}
@@ -1868,32 +2173,29 @@ void EventConsumer::unsubscribe_event(int event_id)
 // First remove the callback entry from the callback map
 //
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
 		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
-		{
-			if(esspos->id == event_id)
-			{
 
 //
 // delete the event queue when used
 //
 
-                delete esspos->ev_queue;
+		delete esspos->ev_queue;
 
 //
-// Remove callback entry in vector
+// Remove callback entry in vector and in the event id index
 //
 
-				evt_cb.callback_list.erase(esspos);
+		evt_cb.callback_list.erase(esspos);
+		event_id_map.erase(std::abs(event_id));
 
 //
 // If the callback list is empty
 //
 
-				if (evt_cb.callback_list.empty() == true)
-				{
+		if (evt_cb.callback_list.empty() == true)
+		{
                     EvChanIte evt_it = channel_map.find(evt_cb.channel_name);
                     EventChannelStruct &evt_ch = evt_it->second;
                     if (evt_ch.channel_type == NOTIFD)
@@ -1903,56 +2205,56 @@ void EventConsumer::unsubscribe_event(int event_id)
                             CosNotifyFilter::Filter_var f = evt_ch.structuredProxyPushSupplier->get_filter(evt_cb.filter_id);
                             evt_ch.structuredProxyPushSupplier->remove_filter(evt_cb.filter_id);
                             f->destroy();
-					    }
+			    }
                         catch (...)
                         {
                             TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventNotFound, "Failed to unsubscribe event, caught exception while calling remove_filter() or destroy() (hint: check the Notification daemon is running ");
                         }
-					}
-					else
-					{
-					    disconnect_event(evt_cb.fully_qualified_event_name,evt_cb.endpoint);
-					}
+			}
+			else
+			{
+			    disconnect_event(evt_cb.fully_qualified_event_name,evt_cb.endpoint);
+			}
 
-					// delete the allocated callback monitor
-					delete epos->second.callback_monitor;
+			// delete the allocated callback monitor
+			delete epos->second.callback_monitor;
 
-					std::string deleted_channel_name = epos->second.channel_name;
-					std::string deleted_event_endpoint = evt_cb.endpoint;
-					event_callback_map.erase(epos);
+			std::string deleted_channel_name = epos->second.channel_name;
+			std::string deleted_event_endpoint = evt_cb.endpoint;
+			event_callback_map.erase(epos);
 
 //
 // Check if there is another callback using the same channel
 //
 
-					std::map<std::string,EventCallBackStruct>::iterator cb_pos;
-					bool channel_used_elsewhere = false;
-					for (cb_pos = event_callback_map.begin(); cb_pos != event_callback_map.end(); ++cb_pos)
-					{
-						if (cb_pos->second.channel_name == deleted_channel_name)
-						{
-							channel_used_elsewhere = true;
-							break;
-						}
-					}
+			std::map<std::string,EventCallBackStruct>::iterator cb_pos;
+			bool channel_used_elsewhere = false;
+			for (cb_pos = event_callback_map.begin(); cb_pos != event_callback_map.end(); ++cb_pos)
+			{
+				if (cb_pos->second.channel_name == deleted_channel_name)
+				{
+					channel_used_elsewhere = true;
+					break;
+				}
+			}
 
 //
 // This channel is not used anymore in the app, remove its entry in the channel maps
 //
 
-					if (channel_used_elsewhere == false)
+			if (channel_used_elsewhere == false)
+			{
+				std::map<std::string,EventChannelStruct>::iterator chan_pos;
+				for (chan_pos = channel_map.begin(); chan_pos != channel_map.end(); ++chan_pos)
+				{
+					if (chan_pos->first == deleted_channel_name)
 					{
-						std::map<std::string,EventChannelStruct>::iterator chan_pos;
-						for (chan_pos = channel_map.begin(); chan_pos != channel_map.end(); ++chan_pos)
+						EventChannelStruct &evt_ch = chan_pos->second;
+
+						if (evt_ch.adm_device_proxy != NULL)
 						{
-							if (chan_pos->first == deleted_channel_name)
-							{
-								EventChannelStruct &evt_ch = chan_pos->second;
-
-								if (evt_ch.adm_device_proxy != NULL)
-								{
-								    if (evt_ch.channel_type == NOTIFD)
-								    {
+						    if (evt_ch.channel_type == NOTIFD)
+						    {
                                         try
                                         {
                                             CosNotifyFilter::Filter_var f = evt_ch.structuredProxyPushSupplier->get_filter(evt_ch.heartbeat_filter_id);
@@ -1973,44 +2275,42 @@ void EventConsumer::unsubscribe_event(int event_id)
                                         {
                                             TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventNotFound, "Failed to unsubscribe event, caught exception while calling remove_filter() or destroy() on the heartbeat filter (hint: check the Notification daemon is running ");
                                         }
-								    }
-								    else
-								    {
+						    }
+						    else
+						    {
                                         disconnect_event_channel(deleted_channel_name,evt_ch.endpoint,deleted_event_endpoint);
-								    }
-								}
+						    }
+						}
 
-								delete evt_ch.adm_device_proxy;
-								delete evt_ch.channel_monitor;
+						delete evt_ch.adm_device_proxy;
+						delete evt_ch.channel_monitor;
 
-								channel_map.erase(chan_pos);
-								break;
-							}
-						}
+						channel_map.erase(chan_pos);
+						break;
+					}
+				}
 
-						std::map<std::string,std::string>::iterator dev_pos,dev_pos_del;
-						for (dev_pos = device_channel_map.begin(); dev_pos != device_channel_map.end();)
-						{
-							if (dev_pos->second == deleted_channel_name)
-							{
-								dev_pos_del = dev_pos;
-								++dev_pos;
-								device_channel_map.erase(dev_pos_del);
+				std::map<std::string,std::string>::iterator dev_pos,dev_pos_del;
+				for (dev_pos = device_channel_map.begin(); dev_pos != device_channel_map.end();)
+				{
+					if (dev_pos->second == deleted_channel_name)
+					{
+						dev_pos_del = dev_pos;
+						++dev_pos;
+						device_channel_map.erase(dev_pos_del);
 
 //
 // Don't "break" the loop! There may be more than one!
 //
 
-							}
-							else
-								++dev_pos;
-						}
-
 					}
+					else
+						++dev_pos;
 				}
-				return;
+
 			}
 		}
+		return;
 	}
 
 	// check also the vector of not yet connected events
@@ -2163,28 +2463,21 @@ void EventConsumer::get_events (int event_id, EventDataList &event_list)
 	std::map<std::string,EventCallBackStruct>::iterator epos;
 	std::vector<EventSubscribeStruct>::iterator esspos;
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
-		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		// check wether an event queue is used!
+		if ( esspos->callback == NULL )
 		{
-			if(esspos->id == event_id)
-			{
-				// check wether an event queue is used!
-				if ( esspos->callback == NULL )
-				{
-					// get the events from the queue
-					esspos->ev_queue->get_events (event_list);
-					return;
-				}
-				else
-				{
-					TangoSys_OMemStream o;
-					o << "No event queue specified during subscribe_event()\n";
-					o << "Cannot return any event data" << std::ends;
-					TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
-				}
-			}
+			// get the events from the queue
+			esspos->ev_queue->get_events (event_list);
+			return;
+		}
+		else
+		{
+			TangoSys_OMemStream o;
+			o << "No event queue specified during subscribe_event()\n";
+			o << "Cannot return any event data" << std::ends;
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
 		}
 	}
 
@@ -2255,28 +2548,21 @@ void EventConsumer::get_events (int event_id, AttrConfEventDataList &event_list)
 	std::map<std::string,EventCallBackStruct>::iterator epos;
 	std::vector<EventSubscribeStruct>::iterator esspos;
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
-		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		// check wether an event queue is used!
+		if ( esspos->callback == NULL )
 		{
-			if(esspos->id == event_id)
-			{
-				// check wether an event queue is used!
-				if ( esspos->callback == NULL )
-				{
-					// get the events from the queue
-					esspos->ev_queue->get_events (event_list);
-					return;
-				}
-				else
-				{
-					TangoSys_OMemStream o;
-					o << "No event queue specified during subscribe_event()\n";
-					o << "Cannot return any event data" << std::ends;
-					TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
-				}
-			}
+			// get the events from the queue
+			esspos->ev_queue->get_events (event_list);
+			return;
+		}
+		else
+		{
+			TangoSys_OMemStream o;
+			o << "No event queue specified during subscribe_event()\n";
+			o << "Cannot return any event data" << std::ends;
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
 		}
 	}
 
@@ -2347,28 +2633,21 @@ void EventConsumer::get_events (int event_id, DataReadyEventDataList &event_list
 	std::map<std::string,EventCallBackStruct>::iterator epos;
 	std::vector<EventSubscribeStruct>::iterator esspos;
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
-		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		// check wether an event queue is used!
+		if ( esspos->callback == NULL )
 		{
-			if(esspos->id == event_id)
-			{
-				// check wether an event queue is used!
-				if ( esspos->callback == NULL )
-				{
-					// get the events from the queue
-					esspos->ev_queue->get_events (event_list);
-					return;
-				}
-				else
-				{
-					TangoSys_OMemStream o;
-					o << "No event queue specified during subscribe_event()\n";
-					o << "Cannot return any event data" << std::ends;
-					TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
-				}
-			}
+			// get the events from the queue
+			esspos->ev_queue->get_events (event_list);
+			return;
+		}
+		else
+		{
+			TangoSys_OMemStream o;
+			o << "No event queue specified during subscribe_event()\n";
+			o << "Cannot return any event data" << std::ends;
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
 		}
 	}
 
@@ -2439,28 +2718,21 @@ void EventConsumer::get_events (int event_id, DevIntrChangeEventDataList &event_
 	std::map<std::string,EventCallBackStruct>::iterator epos;
 	std::vector<EventSubscribeStruct>::iterator esspos;
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
-		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		// check wether an event queue is used!
+		if ( esspos->callback == NULL )
 		{
-			if(esspos->id == event_id)
-			{
-				// check wether an event queue is used!
-				if ( esspos->callback == NULL )
-				{
-					// get the events from the queue
-					esspos->ev_queue->get_events (event_list);
-					return;
-				}
-				else
-				{
-					TangoSys_OMemStream o;
-					o << "No event queue specified during subscribe_event()\n";
-					o << "Cannot return any event data" << std::ends;
-					TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
-				}
-			}
+			// get the events from the queue
+			esspos->ev_queue->get_events (event_list);
+			return;
+		}
+		else
+		{
+			TangoSys_OMemStream o;
+			o << "No event queue specified during subscribe_event()\n";
+			o << "Cannot return any event data" << std::ends;
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
 		}
 	}
 
@@ -2531,28 +2803,21 @@ void EventConsumer::get_events (int event_id, PipeEventDataList &event_list)
 	std::map<std::string,EventCallBackStruct>::iterator epos;
 	std::vector<EventSubscribeStruct>::iterator esspos;
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
-		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		// check wether an event queue is used!
+		if ( esspos->callback == NULL )
 		{
-			if(esspos->id == event_id)
-			{
-				// check wether an event queue is used!
-				if ( esspos->callback == NULL )
-				{
-					// get the events from the queue
-					esspos->ev_queue->get_events (event_list);
-					return;
-				}
-				else
-				{
-					TangoSys_OMemStream o;
-					o << "No event queue specified during subscribe_event()\n";
-					o << "Cannot return any event data" << std::ends;
-					TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
-				}
-			}
+			// get the events from the queue
+			esspos->ev_queue->get_events (event_list);
+			return;
+		}
+		else
+		{
+			TangoSys_OMemStream o;
+			o << "No event queue specified during subscribe_event()\n";
+			o << "Cannot return any event data" << std::ends;
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
 		}
 	}
 
@@ -2624,28 +2889,21 @@ void EventConsumer::get_events (int event_id, CallBack *cb)
 	std::map<std::string,EventCallBackStruct>::iterator epos;
 	std::vector<EventSubscribeStruct>::iterator esspos;
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
-		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		// check wether an event queue is used!
+		if ( esspos->callback == NULL )
 		{
-			if(esspos->id == event_id)
-			{
-				// check wether an event queue is used!
-				if ( esspos->callback == NULL )
-				{
-					// get the events from the queue
-					esspos->ev_queue->get_events (cb);
-					return;
-				}
-				else
-				{
-					TangoSys_OMemStream o;
-					o << "No event queue specified during subscribe_event()\n";
-					o << "Cannot return any event data" << std::ends;
-					TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
-				}
-			}
+			// get the events from the queue
+			esspos->ev_queue->get_events (cb);
+			return;
+		}
+		else
+		{
+			TangoSys_OMemStream o;
+			o << "No event queue specified during subscribe_event()\n";
+			o << "Cannot return any event data" << std::ends;
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
 		}
 	}
 
@@ -2712,27 +2970,20 @@ int  EventConsumer::event_queue_size(int event_id)
 	std::map<std::string,EventCallBackStruct>::iterator epos;
 	std::vector<EventSubscribeStruct>::iterator esspos;
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
-		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		// check wether an event queue is used!
+		if ( esspos->callback == NULL )
 		{
-			if(esspos->id == event_id)
-			{
-				// check wether an event queue is used!
-				if ( esspos->callback == NULL )
-				{
-					// get the event queue size
-					return (esspos->ev_queue->size());
-				}
-				else
-				{
-					TangoSys_OMemStream o;
-					o << "No event queue specified during subscribe_event()\n";
-					o << "Cannot return any event data" << std::ends;
-					TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
-				}
-			}
+			// get the event queue size
+			return (esspos->ev_queue->size());
+		}
+		else
+		{
+			TangoSys_OMemStream o;
+			o << "No event queue specified during subscribe_event()\n";
+			o << "Cannot return any event data" << std::ends;
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
 		}
 	}
 
@@ -2804,27 +3055,20 @@ bool EventConsumer::is_event_queue_empty(int event_id)
 	std::map<std::string,EventCallBackStruct>::iterator epos;
 	std::vector<EventSubscribeStruct>::iterator esspos;
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
-		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		// check wether an event queue is used!
+		if ( esspos->callback == NULL )
 		{
-			if(esspos->id == event_id)
-			{
-				// check wether an event queue is used!
-				if ( esspos->callback == NULL )
-				{
-					// check whether the event queue is empty
-					return (esspos->ev_queue->is_empty());
-				}
-				else
-				{
-					TangoSys_OMemStream o;
-					o << "No event queue specified during subscribe_event()\n";
-					o << "Cannot return any event data" << std::ends;
-					TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
-				}
-			}
+			// check whether the event queue is empty
+			return (esspos->ev_queue->is_empty());
+		}
+		else
+		{
+			TangoSys_OMemStream o;
+			o << "No event queue specified during subscribe_event()\n";
+			o << "Cannot return any event data" << std::ends;
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
 		}
 	}
 
@@ -2895,27 +3139,20 @@ TimeVal EventConsumer::get_last_event_date(int event_id)
 	std::map<std::string,EventCallBackStruct>::iterator epos;
 	std::vector<EventSubscribeStruct>::iterator esspos;
 
-	for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+	if (find_event_id(event_id,epos,esspos) == true)
 	{
-		EventCallBackStruct &evt_cb = epos->second;
-		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		// check wether an event queue is used!
+		if ( esspos->callback == NULL )
 		{
-			if(esspos->id == event_id)
-			{
-				// check wether an event queue is used!
-				if ( esspos->callback == NULL )
-				{
-					// get the last insertion date
-					return (esspos->ev_queue->get_last_event_date());
-				}
-				else
-				{
-					TangoSys_OMemStream o;
-					o << "No event queue specified during subscribe_event()\n";
-					o << "Cannot return any event data" << std::ends;
-					TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
-				}
-			}
+			// get the last insertion date
+			return (esspos->ev_queue->get_last_event_date());
+		}
+		else
+		{
+			TangoSys_OMemStream o;
+			o << "No event queue specified during subscribe_event()\n";
+			o << "Cannot return any event data" << std::ends;
+			TANGO_THROW_API_EXCEPTION(EventSystemExcept, API_EventQueues, o.str());
 		}
 	}
 
@@ -2994,10 +3231,53 @@ int EventConsumer::add_new_callback(DeviceProxy *device, EvCbIte &iter,CallBack
 	ess.ev_queue = ev_queue;
 
 	iter->second.callback_list.push_back(ess);
+	event_id_map[ret_event_id] = iter->first;
 
 	return ret_event_id;
 }
 
+//+--------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventConsumer::find_event_id()
+//
+// description :
+//		Find the callback map entry and the callback list element used by one event. The event id index gives the
+//		callback map key, therefore only the callback list of this entry is scanned. The caller must hold the
+//		map_modification_lock
+//
+// argument :
+//		in :
+//			- event_id : The event identifier (negative if its unsubscription is delayed)
+//		out :
+//			- epos : Iterator in the callback map
+//			- esspos : Iterator in the entry callback list
+//
+// return :
+//		This method returns true if the event has been found
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+bool EventConsumer::find_event_id(int event_id,EvCbIte &epos,std::vector<EventSubscribeStruct>::iterator &esspos)
+{
+	std::unordered_map<int,std::string>::iterator ite = event_id_map.find(std::abs(event_id));
+	if (ite == event_id_map.end())
+		return false;
+
+	epos = event_callback_map.find(ite->second);
+	if (epos == event_callback_map.end())
+		return false;
+
+	std::vector<EventSubscribeStruct> &cb_list = epos->second.callback_list;
+	for (esspos = cb_list.begin();esspos != cb_list.end();++esspos)
+	{
+		if (esspos->id == event_id)
+			return true;
+	}
+
+	return false;
+}
+
 //+------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -3343,29 +3623,20 @@ ChannelType EventConsumer::get_event_system_for_event_id(int event_id)
 
     bool found = false;
     ReaderLock r(map_modification_lock);
-    for (epos = event_callback_map.begin(); epos != event_callback_map.end(); ++epos)
+    if (find_event_id(event_id,epos,esspos) == true)
     {
+        found = true;
         EventCallBackStruct &ecs = epos->second;
-        for (esspos = ecs.callback_list.begin(); esspos != ecs.callback_list.end(); ++esspos)
+        EvChanIte evt_it = channel_map.find(ecs.channel_name);
+        if (evt_it == channel_map.end())
         {
-            if(esspos->id == event_id)
-            {
-                found = true;
-                EvChanIte evt_it = channel_map.find(ecs.channel_name);
-                if (evt_it == channel_map.end())
-                {
-                    TangoSys_OMemStream o;
-                    o << "Can't unsubscribe to event with id " << event_id << "\n";
-                    o << "Corrupted internal map. Please report bug" << std::ends;
-                    TANGO_THROW_EXCEPTION(API_BadConfigurationProperty, o.str());
-                }
-                EventChannelStruct &evt_ch = evt_it->second;
-                ret = evt_ch.channel_type;
-                break;
-            }
-            if (found == true)
-                break;
+            TangoSys_OMemStream o;
+            o << "Can't unsubscribe to event with id " << event_id << "\n";
+            o << "Corrupted internal map. Please report bug" << std::ends;
+            TANGO_THROW_EXCEPTION(API_BadConfigurationProperty, o.str());
         }
+        EventChannelStruct &evt_ch = evt_it->second;
+        ret = evt_ch.channel_type;
     }
 
 //
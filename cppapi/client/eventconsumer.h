@@ -39,6 +39,7 @@
 #include <COS/CosNotifyComm.hh>
 #include <omnithread.h>
 #include <map>
+#include <unordered_map>
 
 #include <readers_writers_lock.h>
 
@@ -185,6 +186,14 @@ struct ZmqDevPipeDataElt:public DevPipeDataElt
 #error "Swap32 has already been defined"
 #endif
 
+//
+// Bulk byte swapping (in place) of 16, 32 and 64 bits data sequences, vectorized when possible (byteswap.cpp)
+//
+
+void byte_swap_16(void *,size_t);
+void byte_swap_32(void *,size_t);
+void byte_swap_64(void *,size_t);
+
 //
 // These template specialization allow us to set or get sequences within a AttrValUnion union.
 // Union method to get/set sequence value are named short_att_value(), double_att_value(),
@@ -244,36 +253,11 @@ inline void ZmqAttrValUnion::init_seq(char *base_ptr,CORBA::ULong &length,TangoC
     if (_n.unmarshal_byte_swap() == true)
     {
         if (sizeof(T) == 2)
-        {
-            for (CORBA::ULong i = 0;i < length;i++)
-            {
-                _CORBA_UShort *tmp_ptr = (_CORBA_UShort *)ptr;
-                _CORBA_UShort tt = *(tmp_ptr + i);
-                *(tmp_ptr + i) = Swap16(tt);
-            }
-        }
+            byte_swap_16(ptr,length);
         else if (sizeof(T) == 4)
-        {
-            for (CORBA::ULong i = 0;i < length;i++)
-            {
-               CORBA::ULong *tmp_ptr = (CORBA::ULong *)ptr;
-                CORBA::ULong t = *(tmp_ptr + i);
-                *(tmp_ptr + i) = Swap32(t);
-            }
-        }
+            byte_swap_32(ptr,length);
         else if (sizeof(T) == 8)
-        {
-            CORBA::ULong double_length = length * 2;
-            for (CORBA::ULong i = 0;i < double_length;i += 2)
-            {
-                CORBA::ULong *tmp_ptr = (CORBA::ULong *)ptr;
-                CORBA::ULong tl1 = *(tmp_ptr + i + 1);
-                CORBA::ULong tl2 = Swap32(tl1);
-                tl1 = *(tmp_ptr + i);
-                *(tmp_ptr + i) = tl2;
-                *(tmp_ptr + i + 1) = Swap32(tl1);
-            }
-        }
+            byte_swap_64(ptr,length);
     }
 
     TA &the_seq = get_seq<TA>();
@@ -319,6 +303,26 @@ typedef struct event_not_connected
 	std::string							prefix;
 } EventNotConnected;
 
+//------------------------ Bulk subscription related info ----------------------------------
+
+struct EventSubscriptionRequest
+{
+	DeviceProxy						*device;			// The device handle
+	std::string						obj_name;			// The attribute name
+	EventType						event;				// The event type
+	CallBack						*callback;			// The callback object (NULL to use an event queue)
+	int								event_queue_size;	// The event queue size (used when callback is NULL)
+	int								event_id;			// Out: The event id (0 if the subscription failed)
+	DevErrorList					errors;				// Out: The subscription error
+};
+
+struct PrefetchedSubscription
+{
+	std::string						adm_name;			// The full admin device name
+	DeviceProxy						*adm_device;		// Admin device proxy (taken when a new channel is created)
+	DeviceData						reply;				// The subscription command result
+};
+
 //------------------------ Event Callback related info --------------------------------------
 
 struct ReceivedFromAdmin
@@ -418,7 +422,7 @@ public :
 	EventConsumer(ApiUtil *ptr);
 	virtual ~EventConsumer() {}
 
-	int connect_event(DeviceProxy *,const std::string &,EventType,CallBack *,EventQueue *,const std::vector<std::string> &,std::string &,int event_id = 0);
+	int connect_event(DeviceProxy *,const std::string &,EventType,CallBack *,EventQueue *,const std::vector<std::string> &,std::string &,int event_id = 0,PrefetchedSubscription *prefetched = NULL);
 	void connect(DeviceProxy *,const std::string &,DeviceData &,const std::string &,bool &);
 
 	void shutdown();
@@ -433,6 +437,7 @@ public :
 	                   int event_queue_size, const std::vector<std::string> &filters, bool stateless = false);
 	int subscribe_event(DeviceProxy *device, EventType event,CallBack *callback,bool stateless = false);
 	int subscribe_event(DeviceProxy *device, EventType event,int event_queue_size,bool stateless = false);
+	void subscribe_events(std::vector<EventSubscriptionRequest> &requests,bool stateless = false);
 
 	void unsubscribe_event(int event_id);
 
@@ -468,10 +473,12 @@ protected :
 	void conf_to_info(AttributeConfig_2 &,AttributeInfoEx **);
 	void get_cs_tango_host(Database *);
 	std::string get_client_attribute_name(const std::string &, const std::vector<std::string> &filters);
+	void subscribe_single_event(EventSubscriptionRequest &,bool);
 
 	static std::map<std::string,std::string> 					device_channel_map;     // key - device_name, value - channel name (full adm name)
 	static std::map<std::string,EventChannelStruct> 				channel_map;            // key - channel_name (full adm name), value - Event Channel info
 	static std::map<std::string,EventCallBackStruct> 			event_callback_map;     // key - callback_key, value - Event CallBack info
+	static std::unordered_map<int,std::string>				event_id_map;			// key - event id, value - callback_key
 	static ReadersWritersLock 								map_modification_lock;
 
 	static std::vector<EventNotConnected> 						event_not_connected;
@@ -486,6 +493,7 @@ protected :
     int                                                     thread_id;
 
 	int add_new_callback(DeviceProxy*, EvCbIte &,CallBack *,EventQueue *,int);
+	bool find_event_id(int,EvCbIte &,std::vector<EventSubscribeStruct>::iterator &);
 	void get_fire_sync_event(DeviceProxy *,CallBack *,EventQueue *,EventType,std::string &,const std::string &,EventCallBackStruct &,std::string &);
 
 	virtual void connect_event_channel(const std::string &,Database *,bool,DeviceData &) = 0;
@@ -20,8 +20,18 @@
 
 #include <iostream>
 #include <numeric>
+#include <iterator>
+#include <algorithm>
 #include <tango.h>
 
+#ifndef _TG_WINDOWS_
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 // DbInfo                              done
 // DbImportDevice
 // DbExportDevice
@@ -110,48 +120,68 @@ bool equalsIgnoreCase(const string& s1, const string& s2)
   	return ret;
 }
 
-t_device* search_device(t_server& s, string& name)
+std::string lower_name(const string& name)
 {
-	for (unsigned int j = 0; j < s.devices.size(); j++)
-	{
-		if (equalsIgnoreCase(s.devices[j]->name, name))
-			return s.devices[j];
-	}
-
-	return NULL;
+	string ret(name);
+	transform(ret.begin(),ret.end(),ret.begin(),chartolower);
+	return ret;
 }
 
-t_tango_class* search_class(t_server& s, string& name)
+//
+// Look-up, add and remove elements of a vector/index pair. When the file defines the same name twice, the index
+// refers to the first one (as a linear search would)
+//
+
+template <class T>
+T* search_index(const unordered_map<string,T*>& index, const string& name)
 {
-	for (unsigned int i = 0; i < s.classes.size(); i++)
-	{
-		if (equalsIgnoreCase(s.classes[i]->name, name))
-			return s.classes[i];
+	typename unordered_map<string,T*>::const_iterator pos = index.find(lower_name(name));
+	if (pos == index.end())
+		return NULL;
+	return pos->second;
+}
 
-	}
-	return NULL;
+template <class T>
+void add_to_index(vector<T*>& vect, unordered_map<string,T*>& index, const string& name, T* obj)
+{
+	vect.push_back(obj);
+	index.emplace(lower_name(name),obj);
 }
 
-t_attribute_property* search_dev_attr_prop(t_device* d, const string& name)
+void remove_property(vector<t_property*>& vect, unordered_map<string,t_property*>& index, t_property* prop)
 {
-	for (unsigned int i = 0; i < d->attribute_properties.size(); i++)
+	string key = lower_name(prop->name);
+	vect.erase(remove(vect.begin(),vect.end(),prop),vect.end());
+	index.erase(key);
+	for (unsigned int i = 0; i < vect.size(); i++)
 	{
-		if (equalsIgnoreCase(d->attribute_properties[i]->attribute_name, name))
-			return d->attribute_properties[i];
+		if (equalsIgnoreCase(vect[i]->name,prop->name))
+		{
+			index.emplace(key,vect[i]);
+			break;
+		}
 	}
-	return NULL;
+	delete prop;
+}
 
+t_device* search_device(t_server& s, const string& name)
+{
+	return search_index(s.device_index,name);
 }
 
-t_attribute_property* search_class_attr_prop(t_tango_class* d, const string& name)
+t_tango_class* search_class(t_server& s, const string& name)
 {
-	for (unsigned int i = 0; i < d->attribute_properties.size(); i++)
-	{
-		if (equalsIgnoreCase(d->attribute_properties[i]->attribute_name, name))
-			return d->attribute_properties[i];
-	}
-	return NULL;
+	return search_index(s.class_index,name);
+}
 
+t_attribute_property* search_dev_attr_prop(t_device* d, const string& name)
+{
+	return search_index(d->attribute_index,name);
+}
+
+t_attribute_property* search_class_attr_prop(t_tango_class* d, const string& name)
+{
+	return search_index(d->attribute_index,name);
 }
 
 std::string& trim(string& str)
@@ -236,6 +266,148 @@ char* to_corba_string(CORBA::ULong val)
   return Tango::string_dup(str.c_str());
 }
 
+//
+// Store one property (name, value number and values) received in a DbPutXXXProperty argin starting at index
+// idx. Update idx and return true if the property is new or if its value changed
+//
+
+bool put_property(vector<t_property*>& props, unordered_map<string,t_property*>& index,
+				  const DevVarStringArray& data_in, unsigned int& idx)
+{
+	unsigned int n_values = 0;
+	string prop_name(data_in[idx]); idx++;
+	if (idx < data_in.length())
+	{
+		sscanf(data_in[idx],"%6u",&n_values); idx++;
+	}
+
+	vector<string> values;
+	for (unsigned int j = 0; j < n_values && idx < data_in.length(); j++)
+	{
+		values.push_back(string(data_in[idx])); idx++;
+	}
+
+	t_property* prop = search_index(index, prop_name);
+	if (prop == NULL)
+	{
+		/* it is a new property */
+		prop = new t_property;
+		prop->name = prop_name;
+		prop->value.swap(values);
+		add_to_index(props, index, prop_name, prop);
+		return true;
+	}
+
+	if (prop->value == values)
+		return false;
+	prop->value.swap(values);
+	return true;
+}
+
+//
+// Build a DbGetXXXAttributeProperty argout. The attrs vector has one entry for each attribute in data_in (NULL
+// when the attribute does not have any property). It is empty when the device or class is not defined
+//
+
+void get_attribute_property(const DevVarStringArray& data_in, const vector<t_attribute_property*>& attrs,
+							DevVarStringArray& data_out)
+{
+	unsigned int num_attr = data_in.length() - 1;
+	unsigned long seq_length = 2;
+	for (unsigned int k = 0; k < num_attr; k++)
+	{
+		seq_length = seq_length + 2;
+		if (k < attrs.size() && attrs[k] != NULL)
+		{
+			for (unsigned int l = 0; l < attrs[k]->properties.size(); l++)
+				seq_length = seq_length + 2 + attrs[k]->properties[l]->value.size();
+		}
+	}
+	data_out.length(seq_length);
+
+	int index = 0;
+	data_out[index] = Tango::string_dup(data_in[0]); index++;
+	data_out[index] = to_corba_string(num_attr); index++;
+
+	for (unsigned int k = 0; k < num_attr; k++)
+	{
+		data_out[index] = Tango::string_dup(data_in[k + 1]); index++; // attribute name
+		if (k >= attrs.size() || attrs[k] == NULL)
+		{
+			data_out[index] = Tango::string_dup("0"); index++; // number of properties
+			continue;
+		}
+
+		vector<t_property*>& props = attrs[k]->properties;
+		data_out[index] = to_corba_string(props.size()); index++;
+		for (unsigned int l = 0; l < props.size(); l++)
+		{
+			data_out[index] = Tango::string_dup(props[l]->name.c_str()); index++;
+			data_out[index] = to_corba_string(props[l]->value.size()); index++;
+			for (unsigned int m = 0; m < props[l]->value.size(); m++)
+			{
+				data_out[index] = Tango::string_dup(props[l]->value[m].c_str()); index++;
+			}
+		}
+	}
+}
+
+//
+// The resource file content. The file is mapped in memory when possible, otherwise it is read in one go
+//
+
+class ResFileContent
+{
+public:
+	ResFileContent(const string &file_name):map(NULL),map_size(0),opened(false)
+	{
+#ifndef _TG_WINDOWS_
+		int fd = ::open(file_name.c_str(),O_RDONLY);
+		if (fd >= 0)
+		{
+			struct stat st;
+			if (::fstat(fd,&st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+			{
+				void *addr = ::mmap(NULL,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+				if (addr != MAP_FAILED)
+				{
+					map = static_cast<char *>(addr);
+					map_size = st.st_size;
+					opened = true;
+				}
+			}
+			::close(fd);
+			if (opened == true)
+				return;
+		}
+#endif
+		ifstream f(file_name.c_str(),ios::in | ios::binary);
+		if (f.good())
+		{
+			buffer.assign(istreambuf_iterator<char>(f),istreambuf_iterator<char>());
+			opened = true;
+		}
+	}
+
+	~ResFileContent()
+	{
+#ifndef _TG_WINDOWS_
+		if (map != NULL)
+			::munmap(map,map_size);
+#endif
+	}
+
+	bool is_open() {return opened;}
+	const char *begin() {return map != NULL ? map : buffer.data();}
+	const char *end() {return map != NULL ? map + map_size : buffer.data() + buffer.size();}
+
+private:
+	char			*map;
+	size_t			map_size;
+	vector<char>	buffer;
+	bool			opened;
+};
+
 } // anonymous namespace
 
 FileDatabaseExt::FileDatabaseExt() {}
@@ -243,7 +415,7 @@ FileDatabaseExt::~FileDatabaseExt() {}
 
 
 FileDatabase::FileDatabase(const std::string& file_name)
-  :ext(new FileDatabaseExt)
+  :read_ptr(NULL),read_end(NULL),modified(false),ext(new FileDatabaseExt)
 {
 	TANGO_LOG_DEBUG << "FILEDATABASE: FileDatabase constructor" << endl;
 	filename = file_name;
@@ -302,11 +474,11 @@ FileDatabase::~FileDatabase()
 // ****************************************************
 // read the next character in the file
 // ****************************************************
-void FileDatabase :: read_char(ifstream& f)
+void FileDatabase :: read_char()
 {
   	CurrentChar=NextChar;
-  	if(!f.eof())
-		f.get(NextChar);
+  	if(read_ptr != read_end)
+		NextChar = *read_ptr++;
   	else
 		NextChar=0;
   	if(CurrentChar=='\n')
@@ -334,48 +506,44 @@ int FileDatabase :: class_lex(const string& tmp_word)
 // ****************************************************
 // Go to the next line                                */
 // ****************************************************
-void  FileDatabase :: jump_line(ifstream& f)
+void  FileDatabase :: jump_line()
 {
-	while(CurrentChar!='\n' && CurrentChar!=0) read_char(f);
-		read_char(f);
+	while(CurrentChar!='\n' && CurrentChar!=0) read_char();
+		read_char();
 }
 
 
-void  FileDatabase :: jump_space(ifstream& f)
+void  FileDatabase :: jump_space()
 {
 	while((CurrentChar<=32) && (CurrentChar>0))
-		read_char(f);
+		read_char();
 }
 
   // ****************************************************
   // Read the next word in the file                           */
   // ****************************************************
-string FileDatabase :: read_word(ifstream& f)
+string FileDatabase :: read_word()
 {
 
    string ret_word="";
 
    /* Jump space and comments */
-   jump_space(f);
+   jump_space();
    while( CurrentChar=='#' ) {
-     jump_line(f);
-     jump_space(f);
+     jump_line();
+     jump_space();
    }
 
    /* Jump C like comments */
    if( CurrentChar=='/' ) {
-     read_char(f);
+     read_char();
      if( CurrentChar=='*' ) {
-       bool end=false;
-       read_char(f);
-       while(end) {
-         while( CurrentChar!='*' )
-           read_char(f);
-         read_char(f);
-         end=(CurrentChar=='/');
-       }
-       read_char(f);
-       jump_space(f);
+       read_char();
+       while( CurrentChar!=0 && ( CurrentChar!='*' || NextChar!='/' ) )
+         read_char();
+       read_char();
+       read_char();
+       jump_space();
      } else {
        ret_word="/";
        return ret_word;
@@ -392,19 +560,19 @@ string FileDatabase :: read_word(ifstream& f)
        ret_word += CurrentChar;
      } else {
        ret_word += CurrentChar;
-       read_char(f);
+       read_char();
        ret_word += CurrentChar;
      }
-     read_char(f);
+     read_char();
      return ret_word;
    }
 
    /* Treat string */
    if( CurrentChar=='"' ) {
-     read_char(f);
+     read_char();
      while( CurrentChar!='"' && CurrentChar!=0 && CurrentChar!='\n' ) {
        ret_word+=CurrentChar;
-       read_char(f);
+       read_char();
      }
      if(CurrentChar==0 || CurrentChar=='\n')
      {
@@ -414,7 +582,7 @@ string FileDatabase :: read_word(ifstream& f)
 		desc << " in file " << filename << "." << ends;
 		TANGO_THROW_API_EXCEPTION(ApiConnExcept, API_DatabaseFileError, desc.str());
      }
-     read_char(f);
+     read_char();
      return ret_word;
    }
 
@@ -425,7 +593,7 @@ string FileDatabase :: read_word(ifstream& f)
      if( CurrentChar=='-' && NextChar=='>' )
        break;
      ret_word+=CurrentChar;
-     read_char(f);
+     read_char();
    }
 
    if(ret_word.length()==0) {
@@ -439,35 +607,35 @@ string FileDatabase :: read_word(ifstream& f)
   // Read the next word in the file
   // And allow / inside
   // ****************************************************
-string FileDatabase:: read_full_word(ifstream& f)
+string FileDatabase:: read_full_word()
 {
  	string ret_word;
 
 	StartLine=CrtLine;
-	jump_space(f);
+	jump_space();
 
 	/* Treat special character */
 	if( CurrentChar==',' || CurrentChar=='\\' )
 	{
   		ret_word += CurrentChar;
-  		read_char(f);
+  		read_char();
   		return ret_word;
 	}
 
 	/* Treat string */
 	if( CurrentChar=='"' )
 	{
-  		read_char(f);
+  		read_char();
   		while( CurrentChar!='"' && CurrentChar!=0 && CurrentChar!='\n')
 		{
 			if (CurrentChar=='\\')
 			{
-				read_char(f);
+				read_char();
 				ret_word += CurrentChar;
 			}
 			else
 				ret_word += CurrentChar;
-			read_char(f);
+			read_char();
   		}
   		if( CurrentChar==0 || CurrentChar=='\n')
   		{
@@ -477,7 +645,7 @@ string FileDatabase:: read_full_word(ifstream& f)
 			desc << " in file " << filename << "." << ends;
 			TANGO_THROW_API_EXCEPTION(ApiConnExcept, API_DatabaseFileError, desc.str());
   		}
-  		read_char(f);
+  		read_char();
 		if (ret_word.length() == 0)
 			ret_word = string(lexical_word_null);
   		return ret_word;
@@ -487,7 +655,7 @@ string FileDatabase:: read_full_word(ifstream& f)
 	while( CurrentChar>32 && CurrentChar!='\\' && CurrentChar!=',')
 	{
   		ret_word += CurrentChar;
-  		read_char(f);
+  		read_char();
 	}
 
 	if(ret_word.length()==0)
@@ -513,7 +681,7 @@ void FileDatabase:: CHECK_LEX(int lt,int le)
 }
 
 
-vector<string> FileDatabase:: parse_resource_value(ifstream& f)
+vector<string> FileDatabase:: parse_resource_value()
 {
 	int  lex;
 	vector<string> ret;
@@ -525,13 +693,13 @@ vector<string> FileDatabase:: parse_resource_value(ifstream& f)
 
 	while( (lex==_TG_COMA || lex==_TG_ASLASH) && word!="" )
 	{
-		word=read_full_word(f);
+		word=read_full_word();
 		lex=class_lex(word);
 
   	/* allow ... ,\ syntax */
 		if( lex==_TG_ASLASH )
 		{
-			word=read_full_word(f);
+			word=read_full_word();
 			lex=class_lex(word);
 		}
 
@@ -540,7 +708,7 @@ vector<string> FileDatabase:: parse_resource_value(ifstream& f)
 		ret.push_back(word);
 		nbr++;
 
-		word=read_word(f);
+		word=read_word();
 		lex=class_lex(word);
   	}
 
@@ -555,7 +723,6 @@ vector<string> FileDatabase:: parse_resource_value(ifstream& f)
 
 std::string FileDatabase::parse_res_file(const std::string &file_name)
 {
-	ifstream f;
 	bool eof=false;
 	int lex;
 
@@ -576,20 +743,21 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 
 /* OPEN THE FILE                  */
 
-	f.open (file_name.c_str(), ifstream::in);
-	if ( !f.good() )
+	ResFileContent f(file_name);
+	if ( !f.is_open() )
 	{
 		TangoSys_MemStream desc;
 		desc << "FILEDATABASE could not open file " << file_name << "." << ends;
 		TANGO_THROW_API_EXCEPTION(ApiConnExcept, API_DatabaseFileError, desc.str());
 	}
+	read_ptr = f.begin();
+	read_end = f.end();
 
 /* CHECK BEGINING OF CONFIG FILE  */
 
-	word=read_word(f);
+	word=read_word();
 	if( word == "" )
 	{
-		f.close();
 		return file_name + " is empty...";
 	}
 	lex=class_lex(word);
@@ -606,19 +774,19 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 
 /* Domain */
 				domain=word;
-           		word=read_word(f);
+           		word=read_word();
 				lex=class_lex(word);
 
 			//TANGO_LOG << "DOMAIN " << domain << endl;;
            		CHECK_LEX(lex,_TG_SLASH);
 
 /* Family */
-           		word=read_word(f);
+           		word=read_word();
 				lex=class_lex(word);
            		CHECK_LEX(lex,_TG_STRING);
            		family=word;
 			//TANGO_LOG << "FAMILI " << family << endl;
-           		word=read_word(f);
+           		word=read_word();
 				lex=class_lex(word);
 
 	   		switch(lex)
@@ -626,22 +794,22 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 	   		case _TG_SLASH:
 
 	     /* Member */
-             			word=read_word(f);lex=class_lex(word);
+             			word=read_word();lex=class_lex(word);
              			CHECK_LEX(lex,_TG_STRING);
              			member=word;
-             			word=read_word(f);
+             			word=read_word();
 				lex=class_lex(word);
 
              			switch(lex)
 				{
 	       			case _TG_SLASH:
 	         /* We have a 4 fields name */
-           				word=read_word(f);
+           				word=read_word();
 					lex=class_lex(word);
            				CHECK_LEX(lex,_TG_STRING);
 	         			name=word;
 
-           				word=read_word(f);
+           				word=read_word();
 					lex=class_lex(word);
 
 	         			switch(lex)
@@ -650,12 +818,12 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 				     		{
 	               /* Device definition */
 						m_server.instance_name = family;
-	               				vector<string> values = parse_resource_value(f);
+	               				vector<string> values = parse_resource_value();
 	               				lex=class_lex(word);
 						//TANGO_LOG << "Class name : " << name << endl;
 						un_class = new t_tango_class;
 						un_class->name = name;
-						m_server.classes.push_back(un_class);
+						add_to_index(m_server.classes, m_server.class_index, name, un_class);
 	               				if( equalsIgnoreCase(member, "device") )
 						{
 	                 /* Device definition */
@@ -664,7 +832,7 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 	                 //TANGO_LOG << "    Device: <" << values[n] << ">" << endl;
 								un_device = new t_device;
 								un_device->name = values[n];
-								m_server.devices.push_back(un_device);
+								add_to_index(m_server.devices, m_server.device_index, un_device->name, un_device);
 								un_class->devices.push_back(un_device);
 							}
 		        			}
@@ -674,19 +842,19 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 	           			case _TG_ARROW:
 	             				{
 	               /* We have an attribute property definition */
-                       				word=read_word(f);
+                       				word=read_word();
 						lex=class_lex(word);
                        				CHECK_LEX(lex,_TG_STRING);
 	                		 	prop_name=word;
 						//TANGO_LOG << "Attribute property: " << prop_name << endl;
 
 	               				/* jump : */
-                       				word=read_word(f);
+                       				word=read_word();
 						lex=class_lex(word);
                        				CHECK_LEX(lex,_TG_COLON);
 
 	               				/* Resource value */
-	               				vector<string> values = parse_resource_value(f);
+	               				vector<string> values = parse_resource_value();
 	               				lex=class_lex(word);
 
 	               /* Device attribute definition */
@@ -700,7 +868,7 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 						{
 							un_dev_attr_prop = new t_attribute_property;
 							un_dev_attr_prop->attribute_name = name;
-							d->attribute_properties.push_back(un_dev_attr_prop);
+							add_to_index(d->attribute_properties, d->attribute_index, name, un_dev_attr_prop);
 						}
 						t_property* prop = new t_property;
 						prop->name = prop_name;
@@ -709,7 +877,7 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 							//TANGO_LOG << "     <" << values[n] << ">" << endl;
 							prop->value.push_back(values[n]);
 						}
-						un_dev_attr_prop->properties.push_back(prop);
+						add_to_index(un_dev_attr_prop->properties, un_dev_attr_prop->property_index, prop_name, prop);
 
 
 	             				}
@@ -730,17 +898,17 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 
 	         /* We have a device property or attribute class definition */
 
-	        			word=read_word(f);
+	        			word=read_word();
 					lex=class_lex(word);
                 			CHECK_LEX(lex,_TG_STRING);
 	        			prop_name=word;
 
 	         /* jump : */
-                			word=read_word(f); lex=class_lex(word);
+                			word=read_word(); lex=class_lex(word);
                 			CHECK_LEX(lex,_TG_COLON);
 
 	         /* Resource value */
-	        			vector<string> values = parse_resource_value(f);
+	        			vector<string> values = parse_resource_value();
 	        			lex=class_lex(word);
 
 	         			if(equalsIgnoreCase(domain, "class"))
@@ -758,7 +926,7 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 							{
 								un_class_attr_prop = new t_attribute_property;
 								un_class_attr_prop->attribute_name = member;
-								c->attribute_properties.push_back(un_class_attr_prop);
+								add_to_index(c->attribute_properties, c->attribute_index, member, un_class_attr_prop);
 							}
 							t_property* prop = new t_property;
 							prop->name = prop_name;
@@ -767,7 +935,7 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 									//TANGO_LOG << "     <" << values[n] << ">" << endl;
 								prop->value.push_back(values[n]);
 							}
-							un_class_attr_prop->properties.push_back(prop);
+							add_to_index(un_class_attr_prop->properties, un_class_attr_prop->property_index, prop_name, prop);
 
 	          	 //put_tango_class_attr_prop(family,member,prop_name,values);
 						}
@@ -791,7 +959,7 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 							 //TANGO_LOG << "     <" << values[n] << ">" << endl;
 							 	un_dev_prop->value.push_back(values[n]);
 						 	}
-						 	d->properties.push_back(un_dev_prop);
+						 	add_to_index(d->properties, d->property_index, prop_name, un_dev_prop);
 						}
 	         			}
 					}
@@ -812,13 +980,13 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 
 	    	 /* We have a class property */
   	    	 /* Member */
-            	 		word=read_word(f); lex=class_lex(word);
+            	 		word=read_word(); lex=class_lex(word);
             	 		CHECK_LEX(lex,_TG_STRING);
             	 		member=word;
-            	 		word=read_word(f); lex=class_lex(word);
+            	 		word=read_word(); lex=class_lex(word);
 
 	    	 /* Resource value */
-	    	 		vector<string> values = parse_resource_value(f);
+	    	 		vector<string> values = parse_resource_value();
   	    	 		lex=class_lex(word);
 
 	    	 /* Class resource */
@@ -837,7 +1005,7 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 								 //TANGO_LOG << "    " << member << "[" << n << "] = " << values[n] << endl;
 								 un_prop->value.push_back(values[n]);
 							 }
-							 un_class->properties.push_back(un_prop);
+							 add_to_index(un_class->properties, un_class->property_index, member, un_prop);
 						 }
 					}
 
@@ -874,7 +1042,6 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
       		eof=(word == lexical_word_null);
      		}
 
-		 f.close();
      	return "";
 
 }
@@ -966,8 +1133,50 @@ string FileDatabase :: get_display()
 	return ost.str();
 }
 
+//-----------------------------------------------------------------------------
+//
+// method :			FileDatabase::write_file() -
+//
+// description : 	Write the file database content into the file. Nothing is done
+//					if the content did not change since the file was read (or last
+//					written). Only the sections of the classes and devices which
+//					changed are rebuilt, the text of the others is kept in a cache
+//
+//-----------------------------------------------------------------------------
+
 void  FileDatabase :: write_file()
 {
+	if (modified == false)
+		return;
+
+	ostringstream content;
+	write_header(content);
+
+	for (unsigned int i = 0; i < m_server.classes.size(); i++)
+	{
+		string &cl_text = class_write_cache[lower_name(m_server.classes[i]->name)];
+		if (cl_text.empty() == true)
+		{
+			ostringstream ost;
+			write_class(ost,m_server.classes[i]);
+			cl_text = ost.str();
+		}
+		content << cl_text;
+	}
+	content << endl;
+
+	for (unsigned int i = 0; i < m_server.devices.size(); i++)
+	{
+		string &dev_text = dev_write_cache[lower_name(m_server.devices[i]->name)];
+		if (dev_text.empty() == true)
+		{
+			ostringstream ost;
+			write_device(ost,m_server.devices[i]);
+			dev_text = ost.str();
+		}
+		content << dev_text;
+	}
+
 	ofstream f;
 	string f_name(filename);
 	/*
@@ -979,6 +1188,46 @@ void  FileDatabase :: write_file()
 	*/
 
 	f.open (f_name.c_str());
+	f << content.str();
+	f.close();
+
+	modified = false;
+}
+
+//-----------------------------------------------------------------------------
+//
+// method :			FileDatabase::set_modified() -
+//
+// description : 	Mark a class or a device as modified. Its file section will be
+//					rebuilt by the next write_file() call. The section text is cached
+//					by name (not by object address which may be reused)
+//
+// argument : in : cl/dev : The modified class or device
+//
+//-----------------------------------------------------------------------------
+
+void FileDatabase::set_modified(t_tango_class *cl)
+{
+	class_write_cache.erase(lower_name(cl->name));
+	modified = true;
+}
+
+void FileDatabase::set_modified(t_device *dev)
+{
+	dev_write_cache.erase(lower_name(dev->name));
+	modified = true;
+}
+
+//-----------------------------------------------------------------------------
+//
+// method :			FileDatabase::write_header() -
+//
+// description : 	Write the file section defining the devices of each class
+//
+//-----------------------------------------------------------------------------
+
+void FileDatabase::write_header(ostream &f)
+{
 	vector<t_tango_class *>::const_iterator it;
 	for(it = m_server.classes.begin(); it != m_server.classes.end(); ++it)
 	{
@@ -996,39 +1245,84 @@ void  FileDatabase :: write_file()
 		f << endl;
 	}
 	f << endl;
+}
 
-	for(it = m_server.classes.begin(); it != m_server.classes.end(); ++it)
+//-----------------------------------------------------------------------------
+//
+// method :			FileDatabase::write_class() -
+//
+// description : 	Write the file section with the properties of a class
+//
+//-----------------------------------------------------------------------------
+
+void FileDatabase::write_class(ostream &f,t_tango_class *cl)
+{
+	f << "#############################################" << endl;
+	f << "# CLASS " << cl->name << endl;
+	f << endl;
+	for(vector<t_property*>::iterator itp = cl->properties.begin(); itp != cl->properties.end(); ++itp)
 	{
-		f << "#############################################" << endl;
-		f << "# CLASS " << (*it)->name << endl;
+		f << "CLASS/" << cl->name << "->" << (*itp)->name << ": " ;
+		int margin = 6 + cl->name.size() + 2 + (*itp)->name.size() + 2;
+		string margin_s(margin,' ');
+		vector<string>::iterator iterator_s = (*itp)->value.begin();
+		if ((*iterator_s).length() == 0)
+			(*iterator_s)[0] = ' ';
+		if (iterator_s != (*itp)->value.end())
+		{
+			//f << "\"" << (*iterator_s) << "\"";
+			if ((*iterator_s).length() == 0)
+				f << "\"\"";
+			else
+			{
+				if (iterator_s->find(' ', 0)!=string::npos)
+					f << "\"" ;
+				string str = (*iterator_s);
+				escape_double_quote(str);
+				f << str;
+				if (iterator_s->find(' ', 0)!=string::npos)
+					f << "\"";
+			}
+			++iterator_s;
+			for(vector<string>::iterator its = iterator_s; its != (*itp)->value.end(); ++its)
+			{
+				f << ",\\" << endl;
+				f << margin_s;
+				if (its->find(' ', 0)!=string::npos)
+					f << "\"" ;
+				string str = (*its);
+				escape_double_quote(str);
+				f << str;
+				if (its->find(' ', 0)!=string::npos)
+					f << "\"";
+			}
+		}
 		f << endl;
-		for(vector<t_property*>::iterator itp = (*it)->properties.begin(); itp != (*it)->properties.end(); ++itp)
+	}
+	f << endl;
+	f << "# CLASS " << cl->name << " attribute properties" << endl;
+	f << endl;
+	for(vector<t_attribute_property*>::const_iterator itap = cl->attribute_properties.begin(); itap != cl->attribute_properties.end(); ++itap)
+	{
+		for(vector<t_property*>::const_iterator itp = (*itap)->properties.begin(); itp != (*itap)->properties.end(); ++itp)
 		{
-			f << "CLASS/" << (*it)->name << "->" << (*itp)->name << ": " ;
-			int margin = 6 + (*it)->name.size() + 2 + (*itp)->name.size() + 2;
-			string margin_s(margin,' ');
+			f << "CLASS/" << cl->name << "/" << (*itap)->attribute_name << "->" << (*itp)->name << ": ";
+			int margin = 6 + cl->name.size() + 1 + (*itap)->attribute_name.size() + 2 + (*itp)->name.size() +2;
 			vector<string>::iterator iterator_s = (*itp)->value.begin();
-			if ((*iterator_s).length() == 0)
-				(*iterator_s)[0] = ' ';
 			if (iterator_s != (*itp)->value.end())
 			{
-				//f << "\"" << (*iterator_s) << "\"";
-				if ((*iterator_s).length() == 0)
-					f << "\"\"";
-				else
-				{
-					if (iterator_s->find(' ', 0)!=string::npos)
-						f << "\"" ;
-					string str = (*iterator_s);
-					escape_double_quote(str);
-					f << str;
-					if (iterator_s->find(' ', 0)!=string::npos)
-						f << "\"";
-				}
+				if (iterator_s->find(' ', 0)!=string::npos)
+					f << "\"" ;
+				string str = (*iterator_s);
+				escape_double_quote(str);
+				f << str;
+				if (iterator_s->find(' ', 0)!=string::npos)
+					f << "\"";
 				++iterator_s;
 				for(vector<string>::iterator its = iterator_s; its != (*itp)->value.end(); ++its)
 				{
 					f << ",\\" << endl;
+					string margin_s(margin,' ');
 					f << margin_s;
 					if (its->find(' ', 0)!=string::npos)
 						f << "\"" ;
@@ -1041,57 +1335,63 @@ void  FileDatabase :: write_file()
 			}
 			f << endl;
 		}
-		f << endl;
-		f << "# CLASS " << (*it)->name << " attribute properties" << endl;
-		f << endl;
-		for(vector<t_attribute_property*>::const_iterator itap = (*it)->attribute_properties.begin(); itap != (*it)->attribute_properties.end(); ++itap)
+	}
+	f << endl;
+}
+
+//-----------------------------------------------------------------------------
+//
+// method :			FileDatabase::write_device() -
+//
+// description : 	Write the file section with the properties of a device
+//
+//-----------------------------------------------------------------------------
+
+void FileDatabase::write_device(ostream &f,t_device *dev)
+{
+	f << "# DEVICE " << dev->name << " properties " << endl << endl;
+	for(vector<t_property*>::const_iterator itp = dev->properties.begin(); itp != dev->properties.end(); ++itp)
+	{
+		f << dev->name << "->" << (*itp)->name << ": ";
+		vector<string>::iterator iterator_s = (*itp)->value.begin();
+		if (iterator_s != (*itp)->value.end())
 		{
-			for(vector<t_property*>::const_iterator itp = (*itap)->properties.begin(); itp != (*itap)->properties.end(); ++itp)
+			int margin = dev->name.size() + 1 + (*itp)->name.size() + 2;
+			if (iterator_s->find(' ', 0)!=string::npos)
+				f << "\"" ;
+			string str = (*iterator_s);
+			escape_double_quote(str);
+			f << str;
+			if (iterator_s->find(' ', 0)!=string::npos)
+				f << "\"";
+			++iterator_s;
+			for(vector<string>::iterator its = iterator_s; its != (*itp)->value.end(); ++its)
 			{
-				f << "CLASS/" << (*it)->name << "/" << (*itap)->attribute_name << "->" << (*itp)->name << ": ";
-				int margin = 6 + (*it)->name.size() + 1 + (*itap)->attribute_name.size() + 2 + (*itp)->name.size() +2;
-				vector<string>::iterator iterator_s = (*itp)->value.begin();
-				if (iterator_s != (*itp)->value.end())
-				{
-					if (iterator_s->find(' ', 0)!=string::npos)
-						f << "\"" ;
-					string str = (*iterator_s);
-					escape_double_quote(str);
-					f << str;
-					if (iterator_s->find(' ', 0)!=string::npos)
-						f << "\"";
-					++iterator_s;
-					for(vector<string>::iterator its = iterator_s; its != (*itp)->value.end(); ++its)
-					{
-						f << ",\\" << endl;
-						string margin_s(margin,' ');
-						f << margin_s;
-						if (its->find(' ', 0)!=string::npos)
-							f << "\"" ;
-						string str = (*its);
-						escape_double_quote(str);
-						f << str;
-						if (its->find(' ', 0)!=string::npos)
-							f << "\"";
-					}
-				}
-				f << endl;
+				f << ",\\" << endl;
+				string margin_s(margin,' ');
+				f << margin_s;
+				if (its->find(' ', 0)!=string::npos)
+					f << "\"" ;
+				string str = (*its);
+				escape_double_quote(str);
+				f << str;
+				if (its->find(' ', 0)!=string::npos)
+					f << "\"";
 			}
 		}
 		f << endl;
-
 	}
 	f << endl;
-	for(vector<t_device*>::const_iterator ite = m_server.devices.begin(); ite != m_server.devices.end(); ++ite)
+	f << "# DEVICE " <<  dev->name << " attribute properties" << endl << endl;
+	for(vector<t_attribute_property*>::const_iterator itap = dev->attribute_properties.begin(); itap != dev->attribute_properties.end(); ++itap)
 	{
-		f << "# DEVICE " << (*ite)->name << " properties " << endl << endl;
-		for(vector<t_property*>::const_iterator itp = (*ite)->properties.begin(); itp != (*ite)->properties.end(); ++itp)
+		for(vector<t_property*>::const_iterator itp = (*itap)->properties.begin(); itp != (*itap)->properties.end(); ++itp)
 		{
-			f << (*ite)->name << "->" << (*itp)->name << ": ";
+			f << dev->name << "/" << (*itap)->attribute_name << "->" << (*itp)->name << ": ";
+			int margin = dev->name.size() + 1 + (*itap)->attribute_name.size() + 2 + (*itp)->name.size() +2;
 			vector<string>::iterator iterator_s = (*itp)->value.begin();
 			if (iterator_s != (*itp)->value.end())
 			{
-				int margin = (*ite)->name.size() + 1 + (*itp)->name.size() + 2;
 				if (iterator_s->find(' ', 0)!=string::npos)
 					f << "\"" ;
 				string str = (*iterator_s);
@@ -1116,46 +1416,7 @@ void  FileDatabase :: write_file()
 			}
 			f << endl;
 		}
-		f << endl;
-		f << "# DEVICE " <<  (*ite)->name << " attribute properties" << endl << endl;
-		for(vector<t_attribute_property*>::const_iterator itap = (*ite)->attribute_properties.begin(); itap != (*ite)->attribute_properties.end(); ++itap)
-		{
-			for(vector<t_property*>::const_iterator itp = (*itap)->properties.begin(); itp != (*itap)->properties.end(); ++itp)
-			{
-				f << (*ite)->name << "/" << (*itap)->attribute_name << "->" << (*itp)->name << ": ";
-				int margin = (*ite)->name.size() + 1 + (*itap)->attribute_name.size() + 2 + (*itp)->name.size() +2;
-				vector<string>::iterator iterator_s = (*itp)->value.begin();
-				if (iterator_s != (*itp)->value.end())
-				{
-					if (iterator_s->find(' ', 0)!=string::npos)
-						f << "\"" ;
-					string str = (*iterator_s);
-					escape_double_quote(str);
-					f << str;
-					if (iterator_s->find(' ', 0)!=string::npos)
-						f << "\"";
-					++iterator_s;
-					for(vector<string>::iterator its = iterator_s; its != (*itp)->value.end(); ++its)
-					{
-						f << ",\\" << endl;
-						string margin_s(margin,' ');
-						f << margin_s;
-						if (its->find(' ', 0)!=string::npos)
-							f << "\"" ;
-						string str = (*its);
-						escape_double_quote(str);
-						f << str;
-						if (its->find(' ', 0)!=string::npos)
-							f << "\"";
-					}
-				}
-				f << endl;
-			}
-		}
-
 	}
-
-	f.close();
 }
 
 void FileDatabase::escape_double_quote(string &_str)
@@ -1193,61 +1454,40 @@ CORBA::Any*   FileDatabase :: DbGetDeviceProperty(CORBA::Any& send)
 
 	if (data_in->length() >= 2)
 	{
-		unsigned long nb_defined_dev = m_server.devices.size();
-		unsigned long i;
-        int seq_length = 2;
+		t_device* dev = search_device(m_server, (*data_in)[0].in());
+
+//
+// Look for the properties first to allocate the returned sequence only once
+//
+
+		vector<t_property*> props(num_prop, (t_property*)NULL);
+		unsigned long seq_length = 2;
+		for (unsigned int j = 0; j < num_prop; j++)
+		{
+			if (dev != NULL)
+				props[j] = search_index(dev->property_index, (*data_in)[j + 1].in());
+			if (props[j] != NULL)
+				seq_length = seq_length + 2 + props[j]->value.size();
+			else
+				seq_length = seq_length + 3;
+		}
+		data_out->length(seq_length);
 
-		for(i = 0; i < nb_defined_dev; i++)
+		for (unsigned int j = 0; j < num_prop; j++)
 		{
-			if ( equalsIgnoreCase((*data_in)[0].in(), m_server.devices[i]->name))
+			if (props[j] != NULL)
 			{
-				for (unsigned int j = 1; j < data_in->length(); j++)
+				int num_val = props[j]->value.size();
+				(*data_out)[index] = Tango::string_dup( props[j]->name.c_str() );index++;
+				(*data_out)[index] = to_corba_string(num_val); index++;
+				for (int k=0; k < num_val; k++)
 				{
-					unsigned long m;
-
-					unsigned long nb_defined_prop = m_server.devices[i]->properties.size();
-					for (m = 0; m < nb_defined_prop; m++)
-					{
-						//if ( strcmp((*data_in)[j], m_server.devices[i]->properties[m]->name.c_str()) == 0 )
-						if ( equalsIgnoreCase((*data_in)[j].in(), m_server.devices[i]->properties[m]->name))
-						{
-                            int num_val  = 0;
-
-							num_prop++;
-							num_val = m_server.devices[i]->properties[m]->value.size();
-							seq_length = seq_length + 2 + m_server.devices[i]->properties[m]->value.size();
-							data_out->length(seq_length);
-							(*data_out)[index] = Tango::string_dup( m_server.devices[i]->properties[m]->name.c_str() );index++;
-							(*data_out)[index] = to_corba_string(num_val); index++;
-							for (int k=0; k < num_val; k++)
-							{
-								(*data_out)[index] = Tango::string_dup( m_server.devices[i]->properties[m]->value[k].c_str());index++;
-							}
-							break;
-						}
-
-					}
-
-					if (m == nb_defined_prop)
-					{
-						seq_length = seq_length + 3;
-						data_out->length(seq_length);
-						(*data_out)[index] = Tango::string_dup((*data_in)[j].in());index++;
-						(*data_out)[index] = Tango::string_dup("0");index++;
-						(*data_out)[index] = Tango::string_dup(" ");index++;
-					}
+					(*data_out)[index] = Tango::string_dup( props[j]->value[k].c_str());index++;
 				}
-				break;
 			}
-		}
-
-		if (i == nb_defined_dev)
-		{
-			for (i = 0;i < num_prop;i++)
+			else
 			{
-				seq_length = seq_length + 3;
-				data_out->length(seq_length);
-				(*data_out)[index] = Tango::string_dup((*data_in)[i + 1].in());index++;
+				(*data_out)[index] = Tango::string_dup((*data_in)[j + 1].in());index++;
 				(*data_out)[index] = Tango::string_dup("0");index++;
 				(*data_out)[index] = Tango::string_dup(" ");index++;
 			}
@@ -1270,56 +1510,27 @@ CORBA::Any*   FileDatabase :: DbPutDeviceProperty(CORBA::Any& send)
 
 	const Tango::DevVarStringArray* data_in = NULL;
 	unsigned int n_properties=0;
-	int n_values=0;
 
 	send >>= data_in;
 
 	if ((*data_in).length() > 1)
 	{
-        int index = 0;
-		std::vector<t_device*>::iterator it;
-		it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[index])));index++;
-		if (it == m_server.devices.end())
+        unsigned int index = 0;
+		t_device* dev = search_device(m_server, (*data_in)[index].in());index++;
+		if (dev == NULL)
 		{
 			TANGO_LOG_DEBUG << "Nome device " << (*data_in)[0] << " non trovato. " << endl;
 			return any_ptr;
 		}
-		t_device& device_trovato = *(*(it));
-
 
 		sscanf((*data_in)[1],"%6u",&n_properties); index++;
-		for (unsigned int i=0; i< n_properties; i++)
+		for (unsigned int i=0; i< n_properties && index < data_in->length(); i++)
 		{
-			std::vector<t_property*>::iterator prop_it;
-			prop_it = find_if(device_trovato.properties.begin(), device_trovato.properties.end(), hasName<t_property>(string((*data_in)[index])));index++;
-			if (prop_it != device_trovato.properties.end())
-			{
-				/* we found a  property */
-				t_property& prop = (*(*prop_it));
-				sscanf((*data_in)[index],"%6d",&n_values); index++;
-				prop.value.resize(n_values);
-				for(int j = 0; j< n_values; j++)
-				{
-					prop.value[j] = (*data_in)[index]; index++;
-				}
-			}
-			else
-			{
-				/* it is a new property */
-				t_property* temp_property = new t_property;
-				temp_property->name = (*data_in)[index-1];
-				sscanf((*data_in)[index],"%6d",&n_values); index++;
-				for(int j = 0; j < n_values; j++)
-				{
-					temp_property->value.push_back(string((*data_in)[index])); index++;
-				}
-				device_trovato.properties.push_back(temp_property);
-			}
-
+			if (put_property(dev->properties, dev->property_index, *data_in, index) == true)
+				set_modified(dev);
 		}
 	}
 
-
 	write_file();
 	return any_ptr;
 }
@@ -1335,21 +1546,18 @@ CORBA::Any*   FileDatabase :: DbDeleteDeviceProperty(CORBA::Any& send)
 	//for(unsigned int i = 0; i < (*data_in).length(); i++)
 	//	TANGO_LOG << "(*data_in)[" << i << "] = " << (*data_in)[i] << endl;
 
-	std::vector<t_device*>::iterator it;
-	it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[0])));
+	t_device* dev = search_device(m_server, (*data_in)[0].in());
 
-	if (it != m_server.devices.end())
+	if (dev != NULL)
 	{
 		for(unsigned int i = 1; i < (*data_in).length(); i++)
 		{
-			t_device& device_trovato = *(*(it));
-			std::vector<t_property*>::iterator itp;
-			itp = find_if(device_trovato.properties.begin(), device_trovato.properties.end(), hasName<t_property>(string((*data_in)[i])));
-
-			if (itp != device_trovato.properties.end())
+			t_property* prop = search_index(dev->property_index, (*data_in)[i].in());
+			if (prop != NULL)
 			{
-				//TANGO_LOG << "found " << (*itp)->name << endl;
-				device_trovato.properties.erase(itp, itp+1);
+				//TANGO_LOG << "found " << prop->name << endl;
+				remove_property(dev->properties, dev->property_index, prop);
+				set_modified(dev);
 			}
 		}
 	}
@@ -1377,62 +1585,16 @@ CORBA::Any*   FileDatabase :: DbGetDeviceAttributeProperty(CORBA::Any& send)
 	//for(unsigned int i = 0; i < data_in->length(); i++)
 	//	TANGO_LOG << "send[" << i << "] = " << (*data_in)[i] << endl;
 
-	int index = 0;
-	data_out->length(2);
-	(*data_out)[0] = Tango::string_dup( (*data_in)[0] ); index++;
-	auto num_attr = data_in->length() - 1;
-	(*data_out)[index] = to_corba_string(num_attr); index++;
-
-	std::vector<t_device*>::iterator dev_it;
-	dev_it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[0])));
-	if (dev_it != m_server.devices.end())
+	t_device* dev = search_device(m_server, (*data_in)[0].in());
+	vector<t_attribute_property*> attrs;
+	if (dev != NULL)
 	{
-		 //TANGO_LOG << "Device " << (*dev_it)->name << " trovato." << endl;
-		 for(unsigned int k =0; k < num_attr; k++)
-		 {
-			 data_out->length(index+2);
-			(*data_out)[index] = Tango::string_dup((*data_in)[k+1]); index++; // attribute name
-			(*data_out)[index] = Tango::string_dup("0"); index++; // number of properties
-			 for(unsigned int j = 0; j < (*dev_it)->attribute_properties.size(); j++)
-			 {
-				if (equalsIgnoreCase((*dev_it)->attribute_properties[j]->attribute_name, (*data_in)[k+1].in()))
-				{
-					int num_attr_find = 0;
-
-					//TANGO_LOG << "Proprieta' " << (*dev_it)->attribute_properties[j]->attribute_name << " trovata." << endl;
-					auto num_prop = (*dev_it)->attribute_properties[j]->properties.size();
-					num_attr_find++;
-
-					(*data_out)[index-1] = to_corba_string(num_prop);
-
-					for (unsigned int l = 0; l < num_prop; l++)
-					{
-						data_out->length(index + 1 + 1 + (*dev_it)->attribute_properties[j]->properties[l]->value.size());
-						(*data_out)[index] = Tango::string_dup((*dev_it)->attribute_properties[j]->properties[l]->name.c_str());index++;
-						auto num_attr_prop = (*dev_it)->attribute_properties[j]->properties[l]->value.size();
-						(*data_out)[index] = to_corba_string(num_attr_prop); index++;
-
-						for(unsigned int ii = 0; ii < (*dev_it)->attribute_properties[j]->properties[l]->value.size(); ii++)
-						{
-							//TANGO_LOG << ii << " = " << (*dev_it)->attribute_properties[j]->properties[l]->value[ii].c_str() << endl;
-							(*data_out)[index] = Tango::string_dup((*dev_it)->attribute_properties[j]->properties[l]->value[ii].c_str()); index++;
-						}
-					}
-
-			  }
-
-			 }
-			}
-	} else {
-		 data_out->length(index + 2 * num_attr);
-		 for(unsigned int i = 0; i < num_attr; i++)
-		 {
-			(*data_out)[index] = Tango::string_dup((*data_in)[i+1]); index++;
-			(*data_out)[index] = Tango::string_dup("0"); index++;
-		 }
-
+		for (unsigned int k = 1; k < data_in->length(); k++)
+			attrs.push_back(search_dev_attr_prop(dev, (*data_in)[k].in()));
 	}
 
+	get_attribute_property(*data_in, attrs, *data_out);
+
 	//for(unsigned int i = 0; i < data_out->length(); i++)
 	//	TANGO_LOG << "data_out[" << i << "] = " << (*data_out)[i] << endl;
 
@@ -1448,7 +1610,6 @@ CORBA::Any*   FileDatabase :: DbPutDeviceAttributeProperty(CORBA::Any& send)
 	const Tango::DevVarStringArray* data_in = NULL;
 	unsigned int num_prop = 0;
 	unsigned int num_attr = 0;
-	unsigned int num_vals = 0;
 
 	CORBA::Any* ret = new CORBA::Any;
 
@@ -1459,77 +1620,28 @@ CORBA::Any*   FileDatabase :: DbPutDeviceAttributeProperty(CORBA::Any& send)
 
 	unsigned int index = 0;
 
-	std::vector<t_device*>::iterator dev_it;
-	dev_it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[index])));index++;
-	if (dev_it != m_server.devices.end())
+	t_device* dev = search_device(m_server, (*data_in)[index].in());index++;
+	if (dev != NULL)
 	{
 		sscanf((*data_in)[index],"%6u",&num_attr); index++;
-		for(unsigned int j = 0; j < num_attr; j++)
+		for(unsigned int j = 0; j < num_attr && index + 1 < data_in->length(); j++)
 		{
-			t_attribute_property* temp_attribute_property;
-			std::vector<t_attribute_property*>::iterator attr_prop_it;
-			attr_prop_it = find_if((*dev_it)->attribute_properties.begin(),(*dev_it)->attribute_properties.end(), hasAttributeName<t_attribute_property>(string((*data_in)[index])));
-			if (attr_prop_it != (*dev_it)->attribute_properties.end())
+			string att_name((*data_in)[index]); index++;
+			t_attribute_property* temp_attribute_property = search_dev_attr_prop(dev, att_name);
+			if (temp_attribute_property == NULL)
 			{
-				temp_attribute_property = (*attr_prop_it);
-			} else {
 				// the property is not yet in the file: we add it
 				temp_attribute_property = new t_attribute_property;
-				temp_attribute_property->attribute_name = string((*data_in)[index]);
-				(*dev_it)->attribute_properties.push_back(temp_attribute_property);
-
+				temp_attribute_property->attribute_name = att_name;
+				add_to_index(dev->attribute_properties, dev->attribute_index, att_name, temp_attribute_property);
 			}
-			//if (equalsIgnoreCase((*dev_it)->attribute_properties[j]->attribute_name, (*data_in)[index].in()))
 
-			index++;
 			sscanf((*data_in)[index],"%6u",&num_prop); index++;
-			for (unsigned int i = 0; i < num_prop; i++)
+			for (unsigned int i = 0; i < num_prop && index < data_in->length(); i++)
 			{
-				bool exist = false;
-				for(unsigned int k = 0; k < temp_attribute_property->properties.size(); k++)
-				{
-		  		if (equalsIgnoreCase(temp_attribute_property->properties[k]->name, (*data_in)[index].in()))
-		  		{
-						index++;
-						temp_attribute_property->properties[k]->value.erase(temp_attribute_property->properties[k]->value.begin(),
-                                                        temp_attribute_property->properties[k]->value.begin()+temp_attribute_property->properties[k]->value.size());
-						sscanf((*data_in)[index],"%6u",&num_vals); index++;
-						for(unsigned int n = 0; n < num_vals; n++)
-						{
-							temp_attribute_property->properties[k]->value.push_back(string((*data_in)[index])); index++;
-						}
-
-// (*dev_it)->attribute_properties[j]->properties[k]->value.push_back( string((*data_in)[index]) );index++;
-						if (index >= data_in->length())
-						{
-							write_file();
-							return ret;
-						}
-						exist = true;
-					}
-				}
-				if ( !exist )
-				{
-					t_property* new_prop = new t_property;
-					new_prop->name = (*data_in)[index]; index++;
-
-					sscanf((*data_in)[index],"%6u",&num_vals); index++;
-					for(unsigned int n = 0; n < num_vals; n++)
-					{
-						new_prop->value.push_back(string((*data_in)[index])); index++;
-					}
-
-					//makeStringArray( string((*data_in)[index]), new_prop->value);index++;
-					//new_prop->value.push_back( string((*data_in)[index]) );index++;
-					temp_attribute_property->properties.push_back(new_prop);
-					if (index >= data_in->length())
-					{
-							write_file();
-							return ret;
-					}
-				}
-
-			 }
+				if (put_property(temp_attribute_property->properties, temp_attribute_property->property_index, *data_in, index) == true)
+					set_modified(dev);
+			}
 		}
 
 	}
@@ -1549,26 +1661,21 @@ CORBA::Any*   FileDatabase :: DbDeleteDeviceAttributeProperty(CORBA::Any& send)
 	//for(unsigned int i = 0; i < (*data_in).length(); i++)
 	//	TANGO_LOG << "(*data_in)[" << i << "] = " << (*data_in)[i] << endl;
 
-	std::vector<t_device*>::iterator it;
-	it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[0])));
+	t_device* dev = search_device(m_server, (*data_in)[0].in());
 
-	if (it != m_server.devices.end())
+	if (dev != NULL && (*data_in).length() > 1)
 	{
-		t_device& device_trovato = *(*(it));
-		for(unsigned int j = 0; j < device_trovato.attribute_properties.size(); j++)
+		t_attribute_property* att = search_dev_attr_prop(dev, (*data_in)[1].in());
+		if (att != NULL)
 		{
-			if (equalsIgnoreCase(device_trovato.attribute_properties[j]->attribute_name, (*data_in)[1].in()))
+			for(unsigned int m = 2; m < (*data_in).length(); m++)
 			{
-				for(unsigned int m = 2; m < (*data_in).length(); m++)
+				t_property* prop = search_index(att->property_index, (*data_in)[m].in());
+				if (prop != NULL)
 				{
-					std::vector<t_property*>::iterator itp;
-					itp = find_if(device_trovato.attribute_properties[j]->properties.begin(), device_trovato.attribute_properties[j]->properties.end(), hasName<t_property>(string((*data_in)[m])));
-
-					if (itp != device_trovato.attribute_properties[j]->properties.end())
-					{
-//						TANGO_LOG << "found property" << (*itp)->name << "for attribute " << device_trovato.attribute_properties[j]->attribute_name << endl;
-						device_trovato.attribute_properties[j]->properties.erase(itp, itp+1);
-					}
+//					TANGO_LOG << "found property" << prop->name << "for attribute " << att->attribute_name << endl;
+					remove_property(att->properties, att->property_index, prop);
+					set_modified(dev);
 				}
 			}
 		}
@@ -1616,66 +1723,50 @@ CORBA::Any*   FileDatabase :: DbGetClassProperty(CORBA::Any& send)
 
 	CORBA::Any *any_ptr = new CORBA::Any();
 	int index = 0;
-	int seq_length = 2;
 
 	data_out->length(2);
 	(*data_out)[0] = Tango::string_dup((*data_in)[0]); index++;
 	const auto num_prop = data_in->length() - 1;
 	(*data_out)[index] = to_corba_string(num_prop); index++;
 
-	unsigned long nb_classes_defined = m_server.classes.size();
-	unsigned long i;
+	t_tango_class* cl = search_class(m_server, (*data_in)[0].in());
+
+//
+// Look for the properties first to allocate the returned sequence only once
+//
+
+	vector<t_property*> props(num_prop, (t_property*)NULL);
+	unsigned long seq_length = 2;
+	for (unsigned int j = 0; j < num_prop; j++)
+	{
+		if (cl != NULL)
+			props[j] = search_index(cl->property_index, (*data_in)[j + 1].in());
+		if (props[j] != NULL)
+			seq_length = seq_length + 2 + props[j]->value.size();
+		else
+			seq_length = seq_length + 2;
+	}
+	data_out->length(seq_length);
 
-	for(i = 0; i < nb_classes_defined; i++)
+	for (unsigned int j = 0; j < num_prop; j++)
 	{
-		if (equalsIgnoreCase((*data_in)[0].in(), m_server.classes[i]->name))
+		if (props[j] != NULL)
 		{
-			// m_server.classes[i] is the class we are looking for
-			for (unsigned int j = 1; j < (*data_in).length(); j++)  // at index 0 is the name of the class, property names are following
+			auto num_val = props[j]->value.size();
+			(*data_out)[index] = Tango::string_dup((*data_in)[j + 1]); index++;
+			(*data_out)[index] = to_corba_string(num_val); index++;
+			for (unsigned int n = 0; n < num_val; n++)
 			{
-				unsigned long nb_prop_defined = m_server.classes[i]->properties.size();
-				unsigned long m;
-				for (m = 0; m < nb_prop_defined; m++)
-				{
-					if (equalsIgnoreCase((*data_in)[j].in(), m_server.classes[i]->properties[m]->name))
-					{
-						auto num_val = m_server.classes[i]->properties[m]->value.size();
-						seq_length = seq_length + 2 + num_val;
-						(*data_out).length(seq_length);
-						(*data_out)[index] = Tango::string_dup((*data_in)[j]); index++;
-						(*data_out)[index] = to_corba_string(num_val); index++;
-						for (unsigned int n = 0; n < num_val; n++)
-						{
-							(*data_out)[index] = Tango::string_dup(m_server.classes[i]->properties[m]->value[n].c_str()); index++;
-						}
-						break;
-					}
-				}
-
-				if (m == nb_prop_defined)
-				{
-					// The requested property does not exist in the specified class
-					seq_length = seq_length + 2;
-					data_out->length(seq_length);
-					// The requested property name is returned, followed by a 0,
-					// meaning the length of this property value is 0 ( <=> class property not found )
-					(*data_out)[index] = Tango::string_dup((*data_in)[j].in());index++;
-					(*data_out)[index] = Tango::string_dup("0");index++;
-				}
+				(*data_out)[index] = Tango::string_dup(props[j]->value[n].c_str()); index++;
 			}
-			break;
 		}
-	}
-
-	if (i == nb_classes_defined)
-	{
-		for (i = 0;i < num_prop;i++)
+		else
 		{
-			seq_length = seq_length + 2;
-			data_out->length(seq_length);
-			(*data_out)[index] = Tango::string_dup((*data_in)[i + 1].in());index++;
+			// The requested property does not exist in the specified class
+			// The requested property name is returned, followed by a 0,
+			// meaning the length of this property value is 0 ( <=> class property not found )
+			(*data_out)[index] = Tango::string_dup((*data_in)[j + 1].in());index++;
 			(*data_out)[index] = Tango::string_dup("0");index++;
-//			(*data_out)[index] = Tango::string_dup(" ");index++;
 		}
 	}
 
@@ -1693,7 +1784,6 @@ CORBA::Any*   FileDatabase :: DbPutClassProperty(CORBA::Any& send)
 	CORBA::Any* ret = new CORBA::Any;
 	const Tango::DevVarStringArray* data_in = NULL;
 	unsigned int n_properties=0;
-	int n_values=0;
 
 	TANGO_LOG_DEBUG << "FILEDATABASE: entering DbPutClassProperty" << endl;
 
@@ -1704,51 +1794,18 @@ CORBA::Any*   FileDatabase :: DbPutClassProperty(CORBA::Any& send)
 	if ((*data_in).length() > 1)
 	{
         unsigned int index = 0;
-		std::vector<t_tango_class*>::iterator it;
-		it = find_if(m_server.classes.begin(), m_server.classes.end(), hasName<t_tango_class>(string((*data_in)[index])));index++;
-		if (it == m_server.classes.end())
+		t_tango_class* cl = search_class(m_server, (*data_in)[index].in());index++;
+		if (cl == NULL)
 		{
 			TANGO_LOG_DEBUG << "Nome classe " << (*data_in)[0] << " non trovato. " << endl;
 			return ret;
 		}
-		t_tango_class& classe_trovata = *(*(it));
 
 		sscanf((*data_in)[index],"%6u",&n_properties); index++;
-		for (unsigned int i=0; i< n_properties; i++)
+		for (unsigned int i=0; i< n_properties && index < data_in->length(); i++)
 		{
-			std::vector<t_property*>::iterator prop_it;
-			prop_it = find_if(classe_trovata.properties.begin(), classe_trovata.properties.end(), hasName<t_property>(string((*data_in)[index])));
-			if (prop_it != classe_trovata.properties.end())
-			{
-				/* we found a  property */
-				index++;
-				t_property& prop = (*(*prop_it));
-				sscanf((*data_in)[index],"%6d",&n_values); index++;
-				prop.value.resize(n_values);
-				for(int j = 0; j< n_values; j++)
-				{
-					prop.value[j] = (*data_in)[index]; index++;
-					//db_data[i] >> prop.value;
-				}
-			}
-			else
-			{
-				/* it is a new property */
-				t_property* temp_property = new t_property;
-				temp_property->name = (*data_in)[index]; index++;
-				sscanf((*data_in)[index],"%6d",&n_values); index++;
-				for(int j = 0; j < n_values; j++)
-				{
-					temp_property->value.push_back(string((*data_in)[index])); index++;
-				}
-				classe_trovata.properties.push_back(temp_property);
-				if (index >= data_in->length())
-				{
-					write_file();
-					return ret;
-				}
-			}
-
+			if (put_property(cl->properties, cl->property_index, *data_in, index) == true)
+				set_modified(cl);
 		}
 	}
 
@@ -1768,21 +1825,18 @@ CORBA::Any*   FileDatabase :: DbDeleteClassProperty(CORBA::Any& send)
 //	for(unsigned int i = 0; i < (*data_in).length(); i++)
 //		TANGO_LOG << "(*data_in)[" << i << "] = " << (*data_in)[i] << endl;
 
-	std::vector<t_tango_class*>::iterator it;
-	it = find_if(m_server.classes.begin(), m_server.classes.end(), hasName<t_tango_class>(string((*data_in)[0])));
+	t_tango_class* cl = search_class(m_server, (*data_in)[0].in());
 
-	if (it != m_server.classes.end())
+	if (cl != NULL)
 	{
 		for(unsigned int i = 1; i < (*data_in).length(); i++)
 		{
-			t_tango_class& classe_trovata = *(*(it));
-			std::vector<t_property*>::iterator itp;
-			itp = find_if(classe_trovata.properties.begin(), classe_trovata.properties.end(), hasName<t_property>(string((*data_in)[i])));
-
-			if (itp != classe_trovata.properties.end())
+			t_property* prop = search_index(cl->property_index, (*data_in)[i].in());
+			if (prop != NULL)
 			{
-				//TANGO_LOG << "found " << (*itp)->name << endl;
-				classe_trovata.properties.erase(itp, itp+1);
+				//TANGO_LOG << "found " << prop->name << endl;
+				remove_property(cl->properties, cl->property_index, prop);
+				set_modified(cl);
 			}
 		}
 	}
@@ -1804,66 +1858,19 @@ CORBA::Any*   FileDatabase :: DbGetClassAttributeProperty(CORBA::Any& send)
 
 	send >>= data_in;
 
-	int index = 0;
-	data_out->length(2);
-	(*data_out)[0] = Tango::string_dup((*data_in)[0]); index++;
-	auto num_attr = data_in->length() - 1;
-	(*data_out)[1] = to_corba_string(num_attr); index++;
-
-	std::vector<t_tango_class*>::iterator it;
-	it = find_if(m_server.classes.begin(), m_server.classes.end(), hasName<t_tango_class>(string((*data_in)[0])));
-	if (it == m_server.classes.end())
+	t_tango_class* cl = search_class(m_server, (*data_in)[0].in());
+	vector<t_attribute_property*> attrs;
+	if (cl == NULL)
 	{
 		TANGO_LOG_DEBUG << "Nome classe " << (*data_in)[0] << " non trovato. " << endl;
-		data_out->length(index + num_attr*2);
-		for(unsigned int j = 0; j < num_attr; j++)
-		{
-			(*data_out)[index] =  Tango::string_dup((*data_in)[j+1]); index++;
-			(*data_out)[index] =  Tango::string_dup("0"); index++;
-		}
-		(*any_ptr) <<= data_out;
-
-		return any_ptr;
 	}
-	t_tango_class& classe_trovata = *(*(it));
-
-	for(unsigned int k =0; k < num_attr; k++)
+	else
 	{
-		data_out->length(index+2);
-		(*data_out)[index] = Tango::string_dup((*data_in)[k+1]); index++;
-		(*data_out)[index] = Tango::string_dup("0"); index++;
-
-		for(unsigned int j = 0; j < classe_trovata.attribute_properties.size(); j++)
-		{
-		 if (equalsIgnoreCase(classe_trovata.attribute_properties[j]->attribute_name, (*data_in)[k+1].in()))
-		 {
-			 auto num_prop = classe_trovata.attribute_properties[j]->properties.size();
-			 //data_out->length(index + 2*num_prop);
-			 (*data_out)[index-1] = to_corba_string(num_prop);
-			 for (unsigned int l = 0; l < classe_trovata.attribute_properties[j]->properties.size(); l++)
-			 {
-					data_out->length(index + 1 + 1 + classe_trovata.attribute_properties[j]->properties[l]->value.size());
-					(*data_out)[index] = Tango::string_dup(classe_trovata.attribute_properties[j]->properties[l]->name.c_str());index++;
-
-					auto num_attr_prop = classe_trovata.attribute_properties[j]->properties[l]->value.size();
-					(*data_out)[index] = to_corba_string(num_attr_prop); index++;
-				 //(*data_out)[index] = Tango::string_dup(classe_trovata.attribute_properties[j]->properties[l]->name.c_str());index++;
-				 //string temp_value("");
-				 if (classe_trovata.attribute_properties[j]->properties[l]->value.size() > 0)
-				 {
-					 //temp_value += classe_trovata.attribute_properties[j]->properties[l]->value[0];
-					 for (unsigned int m = 0; m < classe_trovata.attribute_properties[j]->properties[l]->value.size(); m++)
-					 {
-						 (*data_out)[index] = Tango::string_dup(classe_trovata.attribute_properties[j]->properties[l]->value[m].c_str()); index++;
-						 //temp_value +=  "\n" + classe_trovata.attribute_properties[j]->properties[l]->value[m];
-					 }
-				 }
-			 }
-
-		 }
+		for (unsigned int k = 1; k < data_in->length(); k++)
+			attrs.push_back(search_class_attr_prop(cl, (*data_in)[k].in()));
+	}
 
-		}
-	 }
+	get_attribute_property(*data_in, attrs, *data_out);
 
 	//for(unsigned int i = 0; i < data_out->length(); i++)
 	//	TANGO_LOG << "data_out[" << i << "] = " << (*data_out)[i] << endl;
@@ -1880,87 +1887,38 @@ CORBA::Any*  FileDatabase :: DbPutClassAttributeProperty(CORBA::Any& send)
 	const Tango::DevVarStringArray* data_in = NULL;
 	unsigned int num_attr  = 0;
 	unsigned int num_prop = 0;
-	unsigned int num_vals = 0;
 	unsigned int index = 0;
 
 	TANGO_LOG_DEBUG << "FILEDATABASE: entering DbPutClassAttributeProperty" << endl;
 
 	send >>= data_in;
 
-	std::vector<t_tango_class*>::iterator it;
-	it = find_if(m_server.classes.begin(), m_server.classes.end(), hasName<t_tango_class>(string((*data_in)[index])));index++;
-	if (it == m_server.classes.end())
+	t_tango_class* cl = search_class(m_server, (*data_in)[index].in());index++;
+	if (cl == NULL)
 	{
 		TANGO_LOG_DEBUG << "FILEDATABASE:  DbPutClassAttributeProperty class " << string((*data_in)[0]) << " not found." << endl;
 	} else {
 		sscanf((*data_in)[index],"%6u",&num_attr); index++;
-		t_tango_class& classe_trovata = *(*(it));
-		t_attribute_property* temp_attribute_property;
-		std::vector<t_attribute_property*>::iterator attr_prop_it;
 
-		for(unsigned int j = 0; j < num_attr; j++)
+		for(unsigned int j = 0; j < num_attr && index + 1 < data_in->length(); j++)
 		{
 			// search an attribute property for this attribute
-			attr_prop_it = find_if(classe_trovata.attribute_properties.begin(),classe_trovata.attribute_properties.end(), hasAttributeName<t_attribute_property>(string((*data_in)[index])));
-			if (attr_prop_it != classe_trovata.attribute_properties.end())
+			string att_name((*data_in)[index]); index++;
+			t_attribute_property* temp_attribute_property = search_class_attr_prop(cl, att_name);
+			if (temp_attribute_property == NULL)
 			{
-				temp_attribute_property = (*attr_prop_it);
-			} else {
 				// the property is not yet in the file: we add it
 				temp_attribute_property = new t_attribute_property;
-				temp_attribute_property->attribute_name = string((*data_in)[index]);
-				classe_trovata.attribute_properties.push_back(temp_attribute_property);
-
+				temp_attribute_property->attribute_name = att_name;
+				add_to_index(cl->attribute_properties, cl->attribute_index, att_name, temp_attribute_property);
 			}
-			index++;
+
 			sscanf((*data_in)[index],"%6u",&num_prop); index++;
-			for (unsigned int i = 0; i < num_prop; i++)
+			for (unsigned int i = 0; i < num_prop && index < data_in->length(); i++)
 			{
-				bool exist = false;
-				for(unsigned int k = 0; k < temp_attribute_property->properties.size(); k++)
-				{
-		  		if (equalsIgnoreCase(temp_attribute_property->properties[k]->name, (*data_in)[index].in()))
-		  		{
-						index++;
-						temp_attribute_property->properties[k]->value.erase(temp_attribute_property->properties[k]->value.begin(),
-                                                        temp_attribute_property->properties[k]->value.begin()+temp_attribute_property->properties[k]->value.size());
-						sscanf((*data_in)[index],"%6u",&num_vals); index++;
-						for(unsigned int n = 0; n < num_vals; n++)
-						{
-							temp_attribute_property->properties[k]->value.push_back(string((*data_in)[index])); index++;
-						}
-
-						//(*dev_it)->attribute_properties[j]->properties[k]->value.push_back( string((*data_in)[index]) );index++;
-						if (index >= data_in->length())
-						{
-							write_file();
-							return ret;
-						}
-						exist = true;
-					}
-				}
-				if ( !exist )
-				{
-					t_property* new_prop = new t_property;
-					new_prop->name = (*data_in)[index]; index++;
-
-					sscanf((*data_in)[index],"%6u",&num_vals); index++;
-					for(unsigned int n = 0; n < num_vals; n++)
-					{
-						new_prop->value.push_back(string((*data_in)[index])); index++;
-					}
-
-					//makeStringArray( string((*data_in)[index]), new_prop->value);index++;
-					//new_prop->value.push_back( string((*data_in)[index]) );index++;
-					temp_attribute_property->properties.push_back(new_prop);
-					if (index >= data_in->length())
-					{
-							write_file();
-							return ret;
-					}
-				}
-
-			 }
+				if (put_property(temp_attribute_property->properties, temp_attribute_property->property_index, *data_in, index) == true)
+					set_modified(cl);
+			}
 		}
 
 	}
@@ -1993,22 +1951,16 @@ CORBA::Any*  FileDatabase :: DbGetDeviceList(CORBA::Any& send)
 	{
 		if ( equalsIgnoreCase((*data_in)[0].in(), m_server.name + "/" + m_server.instance_name))
 		{
-			unsigned int i;
-			for(i = 0; i < m_server.classes.size(); i++)
+			t_tango_class* cl = search_class(m_server, (*data_in)[1].in());
+			if (cl != NULL)
 			{
-				//if ( strcmp((*data_in)[1], m_server.classes[i]->name.c_str()) == 0 )
-				if ( equalsIgnoreCase ((*data_in)[1].in(), m_server.classes[i]->name))
+				data_out->length(cl->devices.size());
+				for (unsigned int j = 0; j < cl->devices.size(); j++)
 				{
-					data_out->length(m_server.classes[i]->devices.size());
-					for (unsigned int j = 0; j < m_server.classes[i]->devices.size(); j++)
-					{
-						(*data_out)[j] = Tango::string_dup( m_server.classes[i]->devices[j]->name.c_str() );
-					}
-					break;
+					(*data_out)[j] = Tango::string_dup( cl->devices[j]->name.c_str() );
 				}
 			}
-
-			if (i == m_server.classes.size())
+			else
 			{
 				delete any_ptr;
 				delete data_out;
@@ -2367,23 +2319,25 @@ void FileDatabase::write_event_channel_ior(const string &ior_string)
 // Do we already have this info in file?
 //
 
-	unsigned int i;
-
-	for(i = 0; i < m_server.classes.size(); i++)
+	t_tango_class *cl = search_class(m_server, NOTIFD_CHANNEL);
+	if (cl != NULL)
 	{
-		if ( equalsIgnoreCase (NOTIFD_CHANNEL, m_server.classes[i]->name))
-		{
 
 //
 // Yes, we have it, simply replace the old IOR by the new one (as device name!)
 //
 
-			m_server.classes[i]->devices[0]->name = ior_string;
-			break;
+		t_device *ps_dev = cl->devices[0];
+		set_modified(ps_dev);
+		if (search_device(m_server, ps_dev->name) == ps_dev)
+		{
+			m_server.device_index.erase(lower_name(ps_dev->name));
+			m_server.device_index.emplace(lower_name(ior_string), ps_dev);
 		}
+		ps_dev->name = ior_string;
+		set_modified(ps_dev);
 	}
-
-	if (i == m_server.classes.size())
+	else
 	{
 
 //
@@ -2396,7 +2350,8 @@ void FileDatabase::write_event_channel_ior(const string &ior_string)
 		tg_cl->devices.push_back(ps_dev);
 		tg_cl->name = NOTIFD_CHANNEL;
 
-		m_server.classes.push_back(tg_cl);
+		add_to_index(m_server.classes, m_server.class_index, tg_cl->name, tg_cl);
+		set_modified(tg_cl);
 	}
 }
 
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <tango.h>
 
 namespace Tango{
@@ -38,6 +39,10 @@ namespace Tango{
 #define _TG_ARROW   7
 
 
+//
+// The containers below keep their elements in a vector (file order) and in an index (lower case name) used for
+// the look-ups. Both must be updated together
+//
 
 class t_property
 {
@@ -53,6 +58,7 @@ class t_attribute_property
 public:
 	std::string 				attribute_name;
 	std::vector<t_property*> 	properties;
+	std::unordered_map<std::string,t_property*>	property_index;
 };
 
 
@@ -62,6 +68,8 @@ public:
 	std::string 						name;
 	std::vector<t_property*> 			properties;
 	std::vector<t_attribute_property*> 	attribute_properties;
+	std::unordered_map<std::string,t_property*>				property_index;
+	std::unordered_map<std::string,t_attribute_property*>	attribute_index;
 };
 
 class t_tango_class
@@ -73,6 +81,8 @@ public:
 	std::vector<t_device*> 				devices;
 	std::vector<t_property*> 			properties;
 	std::vector<t_attribute_property*> 	attribute_properties;
+	std::unordered_map<std::string,t_property*>				property_index;
+	std::unordered_map<std::string,t_attribute_property*>	attribute_index;
 };
 
 
@@ -83,6 +93,8 @@ public:
 	std::string 					instance_name;
 	std::vector<t_tango_class*> 	classes;
 	std::vector<t_device*> 			devices;
+	std::unordered_map<std::string,t_tango_class*>	class_index;
+	std::unordered_map<std::string,t_device*>		device_index;
 };
 
 template <class T> class hasName
@@ -175,17 +187,23 @@ private:
 	std::string 			filename;
 	t_server 		m_server;
 
-	void read_char(std::ifstream& f);
+	void read_char();
 	int class_lex(const std::string& word);
-	void  jump_line(std::ifstream& f);
-	void  jump_space(std::ifstream& f);
-	std::string read_word(std::ifstream& f);
+	void  jump_line();
+	void  jump_space();
+	std::string read_word();
 	void CHECK_LEX(int lt,int le);
-	std::vector<std::string> parse_resource_value(std::ifstream& f);
+	std::vector<std::string> parse_resource_value();
 
-	std::string read_full_word(std::ifstream& f);
+	std::string read_full_word();
 	void escape_double_quote(std::string &);
 
+	void set_modified(t_tango_class *);
+	void set_modified(t_device *);
+	void write_header(std::ostream &);
+	void write_class(std::ostream &,t_tango_class *);
+	void write_device(std::ostream &,t_device *);
+
 
 	static const char* lexical_word_null;
 	static const char* lexical_word_number;
@@ -202,9 +220,15 @@ private:
   	int 			StartLine;
   	char 			CurrentChar;
   	char 			NextChar;
+  	const char		*read_ptr;				// Next character to read in the mapped file
+  	const char		*read_end;
 
   	std::string 			word;
 
+	bool			modified;				// Something changed since the file was last written
+	std::unordered_map<std::string,std::string>	class_write_cache;	// Text of the unchanged class sections
+	std::unordered_map<std::string,std::string>	dev_write_cache;	// Text of the unchanged device sections
+
     std::unique_ptr<FileDatabaseExt> ext;
 };
 
@@ -2844,6 +2844,144 @@ void Connection::cancel_all_polling_asynch_request()
 	pasyn_ctr = 0;
 }
 
+//-----------------------------------------------------------------------------
+//
+// method : 		Connection::batch_command_inout()
+//
+// description : 	Add a command to the device batch. The command is
+//					executed by the next execute_batch() call
+//
+// argin(s) :		cmd_name : The command name
+//					argin : The command input data
+//
+//-----------------------------------------------------------------------------
+
+void Connection::batch_command_inout(const std::string &cmd_name)
+{
+	DeviceData argin;
+	batch_command_inout(cmd_name,argin);
+}
+
+void Connection::batch_command_inout(const std::string &cmd_name,const DeviceData &argin)
+{
+	BatchRequest req;
+	req.write = false;
+	req.name = cmd_name;
+	req.argin = argin;
+	ext->batch.push_back(std::move(req));
+}
+
+//-----------------------------------------------------------------------------
+//
+// method : 		Connection::add_batch_request()
+//
+// description : 	Add an attribute writing to the device batch
+//
+// argin(s) :		da : The attribute name and value
+//
+//-----------------------------------------------------------------------------
+
+void Connection::add_batch_request(const DeviceAttribute &da)
+{
+	BatchRequest req;
+	req.write = true;
+	req.name = const_cast<DeviceAttribute &>(da).get_name();
+	req.attr = da;
+	ext->batch.push_back(std::move(req));
+}
+
+//-----------------------------------------------------------------------------
+//
+// method : 		Connection::batch_write_asynch() and Connection::batch_write_reply()
+//
+// description : 	Send an attribute writing request and wait for its reply.
+//					Writing attribute is only possible on a device. These
+//					methods are re-defined in the DeviceProxy class
+//
+//-----------------------------------------------------------------------------
+
+long Connection::batch_write_asynch(const DeviceAttribute &)
+{
+	TANGO_THROW_EXCEPTION(API_NotSupported, "Attribute writing is not supported in the batch of this connection");
+}
+
+void Connection::batch_write_reply(long)
+{
+	TANGO_THROW_EXCEPTION(API_NotSupported, "Attribute writing is not supported in the batch of this connection");
+}
+
+//-----------------------------------------------------------------------------
+//
+// method : 		Connection::execute_batch()
+//
+// description : 	Execute all the operations of the device batch.
+//					All the requests are sent (using the asynchronous
+//					polling model) before waiting for the first reply.
+//					Therefore, the network round trips of the operations
+//					are overlapped. An error in one operation is stored in
+//					its reply and does not stop the batch
+//
+// return :		The operation replies, in the batch order
+//
+//-----------------------------------------------------------------------------
+
+std::vector<BatchReply> Connection::execute_batch()
+{
+	std::vector<BatchRequest> batch;
+	batch.swap(ext->batch);
+
+	std::vector<BatchReply> replies;
+	replies.reserve(batch.size());
+	std::vector<long> ids(batch.size(),-1);
+
+//
+// Send all the requests
+//
+
+	for (size_t loop = 0;loop < batch.size();loop++)
+	{
+		replies.push_back(BatchReply(batch[loop].name));
+		try
+		{
+			if (batch[loop].write == true)
+				ids[loop] = batch_write_asynch(batch[loop].attr);
+			else
+				ids[loop] = command_inout_asynch(batch[loop].name,batch[loop].argin);
+		}
+		catch (DevFailed &e)
+		{
+			replies[loop].set_error(e.errors);
+		}
+	}
+
+//
+// Wait for the replies
+//
+
+	for (size_t loop = 0;loop < batch.size();loop++)
+	{
+		if (ids[loop] == -1)
+			continue;
+
+		try
+		{
+			if (batch[loop].write == true)
+				batch_write_reply(ids[loop]);
+			else
+			{
+				DeviceData dd = command_inout_reply(ids[loop],0);
+				replies[loop].set_data(dd);
+			}
+		}
+		catch (DevFailed &e)
+		{
+			replies[loop].set_error(e.errors);
+		}
+	}
+
+	return replies;
+}
+
 //-----------------------------------------------------------------------------
 //
 // method : 		Connection::omni420_xxx
@@ -35,6 +35,7 @@
 #include <attribute.h>
 #include <classattribute.h>
 #include <eventsupplier.h>
+#include <replyarena.h>
 #include <tango_clock.h>
 
 #include <functional>
@@ -2944,6 +2945,34 @@ void Attribute::delete_seq()
 }
 
 
+//+-------------------------------------------------------------------------
+//
+// method : 		Attribute::get_reply_buffer
+//
+// description : 	Get the buffer used to send a spectrum/image read value
+//					and its associated write value from the reply arena
+//					of the ORB thread executing the read request
+//
+// in :	elt_size : The data element size
+//
+// out : nb_elt : The buffer size (in elements)
+//
+// This method returns nullptr if the thread does not have any active arena
+//
+//--------------------------------------------------------------------------
+
+void *Attribute::get_reply_buffer(size_t elt_size,size_t &nb_elt)
+{
+	ReplyArena *arena = ReplyArena::get_active();
+	if (arena == nullptr)
+		return nullptr;
+
+	WAttribute &assoc_att = get_att_device()->get_device_attr()->get_w_attr_by_ind(assoc_ind);
+	nb_elt = data_size + assoc_att.get_write_value_length();
+
+	return arena->allocate(nb_elt * elt_size);
+}
+
 //+-------------------------------------------------------------------------
 //
 // method : 		Attribute::add_write_value
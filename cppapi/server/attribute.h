@@ -1154,6 +1154,12 @@ public:
         template<class T>
         T (&get_tmp_storage())[2];
 
+/**
+ * Returns a buffer taken from the ORB thread reply arena, large enough for the read value followed by the
+ * associated write value, or nullptr if there is no active arena. nb_elt is set to the buffer size (in elements)
+ */
+        void *get_reply_buffer(size_t elt_size,size_t &nb_elt);
+
 /**
  * Set internal attribute value, date and quality factor (for Tango::DevShort attribute data type).
  *
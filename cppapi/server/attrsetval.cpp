@@ -93,7 +93,13 @@ void Attribute::set_value(Tango::EncodedAttribute *attr)
 		TANGO_THROW_EXCEPTION(API_AttrOptProp, o.str());
 	}
 
+//
+// The encoded buffer is not copied. The reply, the event and the polling buffer refer to it
+// (with exclusion, it stays locked until they have used it)
+//
+
 	set_value(f,d,size,false);
+	attr->inc_set_value_count();
 
 	if (attr->get_exclusion() == true)
 	{
@@ -219,9 +219,19 @@ inline void Attribute::set_value(T *enum_ptr,long x,long y,bool release)
 			}
 			else
 			{
-				value.sh_seq = new Tango::DevVarShortArray(data_size);
-				value.sh_seq->length(data_size);
-				::memcpy(value.sh_seq->get_buffer(false),loc_enum_ptr,data_size * sizeof(Tango::DevShort));
+				size_t nb_elt = 0;
+				Tango::DevShort *arena_buf = static_cast<Tango::DevShort *>(get_reply_buffer(sizeof(Tango::DevShort),nb_elt));
+				if (arena_buf != nullptr)
+				{
+					::memcpy(arena_buf,loc_enum_ptr,data_size * sizeof(Tango::DevShort));
+					value.sh_seq = new Tango::DevVarShortArray(nb_elt,data_size,arena_buf,false);
+				}
+				else
+				{
+					value.sh_seq = new Tango::DevVarShortArray(data_size);
+					value.sh_seq->length(data_size);
+					::memcpy(value.sh_seq->get_buffer(false),loc_enum_ptr,data_size * sizeof(Tango::DevShort));
+				}
 			}
 		}
 		else
@@ -330,9 +340,19 @@ inline void Attribute::set_value(T* p_data, long x, long y, bool release)
 			else
 			{
                                 auto* tmp = get_value_storage<ArrayType>();
-		                *tmp = new ArrayType(data_size);
-				(*tmp)->length(data_size);
-				::memcpy((*tmp)->get_buffer(false),p_data,data_size * sizeof(T));
+				size_t nb_elt = 0;
+				T *arena_buf = static_cast<T *>(get_reply_buffer(sizeof(T),nb_elt));
+				if (arena_buf != nullptr)
+				{
+					::memcpy(arena_buf,p_data,data_size * sizeof(T));
+					*tmp = new ArrayType(nb_elt,data_size,arena_buf,false);
+				}
+				else
+				{
+					*tmp = new ArrayType(data_size);
+					(*tmp)->length(data_size);
+					::memcpy((*tmp)->get_buffer(false),p_data,data_size * sizeof(T));
+				}
 				if (release == true)
 					delete [] p_data;
 			}
@@ -521,9 +541,19 @@ inline void Attribute::set_value(Tango::DevShort *p_data,long x,long y,bool rele
 			}
 			else
 			{
-				value.sh_seq = new Tango::DevVarShortArray(data_size);
-				value.sh_seq->length(data_size);
-				::memcpy(value.sh_seq->get_buffer(false),p_data,data_size * sizeof(Tango::DevShort));
+				size_t nb_elt = 0;
+				Tango::DevShort *arena_buf = static_cast<Tango::DevShort *>(get_reply_buffer(sizeof(Tango::DevShort),nb_elt));
+				if (arena_buf != nullptr)
+				{
+					::memcpy(arena_buf,p_data,data_size * sizeof(Tango::DevShort));
+					value.sh_seq = new Tango::DevVarShortArray(nb_elt,data_size,arena_buf,false);
+				}
+				else
+				{
+					value.sh_seq = new Tango::DevVarShortArray(data_size);
+					value.sh_seq->length(data_size);
+					::memcpy(value.sh_seq->get_buffer(false),p_data,data_size * sizeof(Tango::DevShort));
+				}
 				if (release == true)
 					delete [] p_data;
 			}
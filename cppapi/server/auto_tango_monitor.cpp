@@ -36,6 +36,8 @@
 namespace Tango
 {
 
+    TangoMonitorStats TangoMonitor::stats;
+
     //---------------------------------------------------------------------------------------------------------------
     //
     // class :
@@ -58,6 +58,8 @@
 namespace Tango
 {
 
+BlackBoxStats BlackBox::stats;
+
 //
 // The per thread data storage key (The client IP is stored in thread specific storage)
 // defined in utils.cpp
@@ -986,6 +988,35 @@ void BlackBox::insert_attr_wr_nl(const Tango::AttributeValueList_4 &att_list,
 
 void BlackBox::inc_indexes()
 {
+    switch (box[insert_elt].op_type)
+    {
+    case Op_Command_inout:
+    case Op_Command_inout_2:
+    case Op_Command_inout_4:
+        stats.nb_commands.fetch_add(1,std::memory_order_relaxed);
+        break;
+
+    case Op_Read_Attr:
+    case Op_Read_Attr_2:
+    case Op_Read_Attr_3:
+    case Op_Read_Attr_4:
+    case Op_Read_Attr_5:
+        stats.nb_reads.fetch_add(1,std::memory_order_relaxed);
+        break;
+
+    case Op_Write_Attr:
+    case Op_Write_Attr_3:
+    case Op_Write_Attr_4:
+    case Op_Write_Read_Attributes_4:
+    case Op_Write_Read_Attributes_5:
+        stats.nb_writes.fetch_add(1,std::memory_order_relaxed);
+        break;
+
+    default:
+        stats.nb_others.fetch_add(1,std::memory_order_relaxed);
+        break;
+    }
+
     insert_elt++;
     if (insert_elt == max_elt)
     {
@@ -40,6 +40,7 @@
 #endif
 #include <time.h>
 #include <omniORB4/omniInterceptors.h>
+#include <atomic>
 #include <chrono>
 
 namespace Tango
@@ -176,6 +177,23 @@ inline bool operator==(const BlackBoxElt &,const BlackBoxElt &)
 	return true;
 }
 
+//==================================================================================================================
+//
+//			The BlackBoxStats structure
+//
+// description :
+//		Process wide counters of the requests stored in the devices black box
+//
+//==================================================================================================================
+
+struct BlackBoxStats
+{
+	std::atomic<DevULong64>	nb_commands;		// Number of command_inout requests
+	std::atomic<DevULong64>	nb_reads;			// Number of read_attributes requests
+	std::atomic<DevULong64>	nb_writes;			// Number of write_attributes (and write_read) requests
+	std::atomic<DevULong64>	nb_others;			// Number of other requests (ping, info, history, config,...)
+};
+
 //==================================================================================================================
 //
 //			The BlackBox class
@@ -210,6 +228,8 @@ public:
 
 	Tango::DevVarStringArray *read(long);
 
+	TANGO_IMP static BlackBoxStats	stats;
+
 private:
 
 	void inc_indexes();
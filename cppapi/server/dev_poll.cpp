@@ -77,9 +77,11 @@ void DeviceImpl::init_poll_no_db()
     }
 
 //
-// A loop for all device commands
+// A loop for all device commands. The class command list is shared with the other class devices (which may be under
+// construction)
 //
 
+    omni_mutex_lock guard(device_class->get_dev_create_mutex());
     std::vector<Command *> &cmd_list = device_class->get_command_list();
     std::vector<Command *>::iterator ite_cmd;
     for (ite_cmd = cmd_list.begin();ite_cmd != cmd_list.end();++ite_cmd)
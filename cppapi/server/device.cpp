@@ -488,6 +488,12 @@ void DeviceImpl::real_ctor()
     std::transform(device_name_lower.begin(), device_name_lower.end(),
               device_name_lower.begin(), ::tolower);
 
+//
+// Record the contention profile of the device serialization monitor
+//
+
+    only_one.enable_profile();
+
 //
 //  Write the device name into the per thread data for sub device diagnostics
 //
@@ -495,6 +501,13 @@ void DeviceImpl::real_ctor()
     Tango::Util *tg = Tango::Util::instance();
     tg->get_sub_dev_diag().set_associated_device(device_name_lower);
 
+//
+// The class devices may be created by several threads (see DeviceClass::create_devices). Serialize the part
+// of the construction which uses class wide (and process wide) data
+//
+
+    omni_mutex_lock guard(device_class->get_dev_create_mutex());
+
 //
 // Create the DbDevice object
 //
@@ -3369,6 +3382,19 @@ void DeviceImpl::add_attribute(Tango::Attr *new_attr)
 
     AutoTangoMonitor sync(this, true);
 
+//
+// The class attribute list is shared with the other class devices (which may be under construction). The class
+// mutex is released before starting the polling and the device interface change event (they take other locks)
+//
+
+    std::string attr_name(new_attr->get_name());
+    bool ev_client = false;
+    bool need_free = false;
+    long per = 0;
+
+    {
+    omni_mutex_lock guard(device_class->get_dev_create_mutex());
+
     std::vector<Tango::Attr *> &attr_list = device_class->get_class_attr()->get_attr_list();
     long old_attr_nb = attr_list.size();
 
@@ -3378,7 +3404,6 @@ void DeviceImpl::add_attribute(Tango::Attr *new_attr)
 // Therefore, all devices created after this attribute addition will also have this attribute.
 //
 
-    std::string &attr_name = new_attr->get_name();
     bool already_there = true;
     bool throw_ex = false;
     try
@@ -3423,7 +3448,7 @@ void DeviceImpl::add_attribute(Tango::Attr *new_attr)
 //
 
     ZmqEventSupplier *event_supplier_zmq = Util::instance()->get_zmq_event_supplier();
-    bool ev_client = event_supplier_zmq->any_dev_intr_client(this);
+    ev_client = event_supplier_zmq->any_dev_intr_client(this);
 
     if (idl_version >= MIN_IDL_DEV_INTR && is_intr_change_ev_enable() == true)
     {
@@ -3446,7 +3471,6 @@ void DeviceImpl::add_attribute(Tango::Attr *new_attr)
 // Add this attribute in the MultiClassAttribute attr_list vector if it does not already exist
 //
 
-    bool need_free = false;
     long i;
 
     for (i = 0; i < old_attr_nb; i++)
@@ -3505,6 +3529,9 @@ void DeviceImpl::add_attribute(Tango::Attr *new_attr)
         dev_attr->add_attribute(device_name, device_class, i);
     }
 
+    per = new_attr->get_polling_period();
+    }
+
 //
 // Eventually start or update device interface change event thread
 //
@@ -3515,7 +3542,6 @@ void DeviceImpl::add_attribute(Tango::Attr *new_attr)
 // If attribute has to be polled (set by Pogo), start polling now
 //
 
-    long per = new_attr->get_polling_period();
     if ((!is_attribute_polled(attr_name)) && (per != 0))
     {
         poll_attribute(attr_name, per);
@@ -3598,6 +3624,7 @@ void DeviceImpl::remove_attribute(Tango::Attr *rem_attr, bool free_it, bool clea
 
             if (th_running == false)
             {
+                omni_mutex_lock guard(device_class->get_dev_create_mutex());
                 devintr_shared.interface.get_interface(this);
             }
         }
@@ -3689,9 +3716,14 @@ void DeviceImpl::remove_attribute(Tango::Attr *rem_attr, bool free_it, bool clea
 
 //
 // Remove attribute in MultiClassAttribute in case there is only one device in the class or it is the last device
-// in this class with this attribute
+// in this class with this attribute. The class attribute list is shared with the other class devices (which may be
+// under construction) but the class mutex is not held while stopping the polling or sending the device interface
+// change event
 //
 
+    {
+    omni_mutex_lock guard(device_class->get_dev_create_mutex());
+
     bool update_idx = false;
     unsigned long nb_dev = device_class->get_device_list().size();
 
@@ -3741,6 +3773,7 @@ void DeviceImpl::remove_attribute(Tango::Attr *rem_attr, bool free_it, bool clea
     {
         delete rem_attr;
     }
+    }
 
 //
 // Eventually start or update device interface change event thread
@@ -3771,8 +3804,12 @@ void DeviceImpl::remove_attribute(const std::string &rem_attr_name, bool free_it
 
     try
     {
-        Attr &att = device_class->get_class_attr()->get_attr(rem_attr_name);
-        remove_attribute(&att, free_it, clean_db);
+        Attr *att;
+        {
+            omni_mutex_lock guard(device_class->get_dev_create_mutex());
+            att = &device_class->get_class_attr()->get_attr(rem_attr_name);
+        }
+        remove_attribute(att, free_it, clean_db);
     }
     catch (Tango::DevFailed &e)
     {
@@ -3809,6 +3846,16 @@ void DeviceImpl::add_command(Tango::Command *new_cmd, bool device_level)
 
     AutoTangoMonitor sync(this, true);
 
+//
+// The class command list is shared with the other class devices (which may be under construction). The class
+// mutex is released before the device interface change event is sent
+//
+
+    bool ev_client = false;
+
+    {
+    omni_mutex_lock guard(device_class->get_dev_create_mutex());
+
 //
 // Check that this command is not already defined for this device. If it is already there, immediately returns.
 //
@@ -3875,7 +3922,7 @@ void DeviceImpl::add_command(Tango::Command *new_cmd, bool device_level)
 //
 
     ZmqEventSupplier *event_supplier_zmq = Util::instance()->get_zmq_event_supplier();
-    bool ev_client = event_supplier_zmq->any_dev_intr_client(this);
+    ev_client = event_supplier_zmq->any_dev_intr_client(this);
 
     if (idl_version >= MIN_IDL_DEV_INTR && is_intr_change_ev_enable() == true)
     {
@@ -3908,6 +3955,7 @@ void DeviceImpl::add_command(Tango::Command *new_cmd, bool device_level)
         std::vector<Tango::Command *> &dev_cmd_list = get_local_command_list();
         dev_cmd_list.push_back(new_cmd);
     }
+    }
 
 //
 // Eventually start or update device interface change event thread
@@ -3942,7 +3990,9 @@ void DeviceImpl::remove_command(Tango::Command *rem_cmd, bool free_it, bool clea
     AutoTangoMonitor sync(this, true);
 
 //
-// Check that the class or the device support this command
+// Check that the class or the device support this command. The class command list is shared with the other class
+// devices (which may be under construction) but the class mutex is not held while stopping the polling or sending
+// the device interface change event
 //
 
     std::string &cmd_name = rem_cmd->get_name();
@@ -3950,6 +4000,7 @@ void DeviceImpl::remove_command(Tango::Command *rem_cmd, bool free_it, bool clea
 
     try
     {
+        omni_mutex_lock guard(device_class->get_dev_create_mutex());
         device_class->get_cmd_by_name(cmd_name);
     }
     catch (Tango::DevFailed &)
@@ -3990,6 +4041,7 @@ void DeviceImpl::remove_command(Tango::Command *rem_cmd, bool free_it, bool clea
 
             if (th_running == false)
             {
+                omni_mutex_lock guard(device_class->get_dev_create_mutex());
                 devintr_shared.interface.get_interface(this);
             }
         }
@@ -4062,6 +4114,7 @@ void DeviceImpl::remove_command(Tango::Command *rem_cmd, bool free_it, bool clea
 
     if (device_cmd == false)
     {
+        omni_mutex_lock guard(device_class->get_dev_create_mutex());
         device_class->remove_command(cmd_name_low);
     }
     else
@@ -4110,8 +4163,12 @@ void DeviceImpl::remove_command(const std::string &rem_cmd_name, bool free_it, b
 
     try
     {
-        Command &cmd = device_class->get_cmd_by_name(rem_cmd_name);
-        remove_command(&cmd, free_it, clean_db);
+        Command *cmd;
+        {
+            omni_mutex_lock guard(device_class->get_dev_create_mutex());
+            cmd = &device_class->get_cmd_by_name(rem_cmd_name);
+        }
+        remove_command(cmd, free_it, clean_db);
     }
     catch (Tango::DevFailed &)
     {
@@ -4312,16 +4369,19 @@ void DeviceImpl::init_cmd_poll_period()
         poll_data.push_back(Tango::DbDatum("polled_cmd"));
 
 //
-// get the command list
+// get the command list. It is shared with the other class devices which may be created or may add/remove commands
+// at the same time, take the class mutex while walking it (but not during the database call)
 //
 
+        unsigned long added_cmd = 0;
+        {
+        omni_mutex_lock guard(device_class->get_dev_create_mutex());
         std::vector<Command *> &cmd_list = device_class->get_command_list();
 
 //
 // loop over the command list
 //
 
-        unsigned long added_cmd = 0;
         unsigned long i;
         for (i = 0; i < cmd_list.size(); i++)
         {
@@ -4385,6 +4445,7 @@ void DeviceImpl::init_cmd_poll_period()
                 added_cmd++;
             }
         }
+        }
 
 //
 // only write to the database when a polling need to be added
@@ -38,6 +38,7 @@
 
 #include <tango.h>
 #include <device_2.h>
+#include <latency.h>
 #include <tango_clock.h>
 #include <new>
 
@@ -192,6 +193,7 @@ CORBA::Any *Device_2Impl::command_inout_2(const char *in_cmd,
 //
 
 			check_command_exists(cmd_str);
+			AutoLatency::resolve(cmd_str);
 
 			long vers = get_dev_idl_version();
 
@@ -469,7 +469,10 @@ void Device_3Impl::read_attributes_no_except(const Tango::DevVarStringArray& nam
 			}
 
 			if (tmp_idx.empty() == false)
+			{
+				TraceSpan trace_span(TRACE_READ_HARDWARE,device_name.c_str());
 				read_attr_hardware(tmp_idx);
+			}
 		}
 
 //
@@ -60,6 +60,7 @@
 
 #include <device_4.h>
 #include <eventsupplier.h>
+#include <latency.h>
 #include <device_3.tpp>
 
 
@@ -447,6 +448,14 @@ CORBA::Any *Device_4Impl::command_inout_4(const char *in_cmd,
 {
 	TANGO_LOG_DEBUG << "Device_4Impl::command_inout_4 arrived, source = " << source << ", command = " << in_cmd << std::endl;
 
+//
+// The command duration is recorded under the command name only once the command has been found (see
+// AutoLatency::resolve())
+//
+
+	AutoLatency latency_scope(this,LAT_COMMAND,in_cmd);
+	TraceSpan trace_span(TRACE_DEVICE_METHOD,device_name.c_str(),in_cmd);
+
 //
 // Record operation request in black box
 //
@@ -753,6 +762,8 @@ Tango::AttributeValueList_4* Device_4Impl::read_attributes_4(const Tango::DevVar
 void Device_4Impl::write_attributes_4(const Tango::AttributeValueList_4 & values,
 									  const Tango::ClntIdent &cl_id)
 {
+	AutoLatency latency_scope(this,LAT_WRITE,values);
+	TraceSpan trace_span(TRACE_DEVICE_METHOD,device_name.c_str(),"write_attributes");
 	AutoTangoMonitor sync(this,true);
 	TANGO_LOG_DEBUG << "Device_4Impl::write_attributes_4 arrived" << std::endl;
 
@@ -55,6 +55,8 @@
 
 #include <device_5.h>
 #include <eventsupplier.h>
+#include <replyarena.h>
+#include <latency.h>
 #include <device_3.tpp>
 
 
@@ -121,6 +123,9 @@ Tango::AttributeValueList_5* Device_5Impl::read_attributes_5(const Tango::DevVar
 {
 	TANGO_LOG_DEBUG << "Device_5Impl::read_attributes_5 arrived for dev " << get_name() << ", att[0] = " << names[0] << std::endl;
 
+	AutoLatency latency_scope(this,LAT_READ,names);
+	TraceSpan trace_span(TRACE_DEVICE_METHOD,device_name.c_str(),"read_attributes");
+
 //
 // Record operation request in black box
 //
@@ -129,6 +134,12 @@ Tango::AttributeValueList_5* Device_5Impl::read_attributes_5(const Tango::DevVar
 		blackbox_ptr->insert_attr(names,cl_id,5,source);
 	store_in_bb = true;
 
+//
+// Use the ORB thread reply arena for the reply data (if this is a request received from the network)
+//
+
+	AutoReplyArena arena_scope;
+
 //
 // Build a sequence with the names of the attribute to be read. This is necessary in case of the "AllAttr" shortcut is
 // used. If all attributes are wanted, build this list
@@ -33,6 +33,8 @@
 #include <tango.h>
 #include <new>
 #include <iterator>
+#include <atomic>
+#include <exception>
 
 #include <basiccommand.h>
 #include <blackbox.h>
@@ -44,6 +46,7 @@
 #include <apiexcept.h>
 
 #include <logging.h>
+#include <latency.h>
 
 namespace Tango
 {
@@ -61,6 +64,60 @@ bool less_than_pipe (Pipe *a,Pipe *b)
 		return false;
 }
 
+//
+// Thread used to create devices in parallel during the startup sequence. The device name list indexes are
+// distributed to the threads through an atomic counter.
+//
+
+namespace
+{
+
+struct DevCreateData
+{
+	DevCreateData(const Tango::DevVarStringArray *ptr,const std::function<DeviceImpl *(const char *)> &func)
+	:devlist_ptr(ptr),creator(func),devs(ptr->length(),NULL),errors(ptr->length()),next(0),first_error(ptr->length()) {}
+
+	const Tango::DevVarStringArray					*devlist_ptr;
+	const std::function<DeviceImpl *(const char *)>	&creator;
+	std::vector<DeviceImpl *>						devs;
+	std::vector<std::exception_ptr>					errors;
+	std::atomic<unsigned long>						next;			// Next index to be created
+	std::atomic<unsigned long>						first_error;	// Lowest index which failed (list length if none)
+};
+
+class DevCreateThread: public omni_thread
+{
+public:
+	DevCreateThread(DevCreateData &d):data(d) {}
+
+	void start() {start_undetached();}
+	void *run_undetached(void *)
+	{
+		is_tango_library_thread = true;
+
+		unsigned long nb_dev = data.devlist_ptr->length();
+		for (unsigned long i = data.next++;i < nb_dev && i < data.first_error;i = data.next++)
+		{
+			try
+			{
+				data.devs[i] = data.creator((*data.devlist_ptr)[i].in());
+			}
+			catch (...)
+			{
+				data.errors[i] = std::current_exception();
+				unsigned long first = data.first_error;
+				while (i < first && data.first_error.compare_exchange_weak(first,i) == false);
+			}
+		}
+		return NULL;
+	}
+
+private:
+	DevCreateData	&data;
+};
+
+} // End of anonymous namespace
+
 //+------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -75,6 +132,12 @@ DeviceClass::DeviceClass(const std::string &s):name(s),ext(new DeviceClassExt),
 		only_one("class"),default_cmd(NULL),device_factory_done(false)
 {
 
+//
+// Record the contention profile of the class serialization monitor
+//
+
+	only_one.enable_profile();
+
 //
 // Create the associated DbClass object
 //
@@ -1067,6 +1130,106 @@ void DeviceClass::export_device(DeviceImpl *dev,const char *corba_obj_name)
 	TANGO_LOG_DEBUG << "Leaving DeviceClass::export_device method()" << std::endl;
 }
 
+//+----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DeviceClass::create_devices()
+//
+// description :
+//		This method creates the class devices and stores them in the device list. When the process is
+//		configured to use several threads to create its devices, the devices are created in parallel.
+//		Each device constructor takes the class device creation mutex for its class wide part
+//		(see DeviceImpl::real_ctor())
+//
+// argument :
+// 		in :
+//			- devlist_ptr : The device name list
+//			- creator : The function creating one device
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void DeviceClass::create_devices(const Tango::DevVarStringArray *devlist_ptr,const std::function<DeviceImpl *(const char *)> &creator)
+{
+	unsigned long nb_dev = devlist_ptr->length();
+	unsigned long nb_th = Util::instance()->get_startup_threads();
+	if (nb_th > nb_dev)
+		nb_th = nb_dev;
+
+	TANGO_LOG_DEBUG << "DeviceClass::create_devices(): " << nb_dev << " device(s), " << nb_th << " thread(s)" << std::endl;
+
+//
+// Classical case: Create devices one after the other
+//
+
+	if (nb_th <= 1)
+	{
+		for (unsigned long i = 0;i < nb_dev;i++)
+		{
+			TANGO_LOG_DEBUG << "Device name : " << (*devlist_ptr)[i].in() << std::endl;
+			device_list.push_back(creator((*devlist_ptr)[i].in()));
+		}
+		return;
+	}
+
+//
+// Start the threads and wait for them (the thread objects are deleted by join)
+//
+
+	DevCreateData data(devlist_ptr,creator);
+	std::vector<DevCreateThread *> threads;
+
+	for (unsigned long i = 0;i < nb_th;i++)
+	{
+		threads.push_back(new DevCreateThread(data));
+		threads.back()->start();
+	}
+
+	for (unsigned long i = 0;i < nb_th;i++)
+		threads[i]->join(NULL);
+
+//
+// Store the devices in the device list (name list order). In case of error, keep the devices created before the
+// failing one (as in the classical case), delete the others and re-throw the error
+//
+
+	unsigned long first_error = data.first_error;
+	for (unsigned long i = 0;i < nb_dev;i++)
+	{
+		if (i < first_error)
+			device_list.push_back(data.devs[i]);
+		else
+			delete data.devs[i];
+	}
+
+	if (first_error != nb_dev)
+		std::rethrow_exception(data.errors[first_error]);
+}
+
+//+----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DeviceClass::export_devices()
+//
+// description :
+//		This method exports all devices of the device list starting at a given index
+//
+// argument :
+// 		in :
+//			- first : Index of the first device to be exported
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void DeviceClass::export_devices(size_t first)
+{
+	for (size_t i = first;i < device_list.size();i++)
+	{
+		if ((Tango::Util::_UseDb == true) && (Tango::Util::_FileDb == false))
+			export_device(device_list[i]);
+		else
+			export_device(device_list[i],device_list[i]->get_name().c_str());
+	}
+}
+
 
 //+------------------------------------------------------------------------------------------------------------------
 //
@@ -1121,6 +1284,7 @@ CORBA::Any *DeviceClass::command_handler(DeviceImpl *device,const std::string &c
 
 	if (found == true)
 	{
+		AutoLatency::resolve(command_lower);
 
 //
 // Call the always executed method
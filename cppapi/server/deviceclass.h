@@ -35,6 +35,8 @@
 #ifndef _DEVICECLASS_H
 #define _DEVICECLASS_H
 
+#include <functional>
+
 namespace Tango
 {
 
@@ -383,6 +385,54 @@ protected:
  */
 	void export_device(DeviceImpl *dev,const char* corba_dev_name = "Unused");
 
+/**
+ * Create the class devices.
+ *
+ * This method can be used in the device_factory() method instead of the classical loop on the device
+ * name list. The devices are created by the function given as parameter and stored in the device list
+ * (in the device name list order). If the process has been configured to use several threads to create
+ * its devices (see Util::set_startup_threads()), the devices are created in parallel. In this case,
+ * the device constructors (and therefore the init_device() methods) must not modify data shared with
+ * the other devices without protection. The DeviceImpl methods adding or removing attributes and commands
+ * (add_attribute(), remove_attribute(), add_command() and remove_command()) protect the class lists and
+ * may be used.
+ * The devices are not exported by this method (see export_devices()). On error, export the devices kept
+ * in the device list before re-throwing the exception:
+ * @code
+ * size_t first = device_list.size();
+ * try
+ * {
+ *     create_devices(devlist_ptr,[this](const char *name) -> Tango::DeviceImpl * {return new MyDev(this,name);});
+ * }
+ * catch (...)
+ * {
+ *     export_devices(first);
+ *     throw;
+ * }
+ * export_devices(first);
+ * @endcode
+ *
+ * @param devlist_ptr The device name list
+ * @param creator The function creating one device from its name
+ * @exception DevFailed If one of the device creation failed. The devices created before the failing one
+ * are kept in the device list.
+ * Click <a href="https://tango-controls.readthedocs.io/en/latest/development/advanced/IDL.html#exceptions">here</a> to read
+ * <b>DevFailed</b> exception specification
+ */
+	void create_devices(const Tango::DevVarStringArray *devlist_ptr,const std::function<DeviceImpl *(const char *)> &creator);
+
+/**
+ * Export the class devices.
+ *
+ * Export (see export_device()) all the devices of the device list starting at the given index
+ *
+ * @param first Index in the device list of the first device to be exported
+ * @exception DevFailed If the command sent to the database failed.
+ * Click <a href="https://tango-controls.readthedocs.io/en/latest/development/advanced/IDL.html#exceptions">here</a> to read
+ * <b>DevFailed</b> exception specification
+ */
+	void export_devices(size_t first = 0);
+
 /**
  * Set a Tango classs default command
  *
@@ -478,6 +528,8 @@ public:
 
 	void create_device_pipe(DeviceClass *,DeviceImpl *);
 	std::vector<Pipe *> &get_pipe_list() {return pipe_list;}
+	omni_mutex &get_dev_create_mutex() {return dev_create_mutex;}
+	TangoMonitor &get_class_monitor() {return only_one;}
 
 protected:
 /// @privatesection
@@ -514,6 +566,7 @@ private:
     std::string              svn_tag;
     std::string              svn_location;
     bool                device_factory_done;
+    omni_mutex          dev_create_mutex;       // Serialize the device construction class wide part
 };
 
 
@@ -34,6 +34,9 @@
 #include <tango.h>
 #include <eventsupplier.h>
 #include <devintr.h>
+#include <replyarena.h>
+#include <latency.h>
+#include <monitorprofile.h>
 
 #include <new>
 #include <algorithm>
@@ -137,6 +140,20 @@ void DServer::init_device()
 
 	bool class_factory_done = false;
 	unsigned long i = 0;
+
+//
+// Startup phases timing (printed when the trace level is not 0)
+//
+
+	std::vector<std::pair<std::string,double> > phase_timings;
+	std::chrono::steady_clock::time_point phase_start = std::chrono::steady_clock::now();
+	auto end_phase = [&](const std::string &phase)
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		phase_timings.push_back(make_pair(phase,std::chrono::duration<double,std::milli>(now - phase_start).count()));
+		phase_start = now;
+	};
+
 	try
 	{
 
@@ -160,6 +177,7 @@ void DServer::init_device()
 		else
 			class_factory_func_ptr(this);
 		class_factory_done = true;
+		end_phase("Class factory");
 
 		if (class_list.empty() == false)
 		{
@@ -210,6 +228,7 @@ void DServer::init_device()
 				MultiClassAttribute *c_attr = class_list[i]->get_class_attr();
 				class_list[i]->attribute_factory(c_attr->get_attr_list());
 				c_attr->init_class_attribute(class_list[i]->get_name());
+				end_phase(class_list[i]->get_name() + ": Command and attribute factories");
 
 //
 // Retrieve device(s) name list from the database. No need to implement a retry here (in case of db server restart)
@@ -241,6 +260,7 @@ void DServer::init_device()
 						dev_list[l] = na.value_string[l].c_str();
 
 					TANGO_LOG_DEBUG << dev_list.length() << " device(s) defined" << std::endl;
+					end_phase(class_list[i]->get_name() + ": Device list");
 
 //
 // Create all device(s) - Device creation creates device pipe(s)
@@ -252,12 +272,14 @@ void DServer::init_device()
 						class_list[i]->device_factory(&dev_list);
 					}
                     class_list[i]->set_device_factory_done(true);
+					end_phase(class_list[i]->get_name() + ": Device factory (" + std::to_string(nb_dev) + " device(s))");
 
 //
 // Set value for each device with memorized writable attr. This is necessary only if db is used
 //
 
 					class_list[i]->set_memorized_values(true);
+					end_phase(class_list[i]->get_name() + ": Memorized attributes");
 
 //
 // Check attribute configuration
@@ -276,6 +298,7 @@ void DServer::init_device()
 //
 
 					class_list[i]->release_devices_mon();
+					end_phase(class_list[i]->get_name() + ": Attribute configuration check");
 				}
 				else
 				{
@@ -316,6 +339,7 @@ void DServer::init_device()
 						class_list[i]->device_factory(dev_list_nodb);
 					}
 					class_list[i]->set_device_factory_done(true);
+					end_phase(class_list[i]->get_name() + ": Device factory (" + std::to_string(dev_list_nodb->length()) + " device(s))");
 
 					delete dev_list_nodb;
 				}
@@ -326,6 +350,17 @@ void DServer::init_device()
 		if (man_state == PortableServer::POAManager::DISCARDING)
 			manager->activate();
 
+		if (Tango::Util::_tracelevel >= 1)
+		{
+			double total = 0.0;
+			TANGO_LOG << "Startup sequence timing:" << std::endl;
+			for (size_t loop = 0;loop < phase_timings.size();loop++)
+			{
+				TANGO_LOG << "\t" << phase_timings[loop].first << ": " << phase_timings[loop].second << " ms" << std::endl;
+				total = total + phase_timings[loop].second;
+			}
+			TANGO_LOG << "\tTotal: " << total << " ms" << std::endl;
+		}
 	}
 	catch (std::bad_alloc &)
 	{
@@ -455,6 +490,33 @@ void DServer::server_init_hook()
     }
 }
 
+//+----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DServer::dev_status
+//
+// description :
+//		Get the admin device status. A message is added when the database configuration has changed since the
+//		DS cache snapshot used at startup was taken
+//
+// returns :
+//		The device status
+//
+//-----------------------------------------------------------------------------------------------------------------
+
+Tango::ConstDevString DServer::dev_status()
+{
+	NoSyncModelTangoMonitor mon(this);
+	Tango::ConstDevString status = DeviceImpl::dev_status();
+	if (Tango::Util::instance()->is_db_cache_snapshot_stale() == false)
+		return status;
+
+	snapshot_status = status;
+	snapshot_status = snapshot_status + "\nThe database configuration has changed since the startup snapshot was taken";
+	snapshot_status = snapshot_status + "\nRestart the server to use the new configuration";
+	return snapshot_status.c_str();
+}
+
 //+----------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -691,6 +753,226 @@ Tango::DevVarStringArray *DServer::query_sub_device()
 	return(ret);
 }
 
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DServer::query_reply_arena()
+//
+// description :
+//		command to read the counters of the ORB threads reply arenas (memory used to build the read_attributes
+//		replies)
+//
+// returns :
+//		The counters (one "name = value" string per counter) in a sequence of strings
+//
+//------------------------------------------------------------------------------------------------------------------
+
+Tango::DevVarStringArray *DServer::query_reply_arena()
+{
+	NoSyncModelTangoMonitor mon(this);
+
+	TANGO_LOG_DEBUG << "In query_reply_arena command" << std::endl;
+
+	ReplyArenaStats stats;
+	ReplyArena::get_stats(stats);
+
+	std::vector<std::string> vs;
+	vs.push_back("Arenas = " + std::to_string(stats.nb_arenas));
+	vs.push_back("Requests = " + std::to_string(stats.nb_requests));
+	vs.push_back("Arena allocations = " + std::to_string(stats.nb_alloc));
+	vs.push_back("Heap allocations = " + std::to_string(stats.nb_heap_alloc));
+	vs.push_back("Reserved bytes = " + std::to_string(stats.reserved_bytes));
+
+	Tango::DevVarStringArray *ret = new Tango::DevVarStringArray(vs.size());
+	ret->length(vs.size());
+	for (size_t k = 0;k < vs.size();k++)
+		(*ret)[k] = Tango::string_dup(vs[k].c_str());
+
+	return(ret);
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DServer::query_latency()
+//
+// description :
+//		command to read the request latency histograms recorded for the devices of this process
+//
+// returns :
+//		For each device attribute/command and request type, 3 strings (device name, request type, attribute/command
+//		name) and 8 doubles (count, min, mean, 50th, 90th, 99th and 99.9th percentiles, max). Durations are in us
+//
+//------------------------------------------------------------------------------------------------------------------
+
+Tango::DevVarDoubleStringArray *DServer::query_latency()
+{
+	NoSyncModelTangoMonitor mon(this);
+
+	TANGO_LOG_DEBUG << "In query_latency command" << std::endl;
+
+	std::vector<LatencyEntry> entries;
+	LatencyRecorder::get_entries(entries);
+
+	Tango::DevVarDoubleStringArray *ret = new Tango::DevVarDoubleStringArray();
+	ret->svalue.length(entries.size() * 3);
+	ret->dvalue.length(entries.size() * 8);
+
+	for (size_t k = 0;k < entries.size();k++)
+	{
+		const LatencyEntry &entry = entries[k];
+		const LatencyHistogram &histo = entry.histo;
+
+		ret->svalue[k * 3] = Tango::string_dup(entry.device.c_str());
+		ret->svalue[(k * 3) + 1] = Tango::string_dup(LatencyRecorder::get_type_name(entry.type));
+		ret->svalue[(k * 3) + 2] = Tango::string_dup(entry.name.c_str());
+
+		ret->dvalue[k * 8] = (double)histo.get_count();
+		ret->dvalue[(k * 8) + 1] = (double)histo.get_min();
+		ret->dvalue[(k * 8) + 2] = histo.get_mean();
+		ret->dvalue[(k * 8) + 3] = histo.get_percentile(50.0);
+		ret->dvalue[(k * 8) + 4] = histo.get_percentile(90.0);
+		ret->dvalue[(k * 8) + 5] = histo.get_percentile(99.0);
+		ret->dvalue[(k * 8) + 6] = histo.get_percentile(99.9);
+		ret->dvalue[(k * 8) + 7] = (double)histo.get_max();
+	}
+
+	return(ret);
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DServer::query_monitor_profile()
+//
+// description :
+//		command to read the contention profile of the serialization monitors: the process monitor, the class
+//		monitors and the device monitors (this device included)
+//
+// returns :
+//		For each monitor, 4 strings (monitor type, object name, request type and object name of the longest hold)
+//		and 10 doubles (acquisitions, waits, timeouts, wait mean, 99th percentile and max, hold mean, 50th and 99th
+//		percentiles and max). Durations are in us
+//
+//------------------------------------------------------------------------------------------------------------------
+
+Tango::DevVarDoubleStringArray *DServer::query_monitor_profile()
+{
+	NoSyncModelTangoMonitor mon(this);
+
+	TANGO_LOG_DEBUG << "In query_monitor_profile command" << std::endl;
+
+	Tango::Util *tg = Tango::Util::instance();
+
+	std::vector<std::pair<const char *,std::string> > names;
+	std::vector<MonitorProfileData> profiles;
+	MonitorProfileData data;
+
+	if (tg->get_process_monitor().get_profile(data) == true)
+	{
+		names.push_back({"process",tg->get_ds_name()});
+		profiles.push_back(data);
+	}
+
+	if (get_dev_monitor().get_profile(data) == true)
+	{
+		names.push_back({"device",get_name()});
+		profiles.push_back(data);
+	}
+
+	for (auto cl : class_list)
+	{
+		if (cl->get_class_monitor().get_profile(data) == true)
+		{
+			names.push_back({"class",cl->get_name()});
+			profiles.push_back(data);
+		}
+
+		for (auto dev : cl->get_device_list())
+		{
+			if (dev->get_dev_monitor().get_profile(data) == true)
+			{
+				names.push_back({"device",dev->get_name()});
+				profiles.push_back(data);
+			}
+		}
+	}
+
+	Tango::DevVarDoubleStringArray *ret = new Tango::DevVarDoubleStringArray();
+	ret->svalue.length(profiles.size() * 4);
+	ret->dvalue.length(profiles.size() * 10);
+
+	for (size_t k = 0;k < profiles.size();k++)
+	{
+		const MonitorProfileData &prof = profiles[k];
+
+		ret->svalue[k * 4] = Tango::string_dup(names[k].first);
+		ret->svalue[(k * 4) + 1] = Tango::string_dup(names[k].second.c_str());
+		ret->svalue[(k * 4) + 2] = Tango::string_dup(prof.holder_type.c_str());
+		ret->svalue[(k * 4) + 3] = Tango::string_dup(prof.holder_name.c_str());
+
+		ret->dvalue[k * 10] = (double)prof.nb_acquires;
+		ret->dvalue[(k * 10) + 1] = (double)prof.nb_waits;
+		ret->dvalue[(k * 10) + 2] = (double)prof.nb_timeouts;
+		ret->dvalue[(k * 10) + 3] = prof.wait.get_mean();
+		ret->dvalue[(k * 10) + 4] = prof.wait.get_percentile(99.0);
+		ret->dvalue[(k * 10) + 5] = (double)prof.wait.get_max();
+		ret->dvalue[(k * 10) + 6] = prof.hold.get_mean();
+		ret->dvalue[(k * 10) + 7] = prof.hold.get_percentile(50.0);
+		ret->dvalue[(k * 10) + 8] = prof.hold.get_percentile(99.0);
+		ret->dvalue[(k * 10) + 9] = (double)prof.hold.get_max();
+	}
+
+	return(ret);
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DServer::read_latency()
+//
+// description :
+//		Read method of the Latency attribute. One string per device attribute/command and request type with
+//		"key=value" fields. Durations are in us
+//
+// args :
+//		in :
+//			- att : The attribute
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void DServer::read_latency(Attribute &att)
+{
+	TANGO_LOG_DEBUG << "In read_latency method" << std::endl;
+
+	std::vector<LatencyEntry> entries;
+	LatencyRecorder::get_entries(entries);
+
+	size_t nb = std::min(entries.size(),(size_t)att.get_max_dim_x());
+
+	latency_str.clear();
+	latency_ptr.clear();
+	for (size_t k = 0;k < nb;k++)
+	{
+		const LatencyEntry &entry = entries[k];
+		const LatencyHistogram &histo = entry.histo;
+
+		std::stringstream ss;
+		ss << "device=" << entry.device << " type=" << LatencyRecorder::get_type_name(entry.type);
+		ss << " name=" << entry.name << " count=" << histo.get_count();
+		ss << " min=" << histo.get_min() << " mean=" << histo.get_mean();
+		ss << " p50=" << histo.get_percentile(50.0) << " p90=" << histo.get_percentile(90.0);
+		ss << " p99=" << histo.get_percentile(99.0) << " p999=" << histo.get_percentile(99.9);
+		ss << " max=" << histo.get_max();
+		latency_str.push_back(ss.str());
+	}
+
+	for (auto &str : latency_str)
+		latency_ptr.push_back(const_cast<char *>(str.c_str()));
+
+	att.set_value(latency_ptr.data(),latency_ptr.size());
+}
+
 
 
 //+-----------------------------------------------------------------------------------------------------------------
@@ -73,6 +73,10 @@ public :
 	Tango::DevVarStringArray *query_class();
 	Tango::DevVarStringArray *query_device();
 	Tango::DevVarStringArray *query_sub_device();
+	Tango::DevVarStringArray *query_reply_arena();
+	Tango::DevVarDoubleStringArray *query_latency();
+	Tango::DevVarDoubleStringArray *query_monitor_profile();
+	void read_latency(Attribute &);
 	void kill();
 	void restart(const std::string &);
 	void restart_server();
@@ -97,6 +101,7 @@ public :
 
 	Tango::DevLong event_subscription_change(const Tango::DevVarStringArray *);
 	Tango::DevVarLongStringArray *zmq_event_subscription_change(const Tango::DevVarStringArray *);
+	Tango::DevVarLongStringArray *zmq_event_subscription_changes(const Tango::DevVarStringArray *);
 	void event_confirm_subscription(const Tango::DevVarStringArray *);
 
 	void delete_devices();
@@ -104,6 +109,7 @@ public :
 	void add_logging_target (const Tango::DevVarStringArray *argin);
 	void remove_logging_target (const Tango::DevVarStringArray *argin);
 	Tango::DevVarStringArray* get_logging_target (const std::string& dev_name);
+	Tango::DevVarLongStringArray* get_logging_dropped (const std::string& dev_name);
 	void set_logging_level (const Tango::DevVarLongStringArray *argin);
 	Tango::DevVarLongStringArray* get_logging_level (const Tango::DevVarStringArray *argin);
 	void stop_logging (void);
@@ -119,6 +125,7 @@ public :
 
 	std::vector<DeviceClass *> &get_class_list() {return class_list;}
 	virtual void init_device();
+	virtual Tango::ConstDevString dev_status();
 
 	virtual void server_init_hook();
 
@@ -199,6 +206,11 @@ private:
 
 	bool            polling_bef_9_def;
 	bool            polling_bef_9;
+
+	std::vector<std::string>	latency_str;
+	std::vector<DevString>		latency_ptr;
+
+	std::string					snapshot_status;
 };
 
 class KillThread: public omni_thread
@@ -319,6 +319,205 @@ CORBA::Any *DevQuerySubDeviceCmd::execute(DeviceImpl *device,TANGO_UNUSED(const
 	return(out_any);
 }
 
+//+----------------------------------------------------------------------------
+//
+// method : 		QueryReplyArenaCmd::QueryReplyArenaCmd()
+//
+// description : 	constructor for the QueryReplyArena command of the
+//					DServer.
+//
+//-----------------------------------------------------------------------------
+
+QueryReplyArenaCmd::QueryReplyArenaCmd(const char *name,
+			       	   Tango::CmdArgType in,
+			       	   Tango::CmdArgType out,
+				   const char *out_desc):Command(name,in,out)
+{
+	set_out_type_desc(out_desc);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		QueryReplyArenaCmd::execute(string &s)
+//
+// description : 	method to trigger the execution of the "QueryReplyArena"
+//					command
+//
+//-----------------------------------------------------------------------------
+
+CORBA::Any *QueryReplyArenaCmd::execute(DeviceImpl *device,TANGO_UNUSED(const CORBA::Any &in_any))
+{
+
+	TANGO_LOG_DEBUG << "QueryReplyArenaCmd::execute(): arrived" << std::endl;
+
+//
+// call DServer method which implements this command
+//
+
+	Tango::DevVarStringArray *ret = (static_cast<DServer *>(device))->query_reply_arena();
+
+//
+// return data to the caller
+//
+	CORBA::Any *out_any = NULL;
+	try
+	{
+		out_any = new CORBA::Any();
+	}
+	catch (std::bad_alloc &)
+	{
+		TANGO_LOG_DEBUG << "Bad allocation while in QueryReplyArenaCmd::execute()" << std::endl;
+		delete ret;
+		TANGO_THROW_EXCEPTION(API_MemoryAllocation, "Can't allocate memory in server");
+	}
+	(*out_any) <<= ret;
+
+	TANGO_LOG_DEBUG << "Leaving QueryReplyArenaCmd::execute()" << std::endl;
+	return(out_any);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		QueryLatencyCmd::QueryLatencyCmd()
+//
+// description : 	constructor for the QueryLatency command of the
+//					DServer.
+//
+//-----------------------------------------------------------------------------
+
+QueryLatencyCmd::QueryLatencyCmd(const char *name,
+			       Tango::CmdArgType in,
+			       Tango::CmdArgType out,
+			       const char *out_desc):Command(name,in,out)
+{
+	set_out_type_desc(out_desc);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		QueryLatencyCmd::execute(string &s)
+//
+// description : 	method to trigger the execution of the "QueryLatency"
+//					command
+//
+//-----------------------------------------------------------------------------
+
+CORBA::Any *QueryLatencyCmd::execute(DeviceImpl *device,TANGO_UNUSED(const CORBA::Any &in_any))
+{
+
+	TANGO_LOG_DEBUG << "QueryLatencyCmd::execute(): arrived" << std::endl;
+
+//
+// call DServer method which implements this command
+//
+
+	Tango::DevVarDoubleStringArray *ret = (static_cast<DServer *>(device))->query_latency();
+
+//
+// return data to the caller
+//
+	CORBA::Any *out_any = NULL;
+	try
+	{
+		out_any = new CORBA::Any();
+	}
+	catch (std::bad_alloc &)
+	{
+		TANGO_LOG_DEBUG << "Bad allocation while in QueryLatencyCmd::execute()" << std::endl;
+		delete ret;
+		TANGO_THROW_EXCEPTION(API_MemoryAllocation, "Can't allocate memory in server");
+	}
+	(*out_any) <<= ret;
+
+	TANGO_LOG_DEBUG << "Leaving QueryLatencyCmd::execute()" << std::endl;
+	return(out_any);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		QueryMonitorProfileCmd::QueryMonitorProfileCmd()
+//
+// description : 	constructor for the QueryMonitorProfile command of the
+//					DServer.
+//
+//-----------------------------------------------------------------------------
+
+QueryMonitorProfileCmd::QueryMonitorProfileCmd(const char *name,
+			       Tango::CmdArgType in,
+			       Tango::CmdArgType out,
+			       const char *out_desc):Command(name,in,out)
+{
+	set_out_type_desc(out_desc);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		QueryMonitorProfileCmd::execute(string &s)
+//
+// description : 	method to trigger the execution of the
+//					"QueryMonitorProfile" command
+//
+//-----------------------------------------------------------------------------
+
+CORBA::Any *QueryMonitorProfileCmd::execute(DeviceImpl *device,TANGO_UNUSED(const CORBA::Any &in_any))
+{
+
+	TANGO_LOG_DEBUG << "QueryMonitorProfileCmd::execute(): arrived" << std::endl;
+
+//
+// call DServer method which implements this command
+//
+
+	Tango::DevVarDoubleStringArray *ret = (static_cast<DServer *>(device))->query_monitor_profile();
+
+//
+// return data to the caller
+//
+	CORBA::Any *out_any = NULL;
+	try
+	{
+		out_any = new CORBA::Any();
+	}
+	catch (std::bad_alloc &)
+	{
+		TANGO_LOG_DEBUG << "Bad allocation while in QueryMonitorProfileCmd::execute()" << std::endl;
+		delete ret;
+		TANGO_THROW_EXCEPTION(API_MemoryAllocation, "Can't allocate memory in server");
+	}
+	(*out_any) <<= ret;
+
+	TANGO_LOG_DEBUG << "Leaving QueryMonitorProfileCmd::execute()" << std::endl;
+	return(out_any);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		LatencyAttr::LatencyAttr()
+//
+// description : 	constructor for the Latency attribute of the DServer
+//
+//-----------------------------------------------------------------------------
+
+LatencyAttr::LatencyAttr():SpectrumAttr("Latency",Tango::DEV_STRING,Tango::READ,LATENCY_MAX_READ_ENTRIES)
+{
+	Tango::UserDefaultAttrProp def_prop;
+	def_prop.set_description("Request latency percentiles (us) per device attribute/command and request type");
+	set_default_properties(def_prop);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		LatencyAttr::read()
+//
+// description : 	method to read the "Latency" attribute
+//
+//-----------------------------------------------------------------------------
+
+void LatencyAttr::read(DeviceImpl *device,Attribute &att)
+{
+	(static_cast<DServer *>(device))->read_latency(att);
+}
+
 
 
 
@@ -1199,6 +1398,76 @@ CORBA::Any *ZmqEventSubscriptionChangeCmd::execute(Tango::DeviceImpl *device,con
 	return(out_any);
 }
 
+const std::string ZmqEventSubscriptionChangesCmd::in_desc = "Str[0] = dev1 name, Str[1] = att1/pipe1 name, Str[2] = action (\"subscribe\"), "
+"Str[3] = event name, Str[4] = Tango client lib release, Str[5] = dev2 name,...";
+
+const std::string ZmqEventSubscriptionChangesCmd::out_desc = "8 Lg per subscription: Lg[0] = Error flag - Lg[1] = Str number\n"
+"Lg[2] to Lg[7] = ZmqEventSubscriptionChange Lg[0] to Lg[5]\n"
+"Str = ZmqEventSubscriptionChange Str or error(s) reason, desc and origin";
+
+//+----------------------------------------------------------------------------
+//
+// method : 		ZmqEventSubscriptionChangesCmd::ZmqEventSubscriptionChangesCmd()
+//
+// description : 	constructor for the ZmqEventSubscriptionChanges command.
+//
+//-----------------------------------------------------------------------------
+ZmqEventSubscriptionChangesCmd::ZmqEventSubscriptionChangesCmd()
+:Command("ZmqEventSubscriptionChanges",Tango::DEVVAR_STRINGARRAY, Tango::DEVVAR_LONGSTRINGARRAY,
+         ZmqEventSubscriptionChangesCmd::in_desc.c_str(),
+         ZmqEventSubscriptionChangesCmd::out_desc.c_str())
+{
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		ZmqEventSubscriptionChangesCmd::execute()
+//
+// description : 	method to trigger the execution of the command.
+//
+// in : - device : The device on which the command must be excuted
+//		- in_any : The command input data
+//
+// returns : The command output data (packed in the Any object)
+//
+//-----------------------------------------------------------------------------
+CORBA::Any *ZmqEventSubscriptionChangesCmd::execute(Tango::DeviceImpl *device,const CORBA::Any &in_any)
+{
+    TANGO_LOG_DEBUG << "ZmqEventSubscriptionChangesCmd::execute(): arrived" << std::endl;
+
+//
+// Extract the input string array
+//
+
+	const Tango::DevVarStringArray *in_data;
+	extract(in_any,in_data);
+
+//
+// call DServer method which implements this command
+//
+
+	Tango::DevVarLongStringArray *ret = (static_cast<DServer *>(device))->zmq_event_subscription_changes(in_data);
+
+//
+// return to the caller
+//
+
+	CORBA::Any *out_any = NULL;
+	try
+	{
+		out_any = new CORBA::Any();
+	}
+	catch (std::bad_alloc &)
+	{
+		TANGO_LOG_DEBUG << "Bad allocation while in ZmqEventSubscriptionChangesCmd::execute()" << std::endl;
+		TANGO_THROW_EXCEPTION(API_MemoryAllocation, "Can't allocate memory in server");
+	}
+	(*out_any) <<= ret;
+
+	TANGO_LOG_DEBUG << "Leaving ZmqEventSubscriptionChangesCmd::execute()" << std::endl;
+	return(out_any);
+}
+
 //+----------------------------------------------------------------------------
 //
 // method : 		EventConfirmSubscriptionCmd::EventSubscriptionChangeCmd()
@@ -1358,6 +1627,13 @@ DServerClass::DServerClass(const std::string &s):DeviceClass(s)
 
 		sort(get_command_list().begin(),get_command_list().end(),less_than_dserver);
 
+//
+// Add class attribute(s)
+//
+
+		attribute_factory(get_class_attr()->get_attr_list());
+		get_class_attr()->init_class_attribute(get_name());
+
 //
 // Create device name from device server name
 //
@@ -1463,6 +1739,18 @@ void DServerClass::command_factory()
 						     Tango::DEV_VOID,
 						     Tango::DEVVAR_STRINGARRAY,
 						     "Device server sub device(s) list"));
+	command_list.push_back(new QueryReplyArenaCmd("QueryReplyArena",
+						     Tango::DEV_VOID,
+						     Tango::DEVVAR_STRINGARRAY,
+						     "Reply arenas counters"));
+	command_list.push_back(new QueryLatencyCmd("QueryLatency",
+						     Tango::DEV_VOID,
+						     Tango::DEVVAR_DOUBLESTRINGARRAY,
+						     "3 Str and 8 Db per device attribute/command: Str = device, request type, name - Db = count, min, mean, p50, p90, p99, p99.9, max (us)"));
+	command_list.push_back(new QueryMonitorProfileCmd("QueryMonitorProfile",
+						     Tango::DEV_VOID,
+						     Tango::DEVVAR_DOUBLESTRINGARRAY,
+						     "4 Str and 10 Db per monitor: Str = monitor type, name, longest hold request type and name - Db = acquires, waits, timeouts, wait mean, p99, max, hold mean, p50, p99, max (us)"));
 	command_list.push_back(new DevKillCmd("Kill",
 					      Tango::DEV_VOID,
 					      Tango::DEV_VOID));
@@ -1528,6 +1816,12 @@ void DServerClass::command_factory()
 			  			    std::string("Device name"),
 			  			    std::string("Logging target list")));
 
+  	command_list.push_back(new GetLoggingDropped("GetLoggingDropped",
+			       			    Tango::DEV_STRING,
+			  			    Tango::DEVVAR_LONGSTRINGARRAY,
+			  			    std::string("Device name"),
+			  			    std::string("Lg[i]=Dropped log records. Str[i]=Device logging target")));
+
 	command_list.push_back(new SetLoggingLevel("SetLoggingLevel",
 			  			   Tango::DEVVAR_LONGSTRINGARRAY,
 			  			   Tango::DEV_VOID,
@@ -1554,6 +1848,9 @@ void DServerClass::command_factory()
     command_list.push_back(
         new ZmqEventSubscriptionChangeCmd());
 
+    command_list.push_back(
+        new ZmqEventSubscriptionChangesCmd());
+
 	command_list.push_back(new EventConfirmSubscriptionCmd("EventConfirmSubscription",
 							Tango::DEVVAR_STRINGARRAY, Tango::DEV_VOID,
 							"Str[0] = dev1 name, Str[1] = att1 name, Str[2] = event name, Str[3] = dev2 name, Str[4] = att2 name, Str[5] = event name,..."));
@@ -1605,6 +1902,20 @@ void DServerClass::command_factory()
 	}
 }
 
+//+----------------------------------------------------------------------------
+//
+// method : 		DServerClass::attribute_factory
+//
+// description : 	Create the attribute object(s) and store them in the
+//			attribute list
+//
+//-----------------------------------------------------------------------------
+
+void DServerClass::attribute_factory(std::vector<Attr *> &att_list)
+{
+	att_list.push_back(new LatencyAttr());
+}
+
 
 //+----------------------------------------------------------------------------
 //
@@ -174,6 +174,100 @@ public:
 };
 
 
+//=============================================================================
+//
+//			The QueryReplyArenaCmd class
+//
+// description :	Class to implement the QueryReplyArena command. This
+//			command does not take any input argument and returns the
+//			counters of the reply arenas used by the ORB threads
+//
+//=============================================================================
+
+
+class QueryReplyArenaCmd : public Command
+{
+public:
+
+	QueryReplyArenaCmd(const char *cmd_name,
+			   Tango::CmdArgType in,Tango::CmdArgType out,
+			   const char *desc);
+
+	~QueryReplyArenaCmd() {}
+
+	virtual CORBA::Any *execute(DeviceImpl *device, const CORBA::Any &in_any);
+};
+
+//=============================================================================
+//
+//			The QueryLatencyCmd class
+//
+// description :	Class to implement the QueryLatency command. This
+//			command does not take any input argument and returns the
+//			request latency histograms percentiles
+//
+//=============================================================================
+
+
+class QueryLatencyCmd : public Command
+{
+public:
+
+	QueryLatencyCmd(const char *cmd_name,
+			Tango::CmdArgType in,Tango::CmdArgType out,
+			const char *desc);
+
+	~QueryLatencyCmd() {}
+
+	virtual CORBA::Any *execute(DeviceImpl *device, const CORBA::Any &in_any);
+};
+
+//=============================================================================
+//
+//			The QueryMonitorProfileCmd class
+//
+// description :	Class to implement the QueryMonitorProfile command. This
+//			command does not take any input argument and returns the
+//			serialization monitors contention profile
+//
+//=============================================================================
+
+
+class QueryMonitorProfileCmd : public Command
+{
+public:
+
+	QueryMonitorProfileCmd(const char *cmd_name,
+			Tango::CmdArgType in,Tango::CmdArgType out,
+			const char *desc);
+
+	~QueryMonitorProfileCmd() {}
+
+	virtual CORBA::Any *execute(DeviceImpl *device, const CORBA::Any &in_any);
+};
+
+//=============================================================================
+//
+//			The LatencyAttr class
+//
+// description :	Class to implement the Latency attribute. This spectrum
+//			attribute returns one string per device attribute/command
+//			with its request latency histogram percentiles
+//
+//=============================================================================
+
+
+class LatencyAttr : public SpectrumAttr
+{
+public:
+
+	LatencyAttr();
+	~LatencyAttr() {}
+
+	virtual void read(DeviceImpl *device, Attribute &att);
+};
+
+
 //=============================================================================
 //
 //			The DevKillCmd class
@@ -512,6 +606,28 @@ public:
     virtual CORBA::Any *execute(Tango::DeviceImpl *, const CORBA::Any &);
 };
 
+//=============================================================================
+//
+//			The ZmqEventSubscriptionChangesCmd class
+//
+// description :	Class to implement the ZmqEventSubscriptionChanges command.
+//			This command takes a list of subscriptions (5 strings each)
+//			and returns for each of them the ZmqEventSubscriptionChange
+//			command result or the error
+//
+//=============================================================================
+
+class ZmqEventSubscriptionChangesCmd : public Tango::Command
+{
+public:
+    static const std::string in_desc;
+    static const std::string out_desc;
+    ZmqEventSubscriptionChangesCmd();
+    ~ZmqEventSubscriptionChangesCmd(){}
+
+    virtual CORBA::Any *execute(Tango::DeviceImpl *, const CORBA::Any &);
+};
+
 //=============================================================================
 //
 //			The EventConfirmSubscriptionCmd class
@@ -556,6 +672,7 @@ public:
 	~DServerClass() {}
 
 	void command_factory();
+	void attribute_factory(std::vector<Attr *> &att_list) override;
 	void device_factory(const Tango::DevVarStringArray *devlist);
 
 protected:
@@ -129,6 +129,20 @@ Tango::DevVarStringArray* DServer::get_logging_target (const std::string& dev_na
   	return res;
 }
 
+//+----------------------------------------------------------------------------
+//
+// method : DServer::get_logging_dropped
+//
+//-----------------------------------------------------------------------------
+Tango::DevVarLongStringArray* DServer::get_logging_dropped (const std::string& dev_name)
+{
+  	NoSyncModelTangoMonitor mon(this);
+  	TANGO_LOG_DEBUG << "Entering DServer::get_logging_dropped" << std::endl;
+  	DevVarLongStringArray* res = Logging::get_logging_dropped(dev_name);
+  	TANGO_LOG_DEBUG << "Leaving DServer::get_logging_dropped" << std::endl;
+  	return res;
+}
+
 //+----------------------------------------------------------------------------
 //
 // method : DServer::set_logging_level
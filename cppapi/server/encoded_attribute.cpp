@@ -36,6 +36,13 @@
 
 #ifdef TANGO_USE_JPEG
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <vector>
 #endif
 
 using namespace Tango;
@@ -44,7 +51,7 @@ using namespace Tango;
 
 // ----------------------------------------------------------------------------
 
-EncodedAttribute::EncodedAttribute():manage_exclusion(false),ext(nullptr) {
+EncodedAttribute::EncodedAttribute():manage_exclusion(false),ext(new EncodedAttributeExt) {
 
     buffer_array = (unsigned char **)calloc(1,sizeof(unsigned char *));
     buffer_array[0] = NULL;
@@ -54,9 +61,11 @@ EncodedAttribute::EncodedAttribute():manage_exclusion(false),ext(nullptr) {
     mutex_array = NULL;
     index = 0;
     buf_elt_nb = 1;
+    ext->buff_capacity.resize(1,0);
+    ext->codec_format.resize(1);
 }
 
-EncodedAttribute::EncodedAttribute(int si,bool excl):manage_exclusion(excl),ext(nullptr) {
+EncodedAttribute::EncodedAttribute(int si,bool excl):manage_exclusion(excl),ext(new EncodedAttributeExt) {
 
     buffer_array = (unsigned char **)calloc(si,sizeof(unsigned char *));
     buffSize_array = (std::size_t*)calloc(si,sizeof(std::size_t));
@@ -68,6 +77,8 @@ EncodedAttribute::EncodedAttribute(int si,bool excl):manage_exclusion(excl),ext(
     format = NULL;
     index = 0;
     buf_elt_nb = si;
+    ext->buff_capacity.resize(si,0);
+    ext->codec_format.resize(si);
 
     if (manage_exclusion == true)
         mutex_array = new omni_mutex[si];
@@ -88,65 +99,152 @@ EncodedAttribute::~EncodedAttribute() {
 
 // ----------------------------------------------------------------------------
 
-void EncodedAttribute::encode_jpeg_gray8(unsigned char *gray8,int width,int height,double quality) {
+void EncodedAttribute::set_jpeg_threads(int nb_threads) {
 
-    if (manage_exclusion == true)
-        mutex_array[index].lock();
+    if (nb_threads < 1)
+    {
+        TANGO_THROW_EXCEPTION(API_WrongFormat, "The JPEG thread number must be greater than 0");
+    }
+    ext->jpeg_threads = nb_threads;
+}
 
-    SAFE_FREE(buffer_array[index]);
-    buffSize_array[index] = 0;
-    format = (char *)JPEG_GRAY_8;
-    jpeg_encode_gray8(width,height,gray8,quality,&(buffSize_array[index]),&(buffer_array[index]));
-    INC_INDEX()
+int EncodedAttribute::get_jpeg_threads() {
+
+    return ext->jpeg_threads;
 }
 
 // ----------------------------------------------------------------------------
 
-void EncodedAttribute::encode_jpeg_rgb32(unsigned char *rgb32,int width,int height,double quality) {
+int EncodedAttribute::get_buffers_in_use() {
 
+    int nb = 0;
     if (manage_exclusion == true)
-        mutex_array[index].lock();
-
-    SAFE_FREE(buffer_array[index]);
-    buffSize_array[index] = 0;
-    format = (char *)JPEG_RGB;
-    jpeg_encode_rgb32(width,height,rgb32,quality,&(buffSize_array[index]),&(buffer_array[index]));
-    INC_INDEX()
+    {
+        for (int i = 0;i < buf_elt_nb;i++)
+        {
+            if (mutex_array[i].trylock() == 0)
+                nb++;
+            else
+                mutex_array[i].unlock();
+        }
+    }
+    return nb;
 }
 
+// ----------------------------------------------------------------------------
+// Select the buffer used for the next image. With exclusion, a buffer is locked
+// until the reply (event, polling buffer) using it is sent. Take the first free
+// one starting at the circular index and wait only if they are all used.
 // ----------------------------------------------------------------------------
 
-void EncodedAttribute::encode_jpeg_rgb24(unsigned char *rgb24,int width,int height,double quality) {
+void EncodedAttribute::take_buffer() {
 
     if (manage_exclusion == true)
+    {
+        for (int i = 0;i < buf_elt_nb;i++)
+        {
+            int ind = (index + i) % buf_elt_nb;
+            if (mutex_array[ind].trylock() != 0)
+            {
+                index = ind;
+                return;
+            }
+        }
         mutex_array[index].lock();
+    }
+}
+
+void EncodedAttribute::release_buffer() {
+
+    if (manage_exclusion == true)
+        mutex_array[index].unlock();
+}
+
+// ----------------------------------------------------------------------------
+// The buffers only grow: an image smaller than the previous one re-uses the
+// already allocated memory
+// ----------------------------------------------------------------------------
+
+unsigned char *EncodedAttribute::reserve_buffer(std::size_t size) {
+
+    if( buffer_array[index]==NULL || size>ext->buff_capacity[index] ) {
+        SAFE_FREE(buffer_array[index]);
+        buffSize_array[index] = 0;
+        ext->buff_capacity[index] = 0;
+        buffer_array[index] = (unsigned char *)malloc(size);
+        if (buffer_array[index] == NULL)
+        {
+            release_buffer();
+            TANGO_THROW_EXCEPTION(API_MemoryAllocation, "Can't allocate memory for the encoded image");
+        }
+        ext->buff_capacity[index] = size;
+    }
+    buffSize_array[index] = size;
+    return buffer_array[index];
+}
+
+// ----------------------------------------------------------------------------
+
+void EncodedAttribute::jpeg_encode_buffer(JpegEncoder encoder,unsigned char *data,int width,int height,
+        double quality,const char *fmt) {
+
+    take_buffer();
+
+    // The JPEG encoder writes in the pool buffer and replaces it if it is too small
+    unsigned char *prev_buffer = buffer_array[index];
+    std::size_t size = (prev_buffer == NULL) ? 0 : ext->buff_capacity[index];
+    try
+    {
+        (this->*encoder)(width,height,data,quality,&size,&(buffer_array[index]));
+    }
+    catch (...)
+    {
+        if (buffer_array[index] != prev_buffer)
+            ext->buff_capacity[index] = 0;
+        release_buffer();
+        throw;
+    }
 
-    SAFE_FREE(buffer_array[index]);
-    buffSize_array[index] = 0;
-    format = (char *)JPEG_RGB;
-    jpeg_encode_rgb24(width,height,rgb24,quality,&(buffSize_array[index]),&(buffer_array[index]));
+    if (buffer_array[index] != prev_buffer)
+        ext->buff_capacity[index] = size;
+    buffSize_array[index] = size;
+    format = (char *)fmt;
     INC_INDEX()
 }
 
 // ----------------------------------------------------------------------------
 
+void EncodedAttribute::encode_jpeg_gray8(unsigned char *gray8,int width,int height,double quality) {
+
+    jpeg_encode_buffer(&EncodedAttribute::jpeg_encode_gray8,gray8,width,height,quality,JPEG_GRAY_8);
+}
+
+// ----------------------------------------------------------------------------
+
+void EncodedAttribute::encode_jpeg_rgb32(unsigned char *rgb32,int width,int height,double quality) {
+
+    jpeg_encode_buffer(&EncodedAttribute::jpeg_encode_rgb32,rgb32,width,height,quality,JPEG_RGB);
+}
+
+// ----------------------------------------------------------------------------
+
+void EncodedAttribute::encode_jpeg_rgb24(unsigned char *rgb24,int width,int height,double quality) {
+
+    jpeg_encode_buffer(&EncodedAttribute::jpeg_encode_rgb24,rgb24,width,height,quality,JPEG_RGB);
+}
+
+// ----------------------------------------------------------------------------
+
 void EncodedAttribute::encode_gray8(unsigned char *gray8,int width,int height) {
 
     long unsigned int newSize = width*height + 4;
 
-    if (manage_exclusion == true)
-        mutex_array[index].lock();
-
-    if( newSize!=buffSize_array[index] ) {
-        SAFE_FREE(buffer_array[index]);
-        buffer_array[index] = (unsigned char *)malloc(newSize);
-        buffSize_array[index] = newSize;
-    }
+    take_buffer();
+    unsigned char *tmp_ptr = reserve_buffer(newSize);
 
     format = (char *)GRAY_8;
 
     // Store image dimension (big endian)
-    unsigned char *tmp_ptr = buffer_array[index];
     tmp_ptr[0] = (unsigned char)( (width>>8) & 0xFF );
     tmp_ptr[1] = (unsigned char)( width & 0xFF );
     tmp_ptr[2] = (unsigned char)( (height>>8) & 0xFF );
@@ -163,19 +261,12 @@ void EncodedAttribute::encode_gray16(unsigned short *gray16,int width,int height
 
     long unsigned int newSize = width*height*2 + 4;
 
-    if (manage_exclusion == true)
-        mutex_array[index].lock();
-
-    if( newSize!=buffSize_array[index] ) {
-        SAFE_FREE(buffer_array[index]);
-        buffer_array[index] = (unsigned char *)malloc(newSize);
-        buffSize_array[index] = newSize;
-    }
+    take_buffer();
+    unsigned char *tmp_ptr = reserve_buffer(newSize);
 
     format = (char *)GRAY_16;
 
     // Store image dimension (big endian)
-    unsigned char *tmp_ptr = buffer_array[index];
     tmp_ptr[0] = (unsigned char)( (width>>8) & 0xFF );
     tmp_ptr[1] = (unsigned char)( width & 0xFF );
     tmp_ptr[2] = (unsigned char)( (height>>8) & 0xFF );
@@ -200,19 +291,12 @@ void EncodedAttribute::encode_rgb24(unsigned char *rgb24,int width,int height) {
 
     long unsigned int newSize = width*height*3 + 4;
 
-    if (manage_exclusion == true)
-        mutex_array[index].lock();
-
-    if( newSize!=buffSize_array[index] ) {
-        SAFE_FREE(buffer_array[index]);
-        buffer_array[index] = (unsigned char *)malloc(newSize);
-        buffSize_array[index] = newSize;
-    }
+    take_buffer();
+    unsigned char *tmp_ptr = reserve_buffer(newSize);
 
     format = (char *)RGB_24;
 
     // Store image dimension (big endian)
-    unsigned char *tmp_ptr = buffer_array[index];
     tmp_ptr[0] = (unsigned char)( (width>>8) & 0xFF );
     tmp_ptr[1] = (unsigned char)( width & 0xFF );
     tmp_ptr[2] = (unsigned char)( (height>>8) & 0xFF );
@@ -220,7 +304,28 @@ void EncodedAttribute::encode_rgb24(unsigned char *rgb24,int width,int height) {
 
     // Copy image
     memcpy(tmp_ptr+4,rgb24,newSize-4);
+    INC_INDEX()
+}
+
+// ----------------------------------------------------------------------------
+
+void EncodedAttribute::encode_gray8(unsigned char *gray8,int width,int height,const std::string &codec) {
+
+    codec_encode(GRAY_8,gray8,1,width,height,codec);
+}
+
+// ----------------------------------------------------------------------------
 
+void EncodedAttribute::encode_gray16(unsigned short *gray16,int width,int height,const std::string &codec) {
+
+    codec_encode(GRAY_16,reinterpret_cast<unsigned char *>(gray16),2,width,height,codec);
+}
+
+// ----------------------------------------------------------------------------
+
+void EncodedAttribute::encode_rgb24(unsigned char *rgb24,int width,int height,const std::string &codec) {
+
+    codec_encode(RGB_24,rgb24,3,width,height,codec);
 }
 
 // ----------------------------------------------------------------------------
@@ -242,6 +347,12 @@ void EncodedAttribute::decode_rgb32(DeviceAttribute *attr,int *width,int *height
 
     int isRGB  = (strcmp(local_format.c_str() ,RGB_24 ) == 0);
     int isJPEG = (strcmp(local_format.c_str() ,JPEG_RGB ) == 0);
+    EncodedCodec *codec = NULL;
+    if( !isRGB && !isJPEG )
+    {
+        codec = get_codec(local_format,RGB_24);
+        isRGB = (codec != NULL);
+    }
 
     if( !isRGB && !isJPEG )
     {
@@ -255,6 +366,11 @@ void EncodedAttribute::decode_rgb32(DeviceAttribute *attr,int *width,int *height
     std::size_t size = encBuff.length();
     rawBuff = encBuff.get_buffer(false);
 
+    if( codec != NULL && size < 4 )
+    {
+        TANGO_THROW_EXCEPTION(API_DecodeErr, "Not enough data for the image size");
+    }
+
     if( isRGB )
     {
 
@@ -269,6 +385,15 @@ void EncodedAttribute::decode_rgb32(DeviceAttribute *attr,int *width,int *height
         hh = hh << 8;
         int iHeight = hh | hl;
 
+        // Decompress to RGB24
+        std::vector<unsigned char> rgb24;
+        if( codec != NULL )
+        {
+            rgb24.resize((std::size_t)iWidth*iHeight*3 + 4);
+            codec->decompress(rawBuff+4,size-4,(std::size_t)iWidth*iHeight,3,rgb24.data()+4);
+            rawBuff = rgb24.data();
+        }
+
         unsigned char *data = new unsigned char[iWidth*iHeight*4];
 
         // Convert to RGB32
@@ -319,6 +444,12 @@ void EncodedAttribute::decode_gray8(DeviceAttribute *attr,int *width,int *height
 
     int isGrey  = (strcmp(local_format.c_str() ,GRAY_8 ) == 0);
     int isJPEG = (strcmp(local_format.c_str() ,JPEG_GRAY_8 ) == 0);
+    EncodedCodec *codec = NULL;
+    if( !isGrey && !isJPEG )
+    {
+        codec = get_codec(local_format,GRAY_8);
+        isGrey = (codec != NULL);
+    }
 
     if( !isGrey && !isJPEG )
     {
@@ -332,6 +463,11 @@ void EncodedAttribute::decode_gray8(DeviceAttribute *attr,int *width,int *height
     std::size_t size = encBuff.length();
     rawBuff = encBuff.get_buffer(false);
 
+    if( codec != NULL && size < 4 )
+    {
+        TANGO_THROW_EXCEPTION(API_DecodeErr, "Not enough data for the image size");
+    }
+
     if( isGrey )
     {
 
@@ -347,7 +483,20 @@ void EncodedAttribute::decode_gray8(DeviceAttribute *attr,int *width,int *height
         int iHeight = hh | hl;
 
         unsigned char *data = new unsigned char[iWidth*iHeight];
-        memcpy(data,&(rawBuff[4]),iWidth*iHeight);
+        if( codec != NULL )
+        {
+            try
+            {
+                codec->decompress(rawBuff+4,size-4,(std::size_t)iWidth*iHeight,1,data);
+            }
+            catch (...)
+            {
+                delete [] data;
+                throw;
+            }
+        }
+        else
+            memcpy(data,&(rawBuff[4]),iWidth*iHeight);
 
         *gray8  = data;
         *width  = iWidth;
@@ -383,6 +532,12 @@ void EncodedAttribute::decode_gray16(DeviceAttribute *attr,int *width,int *heigh
     std::string local_format(encDataSeq.in()[0].encoded_format);
 
     int isGrey  = (strcmp(local_format.c_str() ,GRAY_16 ) == 0);
+    EncodedCodec *codec = NULL;
+    if( !isGrey )
+    {
+        codec = get_codec(local_format,GRAY_16);
+        isGrey = (codec != NULL);
+    }
 
     if( !isGrey )
     {
@@ -393,8 +548,14 @@ void EncodedAttribute::decode_gray16(DeviceAttribute *attr,int *width,int *heigh
 
     DevVarEncodedArray &encData = encDataSeq.inout();
     DevVarCharArray &encBuff = encData[0].encoded_data;
+    std::size_t size = encBuff.length();
     rawBuff = encBuff.get_buffer(false);
 
+    if( codec != NULL && size < 4 )
+    {
+        TANGO_THROW_EXCEPTION(API_DecodeErr, "Not enough data for the image size");
+    }
+
     if( isGrey )
     {
 
@@ -411,6 +572,24 @@ void EncodedAttribute::decode_gray16(DeviceAttribute *attr,int *width,int *heigh
 
         unsigned short *data = new unsigned short[ iWidth*iHeight*2 ];
 
+        if( codec != NULL )
+        {
+            try
+            {
+                codec->decompress(rawBuff+4,size-4,(std::size_t)iWidth*iHeight,2,reinterpret_cast<unsigned char *>(data));
+            }
+            catch (...)
+            {
+                delete [] data;
+                throw;
+            }
+
+            *gray16 = data;
+            *width  = iWidth;
+            *height = iHeight;
+            return;
+        }
+
         int srcIdx = 4;
         int dstIdx = 0;
         for(int j=0;j<iHeight;j++)
@@ -486,9 +665,156 @@ namespace
     }
 
 
-        // ----------------------------------------------------------------
-    static void jpeg_encode_rgb(int width,int height,unsigned char *rgb,double quality,
-            std::size_t* jpegSize,unsigned char **jpegData, color_space type) {
+    int jpeg_components(color_space type)
+    {
+        switch(type)
+        {
+            case color_space::RGB:
+                return 3;
+            case color_space::RGBA:
+                return 4;
+            case color_space::GRAY:
+            default:
+                return 1;
+        }
+    }
+
+    // For RGB images, outputs to RGBA if supported by the jpeg implementation(which is the case for libjpeg-turbo)
+    // outputs to RGB otherwise.
+    void jpeg_set_out_color_space(jpeg_decompress_struct &cinfo)
+    {
+        if(cinfo.num_components == 3)
+        {
+#ifdef JCS_EXTENSIONS
+            cinfo.out_color_space = JCS_EXT_RGBA;
+#else
+            cinfo.out_color_space = JCS_RGB;
+#endif
+        }
+    }
+
+    // ----------------------------------------------------------------
+    // Run nb_tasks tasks on nb_threads threads (the calling thread is one
+    // of them). The first error is re-thrown once all the threads are joined
+    // ----------------------------------------------------------------
+    void jpeg_run_tasks(int nb_threads,int nb_tasks,const std::function<void(int)> &task)
+    {
+        std::atomic<int> next(0);
+        std::vector<std::exception_ptr> errors(nb_tasks);
+
+        auto worker = [&]() {
+            for (int i = next++;i < nb_tasks;i = next++)
+            {
+                try
+                {
+                    task(i);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int i = 1;i < std::min(nb_threads,nb_tasks);i++)
+        {
+            try
+            {
+                threads.emplace_back(worker);
+            }
+            catch (std::system_error &)
+            {
+                break;
+            }
+        }
+        worker();
+        for (auto &th : threads)
+            th.join();
+
+        for (auto &err : errors)
+        {
+            if (err)
+                std::rethrow_exception(err);
+        }
+    }
+
+    // ----------------------------------------------------------------
+    // Position of the markers in a JPEG stream header. Only single scan
+    // huffman sequential streams are accepted
+    // ----------------------------------------------------------------
+    struct jpeg_header
+    {
+        std::size_t sof;            // SOF marker position
+        std::size_t sos;            // SOS marker position
+        std::size_t scan;           // Entropy coded data position
+        int restart_interval;       // Restart interval in MCU (0 if none)
+    };
+
+    bool jpeg_parse_header(const unsigned char *data,std::size_t size,jpeg_header &header)
+    {
+        if (size < 4 || data[0] != 0xFF || data[1] != 0xD8)
+            return false;
+
+        header.sof = 0;
+        header.restart_interval = 0;
+
+        std::size_t pos = 2;
+        while (pos + 4 <= size)
+        {
+            if (data[pos] != 0xFF)
+                return false;
+            unsigned char marker = data[pos + 1];
+            if (marker == 0xFF)
+            {
+                pos++;
+                continue;
+            }
+
+            std::size_t length = (data[pos + 2] << 8) | data[pos + 3];
+            if (length < 2 || pos + 2 + length > size)
+                return false;
+
+            switch (marker)
+            {
+                case 0xC0:
+                case 0xC1:
+                    if (length < 8 || length < 8 + 3 * (std::size_t)data[pos + 9])
+                        return false;
+                    header.sof = pos;
+                    break;
+
+                case 0xDD:
+                    if (length < 4)
+                        return false;
+                    header.restart_interval = (data[pos + 4] << 8) | data[pos + 5];
+                    break;
+
+                case 0xDA:
+                    if (length < 3 || pos + 4 >= size || header.sof == 0 || data[pos + 4] != data[header.sof + 9])
+                        return false;
+                    header.sos = pos;
+                    header.scan = pos + 2 + length;
+                    return true;
+
+                case 0xC4:
+                case 0xC8:
+                case 0xCC:
+                    break;
+
+                default:
+                    if (marker >= 0xC2 && marker <= 0xCF)
+                        return false;
+                    break;
+            }
+            pos = pos + 2 + length;
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------------
+    static void jpeg_encode_strip(int width,int height,unsigned char *rgb,double quality,
+            std::size_t* jpegSize,unsigned char **jpegData, color_space type, bool restart) {
 
         jpeg_compress_struct cinfo{};
         jpeg_error_mgr jerr{};
@@ -498,7 +824,9 @@ namespace
         
         jpeg_create_compress(&cinfo);
 
-        unsigned long size;
+        // An already allocated buffer is used by libjpeg, which allocates a new one if it is too small
+        unsigned char *prev_data = *jpegData;
+        unsigned long size = (prev_data != NULL) ? *jpegSize : 0;
         jpeg_mem_dest(&cinfo, jpegData, &size);
 
         cinfo.image_width = width;      /* image width and height, in pixels */
@@ -533,6 +861,10 @@ namespace
 
         jpeg_set_quality(&cinfo, quality, TRUE);
 
+        // One restart marker at the beginning of each MCU row
+        if (restart == true)
+            cinfo.restart_in_rows = 1;
+
         jpeg_start_compress(&cinfo, TRUE);
 
         unsigned char* row_ptr[1];
@@ -548,25 +880,292 @@ namespace
         // cause this is where it is actually set.
         // Depending on the implementation, if done before it will return 4096 all the time
         *jpegSize = size;
+
+        if (prev_data != NULL && *jpegData != prev_data)
+            free(prev_data);
+    }
+
+    // ----------------------------------------------------------------
+    // Encode an image. With several threads, the image is cut in strips
+    // encoded in parallel with one restart marker per MCU row. The strip
+    // streams are then joined: header of the first strip (with the image
+    // height), strips entropy coded data separated by restart markers and EOI.
+    // The strip height is a multiple of 8 MCU rows, therefore the restart
+    // marker numbers within each strip are the ones of the joined stream.
+    // ----------------------------------------------------------------
+    const int JPEG_STRIP_ROW_UNIT = 128;
+
+    static void jpeg_encode_rgb(int width,int height,unsigned char *rgb,double quality,
+            std::size_t* jpegSize,unsigned char **jpegData, color_space type, int nb_threads) {
+
+        int strip_rows = (height + nb_threads - 1) / std::max(nb_threads,1);
+        strip_rows = ((strip_rows + JPEG_STRIP_ROW_UNIT - 1) / JPEG_STRIP_ROW_UNIT) * JPEG_STRIP_ROW_UNIT;
+
+        if (nb_threads <= 1 || width <= 0 || height <= strip_rows)
+        {
+            jpeg_encode_strip(width, height, rgb, quality, jpegSize, jpegData, type, false);
+            return;
+        }
+
+        int nb_strips = (height + strip_rows - 1) / strip_rows;
+        int mcu_height = (type == color_space::GRAY) ? 8 : 16;
+        std::size_t row_size = (std::size_t)width * jpeg_components(type);
+
+        std::vector<unsigned char *> strip_data(nb_strips, nullptr);
+        std::vector<std::size_t> strip_size(nb_strips, 0);
+        std::vector<jpeg_header> strip_header(nb_strips);
+
+        auto free_strips = [&]() {
+            for (auto &ptr : strip_data)
+                SAFE_FREE(ptr);
+        };
+
+        try
+        {
+            jpeg_run_tasks(nb_threads, nb_strips, [&](int i) {
+                int first_row = i * strip_rows;
+                int rows = std::min(strip_rows, height - first_row);
+                jpeg_encode_strip(width, rows, rgb + (first_row * row_size), quality, &strip_size[i], &strip_data[i],
+                        type, true);
+            });
+        }
+        catch (...)
+        {
+            free_strips();
+            throw;
+        }
+
+        std::size_t total_size = 0;
+        for (int i = 0;i < nb_strips;i++)
+        {
+            if (jpeg_parse_header(strip_data[i], strip_size[i], strip_header[i]) == false ||
+                strip_data[i][strip_size[i] - 2] != 0xFF || strip_data[i][strip_size[i] - 1] != 0xD9)
+            {
+                free_strips();
+                TANGO_THROW_EXCEPTION(API_EncodeErr, "Unexpected JPEG stream format while joining image strips");
+            }
+            if (i == 0)
+                total_size = strip_header[i].scan;
+            total_size = total_size + (strip_size[i] - strip_header[i].scan - 2) + 2;
+        }
+
+        unsigned char *out = *jpegData;
+        if (out == NULL || *jpegSize < total_size)
+        {
+            out = (unsigned char *)malloc(total_size);
+            if (out == NULL)
+            {
+                free_strips();
+                TANGO_THROW_EXCEPTION(API_MemoryAllocation, "Can't allocate memory for the JPEG image");
+            }
+            SAFE_FREE(*jpegData);
+        }
+
+        std::size_t header_size = strip_header[0].scan;
+        memcpy(out, strip_data[0], header_size);
+        out[strip_header[0].sof + 5] = (unsigned char)((height >> 8) & 0xFF);
+        out[strip_header[0].sof + 6] = (unsigned char)(height & 0xFF);
+
+        unsigned char *ptr = out + header_size;
+        for (int i = 0;i < nb_strips;i++)
+        {
+            std::size_t scan_size = strip_size[i] - strip_header[i].scan - 2;
+            memcpy(ptr, strip_data[i] + strip_header[i].scan, scan_size);
+            ptr = ptr + scan_size;
+            *ptr++ = 0xFF;
+            if (i == nb_strips - 1)
+                *ptr++ = 0xD9;
+            else
+                *ptr++ = (unsigned char)(0xD0 + ((((i + 1) * strip_rows) / mcu_height - 1) % 8));
+        }
+
+        free_strips();
+
+        *jpegData = out;
+        *jpegSize = total_size;
+    }
+
+    // ----------------------------------------------------------------
+    // Decode rows [first_row,last_row[ of a strip stream starting at image
+    // row strip_row. Rows outside this range are decoded only to give
+    // the upsampling context and are not stored.
+    // ----------------------------------------------------------------
+    void jpeg_decode_strip(std::vector<unsigned char> &stream,unsigned char *frame,int row_stride,
+            int strip_row,int first_row,int last_row)
+    {
+        jpeg_decompress_struct cinfo{};
+        jpeg_error_mgr jerr{};
+        cinfo.err = jpeg_std_error(&jerr);
+        jerr.error_exit = &handle_jpeg_error<jpeg_decompress_struct>;
+
+        jpeg_create_decompress(&cinfo);
+
+        jpeg_mem_src(&cinfo, stream.data(), (unsigned long)stream.size());
+        jpeg_read_header(&cinfo, TRUE);
+        jpeg_set_out_color_space(cinfo);
+
+        jpeg_start_decompress(&cinfo);
+
+        if ((int)(cinfo.output_width * cinfo.output_components) != row_stride)
+        {
+            jpeg_destroy_decompress(&cinfo);
+            TANGO_THROW_EXCEPTION(API_DecodeErr, "Unexpected JPEG strip format");
+        }
+
+        std::vector<unsigned char> unused_row(row_stride);
+        unsigned char *buffer_array[1];
+        while (cinfo.output_scanline < cinfo.output_height && strip_row + (int)cinfo.output_scanline < last_row)
+        {
+            int row = strip_row + cinfo.output_scanline;
+            if (row >= first_row)
+                buffer_array[0] = frame + (std::size_t)row * row_stride;
+            else
+                buffer_array[0] = unused_row.data();
+            jpeg_read_scanlines(&cinfo, buffer_array, 1);
+        }
+
+        jpeg_destroy_decompress(&cinfo);
+    }
+
+    // ----------------------------------------------------------------
+    // Decode a JPEG image with several threads. This is possible when the
+    // image has restart markers at the beginning of MCU rows. The restart
+    // intervals are shared between threads, each one decoding its own
+    // stream (the image header with the strip height and its intervals).
+    // For color images, one more interval is decoded above and below the
+    // strip to get the same chroma upsampling than a sequential decoding.
+    // Returns false (and does nothing) if the image can't be split.
+    // ----------------------------------------------------------------
+    bool jpeg_decode_parallel(std::size_t jpegSize,unsigned char *jpegData,int *width,int *height,
+            unsigned char *&frame,int nb_threads)
+    {
+        jpeg_header header;
+        if (jpeg_parse_header(jpegData, jpegSize, header) == false || header.restart_interval == 0)
+            return false;
+
+        const unsigned char *sof = jpegData + header.sof;
+        int img_height = (sof[5] << 8) | sof[6];
+        int img_width = (sof[7] << 8) | sof[8];
+        int nb_comp = sof[9];
+        if (img_height == 0 || img_width == 0 || (nb_comp != 1 && nb_comp != 3))
+            return false;
+
+        int h_max = 1;
+        int v_max = 1;
+        if (nb_comp != 1)
+        {
+            for (int i = 0;i < nb_comp;i++)
+            {
+                h_max = std::max(h_max, sof[11 + (3 * i)] >> 4);
+                v_max = std::max(v_max, sof[11 + (3 * i)] & 0x0F);
+            }
+        }
+
+        int mcus_per_row = (img_width + (8 * h_max) - 1) / (8 * h_max);
+        if (header.restart_interval % mcus_per_row != 0)
+            return false;
+
+        int interval_rows = (header.restart_interval / mcus_per_row) * 8 * v_max;
+        int nb_intervals = (img_height + interval_rows - 1) / interval_rows;
+        if (nb_intervals < 2)
+            return false;
+
+        // Find the restart intervals in the entropy coded data
+        std::vector<std::size_t> starts(1, header.scan);
+        std::vector<std::size_t> ends;
+        for (std::size_t pos = header.scan;pos + 1 < jpegSize;pos++)
+        {
+            if (jpegData[pos] != 0xFF || jpegData[pos + 1] == 0x00 || jpegData[pos + 1] == 0xFF)
+                continue;
+
+            if (jpegData[pos + 1] >= 0xD0 && jpegData[pos + 1] <= 0xD7)
+            {
+                ends.push_back(pos);
+                starts.push_back(pos + 2);
+                pos++;
+            }
+            else
+            {
+                ends.push_back(pos);
+                break;
+            }
+        }
+        if (ends.size() != starts.size() || (int)starts.size() != nb_intervals)
+            return false;
+
+#ifdef JCS_EXTENSIONS
+        int out_comp = (nb_comp == 3) ? 4 : 1;
+#else
+        int out_comp = nb_comp;
+#endif
+        int row_stride = img_width * out_comp;
+        frame = new unsigned char[(std::size_t)row_stride * img_height];
+
+        int nb_strips = std::min(nb_threads, nb_intervals);
+        try
+        {
+            jpeg_run_tasks(nb_threads, nb_strips, [&](int i) {
+                int first = (i * nb_intervals) / nb_strips;
+                int last = ((i + 1) * nb_intervals) / nb_strips;
+                int dec_first = first;
+                int dec_last = last;
+                if (nb_comp != 1)
+                {
+                    dec_first = std::max(first - 1, 0);
+                    dec_last = std::min(last + 1, nb_intervals);
+                }
+
+                int strip_row = dec_first * interval_rows;
+                int strip_height = std::min(dec_last * interval_rows, img_height) - strip_row;
+
+                std::vector<unsigned char> stream(jpegData, jpegData + header.scan);
+                stream[header.sof + 5] = (unsigned char)((strip_height >> 8) & 0xFF);
+                stream[header.sof + 6] = (unsigned char)(strip_height & 0xFF);
+                for (int j = dec_first;j < dec_last;j++)
+                {
+                    if (j != dec_first)
+                    {
+                        stream.push_back(0xFF);
+                        stream.push_back((unsigned char)(0xD0 + ((j - dec_first - 1) % 8)));
+                    }
+                    stream.insert(stream.end(), jpegData + starts[j], jpegData + ends[j]);
+                }
+                stream.push_back(0xFF);
+                stream.push_back(0xD9);
+
+                jpeg_decode_strip(stream, frame, row_stride, strip_row, first * interval_rows,
+                        std::min(last * interval_rows, img_height));
+            });
+        }
+        catch (...)
+        {
+            delete [] frame;
+            frame = nullptr;
+            throw;
+        }
+
+        *width = img_width;
+        *height = img_height;
+        return true;
     }
 }
 // --------------------------------------------------------------------------
 
 void EncodedAttribute::jpeg_encode_rgb32(int width,int height,unsigned char *rgb32,double quality,
         std::size_t* jpegSize,unsigned char **jpegData) {
-    jpeg_encode_rgb(width, height, rgb32, quality, jpegSize, jpegData, color_space::RGBA);
+    jpeg_encode_rgb(width, height, rgb32, quality, jpegSize, jpegData, color_space::RGBA, ext->jpeg_threads);
 }
 
 void EncodedAttribute::jpeg_encode_rgb24(int width,int height,unsigned char *rgb24,double quality,
         std::size_t* jpegSize,unsigned char **jpegData) {
-    jpeg_encode_rgb(width, height, rgb24, quality, jpegSize, jpegData, color_space::RGB);
+    jpeg_encode_rgb(width, height, rgb24, quality, jpegSize, jpegData, color_space::RGB, ext->jpeg_threads);
 }
 
 // --------------------------------------------------------------------------
 
 void EncodedAttribute::jpeg_encode_gray8(int width,int height,unsigned char *gray8,double quality,
         std::size_t* jpegSize,unsigned char **jpegData) {
-    jpeg_encode_rgb(width, height, gray8, quality, jpegSize, jpegData, color_space::GRAY);
+    jpeg_encode_rgb(width, height, gray8, quality, jpegSize, jpegData, color_space::GRAY, ext->jpeg_threads);
 }
 
 // --------------------------------------------------------------------------
@@ -574,6 +1173,9 @@ void EncodedAttribute::jpeg_encode_gray8(int width,int height,unsigned char *gra
 void EncodedAttribute::jpeg_decode(std::size_t jpegSize, unsigned char *jpegData,
         int *width,int *height,unsigned char*& frame) {
 
+    if (ext->jpeg_threads > 1 && jpeg_decode_parallel(jpegSize, jpegData, width, height, frame, ext->jpeg_threads) == true)
+        return;
+
     jpeg_decompress_struct cinfo{};
     jpeg_error_mgr jerr{};
     /* We set up the normal JPEG error routines, then override error_exit. */
@@ -585,16 +1187,7 @@ void EncodedAttribute::jpeg_decode(std::size_t jpegSize, unsigned char *jpegData
     jpeg_mem_src(&cinfo, jpegData, (unsigned long)jpegSize);
     jpeg_read_header(&cinfo, TRUE);
     // Check if the image is gray or RGB
-    // For RGB images, outputs to RGBA if supported by the jpeg implementation(which is the case for libjpeg-turbo)
-    // outputs to RGB otherwise.
-    if(cinfo.num_components == 3)
-    {
-#ifdef JCS_EXTENSIONS
-        cinfo.out_color_space = JCS_EXT_RGBA;
-#else
-        cinfo.out_color_space = JCS_RGB;
-#endif
-    }
+    jpeg_set_out_color_space(cinfo);
 
     jpeg_start_decompress(&cinfo);
 
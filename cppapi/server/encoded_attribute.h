@@ -38,6 +38,7 @@
 #define _ENCODED_ATT_H
 
 #include <encoded_format.h>
+#include <atomic>
 
 #ifdef TANGO_USE_JPEG
 #include <jpeglib.h>
@@ -47,6 +48,57 @@
 namespace Tango
 {
 
+    /**
+     * Base class for the lossless codecs used by the EncodedAttribute class.
+     *
+     * A codec compresses an image made of elements of 1, 2 or 3 bytes (8 bits gray, 16 bits gray or
+     * 24 bits RGB pixels). The 2 bytes elements are unsigned short in the host byte order.
+     * The codec output must not depend on the host byte order. The compress and decompress methods
+     * may be called by several threads at the same time.
+     * A codec is registered with EncodedAttribute::register_codec() and then used with its name
+     * by the encode methods. The codec name is added to the encoded format (GRAY16:DELTA_SHUFFLE_LZ for
+     * instance) and the decode methods use it to find the codec.
+     *
+     * @headerfile tango.h
+     * @ingroup Server
+     */
+
+    class EncodedCodec
+    {
+        public:
+            virtual ~EncodedCodec() {}
+
+            /**
+             * Get the codec name
+             *
+             * @return The codec name
+             */
+            virtual std::string get_name() = 0;
+
+            /**
+             * Compress data
+             *
+             * @param data     The data to be compressed
+             * @param nb_elt   The element number
+             * @param elt_size The element size (1, 2 or 3 bytes)
+             * @param out      The compressed data (appended to the vector)
+             */
+            virtual void compress(const unsigned char *data,std::size_t nb_elt,int elt_size,
+                                  std::vector<unsigned char> &out) = 0;
+
+            /**
+             * Decompress data. Throws DevFailed in case of failure.
+             *
+             * @param data     The compressed data
+             * @param size     The compressed data size
+             * @param nb_elt   The element number
+             * @param elt_size The element size (1, 2 or 3 bytes)
+             * @param out      The decompressed data (nb_elt * elt_size bytes allocated by the caller)
+             */
+            virtual void decompress(const unsigned char *data,std::size_t size,std::size_t nb_elt,int elt_size,
+                                    unsigned char *out) = 0;
+    };
+
     /**
      * This class provides method to deal with Tango::DevEncoded attribute format.
      *
@@ -74,7 +126,12 @@ namespace Tango
              * This constructor allows the user to define the size of the buffer pool used to
              * store the encoded images. This buffer pool is managed as a circular pool.
              * A different buffer is used each time an image is encoded. The last used buffer is then
-             * passed to the attribute with the attribute::set_value() method
+             * passed to the attribute with the attribute::set_value() method. The buffer is not copied:
+             * the client reply, the event and the polling buffer refer to it.
+             * A buffer is kept from one image to the next one and is re-allocated only when a larger
+             * image is encoded. When the instance manages the data buffer serialization, a buffer is
+             * locked until the reply using it is sent and the encode methods use the next free buffer
+             * of the pool (they wait only if all the buffers are still used).
              *
              * @param buf_pool_size    Buffer pool size
              * @param serialization	   Set to true if the instance manage the data buffer serialization
@@ -159,6 +216,39 @@ namespace Tango
              *
              */
             void encode_rgb24(unsigned char *rgb24,int width,int height);
+
+            /**
+             * Encode a 8 bit grayscale image with a lossless codec
+             *
+             * @param gray8    Array of 8bit gray sample
+             * @param width    The image width
+             * @param height   The image height
+             * @param codec    The codec name (DELTA_SHUFFLE_LZ or a registered codec)
+             *
+             */
+            void encode_gray8(unsigned char *gray8,int width,int height,const std::string &codec);
+
+            /**
+             * Encode a 16 bit grayscale image with a lossless codec
+             *
+             * @param gray16   Array of 16bit gray sample
+             * @param width    The image width
+             * @param height   The image height
+             * @param codec    The codec name (DELTA_SHUFFLE_LZ or a registered codec)
+             *
+             */
+            void encode_gray16(unsigned short *gray16,int width,int height,const std::string &codec);
+
+            /**
+             * Encode a 24 bit color image with a lossless codec
+             *
+             * @param rgb24    Array of 24bit RGB sample
+             * @param width    The image width
+             * @param height   The image height
+             * @param codec    The codec name (DELTA_SHUFFLE_LZ or a registered codec)
+             *
+             */
+            void encode_rgb24(unsigned char *rgb24,int width,int height,const std::string &codec);
             //@}
 
 
@@ -166,7 +256,7 @@ namespace Tango
             */
             //@{
             /**
-             * Decode a color image (JPEG_RGB or RGB24) and returns a 32 bits RGB image.
+             * Decode a color image (JPEG_RGB, RGB24 or RGB24 with a codec) and returns a 32 bits RGB image.
              * Throws DevFailed in case of failure.
              *
              * @param attr     DeviceAttribute that contains the image
@@ -177,7 +267,7 @@ namespace Tango
             void decode_rgb32(DeviceAttribute *attr,int *width,int *height,unsigned char **rgb32);
 
             /**
-             * Decode a 8 bits grayscale image (JPEG_GRAY8 or GRAY8) and returns a 8 bits gray scale image.
+             * Decode a 8 bits grayscale image (JPEG_GRAY8, GRAY8 or GRAY8 with a codec) and returns a 8 bits gray scale image.
              * Throws DevFailed in case of failure.
              *
              * @param attr     DeviceAttribute that contains the image
@@ -188,7 +278,7 @@ namespace Tango
             void decode_gray8(DeviceAttribute *attr,int *width,int *height,unsigned char **gray8);
 
             /**
-             * Decode a 16 bits grayscale image (GRAY16) and returns a 16 bits gray scale image.
+             * Decode a 16 bits grayscale image (GRAY16 or GRAY16 with a codec) and returns a 16 bits gray scale image.
              * Throws DevFailed in case of failure.
              *
              * @param attr     DeviceAttribute that contains the image
@@ -200,6 +290,70 @@ namespace Tango
 
             //@}
 
+            /**@name JPEG Threading Methods
+            */
+            //@{
+            /**
+             * Set the number of threads used to encode and decode JPEG images.
+             *
+             * With more than one thread, a JPEG image is cut in horizontal strips separated by JPEG restart
+             * markers. The strips are encoded in parallel and joined in one standard JPEG stream.
+             * JPEG images with restart markers at the beginning of MCU rows (as the one encoded in parallel)
+             * are also decoded in parallel. The default is 1 (no parallel encoding or decoding).
+             *
+             * @param nb_threads   The number of threads
+             */
+            void set_jpeg_threads(int nb_threads);
+
+            /**
+             * Get the number of threads used to encode and decode JPEG images.
+             *
+             * @return The number of threads
+             */
+            int get_jpeg_threads();
+            //@}
+
+            /**@name Codec Methods
+            */
+            //@{
+            /**
+             * Register a lossless codec. The codec object is deleted by the library.
+             * Throws DevFailed if a codec with the same name is already registered.
+             *
+             * @param codec    The codec
+             */
+            static void register_codec(EncodedCodec *codec);
+
+            /**
+             * Get the registered codec names (including the built-in DELTA_SHUFFLE_LZ codec)
+             *
+             * @return The codec names
+             */
+            static std::vector<std::string> get_codec_list();
+            //@}
+
+            /**@name Buffer Pool Methods
+            */
+            //@{
+            /**
+             * Get the number of pool buffers still used by a client reply, an event or the polling buffer.
+             * The buffers are tracked only when the instance manages the data buffer serialization
+             * (0 is returned otherwise).
+             *
+             * @return The number of buffers in use
+             */
+            int get_buffers_in_use();
+
+            /**
+             * Get the number of encoded images passed to an attribute with the Attribute::set_value()
+             * method. The image buffer is never copied by this method: the reply, the event and the polling
+             * buffer refer to it.
+             *
+             * @return The number of images passed to an attribute
+             */
+            unsigned long long get_set_value_count() {return ext->set_value_count;}
+            //@}
+
             /// @privatesection
 
             DevUChar  *get_data()
@@ -221,10 +375,19 @@ namespace Tango
                 return &(mutex_array[buf_elt_nb-1]);
                 else
                     return &(mutex_array[index-1]);}
+            void inc_set_value_count() {ext->set_value_count++;}
 
         private:
             class EncodedAttributeExt
             {
+                public:
+                    EncodedAttributeExt():jpeg_threads(1),set_value_count(0) {}
+
+                    int     jpeg_threads;       // Number of threads used for JPEG encoding/decoding
+                    std::vector<std::string> codec_format;          // Format name of each pool buffer when a codec is used
+                    std::vector<unsigned char> codec_buffer;
+                    std::vector<std::size_t> buff_capacity;         // Allocated size of each pool buffer
+                    std::atomic<unsigned long long> set_value_count; // Images passed to an attribute
             };
 
             unsigned char 		    **buffer_array;
@@ -238,10 +401,25 @@ namespace Tango
 
             std::unique_ptr<EncodedAttributeExt>     ext;           // Class extension
 
+            // ----------------------------------------------------------------------------
+            // Pool management: take_buffer() selects (and locks if needed) the buffer used
+            // for the next image, reserve_buffer() makes it large enough (it is never
+            // shrunk) and release_buffer() unlocks it when the encoding fails.
+            // ----------------------------------------------------------------------------
+            void take_buffer();
+            unsigned char *reserve_buffer(std::size_t size);
+            void release_buffer();
+
+            typedef void (EncodedAttribute::*JpegEncoder)(int,int,unsigned char *,double,std::size_t *,unsigned char **);
+            void jpeg_encode_buffer(JpegEncoder encoder,unsigned char *data,int width,int height,double quality,
+                    const char *fmt);
+
             // ----------------------------------------------------------------------------
             // Encode a RGB image to a buffer
             // quality ranges in 0(poor), 100(max)
-            // jpegData is allocated by the function and must be freed by the caller.
+            // On input, jpegData/jpegSize are an already allocated buffer and its size
+            // (NULL/0 if none). This buffer is used if it is large enough. Otherwise, it is
+            // freed and jpegData is allocated by the function. It must be freed by the caller.
             // ----------------------------------------------------------------------------
             void jpeg_encode_rgb32(int width,int height,unsigned char *rgb32,
                     double quality, std::size_t* jpegSize,unsigned char **jpegData);
@@ -260,6 +438,16 @@ namespace Tango
             // ----------------------------------------------------------------------------
             void jpeg_decode(std::size_t jpegSize, unsigned char *jpegData,
                     int *width, int *height, unsigned char*& frame);
+
+            // ----------------------------------------------------------------------------
+            // Encode an image with a lossless codec (elt_size is the pixel size in bytes).
+            // The codec used by an encoded format is returned by get_codec() (NULL if the
+            // format does not use a codec, exception if the codec is unknown)
+            // ----------------------------------------------------------------------------
+            void codec_encode(const char *base_format,const unsigned char *data,int elt_size,
+                    int width,int height,const std::string &codec);
+
+            static EncodedCodec *get_codec(const std::string &format,const char *base_format);
     };
 
 #define INC_INDEX() \
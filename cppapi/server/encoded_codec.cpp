@@ -0,0 +1,493 @@
+//=============================================================================
+//
+// file :		encoded_codec.cpp
+//
+// description :	Lossless codecs used for the Tango::DevEncoded format
+//
+// project :		TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//                      European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Tango.  If not, see <http://www.gnu.org/licenses/>.
+//
+//=============================================================================
+
+#include "encoded_attribute.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace Tango;
+
+namespace
+{
+    // ----------------------------------------------------------------
+    // DELTA_SHUFFLE_LZ codec.
+    // Each pixel is replaced by its difference with the previous one
+    // (per channel for RGB). The differences are then split in byte
+    // planes (most significant byte first for 16 bits pixels) and the
+    // planes are compressed with a LZ77 coder (LZ4 like block format).
+    // For smooth detector images, the most significant byte plane is
+    // almost constant and is very well compressed.
+    //
+    // Stream: one method byte (STORED or LZ) followed by the planes
+    // (STORED) or by the LZ block (LZ)
+    // ----------------------------------------------------------------
+
+    const unsigned char METHOD_STORED = 0;
+    const unsigned char METHOD_LZ = 1;
+
+    const int LZ_MIN_MATCH = 4;
+    const int LZ_HASH_BITS = 14;
+    const std::size_t LZ_MAX_OFFSET = 65535;
+    const std::size_t LZ_LAST_LITERALS = 12;      // The block always ends with some literals
+
+    [[noreturn]] void codec_error(const char *msg)
+    {
+        TANGO_THROW_EXCEPTION(API_DecodeErr, msg);
+    }
+
+    inline uint32_t read32(const unsigned char *ptr)
+    {
+        uint32_t val;
+        memcpy(&val, ptr, sizeof(val));
+        return val;
+    }
+
+    inline uint32_t lz_hash(uint32_t seq)
+    {
+        return (seq * 2654435761U) >> (32 - LZ_HASH_BITS);
+    }
+
+    void lz_put_length(std::vector<unsigned char> &out, std::size_t len)
+    {
+        while (len >= 255)
+        {
+            out.push_back(255);
+            len = len - 255;
+        }
+        out.push_back((unsigned char)len);
+    }
+
+    void lz_put_sequence(std::vector<unsigned char> &out, const unsigned char *lit, std::size_t lit_len,
+            std::size_t offset, std::size_t match_len)
+    {
+        std::size_t ml = (match_len != 0) ? match_len - LZ_MIN_MATCH : 0;
+        unsigned char token = (unsigned char)(((lit_len < 15 ? lit_len : 15) << 4) | (ml < 15 ? ml : 15));
+        out.push_back(token);
+        if (lit_len >= 15)
+            lz_put_length(out, lit_len - 15);
+        out.insert(out.end(), lit, lit + lit_len);
+
+        if (match_len != 0)
+        {
+            out.push_back((unsigned char)(offset & 0xFF));
+            out.push_back((unsigned char)(offset >> 8));
+            if (ml >= 15)
+                lz_put_length(out, ml - 15);
+        }
+    }
+
+    void lz_compress(const unsigned char *src, std::size_t size, std::vector<unsigned char> &out)
+    {
+        std::vector<uint32_t> table(1 << LZ_HASH_BITS, 0);
+
+        std::size_t anchor = 0;
+        std::size_t ip = 0;
+        std::size_t limit = (size > LZ_LAST_LITERALS) ? size - LZ_LAST_LITERALS : 0;
+
+        while (ip < limit)
+        {
+            uint32_t seq = read32(src + ip);
+            uint32_t h = lz_hash(seq);
+            std::size_t ref = table[h];
+            table[h] = (uint32_t)ip;
+
+            if (ref < ip && ip - ref <= LZ_MAX_OFFSET && read32(src + ref) == seq)
+            {
+                std::size_t len = LZ_MIN_MATCH;
+                while (ip + len < limit && src[ref + len] == src[ip + len])
+                    len++;
+
+                lz_put_sequence(out, src + anchor, ip - anchor, ip - ref, len);
+                ip = ip + len;
+                anchor = ip;
+            }
+            else
+            {
+                // Go faster in data which do not compress
+                ip = ip + 1 + ((ip - anchor) >> 6);
+            }
+        }
+
+        lz_put_sequence(out, src + anchor, size - anchor, 0, 0);
+    }
+
+    std::size_t lz_get_length(const unsigned char *&ip, const unsigned char *end)
+    {
+        std::size_t len = 0;
+        unsigned char b;
+        do
+        {
+            if (ip >= end)
+                codec_error("Truncated DELTA_SHUFFLE_LZ data");
+            b = *ip++;
+            len = len + b;
+        }
+        while (b == 255);
+        return len;
+    }
+
+    void lz_decompress(const unsigned char *ip, std::size_t size, unsigned char *op, std::size_t out_size)
+    {
+        const unsigned char *end = ip + size;
+        unsigned char *out_start = op;
+        unsigned char *out_end = op + out_size;
+
+        while (ip < end)
+        {
+            unsigned char token = *ip++;
+
+            std::size_t lit_len = token >> 4;
+            if (lit_len == 15)
+                lit_len = lit_len + lz_get_length(ip, end);
+            if ((std::size_t)(end - ip) < lit_len || (std::size_t)(out_end - op) < lit_len)
+                codec_error("Corrupted DELTA_SHUFFLE_LZ data");
+            memcpy(op, ip, lit_len);
+            ip = ip + lit_len;
+            op = op + lit_len;
+
+            if (ip == end)
+                break;
+
+            if (end - ip < 2)
+                codec_error("Truncated DELTA_SHUFFLE_LZ data");
+            std::size_t offset = ip[0] | (ip[1] << 8);
+            ip = ip + 2;
+
+            std::size_t match_len = token & 0x0F;
+            if (match_len == 15)
+                match_len = match_len + lz_get_length(ip, end);
+            match_len = match_len + LZ_MIN_MATCH;
+
+            if (offset == 0 || offset > (std::size_t)(op - out_start) || (std::size_t)(out_end - op) < match_len)
+                codec_error("Corrupted DELTA_SHUFFLE_LZ data");
+
+            const unsigned char *ref = op - offset;
+            if (offset >= match_len)
+                memcpy(op, ref, match_len);
+            else
+            {
+                for (std::size_t i = 0;i < match_len;i++)
+                    op[i] = ref[i];
+            }
+            op = op + match_len;
+        }
+
+        if (op != out_end)
+            codec_error("Truncated DELTA_SHUFFLE_LZ data");
+    }
+
+    // ----------------------------------------------------------------
+    // Delta + shuffle of 16 bits pixels: planes[0] gets the most
+    // significant byte of the differences, planes[nb] the least one
+    // ----------------------------------------------------------------
+    void shuffle16(const unsigned short *src, std::size_t nb, unsigned char *planes)
+    {
+        unsigned char *msb = planes;
+        unsigned char *lsb = planes + nb;
+        std::size_t i = 0;
+        unsigned short prev = 0;
+
+#ifdef __SSE2__
+        const __m128i low_mask = _mm_set1_epi16(0x00FF);
+        __m128i prev_v = _mm_setzero_si128();
+        for (;i + 16 <= nb;i = i + 16)
+        {
+            __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+            __m128i p0 = _mm_or_si128(_mm_slli_si128(v0, 2), _mm_srli_si128(prev_v, 14));
+            __m128i p1 = _mm_or_si128(_mm_slli_si128(v1, 2), _mm_srli_si128(v0, 14));
+            __m128i d0 = _mm_sub_epi16(v0, p0);
+            __m128i d1 = _mm_sub_epi16(v1, p1);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(msb + i),
+                    _mm_packus_epi16(_mm_srli_epi16(d0, 8), _mm_srli_epi16(d1, 8)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(lsb + i),
+                    _mm_packus_epi16(_mm_and_si128(d0, low_mask), _mm_and_si128(d1, low_mask)));
+            prev_v = v1;
+        }
+        if (i != 0)
+            prev = src[i - 1];
+#endif
+
+        for (;i < nb;i++)
+        {
+            unsigned short d = (unsigned short)(src[i] - prev);
+            msb[i] = (unsigned char)(d >> 8);
+            lsb[i] = (unsigned char)(d & 0xFF);
+            prev = src[i];
+        }
+    }
+
+    void unshuffle16(const unsigned char *planes, std::size_t nb, unsigned short *dst)
+    {
+        const unsigned char *msb = planes;
+        const unsigned char *lsb = planes + nb;
+        std::size_t i = 0;
+        unsigned short prev = 0;
+
+#ifdef __SSE2__
+        __m128i prev_v = _mm_setzero_si128();
+        for (;i + 16 <= nb;i = i + 16)
+        {
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(msb + i));
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lsb + i));
+            __m128i d0 = _mm_unpacklo_epi8(lo, hi);
+            __m128i d1 = _mm_unpackhi_epi8(lo, hi);
+
+            // Prefix sums within each vector, then add the last value of the previous vector
+            d0 = _mm_add_epi16(d0, _mm_slli_si128(d0, 2));
+            d0 = _mm_add_epi16(d0, _mm_slli_si128(d0, 4));
+            d0 = _mm_add_epi16(d0, _mm_slli_si128(d0, 8));
+            d0 = _mm_add_epi16(d0, prev_v);
+            prev_v = _mm_shufflehi_epi16(d0, 0xFF);
+            prev_v = _mm_unpackhi_epi64(prev_v, prev_v);
+
+            d1 = _mm_add_epi16(d1, _mm_slli_si128(d1, 2));
+            d1 = _mm_add_epi16(d1, _mm_slli_si128(d1, 4));
+            d1 = _mm_add_epi16(d1, _mm_slli_si128(d1, 8));
+            d1 = _mm_add_epi16(d1, prev_v);
+            prev_v = _mm_shufflehi_epi16(d1, 0xFF);
+            prev_v = _mm_unpackhi_epi64(prev_v, prev_v);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), d0);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), d1);
+        }
+        if (i != 0)
+            prev = dst[i - 1];
+#endif
+
+        for (;i < nb;i++)
+        {
+            prev = (unsigned short)(prev + ((msb[i] << 8) | lsb[i]));
+            dst[i] = prev;
+        }
+    }
+
+    // ----------------------------------------------------------------
+    // Delta + shuffle of 8 bits channels (1 channel for gray, 3 for RGB)
+    // ----------------------------------------------------------------
+    void shuffle8(const unsigned char *src, std::size_t nb, int nb_chan, unsigned char *planes)
+    {
+        for (int c = 0;c < nb_chan;c++)
+        {
+            unsigned char *plane = planes + (c * nb);
+            unsigned char prev = 0;
+            for (std::size_t i = 0;i < nb;i++)
+            {
+                unsigned char val = src[(i * nb_chan) + c];
+                plane[i] = (unsigned char)(val - prev);
+                prev = val;
+            }
+        }
+    }
+
+    void unshuffle8(const unsigned char *planes, std::size_t nb, int nb_chan, unsigned char *dst)
+    {
+        for (int c = 0;c < nb_chan;c++)
+        {
+            const unsigned char *plane = planes + (c * nb);
+            unsigned char prev = 0;
+            for (std::size_t i = 0;i < nb;i++)
+            {
+                prev = (unsigned char)(prev + plane[i]);
+                dst[(i * nb_chan) + c] = prev;
+            }
+        }
+    }
+
+    class DeltaShuffleLzCodec: public EncodedCodec
+    {
+        public:
+            std::string get_name() override {return DELTA_SHUFFLE_LZ;}
+
+            void compress(const unsigned char *data, std::size_t nb_elt, int elt_size,
+                    std::vector<unsigned char> &out) override
+            {
+                std::size_t size = nb_elt * elt_size;
+                std::vector<unsigned char> planes(size);
+                if (elt_size == 2)
+                    shuffle16(reinterpret_cast<const unsigned short *>(data), nb_elt, planes.data());
+                else
+                    shuffle8(data, nb_elt, elt_size, planes.data());
+
+                std::size_t start = out.size();
+                out.reserve(start + 1 + size + (size / 255) + 16);
+                out.push_back(METHOD_LZ);
+                lz_compress(planes.data(), size, out);
+
+                // Store the planes if the LZ coder does not help
+                if (out.size() - start > size + 1)
+                {
+                    out.resize(start);
+                    out.push_back(METHOD_STORED);
+                    out.insert(out.end(), planes.begin(), planes.end());
+                }
+            }
+
+            void decompress(const unsigned char *data, std::size_t size, std::size_t nb_elt, int elt_size,
+                    unsigned char *out) override
+            {
+                if (size < 1)
+                    codec_error("Truncated DELTA_SHUFFLE_LZ data");
+
+                std::size_t out_size = nb_elt * elt_size;
+                std::vector<unsigned char> planes(out_size);
+                if (data[0] == METHOD_LZ)
+                    lz_decompress(data + 1, size - 1, planes.data(), out_size);
+                else if (data[0] == METHOD_STORED && size - 1 == out_size)
+                    std::copy(data + 1, data + size, planes.begin());
+                else
+                    codec_error("Corrupted DELTA_SHUFFLE_LZ data");
+
+                if (elt_size == 2)
+                    unshuffle16(planes.data(), nb_elt, reinterpret_cast<unsigned short *>(out));
+                else
+                    unshuffle8(planes.data(), nb_elt, elt_size, out);
+            }
+    };
+
+    // ----------------------------------------------------------------
+    // The codec registry (with the built-in codec)
+    // ----------------------------------------------------------------
+    omni_mutex &codec_mutex()
+    {
+        static omni_mutex the_mutex;
+        return the_mutex;
+    }
+
+    std::map<std::string, std::unique_ptr<EncodedCodec>> &codec_map()
+    {
+        static std::map<std::string, std::unique_ptr<EncodedCodec>> the_map = []() {
+            std::map<std::string, std::unique_ptr<EncodedCodec>> m;
+            m[DELTA_SHUFFLE_LZ].reset(new DeltaShuffleLzCodec());
+            return m;
+        }();
+        return the_map;
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void EncodedAttribute::register_codec(EncodedCodec *codec) {
+
+    std::unique_ptr<EncodedCodec> codec_ptr(codec);
+    std::string name = codec_ptr->get_name();
+    if (name.empty() || name.find(CODEC_SEP) != std::string::npos)
+    {
+        TANGO_THROW_EXCEPTION(API_WrongFormat, "Invalid codec name");
+    }
+
+    omni_mutex_lock guard(codec_mutex());
+    auto &codecs = codec_map();
+    if (codecs.find(name) != codecs.end())
+    {
+        TangoSys_OMemStream o;
+        o << "Codec " << name << " already registered" << std::ends;
+        TANGO_THROW_EXCEPTION(API_WrongFormat, o.str());
+    }
+    codecs[name] = std::move(codec_ptr);
+}
+
+// ----------------------------------------------------------------------------
+
+std::vector<std::string> EncodedAttribute::get_codec_list() {
+
+    std::vector<std::string> names;
+    omni_mutex_lock guard(codec_mutex());
+    for (const auto &codec : codec_map())
+        names.push_back(codec.first);
+    return names;
+}
+
+// ----------------------------------------------------------------------------
+
+EncodedCodec *EncodedAttribute::get_codec(const std::string &format,const char *base_format) {
+
+    std::string prefix = std::string(base_format) + CODEC_SEP;
+    if (format.size() <= prefix.size() || format.compare(0, prefix.size(), prefix) != 0)
+        return NULL;
+
+    std::string name = format.substr(prefix.size());
+    omni_mutex_lock guard(codec_mutex());
+    auto &codecs = codec_map();
+    auto pos = codecs.find(name);
+    if (pos == codecs.end())
+    {
+        TangoSys_OMemStream o;
+        o << "Unknown codec " << name << std::ends;
+        TANGO_THROW_EXCEPTION(API_WrongFormat, o.str());
+    }
+    return pos->second.get();
+}
+
+// ----------------------------------------------------------------------------
+
+void EncodedAttribute::codec_encode(const char *base_format,const unsigned char *data,int elt_size,
+        int width,int height,const std::string &codec) {
+
+    std::string local_format = std::string(base_format) + CODEC_SEP + codec;
+    EncodedCodec *codec_ptr = get_codec(local_format, base_format);
+    if (codec_ptr == NULL)
+    {
+        TANGO_THROW_EXCEPTION(API_WrongFormat, "Invalid codec name");
+    }
+
+    take_buffer();
+
+    // Store image dimension (big endian) and then the compressed image
+    std::vector<unsigned char> &out = ext->codec_buffer;
+    out.clear();
+    out.push_back((unsigned char)( (width>>8) & 0xFF ));
+    out.push_back((unsigned char)( width & 0xFF ));
+    out.push_back((unsigned char)( (height>>8) & 0xFF ));
+    out.push_back((unsigned char)( height & 0xFF ));
+
+    try
+    {
+        codec_ptr->compress(data, (std::size_t)width * height, elt_size, out);
+    }
+    catch (...)
+    {
+        release_buffer();
+        throw;
+    }
+
+    memcpy(reserve_buffer(out.size()), out.data(), out.size());
+
+    // The format string is kept with its pool buffer: the previous buffer format may still be in use
+    ext->codec_format[index] = local_format;
+    format = const_cast<char *>(ext->codec_format[index].c_str());
+    INC_INDEX()
+}
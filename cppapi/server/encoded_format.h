@@ -60,6 +60,14 @@ namespace Tango
 
 #define			RGB_24			"RGB24"
 
+//
+// Lossless codecs. The codec name is added to the GRAY8, GRAY16 or RGB24 format after a separator
+// (GRAY16:DELTA_SHUFFLE_LZ for instance)
+//
+
+#define			CODEC_SEP			":"
+#define			DELTA_SHUFFLE_LZ	"DELTA_SHUFFLE_LZ"
+
 } // End of Tango namespace
 
 #endif // _ENCODED_FORMAT_H
@@ -1038,6 +1038,90 @@ DevVarLongStringArray *DServer::zmq_event_subscription_change(const Tango::DevVa
 	return ret_data;
 }
 
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DServer::zmq_event_subscription_changes()
+//
+// description :
+//		method to execute the command ZmqEventSubscriptionChanges command. It does the job of the
+//		ZmqEventSubscriptionChange command for a list of subscriptions. An error for one subscription does not stop
+//		the other ones.
+//
+// args :
+// 		in :
+//			- argin : The command input argument. SUB_CHANGES_ARG_NB strings per subscription (device name,
+//					  attribute/pipe name, action, event name and Tango client lib release)
+//
+// returns :
+//		The command output data. SUB_CHANGES_LG_NB numbers per subscription:
+//			- Lg[0] : 0 if the subscription succeeded, 1 otherwise
+//			- Lg[1] : The number of strings for this subscription
+//			- Lg[2] to Lg[7] : The ZmqEventSubscriptionChange command numbers (0 in case of error)
+//		The subscription strings are the ZmqEventSubscriptionChange command strings. In case of error, they are the
+//		reason, description and origin of each error.
+//
+//-------------------------------------------------------------------------------------------------------------------
+DevVarLongStringArray *DServer::zmq_event_subscription_changes(const Tango::DevVarStringArray *argin)
+{
+	unsigned int nb_sub = argin->length() / SUB_CHANGES_ARG_NB;
+	if ((nb_sub == 0) || (argin->length() % SUB_CHANGES_ARG_NB != 0))
+	{
+		TangoSys_OMemStream o;
+		o << "Wrong number of input arguments, needs " << SUB_CHANGES_ARG_NB << " per subscription i.e. device name, ";
+		o << "attribute/pipe name, action, event name, Tango lib release" << std::ends;
+
+		TANGO_THROW_EXCEPTION(API_WrongNumberOfArgs, o.str());
+	}
+
+	std::unique_ptr<Tango::DevVarLongStringArray> ret_data(new Tango::DevVarLongStringArray());
+	ret_data->lvalue.length(nb_sub * SUB_CHANGES_LG_NB);
+
+	DevVarStringArray sub_in;
+	sub_in.length(SUB_CHANGES_ARG_NB);
+
+	for (unsigned int loop = 0;loop < nb_sub;loop++)
+	{
+		for (int i = 0;i < SUB_CHANGES_ARG_NB;i++)
+			sub_in[i] = Tango::string_dup((*argin)[(loop * SUB_CHANGES_ARG_NB) + i].in());
+
+		DevLong *lg = ret_data->lvalue.get_buffer() + (loop * SUB_CHANGES_LG_NB);
+		for (int i = 0;i < SUB_CHANGES_LG_NB;i++)
+			lg[i] = 0;
+
+		unsigned int str_nb = ret_data->svalue.length();
+		try
+		{
+			std::unique_ptr<DevVarLongStringArray> sub_out(zmq_event_subscription_change(&sub_in));
+
+			unsigned int nb_lg = std::min(sub_out->lvalue.length(),(CORBA::ULong)(SUB_CHANGES_LG_NB - 2));
+			for (unsigned int i = 0;i < nb_lg;i++)
+				lg[i + 2] = sub_out->lvalue[i];
+
+			unsigned int nb_str = sub_out->svalue.length();
+			ret_data->svalue.length(str_nb + nb_str);
+			for (unsigned int i = 0;i < nb_str;i++)
+				ret_data->svalue[str_nb + i] = Tango::string_dup(sub_out->svalue[i].in());
+			lg[1] = nb_str;
+		}
+		catch (Tango::DevFailed &e)
+		{
+			unsigned int nb_err = e.errors.length();
+			ret_data->svalue.length(str_nb + (nb_err * 3));
+			for (unsigned int i = 0;i < nb_err;i++)
+			{
+				ret_data->svalue[str_nb + (i * 3)] = Tango::string_dup(e.errors[i].reason.in());
+				ret_data->svalue[str_nb + (i * 3) + 1] = Tango::string_dup(e.errors[i].desc.in());
+				ret_data->svalue[str_nb + (i * 3) + 2] = Tango::string_dup(e.errors[i].origin.in());
+			}
+			lg[0] = 1;
+			lg[1] = nb_err * 3;
+		}
+	}
+
+	return ret_data.release();
+}
+
 //+-----------------------------------------------------------------------------------------------------------------
 //
 // method :
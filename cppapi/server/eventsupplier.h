@@ -66,6 +66,7 @@
 #include <sys/time.h>
 #endif
 
+#include <atomic>
 #include <chrono>
 
 namespace Tango
@@ -271,6 +272,12 @@ private :
 #define     LARGE_DATA_THRESHOLD_ENCODED   LARGE_DATA_THRESHOLD * 4
 
 
+struct ZmqEventSupplierStats
+{
+	std::atomic<DevULong64>		nb_events;			// Number of events given to the publisher sockets
+	std::atomic<DevULong64>		nb_bytes;			// Number of event data bytes
+};
+
 class ZmqEventSupplier : public EventSupplier
 {
 public :
@@ -307,6 +314,8 @@ public :
                                   const std::string &event_type,
                                   const std::string &obj_name_lower,
                                   bool intr_change);
+
+	TANGO_IMP static ZmqEventSupplierStats	stats;	// Process wide counters (read by the metrics exporter)
 protected :
 	ZmqEventSupplier(Util *);
 
@@ -108,6 +108,7 @@ constexpr const char* API_MemAttFailedDuringInit        = "API_MemAttFailedDurin
 constexpr const char* API_MemoryAllocation              = "API_MemoryAllocation";
 constexpr const char* API_MethodArgument                = "API_MethodArgument";
 constexpr const char* API_MethodNotFound                = "API_MethodNotFound";
+constexpr const char* API_MetricsExporterFailed         = "API_MetricsExporterFailed";
 constexpr const char* API_MissedEvents                  = "API_MissedEvents";
 constexpr const char* API_NoDataYet                     = "API_NoDataYet";
 constexpr const char* API_NonDatabaseDevice             = "API_NonDatabaseDevice";
@@ -145,6 +146,7 @@ constexpr const char* API_StdException                  = "API_StdException";
 constexpr const char* API_SystemCallFailed              = "API_SystemCallFailed";
 constexpr const char* API_TangoHostNotSet               = "API_TangoHostNotSet";
 constexpr const char* API_ThrowException                = "API_ThrowException";
+constexpr const char* API_TracingFailed                 = "API_TracingFailed";
 constexpr const char* API_UnsupportedAttribute          = "API_UnsupportedAttribute";
 constexpr const char* API_UnsupportedDBaseModifier      = "API_UnsupportedDBaseModifier";
 constexpr const char* API_UnsupportedFeature            = "API_UnsupportedFeature";
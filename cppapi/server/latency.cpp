@@ -0,0 +1,542 @@
+//====================================================================================================================
+//
+// file :               latency.cpp
+//
+// description :        C++ source code for the LatencyHistogram, LatencyRecorder and AutoLatency classes.
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#include <tango.h>
+#include <latency.h>
+#include <monitorprofile.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Tango
+{
+
+namespace
+{
+
+//
+// The histograms recorded by one thread. The key is built from the device name, the request type and the
+// attribute/command name. The mutex is taken by the owner thread for each record and by the reader while merging.
+// dropped is the number of requests recorded by the thread and not stored because the process key set is full
+//
+
+struct LatencyShard
+{
+	LatencyShard();
+	~LatencyShard();
+
+	omni_mutex										mutex;
+	std::unordered_map<std::string,LatencyEntry>	entries;
+	std::string										key;
+	DevULong64										dropped;
+};
+
+thread_local std::unique_ptr<LatencyShard> thread_shard;
+
+omni_mutex shard_list_mutex;
+std::vector<LatencyShard *> shard_list;
+std::unordered_map<std::string,LatencyEntry> retired_entries;
+DevULong64 retired_dropped = 0;
+
+//
+// The histogram keys of the whole process (bounded to LATENCY_MAX_ENTRIES). Only used when a thread records a key
+// for the first time
+//
+
+omni_mutex key_set_mutex;
+std::unordered_set<std::string> key_set;
+
+bool register_key(const std::string &key)
+{
+	omni_mutex_lock sync(key_set_mutex);
+
+	if (key_set.find(key) != key_set.end())
+		return true;
+	if (key_set.size() >= LATENCY_MAX_ENTRIES)
+		return false;
+
+	key_set.insert(key);
+	return true;
+}
+
+void merge_entries(std::map<std::string,LatencyEntry> &result,const std::unordered_map<std::string,LatencyEntry> &entries)
+{
+	for (const auto &elt : entries)
+	{
+		std::map<std::string,LatencyEntry>::iterator ite = result.find(elt.first);
+		if (ite == result.end())
+			result.insert(elt);
+		else
+			ite->second.histo.merge(elt.second.histo);
+	}
+}
+
+LatencyShard::LatencyShard():dropped(0)
+{
+	omni_mutex_lock sync(shard_list_mutex);
+	shard_list.push_back(this);
+}
+
+LatencyShard::~LatencyShard()
+{
+	omni_mutex_lock sync(shard_list_mutex);
+	shard_list.erase(std::remove(shard_list.begin(),shard_list.end(),this),shard_list.end());
+	retired_dropped = retired_dropped + dropped;
+
+	for (auto &elt : entries)
+	{
+		std::unordered_map<std::string,LatencyEntry>::iterator ite = retired_entries.find(elt.first);
+		if (ite == retired_entries.end())
+			retired_entries.insert(std::move(elt));
+		else
+			ite->second.histo.merge(elt.second.histo);
+	}
+}
+
+}
+
+const char *LatencyRecorder::type_names[LAT_TYPE_NB] = {"read","write","command","poll"};
+
+thread_local bool AutoLatency::active = false;
+thread_local bool AutoLatency::resolved = false;
+thread_local std::string AutoLatency::resolved_name;
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		LatencyHistogram::LatencyHistogram
+//
+// description :
+//		Constructor of the LatencyHistogram class. All the buckets are empty
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+LatencyHistogram::LatencyHistogram():count(0),min(0),max(0),sum(0)
+{
+	std::fill(buckets,buckets + LATENCY_BUCKET_NB,0);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		LatencyHistogram::bucket_index
+//
+// description :
+//		Compute the bucket index of a duration. The index is made of the position of the most significant bit and
+//		of the LATENCY_SUB_BUCKET_BITS bits following it
+//
+// argument :
+//		in :
+//			- val : The duration (us)
+//
+// return :
+//		The bucket index
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+size_t LatencyHistogram::bucket_index(DevULong64 val)
+{
+	if (val < LATENCY_SUB_BUCKET_NB)
+		return (size_t)val;
+
+	if (val > 0xFFFFFFFFULL)
+		val = 0xFFFFFFFFULL;
+
+	int msb = 0;
+	while ((val >> (msb + 1)) != 0)
+		msb++;
+
+	size_t sub = (size_t)(val >> (msb - LATENCY_SUB_BUCKET_BITS)) & (LATENCY_SUB_BUCKET_NB - 1);
+	return ((msb - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKET_NB) + sub;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		LatencyHistogram::bucket_upper_bound
+//
+// description :
+//		Return the highest duration counted in a bucket
+//
+// argument :
+//		in :
+//			- ind : The bucket index
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+DevULong64 LatencyHistogram::bucket_upper_bound(size_t ind)
+{
+	if (ind < LATENCY_SUB_BUCKET_NB)
+		return ind;
+
+	int msb = (int)(ind / LATENCY_SUB_BUCKET_NB) + LATENCY_SUB_BUCKET_BITS - 1;
+	DevULong64 sub = ind % LATENCY_SUB_BUCKET_NB;
+	DevULong64 width = 1ULL << (msb - LATENCY_SUB_BUCKET_BITS);
+
+	return ((LATENCY_SUB_BUCKET_NB + sub) * width) + width - 1;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		LatencyHistogram::record
+//
+// description :
+//		Add one duration to the histogram
+//
+// argument :
+//		in :
+//			- val : The duration (us)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void LatencyHistogram::record(DevULong64 val)
+{
+	buckets[bucket_index(val)]++;
+
+	if (count == 0 || val < min)
+		min = val;
+	if (val > max)
+		max = val;
+	sum = sum + val;
+	count++;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		LatencyHistogram::merge
+//
+// description :
+//		Add the counts of another histogram to this one
+//
+// argument :
+//		in :
+//			- other : The other histogram
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+	if (other.count == 0)
+		return;
+
+	for (size_t i = 0;i < LATENCY_BUCKET_NB;i++)
+		buckets[i] = buckets[i] + other.buckets[i];
+
+	if (count == 0 || other.min < min)
+		min = other.min;
+	if (other.max > max)
+		max = other.max;
+	sum = sum + other.sum;
+	count = count + other.count;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		LatencyHistogram::get_percentile
+//
+// description :
+//		Return the duration below which the given part of the recorded durations are. The result is the upper
+//		bound of the bucket where the percentile is (limited to the max recorded duration)
+//
+// argument :
+//		in :
+//			- perc : The percentile (between 0 and 100)
+//
+// return :
+//		The duration (us)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+double LatencyHistogram::get_percentile(double perc) const
+{
+	if (count == 0)
+		return 0.0;
+
+	DevULong64 target = (DevULong64)std::ceil((perc / 100.0) * count);
+	if (target == 0)
+		target = 1;
+
+	DevULong64 cumul = 0;
+	for (size_t i = 0;i < LATENCY_BUCKET_NB;i++)
+	{
+		cumul = cumul + buckets[i];
+		if (cumul >= target)
+			return (double)std::min(bucket_upper_bound(i),max);
+	}
+
+	return (double)max;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		LatencyRecorder::record
+//
+// description :
+//		Record one request duration in the calling thread histograms. The first time the thread records a key, the
+//		key is added to the process key set. Nothing is recorded (the request is only counted as dropped) for a key
+//		which is not in the process key set when this set already has LATENCY_MAX_ENTRIES keys.
+//
+// argument :
+//		in :
+//			- dev_name : The device name (lower case)
+//			- type : The request type
+//			- name : The attribute/command name
+//			- val : The duration (us)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void LatencyRecorder::record(const std::string &dev_name,LatencyType type,const char *name,DevULong64 val)
+{
+	if (!thread_shard)
+		thread_shard.reset(new LatencyShard());
+
+	LatencyShard *shard = thread_shard.get();
+	std::string &key = shard->key;
+	key.assign(dev_name);
+	key.push_back('\n');
+	key.push_back((char)('0' + type));
+	key.push_back('\n');
+	size_t name_pos = key.size();
+	for (const char *ptr = name;*ptr != '\0';ptr++)
+		key.push_back((char)::tolower(*ptr));
+
+	omni_mutex_lock sync(shard->mutex);
+
+	std::unordered_map<std::string,LatencyEntry>::iterator ite = shard->entries.find(key);
+	if (ite == shard->entries.end())
+	{
+		if (register_key(key) == false)
+		{
+			shard->dropped++;
+			return;
+		}
+
+		LatencyEntry entry;
+		entry.device = dev_name;
+		entry.type = type;
+		entry.name = key.substr(name_pos);
+		ite = shard->entries.insert(std::make_pair(key,std::move(entry))).first;
+	}
+
+	ite->second.histo.record(val);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		LatencyRecorder::get_entries
+//
+// description :
+//		Merge the histograms of all the threads of the process (alive or not)
+//
+// argument :
+//		out :
+//			- result : The merged histograms, sorted by device, request type and attribute/command name
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void LatencyRecorder::get_entries(std::vector<LatencyEntry> &result)
+{
+	std::map<std::string,LatencyEntry> merged;
+
+	{
+		omni_mutex_lock sync(shard_list_mutex);
+
+		merge_entries(merged,retired_entries);
+		for (auto shard : shard_list)
+		{
+			omni_mutex_lock shard_sync(shard->mutex);
+			merge_entries(merged,shard->entries);
+		}
+	}
+
+	result.clear();
+	result.reserve(merged.size());
+	for (auto &elt : merged)
+		result.push_back(std::move(elt.second));
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		LatencyRecorder::get_dropped
+//
+// description :
+//		Return the number of requests not recorded because the process key set already had LATENCY_MAX_ENTRIES
+//		keys (all the threads of the process, alive or not)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+DevULong64 LatencyRecorder::get_dropped()
+{
+	omni_mutex_lock sync(shard_list_mutex);
+
+	DevULong64 dropped = retired_dropped;
+	for (auto shard : shard_list)
+	{
+		omni_mutex_lock shard_sync(shard->mutex);
+		dropped = dropped + shard->dropped;
+	}
+
+	return dropped;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		AutoLatency::AutoLatency
+//
+// description :
+//		Constructors of the AutoLatency class for a command (or one attribute), a list of attribute names and a list
+//		of attribute values to be written
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+AutoLatency::AutoLatency(DeviceImpl *d,LatencyType t,const char *n):name(n),names(nullptr),values(nullptr)
+{
+	start(d,t);
+}
+
+AutoLatency::AutoLatency(DeviceImpl *d,LatencyType t,const DevVarStringArray &n):name(nullptr),names(&n),values(nullptr)
+{
+	start(d,t);
+}
+
+AutoLatency::AutoLatency(DeviceImpl *d,LatencyType t,const AttributeValueList_4 &v):name(nullptr),names(nullptr),values(&v)
+{
+	start(d,t);
+}
+
+void AutoLatency::start(DeviceImpl *d,LatencyType t)
+{
+	dev = d;
+	type = t;
+	outermost = !active;
+	if (outermost == true)
+	{
+		active = true;
+		resolved = false;
+
+//
+// The request is the monitor holder identity (the first attribute for a request with several attributes)
+//
+
+		const char *req_name = name;
+		if (names != nullptr && names->length() != 0)
+			req_name = (*names)[0].in();
+		else if (values != nullptr && values->length() != 0)
+			req_name = (*values)[0].name.in();
+		MonitorProfile::set_request(type,dev,req_name);
+
+		start_time = std::chrono::steady_clock::now();
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		AutoLatency::~AutoLatency
+//
+// description :
+//		Record the scope duration for each of the request attributes (or for the command)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+AutoLatency::~AutoLatency()
+{
+	if (outermost == false)
+		return;
+
+	active = false;
+	MonitorProfile::clear_request();
+
+	auto elapsed = std::chrono::steady_clock::now() - start_time;
+	DevULong64 us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+	try
+	{
+		const std::string &dev_name = dev->get_name_lower();
+
+		if (type == LAT_COMMAND)
+		{
+			if (resolved == true)
+				LatencyRecorder::record(dev_name,type,resolved_name.c_str(),us);
+		}
+		else if (name != nullptr)
+			LatencyRecorder::record(dev_name,type,name,us);
+		else if (names != nullptr)
+		{
+			for (CORBA::ULong loop = 0;loop < names->length();loop++)
+				LatencyRecorder::record(dev_name,type,(*names)[loop].in(),us);
+		}
+		else
+		{
+			for (CORBA::ULong loop = 0;loop < values->length();loop++)
+				LatencyRecorder::record(dev_name,type,(*values)[loop].name.in(),us);
+		}
+	}
+	catch (...)
+	{
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		AutoLatency::resolve
+//
+// description :
+//		Give the command name to the outermost command scope of the calling thread once the command has been found.
+//		Only the first call is taken into account (the command of a collocated call done while executing a command
+//		is not the recorded one)
+//
+// argument :
+//		in :
+//			- cmd_name : The command name (lower case)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void AutoLatency::resolve(const std::string &cmd_name)
+{
+	if (active == true && resolved == false)
+	{
+		resolved_name.assign(cmd_name);
+		resolved = true;
+	}
+}
+
+} // End of Tango namespace
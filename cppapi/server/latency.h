@@ -0,0 +1,180 @@
+//====================================================================================================================
+//
+// file :               latency.h
+//
+// description :        Include for the request latency histograms. Latencies of the read, write, command and polling
+//						requests are recorded per device and attribute/command in per thread histograms which are
+//						merged when they are read.
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _LATENCY_H
+#define _LATENCY_H
+
+#include <tango.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Tango
+{
+
+enum LatencyType
+{
+	LAT_READ = 0,
+	LAT_WRITE,
+	LAT_COMMAND,
+	LAT_POLL,
+	LAT_TYPE_NB
+};
+
+//==================================================================================================================
+//
+//			The LatencyHistogram class
+//
+// description :
+//		Log-linear histogram of durations in micro-seconds. Each power of 2 is split in 2^LATENCY_SUB_BUCKET_BITS
+//		buckets (values below 2^LATENCY_SUB_BUCKET_BITS are exact). Durations above 2^32 us are counted in the last
+//		bucket.
+//
+//==================================================================================================================
+
+const size_t LATENCY_SUB_BUCKET_NB = 1 << LATENCY_SUB_BUCKET_BITS;
+const size_t LATENCY_BUCKET_NB = (32 - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKET_NB;
+
+class LatencyHistogram
+{
+public:
+	LatencyHistogram();
+
+	void record(DevULong64);
+	void merge(const LatencyHistogram &);
+
+	DevULong64 get_count() const {return count;}
+	DevULong64 get_min() const {return count == 0 ? 0 : min;}
+	DevULong64 get_max() const {return max;}
+	DevULong64 get_sum() const {return sum;}
+	double get_mean() const {return count == 0 ? 0.0 : (double)sum / count;}
+	double get_percentile(double) const;
+
+	static size_t bucket_index(DevULong64);
+	static DevULong64 bucket_upper_bound(size_t);
+
+private:
+	DevULong64			buckets[LATENCY_BUCKET_NB];
+	DevULong64			count;
+	DevULong64			min;
+	DevULong64			max;
+	DevULong64			sum;
+};
+
+//==================================================================================================================
+//
+//			The LatencyEntry structure
+//
+// description :
+//		The histogram of one request type for one device attribute or command
+//
+//==================================================================================================================
+
+struct LatencyEntry
+{
+	std::string			device;			// The device name (lower case)
+	LatencyType			type;			// The request type
+	std::string			name;			// The attribute or command name (lower case)
+	LatencyHistogram	histo;
+};
+
+//==================================================================================================================
+//
+//			The LatencyRecorder class
+//
+// description :
+//		Record the latencies in the calling thread histograms (one lock owned by the thread, so without contention).
+//		get_entries() merges the histograms of all the threads (and of the threads which have exited)
+//
+//		The set of histogram keys (device, request type, attribute/command) is bounded for the whole process to
+//		LATENCY_MAX_ENTRIES (1024) keys. A new key is checked against this set (under a process wide lock) only the
+//		first time a thread records it. Afterwards, the thread histogram is the fast path. The requests for a new key
+//		when the set is full are dropped and counted (see get_dropped()). A histogram is LATENCY_BUCKET_NB (240)
+//		64 bits counters, about 2 kB with its entry. A thread keeps only the histograms it has recorded, and the
+//		histograms of the exited threads are merged in one set, so both are bounded by the process key set.
+//
+//==================================================================================================================
+
+class LatencyRecorder
+{
+public:
+	static void record(const std::string &,LatencyType,const char *,DevULong64);
+	static void get_entries(std::vector<LatencyEntry> &);
+	static DevULong64 get_dropped();
+	static const char *get_type_name(LatencyType type) {return type_names[type];}
+
+private:
+	static const char *type_names[LAT_TYPE_NB];
+};
+
+//==================================================================================================================
+//
+//			The AutoLatency class
+//
+// description :
+//		Record the duration of its scope for the given request. Only the outermost scope of a thread records (the
+//		read done by the polling thread or a collocated call done while executing a command are not recorded on
+//		their own). A request with several attributes is recorded for each of them. The outermost scope request
+//		is also the identity given to the monitors held by the thread (see monitorprofile.h).
+//		A command is recorded only once it has been found in the device command list (see resolve()), under its
+//		lower case name. A command name sent by a client which is not a device command is not recorded.
+//
+//==================================================================================================================
+
+class AutoLatency
+{
+public:
+	AutoLatency(DeviceImpl *,LatencyType,const char *);
+	AutoLatency(DeviceImpl *,LatencyType,const DevVarStringArray &);
+	AutoLatency(DeviceImpl *,LatencyType,const AttributeValueList_4 &);
+	~AutoLatency();
+
+	static void resolve(const std::string &);
+
+private:
+	void start(DeviceImpl *,LatencyType);
+
+	DeviceImpl								*dev;
+	LatencyType								type;
+	const char								*name;
+	const DevVarStringArray					*names;
+	const AttributeValueList_4				*values;
+	bool									outermost;
+	std::chrono::steady_clock::time_point	start_time;
+
+	static thread_local bool				active;
+	static thread_local bool				resolved;
+	static thread_local std::string			resolved_name;
+};
+
+} // End of Tango namespace
+
+#endif /* _LATENCY_H */
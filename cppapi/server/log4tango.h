@@ -35,6 +35,7 @@
 //-------------------------------------------------------------
 #include <log4tango/Logger.hh>
 #include <log4tango/RollingFileAppender.hh>
+#include <log4tango/BinaryFileAppender.hh>
 #include <log4tango/OstreamAppender.hh>
 #include <log4tango/PatternLayout.hh>
 #include <log4tango/XmlLayout.hh>
@@ -52,62 +53,78 @@
 
 //-------------------------------------------------------------
 // LOGGING MACROS (FOR DEVICE DEVELOPERS)
+// The arguments are not evaluated when the level is disabled
 //-------------------------------------------------------------
 #define LOG_FATAL(X) \
+  if (!log4tango::Logger::is_level_compiled(log4tango::Level::FATAL) || \
+      !get_logger()->is_fatal_enabled()) {} else \
     get_logger()->fatal( \
         ::Tango::logging_detail::basename(__FILE__), __LINE__, \
         TANGO_STRIP_PARENS( TANGO_EXPAND_ARGS X ))
 
 #define LOG_ERROR(X) \
+  if (!log4tango::Logger::is_level_compiled(log4tango::Level::ERROR) || \
+      !API_LOGGER->is_error_enabled()) {} else \
     API_LOGGER->error( \
         ::Tango::logging_detail::basename(__FILE__), __LINE__, \
         TANGO_STRIP_PARENS( TANGO_EXPAND_ARGS X ))
 
 #define LOG_WARN(X) \
+  if (!log4tango::Logger::is_level_compiled(log4tango::Level::WARN) || \
+      !get_logger()->is_warn_enabled()) {} else \
     get_logger()->warn( \
         ::Tango::logging_detail::basename(__FILE__), __LINE__, \
         TANGO_STRIP_PARENS( TANGO_EXPAND_ARGS X ))
 
 #define LOG_INFO(X) \
+  if (!log4tango::Logger::is_level_compiled(log4tango::Level::INFO) || \
+      !get_logger()->is_info_enabled()) {} else \
     get_logger()->info( \
         ::Tango::logging_detail::basename(__FILE__), __LINE__, \
         TANGO_STRIP_PARENS( TANGO_EXPAND_ARGS X ))
 
 #define LOG_DEBUG(X) \
+  if (!log4tango::Logger::is_level_compiled(log4tango::Level::DEBUG) || \
+      !get_logger()->is_debug_enabled()) {} else \
     get_logger()->debug( \
         ::Tango::logging_detail::basename(__FILE__), __LINE__, \
         TANGO_STRIP_PARENS( TANGO_EXPAND_ARGS X ))
 
 #define DEV_FATAL_STREAM(device) \
-  if (device->get_logger()->is_fatal_enabled()) \
+  if (log4tango::Logger::is_level_compiled(log4tango::Level::FATAL) && \
+      device->get_logger()->is_fatal_enabled()) \
     device->get_logger()->fatal_stream() \
       << log4tango::_begin_log \
       << log4tango::LoggerStream::SourceLocation{ \
           ::Tango::logging_detail::basename(__FILE__), __LINE__}
 
 #define DEV_ERROR_STREAM(device) \
-  if (device->get_logger()->is_error_enabled()) \
+  if (log4tango::Logger::is_level_compiled(log4tango::Level::ERROR) && \
+      device->get_logger()->is_error_enabled()) \
     device->get_logger()->error_stream() \
       << log4tango::_begin_log \
       << log4tango::LoggerStream::SourceLocation{ \
           ::Tango::logging_detail::basename(__FILE__), __LINE__}
 
 #define DEV_WARN_STREAM(device) \
-  if (device->get_logger()->is_warn_enabled()) \
+  if (log4tango::Logger::is_level_compiled(log4tango::Level::WARN) && \
+      device->get_logger()->is_warn_enabled()) \
     device->get_logger()->warn_stream() \
       << log4tango::_begin_log \
       << log4tango::LoggerStream::SourceLocation{ \
           ::Tango::logging_detail::basename(__FILE__), __LINE__}
 
 #define DEV_INFO_STREAM(device) \
-  if (device->get_logger()->is_info_enabled()) \
+  if (log4tango::Logger::is_level_compiled(log4tango::Level::INFO) && \
+      device->get_logger()->is_info_enabled()) \
     device->get_logger()->info_stream() \
       << log4tango::_begin_log \
       << log4tango::LoggerStream::SourceLocation{ \
           ::Tango::logging_detail::basename(__FILE__), __LINE__}
 
 #define DEV_DEBUG_STREAM(device) \
-  if (device->get_logger()->is_debug_enabled()) \
+  if (log4tango::Logger::is_level_compiled(log4tango::Level::DEBUG) && \
+      device->get_logger()->is_debug_enabled()) \
     device->get_logger()->debug_stream() \
       << log4tango::_begin_log \
       << log4tango::LoggerStream::SourceLocation{ \
@@ -222,6 +222,52 @@ CORBA::Any *GetLoggingTarget::execute (DeviceImpl *device, const CORBA::Any &in_
 	return insert((static_cast<DServer *>(device))->get_logging_target(std::string(tmp_str)));
 }
 
+//+-------------------------------------------------------------------------
+//
+// method :		GetLoggingDropped::GetLoggingDropped
+//
+// description :  Constructor for Command class GetLoggingDropped
+//
+//--------------------------------------------------------------------------
+GetLoggingDropped::GetLoggingDropped (const char *name,
+				    Tango::CmdArgType in,
+				    Tango::CmdArgType out,
+				    const std::string &in_desc,
+				    const std::string &out_desc)
+ :  Command(name, in, out)
+{
+  set_in_type_desc(const_cast<std::string&>(in_desc));
+  set_out_type_desc(const_cast<std::string&>(out_desc));
+}
+
+//+-------------------------------------------------------------------------
+//
+// method :		GetLoggingDropped::execute
+//
+// description :	Trigger the execution of the method implementing
+//			the GetLoggingDropped command of the DServerClass
+//
+//--------------------------------------------------------------------------
+CORBA::Any *GetLoggingDropped::execute (DeviceImpl *device, const CORBA::Any &in_any)
+{
+
+	TANGO_LOG_DEBUG << "GetLoggingDropped::execute(): arrived " << std::endl;
+
+//
+// Extract the input data
+//
+	const char* tmp_str;
+	if ((in_any >>= tmp_str) == false)
+	{
+		TANGO_THROW_EXCEPTION(API_IncompatibleCmdArgumentType, "Imcompatible command argument type, expected type is : DevString");
+	}
+
+//
+// Return to caller
+//
+	return insert((static_cast<DServer *>(device))->get_logging_dropped(std::string(tmp_str)));
+}
+
 //+-------------------------------------------------------------------------
 //
 // method :		SetLoggingLevel::SetLoggingLevel
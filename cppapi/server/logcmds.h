@@ -106,6 +106,29 @@ public:
 	virtual CORBA::Any *execute(DeviceImpl *device, const CORBA::Any &in_any);
 };
 
+//=============================================================================
+//
+//			The GetLoggingDropped class
+//
+// description :	Class implementing the GetLoggingDropped command.
+//			This command returns the number of log records dropped by
+//			each device logging target of a device (target buffer full).
+//
+//=============================================================================
+class GetLoggingDropped : public Command
+{
+public:
+	GetLoggingDropped (const char *cmd_name,
+		    Tango::CmdArgType in,
+		    Tango::CmdArgType out,
+		    const std::string &in_desc,
+		    const std::string &out_desc);
+
+	~GetLoggingDropped() {}
+
+	virtual CORBA::Any *execute(DeviceImpl *device, const CORBA::Any &in_any);
+};
+
 //=============================================================================
 //
 //			The SetLoggingLevel class
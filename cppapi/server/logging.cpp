@@ -83,6 +83,8 @@ std::string Logging::_log_path("");
 size_t Logging::_rft = 0;
 // the cmd line verbose level
 int Logging::_cmd_line_level = 0;
+// true if file targets write asynchronously
+bool Logging::_async_file = false;
 
 //+----------------------------------------------------------------------------
 // method :     Logging::init()
@@ -160,6 +162,8 @@ void Logging::init (const std::string& ds_name, // dserver name
         db_data.push_back(DbDatum("logging_level"));
         // the core-logger's logging target list
         db_data.push_back(DbDatum("logging_target"));
+        // the file targets asynchronous mode (for all the process loggers)
+        db_data.push_back(DbDatum("logging_async"));
         // get properties from TANGO-db
         db.get_device_property(dserver_dev_name, db_data,tg->get_db_cache());
         // set logging path
@@ -201,6 +205,11 @@ void Logging::init (const std::string& ds_name, // dserver name
         // get logging targets
         if (db_data[3].is_empty() == false)
           db_data[3] >> targets;
+        // set file targets asynchronous mode
+        if (db_data[4].is_empty() == false) {
+          db_data[4] >> Logging::_async_file;
+          _VERBOSE(("\tfile targets asynchronous mode is %d\n", Logging::_async_file));
+        }
       } catch (...) {
         _VERBOSE(("\texception caught while handling logging properties\n"));
         // ignore any exception
@@ -348,6 +357,9 @@ void Logging::add_logging_target(log4tango::Logger* logger,
     else if (ltg_type_str == kLogTargetDevice) {
       ltg_type = LOG_DEVICE;
     }
+    else if (ltg_type_str == kLogTargetBinary) {
+      ltg_type = LOG_BINARY;
+    }
     else {
       if (throw_exception) {
         TangoSys_OMemStream o;
@@ -364,11 +376,13 @@ void Logging::add_logging_target(log4tango::Logger* logger,
       case LOG_CONSOLE: {
         appender_name += kDefaultConsoleName;
       } break;
-      case LOG_FILE: {
+      case LOG_FILE:
+      case LOG_BINARY: {
         if (ltg_name_str == kDefaultTargetName) {
           // use default path and file name
           full_file_name  = Logging::_log_path + "/";
-          full_file_name += Logging::dev_to_file_name(logger->get_name()) + ".log";
+          full_file_name += Logging::dev_to_file_name(logger->get_name());
+          full_file_name += (ltg_type == LOG_FILE) ? ".log" : ".blog";
         } else if (ltg_name_str.find('/') !=  std::string::npos) {
           // user specified a "custom" path and file name
           full_file_name = ltg_name_str;
@@ -441,7 +455,33 @@ void Logging::add_logging_target(log4tango::Logger* logger,
             break;
           }
           appender->set_layout(layout);
+          // the layout must be set before switching to the asynchronous mode
+          if (Logging::_async_file) {
+            static_cast<TangoRollingFileAppender*>(appender)->set_async(true);
+          }
         } break;  // case LOG_FILE
+        case LOG_BINARY: {
+          // records are formatted off-line (see log4tango_decode): no layout
+          appender = new log4tango::BinaryFileAppender(appender_name, full_file_name, Logging::_rft * 1024);
+          if (appender == 0) {
+            if (throw_exception) {
+              TangoSys_OMemStream o;
+              o << "Out of memory error" << std::ends;
+              TANGO_THROW_EXCEPTION(API_MemoryAllocation, o.str());
+            }
+            break;
+          }
+          if (appender->is_valid() == false) {
+            delete appender;
+            appender = 0;
+            if (throw_exception) {
+              TangoSys_OMemStream o;
+              o << "Could not open logging file " << full_file_name << std::ends;
+              TANGO_THROW_EXCEPTION(API_CannotOpenFile, o.str());
+            }
+            break;
+          }
+        } break;  // case LOG_BINARY
         case LOG_DEVICE: {
           appender = new TangoAppender(logger->get_name(), appender_name, ltg_name_str);
           if (appender == 0) {
@@ -557,6 +597,9 @@ void Logging::remove_logging_target (const Tango::DevVarStringArray *argin)
       else if (tg_type_str == kLogTargetDevice) {
         tg_type = Tango::LOG_DEVICE;
       }
+      else if (tg_type_str == kLogTargetBinary) {
+        tg_type = Tango::LOG_BINARY;
+      }
       else {
         TangoSys_OMemStream o;
         o << "Logging target type <" << tg_type_str << "> not supported" << std::ends;
@@ -578,11 +621,12 @@ void Logging::remove_logging_target (const Tango::DevVarStringArray *argin)
           // build full appender name (target_type+sep+target_name)
           std::string full_tg_name = tg_type_str + kLogTargetSep;
           // a special case : target is the a file
-          if (tg_type == Tango::LOG_FILE) {
+          if (tg_type == Tango::LOG_FILE || tg_type == Tango::LOG_BINARY) {
             if (tg_name == kDefaultTargetName) {
               // use both default path and file name
               full_tg_name += Logging::_log_path + "/";
-              full_tg_name += Logging::dev_to_file_name(logger->get_name()) + ".log";
+              full_tg_name += Logging::dev_to_file_name(logger->get_name());
+              full_tg_name += (tg_type == Tango::LOG_FILE) ? ".log" : ".blog";
             } else if (tg_name.find('/') !=  std::string::npos) {
               // user specified a "custom" path and file name
               full_tg_name += tg_name;
@@ -683,6 +727,57 @@ Tango::DevVarStringArray* Logging::get_logging_target (const std::string& dev_na
   return ret;
 }
 
+//+----------------------------------------------------------------------------
+// method : Logging::get_logging_dropped
+//-----------------------------------------------------------------------------
+Tango::DevVarLongStringArray* Logging::get_logging_dropped (const std::string& dev_name)
+{
+  Tango::DevVarLongStringArray* ret = 0;
+  try {
+    // trace
+    TANGO_LOG_DEBUG << "Entering Logging::get_logging_dropped " << std::endl;
+    // first check device name (does it exist?)
+    DeviceImpl* dev = 0;
+    try {
+      dev = Tango::Util::instance()->get_device_by_name(dev_name);
+    }
+    catch (Tango::DevFailed &e) {
+      TangoSys_OMemStream o;
+      o << "Device " << dev_name << " not found" << std::ends;
+      TANGO_RETHROW_EXCEPTION(e, API_DeviceNotFound, o.str());
+    }
+    // get device's logger
+    log4tango::Logger *logger = dev->get_logger();
+    if (logger == 0) {
+      TangoSys_OMemStream o;
+      o << "Could not instantiate logger (out of memory error)" << std::ends;
+      TANGO_THROW_EXCEPTION(API_MemoryAllocation, o.str());
+    }
+    // only the device targets buffer (and may drop) their records
+    log4tango::AppenderList al = logger->get_all_appenders();
+    ret = new Tango::DevVarLongStringArray();
+    for (unsigned int i = 0; i != al.size(); i++) {
+      TangoAppender *app = dynamic_cast<TangoAppender*>(al[i]);
+      if (app == 0) {
+        continue;
+      }
+      CORBA::ULong nb = ret->svalue.length();
+      ret->svalue.length(nb + 1);
+      ret->lvalue.length(nb + 1);
+      ret->svalue[nb] = Tango::string_dup(app->get_name().c_str());
+      ret->lvalue[nb] = static_cast<DevLong>(app->get_dropped_count());
+    } // for i
+    // trace
+    TANGO_LOG_DEBUG << "Leaving Logging::get_logging_dropped " << std::endl;
+  }
+  catch (std::exception& e) {
+    TangoSys_OMemStream o;
+    o << "std::exception caught [" << e.what() << "]" << std::ends;
+    TANGO_THROW_EXCEPTION(API_StdException, o.str());
+  }
+  return ret;
+}
+
 //+----------------------------------------------------------------------------
 // method : Logging::set_logging_level
 //-----------------------------------------------------------------------------
@@ -899,6 +994,7 @@ void Logging::set_rolling_file_threshold(log4tango::Logger* logger, size_t rtf)
   std::string::size_type idx;
   TangoRollingFileAppender *rfa;
   std::string prefix = std::string(kLogTargetFile) + kLogTargetSep;
+  std::string binary_prefix = std::string(kLogTargetBinary) + kLogTargetSep;
   // get logger's appender list
   log4tango::AppenderList al = logger->get_all_appenders();
   // for each appender in <al>
@@ -910,6 +1006,10 @@ void Logging::set_rolling_file_threshold(log4tango::Logger* logger, size_t rtf)
       // change its rtf
       rfa->set_maximum_file_size(rtf * 1024);
     }
+    // is it a binary file target? (the new size applies to its next file)
+    else if (al[i]->get_name().find(binary_prefix) == 0) {
+      static_cast<log4tango::BinaryFileAppender*>(al[i])->set_maximum_file_size(rtf * 1024);
+    }
   }
 }
 
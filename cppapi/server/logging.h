@@ -83,8 +83,10 @@ inline const char* basename(const char* path)
 #endif //== compiling TANGO lib ===============================
 
 // Map. TANGO_LOG_INFO to INFO level --------------------------------
+// (nothing is evaluated when the level is not compiled in or disabled)
 #define TANGO_LOG_INFO                             \
-  if (API_LOGGER && API_LOGGER->is_info_enabled()) \
+  if (log4tango::Logger::is_level_compiled(log4tango::Level::INFO) && \
+      API_LOGGER && API_LOGGER->is_info_enabled()) \
     API_LOGGER->info_stream()                      \
       << log4tango::_begin_log       \
       << log4tango::LoggerStream::SourceLocation{ \
@@ -92,7 +94,8 @@ inline const char* basename(const char* path)
 
 // Map. TANGO_LOG_DEBUG to DEBUG level -------------------------------
 #define TANGO_LOG_DEBUG                                       \
-  if (API_LOGGER && API_LOGGER->is_debug_enabled()) \
+  if (log4tango::Logger::is_level_compiled(log4tango::Level::DEBUG) && \
+      API_LOGGER && API_LOGGER->is_debug_enabled()) \
     API_LOGGER->debug_stream()                      \
       << log4tango::_begin_log        \
       << log4tango::LoggerStream::SourceLocation{ \
@@ -161,6 +164,11 @@ public:
    **/
   static DevVarStringArray* get_logging_target (const std::string& dev_name);
 
+  /**
+   * Implementation of the DServer GetLoggingDropped Tango command
+   **/
+  static DevVarLongStringArray* get_logging_dropped (const std::string& dev_name);
+
   /**
    * Implementation of the DServer SetLoggingLevel Tango command
    **/
@@ -248,6 +256,11 @@ private:
    *
    **/
    static int _cmd_line_level;
+
+  /**
+   * True if file targets write asynchronously (logging_async property)
+   **/
+   static bool _async_file;
 };
 
 } // namespace tango
@@ -0,0 +1,585 @@
+//====================================================================================================================
+//
+// file :               metrics.cpp
+//
+// description :        C++ source code for the MetricsExporter class and for the ORB thread counters interceptors
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#include <tango.h>
+#include <metrics.h>
+#include <latency.h>
+#include <blackbox.h>
+#include <eventsupplier.h>
+#include <pollthread.h>
+
+#include <cstring>
+#include <sstream>
+
+#ifndef _TG_WINDOWS_
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+namespace Tango
+{
+
+namespace
+{
+
+//
+// Set while the thread executes a request (a oneway request has no reply, the flag is then still set when the next
+// request arrives)
+//
+
+thread_local bool in_request = false;
+
+const int METRICS_READ_TIMEOUT = 2000;			// Time given to a client to send its request (ms)
+const size_t METRICS_MAX_REQUEST = 8192;		// Max HTTP request size (bytes)
+
+void request_done()
+{
+	if (in_request == true)
+	{
+		in_request = false;
+		MetricsExporter::orb_stats.nb_busy.fetch_sub(1,std::memory_order_relaxed);
+	}
+}
+
+std::string escape_label(const std::string &val)
+{
+	std::string ret;
+	ret.reserve(val.size());
+	for (auto c : val)
+	{
+		if (c == '\\')
+			ret.append("\\\\");
+		else if (c == '"')
+			ret.append("\\\"");
+		else if (c == '\n')
+			ret.append("\\n");
+		else
+			ret.push_back(c);
+	}
+	return ret;
+}
+
+void add_family(std::ostringstream &oss,const char *name,const char *type,const char *help)
+{
+	oss << "# TYPE " << name << " " << type << "\n";
+	oss << "# HELP " << name << " " << help << "\n";
+}
+
+double us_to_s(DevULong64 us)
+{
+	return (double)us / 1000000.0;
+}
+
+}
+
+OrbThreadStats MetricsExporter::orb_stats;
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// function :
+//		metrics_request_received, metrics_reply_sent, metrics_exception_sent
+//
+// description :
+//		The functions called by the omniORB interceptors to count the requests and the ORB threads busy with a
+//		request
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+CORBA::Boolean metrics_request_received(TANGO_UNUSED(omni::omniInterceptors::serverReceiveRequest_T::info_T &info))
+{
+	MetricsExporter::orb_stats.nb_requests.fetch_add(1,std::memory_order_relaxed);
+	if (in_request == false)
+	{
+		in_request = true;
+		MetricsExporter::orb_stats.nb_busy.fetch_add(1,std::memory_order_relaxed);
+	}
+	return true;
+}
+
+CORBA::Boolean metrics_reply_sent(TANGO_UNUSED(omni::omniInterceptors::serverSendReply_T::info_T &info))
+{
+	request_done();
+	return true;
+}
+
+CORBA::Boolean metrics_exception_sent(TANGO_UNUSED(omni::omniInterceptors::serverSendException_T::info_T &info))
+{
+	request_done();
+	return true;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MetricsExporter::MetricsExporter
+//
+// description :
+//		Constructor of the MetricsExporter class. The listening socket is created here so that an error is reported
+//		to the caller. The thread is started by the start() method.
+//
+// argument :
+//		in :
+//			- ep : The endpoint ("<port>", "<ip>:<port>" or "unix:<path>")
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+MetricsExporter::MetricsExporter(const std::string &ep):omni_thread(),endpoint(ep),listen_fd(-1)
+{
+#ifdef _TG_WINDOWS_
+	TANGO_THROW_EXCEPTION(API_MetricsExporterFailed, "The metrics exporter is not supported on Windows");
+#else
+	wake_fd[0] = -1;
+	wake_fd[1] = -1;
+
+	try
+	{
+		if (ep.find("unix:") == 0)
+			open_unix_socket(ep.substr(5));
+		else
+			open_tcp_socket(ep);
+
+		if (::pipe(wake_fd) != 0)
+		{
+			TANGO_THROW_EXCEPTION(API_MetricsExporterFailed, "Can't create the metrics exporter wake-up pipe");
+		}
+	}
+	catch (...)
+	{
+		if (listen_fd != -1)
+			::close(listen_fd);
+		if (unix_path.empty() == false)
+			::unlink(unix_path.c_str());
+		throw;
+	}
+#endif
+}
+
+MetricsExporter::~MetricsExporter()
+{
+#ifndef _TG_WINDOWS_
+	::close(listen_fd);
+	::close(wake_fd[0]);
+	::close(wake_fd[1]);
+	if (unix_path.empty() == false)
+		::unlink(unix_path.c_str());
+#endif
+}
+
+#ifndef _TG_WINDOWS_
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MetricsExporter::open_tcp_socket
+//
+// description :
+//		Create the TCP listening socket. With port 0, the port is chosen by the system and the endpoint is updated
+//
+// argument :
+//		in :
+//			- ep : The endpoint ("<port>" or "<ip>:<port>")
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void MetricsExporter::open_tcp_socket(const std::string &ep)
+{
+	std::string ip("127.0.0.1");
+	std::string port_str(ep);
+
+	std::string::size_type pos = ep.rfind(':');
+	if (pos != std::string::npos)
+	{
+		ip = ep.substr(0,pos);
+		port_str = ep.substr(pos + 1);
+	}
+
+	struct sockaddr_in addr;
+	::memset(&addr,0,sizeof(addr));
+	addr.sin_family = AF_INET;
+
+	int port = -1;
+	std::istringstream iss(port_str);
+	iss >> port;
+	if (!iss || iss.eof() == false || port < 0 || port > 65535 || ::inet_pton(AF_INET,ip.c_str(),&addr.sin_addr) != 1)
+	{
+		std::stringstream o;
+		o << "Wrong metrics exporter endpoint: " << ep << " (\"port\", \"ip:port\" or \"unix:path\" expected)";
+		TANGO_THROW_EXCEPTION(API_MetricsExporterFailed, o.str());
+	}
+	addr.sin_port = htons((unsigned short)port);
+
+	listen_fd = ::socket(AF_INET,SOCK_STREAM,0);
+	if (listen_fd == -1)
+	{
+		TANGO_THROW_EXCEPTION(API_MetricsExporterFailed, "Can't create the metrics exporter socket");
+	}
+
+	int reuse = 1;
+	::setsockopt(listen_fd,SOL_SOCKET,SO_REUSEADDR,&reuse,sizeof(reuse));
+	::fcntl(listen_fd,F_SETFD,FD_CLOEXEC);
+
+	if (::bind(listen_fd,(struct sockaddr *)&addr,sizeof(addr)) != 0 || ::listen(listen_fd,8) != 0)
+	{
+		std::stringstream o;
+		o << "Can't listen on " << ep << " for the metrics exporter: " << ::strerror(errno);
+		TANGO_THROW_EXCEPTION(API_MetricsExporterFailed, o.str());
+	}
+
+	socklen_t len = sizeof(addr);
+	if (::getsockname(listen_fd,(struct sockaddr *)&addr,&len) == 0)
+		endpoint = ip + ':' + std::to_string(ntohs(addr.sin_port));
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MetricsExporter::open_unix_socket
+//
+// description :
+//		Create the Unix listening socket. A file left at the same path (previous run) is removed
+//
+// argument :
+//		in :
+//			- path : The socket path
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void MetricsExporter::open_unix_socket(const std::string &path)
+{
+	struct sockaddr_un addr;
+	::memset(&addr,0,sizeof(addr));
+	addr.sun_family = AF_UNIX;
+
+	if (path.empty() == true || path.size() >= sizeof(addr.sun_path))
+	{
+		std::stringstream o;
+		o << "Wrong metrics exporter Unix socket path: " << path;
+		TANGO_THROW_EXCEPTION(API_MetricsExporterFailed, o.str());
+	}
+	::strcpy(addr.sun_path,path.c_str());
+
+	listen_fd = ::socket(AF_UNIX,SOCK_STREAM,0);
+	if (listen_fd == -1)
+	{
+		TANGO_THROW_EXCEPTION(API_MetricsExporterFailed, "Can't create the metrics exporter socket");
+	}
+	::fcntl(listen_fd,F_SETFD,FD_CLOEXEC);
+
+	::unlink(path.c_str());
+	if (::bind(listen_fd,(struct sockaddr *)&addr,sizeof(addr)) != 0 || ::listen(listen_fd,8) != 0)
+	{
+		std::stringstream o;
+		o << "Can't listen on " << path << " for the metrics exporter: " << ::strerror(errno);
+		TANGO_THROW_EXCEPTION(API_MetricsExporterFailed, o.str());
+	}
+	unix_path = path;
+}
+
+#endif
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MetricsExporter::run_undetached
+//
+// description :
+//		The thread code. Clients are served one after the other until the stop() method is called
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void *MetricsExporter::run_undetached(TANGO_UNUSED(void *ptr))
+{
+#ifndef _TG_WINDOWS_
+	while (true)
+	{
+		struct pollfd fds[2];
+		fds[0].fd = listen_fd;
+		fds[0].events = POLLIN;
+		fds[1].fd = wake_fd[0];
+		fds[1].events = POLLIN;
+
+		int res = ::poll(fds,2,-1);
+		if (res < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		if (fds[1].revents != 0)
+			break;
+
+		if ((fds[0].revents & POLLIN) != 0)
+		{
+			int fd = ::accept(listen_fd,NULL,NULL);
+			if (fd != -1)
+			{
+				try
+				{
+					serve_client(fd);
+				}
+				catch (...)
+				{
+				}
+				::close(fd);
+			}
+		}
+	}
+#endif
+	return NULL;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MetricsExporter::stop
+//
+// description :
+//		Ask the thread to exit and wait for it. The object is deleted by the join
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void MetricsExporter::stop()
+{
+#ifndef _TG_WINDOWS_
+	char c = 0;
+	while (::write(wake_fd[1],&c,1) == -1 && errno == EINTR)
+	{
+	}
+#endif
+	join(NULL);
+}
+
+#ifndef _TG_WINDOWS_
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MetricsExporter::serve_client
+//
+// description :
+//		Read the client HTTP request and send the reply. Only GET on "/" or "/metrics" is accepted
+//
+// argument :
+//		in :
+//			- fd : The client socket
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void MetricsExporter::serve_client(int fd)
+{
+	std::string req;
+	char buf[1024];
+
+	while (req.find("\r\n\r\n") == std::string::npos && req.find("\n\n") == std::string::npos)
+	{
+		struct pollfd pfd;
+		pfd.fd = fd;
+		pfd.events = POLLIN;
+		if (::poll(&pfd,1,METRICS_READ_TIMEOUT) <= 0)
+			return;
+
+		ssize_t nb = ::recv(fd,buf,sizeof(buf),0);
+		if (nb <= 0)
+			return;
+		req.append(buf,nb);
+		if (req.size() > METRICS_MAX_REQUEST)
+			return;
+	}
+
+	std::string method,path;
+	std::istringstream iss(req);
+	iss >> method >> path;
+	std::string::size_type pos = path.find('?');
+	if (pos != std::string::npos)
+		path.erase(pos);
+
+	std::string status("200 OK");
+	std::string type("application/openmetrics-text; version=1.0.0; charset=utf-8");
+	std::string body;
+
+	if (method != "GET")
+	{
+		status = "405 Method Not Allowed";
+		type = "text/plain";
+	}
+	else if (path != "/" && path != "/metrics")
+	{
+		status = "404 Not Found";
+		type = "text/plain";
+	}
+	else
+		collect(body);
+
+	std::string reply = "HTTP/1.0 " + status + "\r\nContent-Type: " + type + "\r\nContent-Length: ";
+	reply = reply + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+
+	int flags = 0;
+#ifdef MSG_NOSIGNAL
+	flags = MSG_NOSIGNAL;
+#endif
+	size_t sent = 0;
+	while (sent < reply.size())
+	{
+		ssize_t nb = ::send(fd,reply.data() + sent,reply.size() - sent,flags);
+		if (nb < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return;
+		}
+		sent = sent + nb;
+	}
+}
+
+#endif
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MetricsExporter::collect
+//
+// description :
+//		Build the OpenMetrics text exposition of the process counters
+//
+// argument :
+//		out :
+//			- out : The exposition text
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void MetricsExporter::collect(std::string &out)
+{
+	std::ostringstream oss;
+	oss.precision(9);
+
+	try
+	{
+		Util *tg = Util::instance(false);
+		add_family(oss,"tango_server","info","Device server identification");
+		oss << "tango_server_info{server=\"" << escape_label(tg->get_ds_name()) << "\",tango_version=\"";
+		oss << escape_label(tg->get_version_str()) << "\"} 1\n";
+	}
+	catch (DevFailed &)
+	{
+	}
+
+//
+// ORB threads
+//
+
+	add_family(oss,"tango_orb_threads","gauge","Number of alive ORB threads");
+	oss << "tango_orb_threads " << orb_stats.nb_threads.load(std::memory_order_relaxed) << "\n";
+	add_family(oss,"tango_orb_busy_threads","gauge","Number of ORB threads executing a request");
+	oss << "tango_orb_busy_threads " << orb_stats.nb_busy.load(std::memory_order_relaxed) << "\n";
+	add_family(oss,"tango_orb_requests","counter","Number of requests received by the ORB");
+	oss << "tango_orb_requests_total " << orb_stats.nb_requests.load(std::memory_order_relaxed) << "\n";
+
+//
+// Black box
+//
+
+	add_family(oss,"tango_blackbox_requests","counter","Number of requests recorded in the devices black box");
+	oss << "tango_blackbox_requests_total{type=\"command\"} " << BlackBox::stats.nb_commands.load(std::memory_order_relaxed) << "\n";
+	oss << "tango_blackbox_requests_total{type=\"read\"} " << BlackBox::stats.nb_reads.load(std::memory_order_relaxed) << "\n";
+	oss << "tango_blackbox_requests_total{type=\"write\"} " << BlackBox::stats.nb_writes.load(std::memory_order_relaxed) << "\n";
+	oss << "tango_blackbox_requests_total{type=\"other\"} " << BlackBox::stats.nb_others.load(std::memory_order_relaxed) << "\n";
+
+//
+// Polling threads
+//
+
+	add_family(oss,"tango_polling_executions","counter","Number of polled object executions");
+	oss << "tango_polling_executions_total " << PollThread::stats.nb_polls.load(std::memory_order_relaxed) << "\n";
+	add_family(oss,"tango_polling_late_executions","counter","Number of polled object executions started late");
+	oss << "tango_polling_late_executions_total " << PollThread::stats.nb_late.load(std::memory_order_relaxed) << "\n";
+	add_family(oss,"tango_polling_lateness_seconds","counter","Sum of the polled object executions lateness");
+	oss << "tango_polling_lateness_seconds_total " << us_to_s(PollThread::stats.late_us.load(std::memory_order_relaxed)) << "\n";
+	add_family(oss,"tango_polling_max_lateness_seconds","gauge","Highest polled object execution lateness");
+	oss << "tango_polling_max_lateness_seconds " << us_to_s(PollThread::stats.max_late_us.load(std::memory_order_relaxed)) << "\n";
+	add_family(oss,"tango_polling_discarded","counter","Number of polled object executions discarded because the polling thread was late");
+	oss << "tango_polling_discarded_total " << PollThread::stats.nb_discarded.load(std::memory_order_relaxed) << "\n";
+
+//
+// Events
+//
+
+	add_family(oss,"tango_events_pushed","counter","Number of events given to the ZMQ publisher sockets");
+	oss << "tango_events_pushed_total " << ZmqEventSupplier::stats.nb_events.load(std::memory_order_relaxed) << "\n";
+	add_family(oss,"tango_events_pushed_bytes","counter","Number of event data bytes given to the ZMQ publisher sockets");
+	oss << "tango_events_pushed_bytes_total " << ZmqEventSupplier::stats.nb_bytes.load(std::memory_order_relaxed) << "\n";
+
+//
+// Serialization monitors
+//
+
+	add_family(oss,"tango_monitor_waits","counter","Number of monitor acquisitions which had to wait for another thread");
+	oss << "tango_monitor_waits_total " << TangoMonitor::stats.nb_waits.load(std::memory_order_relaxed) << "\n";
+	add_family(oss,"tango_monitor_wait_seconds","counter","Time spent waiting for monitors");
+	oss << "tango_monitor_wait_seconds_total " << us_to_s(TangoMonitor::stats.wait_us.load(std::memory_order_relaxed)) << "\n";
+	add_family(oss,"tango_monitor_timeouts","counter","Number of monitor acquisitions given up after the monitor timeout");
+	oss << "tango_monitor_timeouts_total " << TangoMonitor::stats.nb_timeouts.load(std::memory_order_relaxed) << "\n";
+
+//
+// Request latencies
+//
+
+	std::vector<LatencyEntry> entries;
+	LatencyRecorder::get_entries(entries);
+
+	const double quantiles[] = {0.5,0.9,0.99,0.999};
+
+	add_family(oss,"tango_request_latency_seconds","summary","Request latency per device attribute/command and request type");
+	for (const auto &entry : entries)
+	{
+		std::string labels = "device=\"" + escape_label(entry.device) + "\",type=\"" + LatencyRecorder::get_type_name(entry.type);
+		labels = labels + "\",name=\"" + escape_label(entry.name) + "\"";
+
+		for (auto q : quantiles)
+		{
+			oss << "tango_request_latency_seconds{" << labels << ",quantile=\"" << q << "\"} ";
+			oss << us_to_s((DevULong64)entry.histo.get_percentile(q * 100.0)) << "\n";
+		}
+		oss << "tango_request_latency_seconds_sum{" << labels << "} " << us_to_s(entry.histo.get_sum()) << "\n";
+		oss << "tango_request_latency_seconds_count{" << labels << "} " << entry.histo.get_count() << "\n";
+	}
+	add_family(oss,"tango_request_latency_dropped","counter","Number of requests not recorded because the thread latency histograms number was at its limit");
+	oss << "tango_request_latency_dropped_total " << LatencyRecorder::get_dropped() << "\n";
+
+	oss << "# EOF\n";
+	out = oss.str();
+}
+
+} // End of Tango namespace
@@ -0,0 +1,105 @@
+//====================================================================================================================
+//
+// file :               metrics.h
+//
+// description :        Include for the MetricsExporter class. The exporter is an optional thread serving the device
+//						server internal counters in the OpenMetrics text format on a loopback HTTP port or on a Unix
+//						socket.
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _METRICS_H
+#define _METRICS_H
+
+#include <tango.h>
+#include <omniORB4/omniInterceptors.h>
+#include <atomic>
+#include <string>
+
+namespace Tango
+{
+
+CORBA::Boolean metrics_request_received(omni::omniInterceptors::serverReceiveRequest_T::info_T &);
+CORBA::Boolean metrics_reply_sent(omni::omniInterceptors::serverSendReply_T::info_T &);
+CORBA::Boolean metrics_exception_sent(omni::omniInterceptors::serverSendException_T::info_T &);
+
+//==================================================================================================================
+//
+//			The OrbThreadStats structure
+//
+// description :
+//		Process wide counters of the ORB threads, updated by the omniORB interceptors
+//
+//==================================================================================================================
+
+struct OrbThreadStats
+{
+	std::atomic<DevLong64>		nb_threads;			// Number of alive ORB threads
+	std::atomic<DevLong64>		nb_busy;			// Number of ORB threads executing a request
+	std::atomic<DevULong64>		nb_requests;		// Number of requests received
+};
+
+//==================================================================================================================
+//
+//			The MetricsExporter class
+//
+// description :
+//		Thread answering the HTTP GET requests received on its listening socket with the OpenMetrics text exposition
+//		of the process counters. The endpoint is "<port>" or "<ip>:<port>" for TCP (the default ip is 127.0.0.1)
+//		or "unix:<path>" for a Unix socket. Only atomic counters are read, the only locks taken are the
+//		latency histograms thread locks (see LatencyRecorder), each one for the time needed to copy it.
+//
+//==================================================================================================================
+
+class MetricsExporter: public omni_thread
+{
+public:
+	MetricsExporter(const std::string &);
+
+	void *run_undetached(void *);
+	void start() {start_undetached();}
+	void stop();
+
+	const std::string &get_endpoint() {return endpoint;}
+
+	static void collect(std::string &);
+
+	TANGO_IMP static OrbThreadStats	orb_stats;
+
+private:
+	~MetricsExporter();
+
+	void open_tcp_socket(const std::string &);
+	void open_unix_socket(const std::string &);
+	void serve_client(int);
+
+	std::string				endpoint;
+	std::string				unix_path;
+	int						listen_fd;
+	int						wake_fd[2];
+};
+
+} // End of Tango namespace
+
+#endif /* _METRICS_H */
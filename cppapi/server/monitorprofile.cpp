@@ -0,0 +1,239 @@
+//====================================================================================================================
+//
+// file :               monitorprofile.cpp
+//
+// description :        C++ source code for the MonitorProfile class and for the TangoMonitor profile methods
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#include <tango.h>
+#include <monitorprofile.h>
+
+namespace Tango
+{
+
+namespace
+{
+
+//
+// The request executed by the thread (the outermost AutoLatency scope). The name points to the request argument,
+// it is valid until the request end
+//
+
+struct MonitorRequest
+{
+	LatencyType			type;
+	DeviceImpl			*dev;
+	const char			*name;
+};
+
+thread_local MonitorRequest thread_request = {LAT_TYPE_NB,nullptr,nullptr};
+
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		TangoMonitor::~TangoMonitor
+//
+// description :
+//		Destructor of the TangoMonitor class
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+TangoMonitor::~TangoMonitor()
+{
+	delete profile;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		TangoMonitor::enable_profile
+//
+// description :
+//		Start recording the monitor contention profile. Done for the serialization monitors (device, class and
+//		process) when they are created
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void TangoMonitor::enable_profile()
+{
+	omni_mutex_lock guard(*this);
+	if (profile == NULL)
+		profile = new MonitorProfile();
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		TangoMonitor::get_profile
+//
+// description :
+//		Get a copy of the monitor contention profile
+//
+// argument :
+//		out :
+//			- data : The profile
+//
+// return :
+//		False if the monitor profile is not recorded
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+bool TangoMonitor::get_profile(MonitorProfileData &data)
+{
+	omni_mutex_lock guard(*this);
+	if (profile == NULL)
+		return false;
+
+	data = profile->get_data();
+	return true;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		TangoMonitor::profile_acquire, TangoMonitor::profile_timeout, TangoMonitor::profile_release
+//
+// description :
+//		Forward the monitor events to its profile. Called by the inline monitor methods with the monitor mutex
+//		locked
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void TangoMonitor::profile_acquire(DevULong64 wait_us,bool waited)
+{
+	profile->acquire(wait_us,waited);
+}
+
+void TangoMonitor::profile_timeout(DevULong64 wait_us)
+{
+	profile->timeout(wait_us);
+}
+
+void TangoMonitor::profile_release()
+{
+	profile->release();
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MonitorProfile::acquire, MonitorProfile::timeout
+//
+// description :
+//		Record an acquisition (and start the hold time measurement) or an acquisition given up after the monitor
+//		timeout
+//
+// argument :
+//		in :
+//			- wait_us : The wait time (us)
+//			- waited : Set to true if the monitor was held by another thread
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void MonitorProfile::acquire(DevULong64 wait_us,bool waited)
+{
+	data.nb_acquires++;
+	if (waited == true)
+		data.nb_waits++;
+	data.wait.record(wait_us);
+	hold_start = std::chrono::steady_clock::now();
+}
+
+void MonitorProfile::timeout(DevULong64 wait_us)
+{
+	data.nb_timeouts++;
+	data.wait.record(wait_us);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MonitorProfile::release
+//
+// description :
+//		Record the hold time. The request executed by the thread is kept if this is the longest hold
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void MonitorProfile::release()
+{
+	auto elapsed = std::chrono::steady_clock::now() - hold_start;
+	DevULong64 us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+	bool longest = data.hold.get_count() == 0 || us > data.hold.get_max();
+	data.hold.record(us);
+	if (longest == false)
+		return;
+
+	try
+	{
+		const MonitorRequest &req = thread_request;
+		if (req.dev != nullptr)
+		{
+			data.holder_type = LatencyRecorder::get_type_name(req.type);
+			data.holder_name = req.dev->get_name();
+			if (req.name != nullptr)
+				data.holder_name = data.holder_name + '/' + req.name;
+		}
+		else
+		{
+			data.holder_type = "unknown";
+			data.holder_name.clear();
+		}
+	}
+	catch (...)
+	{
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MonitorProfile::set_request, MonitorProfile::clear_request
+//
+// description :
+//		Set or clear the request executed by the calling thread
+//
+// argument :
+//		in :
+//			- type : The request type
+//			- dev : The device
+//			- name : The attribute or command name (may be NULL)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void MonitorProfile::set_request(LatencyType type,DeviceImpl *dev,const char *name)
+{
+	thread_request = {type,dev,name};
+}
+
+void MonitorProfile::clear_request()
+{
+	thread_request = {LAT_TYPE_NB,nullptr,nullptr};
+}
+
+} // End of Tango namespace
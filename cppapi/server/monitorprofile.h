@@ -0,0 +1,96 @@
+//====================================================================================================================
+//
+// file :               monitorprofile.h
+//
+// description :        Include for the serialization monitors contention profile. The device, class and process
+//						monitors record their acquisitions, the time spent waiting for them, the time they are held
+//						and the request which held them the longest time.
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _MONITORPROFILE_H
+#define _MONITORPROFILE_H
+
+#include <tango.h>
+#include <latency.h>
+#include <chrono>
+#include <string>
+
+namespace Tango
+{
+
+//==================================================================================================================
+//
+//			The MonitorProfileData structure
+//
+// description :
+//		The contention profile of one monitor. Only the outermost acquisitions of a thread are counted, an
+//		acquisition which did not wait is recorded with a 0 us wait. Durations are in micro-seconds.
+//
+//==================================================================================================================
+
+struct MonitorProfileData
+{
+	MonitorProfileData():nb_acquires(0),nb_waits(0),nb_timeouts(0) {}
+
+	DevULong64			nb_acquires;		// Number of acquisitions
+	DevULong64			nb_waits;			// Number of acquisitions which had to wait for another thread
+	DevULong64			nb_timeouts;		// Number of acquisitions given up after the monitor timeout
+	LatencyHistogram	wait;				// Wait time (acquisitions and timeouts)
+	LatencyHistogram	hold;				// Hold time
+	std::string			holder_type;		// Request type of the longest hold (read, write, command, poll or unknown)
+	std::string			holder_name;		// Object name (device/attribute or device/command) of the longest hold
+};
+
+//==================================================================================================================
+//
+//			The MonitorProfile class
+//
+// description :
+//		Contention profile of one monitor. Its methods are called by the monitor with its mutex locked. The request
+//		holding the monitor is the request executed by the thread, set by the AutoLatency class.
+//
+//==================================================================================================================
+
+class MonitorProfile
+{
+public:
+	MonitorProfile() {}
+
+	void acquire(DevULong64,bool);
+	void timeout(DevULong64);
+	void release();
+	const MonitorProfileData &get_data() {return data;}
+
+	static void set_request(LatencyType,DeviceImpl *,const char *);
+	static void clear_request();
+
+private:
+	MonitorProfileData						data;
+	std::chrono::steady_clock::time_point	hold_start;
+};
+
+} // End of Tango namespace
+
+#endif /* _MONITORPROFILE_H */
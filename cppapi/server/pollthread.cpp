@@ -32,6 +32,7 @@
 
 #include <tango.h>
 #include <eventsupplier.h>
+#include <latency.h>
 #include <pollthread.tpp>
 
 #include <iomanip>
@@ -57,6 +58,7 @@ Dur duration_abs(Dur d)
 DeviceImpl *PollThread::dev_to_del = NULL;
 std::string PollThread::name_to_del = "";
 PollObjType PollThread::type_to_del = Tango::POLL_CMD;
+PollThreadStats PollThread::stats;
 
 //+-----------------------------------------------------------------------------------------------------------------
 //
@@ -768,10 +770,12 @@ void PollThread::one_more_poll()
 		switch (tmp.type)
 		{
 		case Tango::POLL_CMD:
+			store_lateness(tmp);
 			poll_cmd(tmp);
 			break;
 
 		case Tango::POLL_ATTR:
+			store_lateness(tmp);
 			poll_attr(tmp);
 			break;
 
@@ -876,6 +880,38 @@ void PollThread::one_more_poll()
     tune_ctr--;
 }
 
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollThread::store_lateness
+//
+// description :
+//		Update the polling counters with the delay between the work item wake up date and now
+//
+// argument :
+//		in :
+//			- item : The work item about to be executed
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void PollThread::store_lateness(const WorkItem &item)
+{
+	stats.nb_polls.fetch_add(1,std::memory_order_relaxed);
+
+	auto late = PollClock::now() - item.wake_up_date;
+	if (late <= PollClock::duration::zero())
+		return;
+
+	DevULong64 late_us = std::chrono::duration_cast<std::chrono::microseconds>(late).count();
+	stats.nb_late.fetch_add(1,std::memory_order_relaxed);
+	stats.late_us.fetch_add(late_us,std::memory_order_relaxed);
+
+	DevULong64 max_us = stats.max_late_us.load(std::memory_order_relaxed);
+	while (late_us > max_us && stats.max_late_us.compare_exchange_weak(max_us,late_us,std::memory_order_relaxed) == false)
+	{
+	}
+}
+
 //+---------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -1327,6 +1363,7 @@ void PollThread::compute_sleep_time()
                     while ((after - next) > DISCARD_THRESHOLD)
                     {
                         TANGO_LOG_DEBUG << "Discard one elt !!!!!!!!!!!!!" << std::endl;
+                        stats.nb_discarded.fetch_add(1,std::memory_order_relaxed);
                         WorkItem tmp = works.front();
                         if (tmp.type == POLL_ATTR)
                         {
@@ -1585,21 +1622,25 @@ void PollThread::poll_attr(WorkItem &to_do)
 
 	auto before_cmd = PollClock::now();
 
-	try
 	{
-		if (idl_vers >= 5)
-			argout_5 = (static_cast<Device_5Impl *>(to_do.dev))->read_attributes_5(attr_names,Tango::DEV,dummy_cl_id);
-		else if (idl_vers == 4)
-			argout_4 = (static_cast<Device_4Impl *>(to_do.dev))->read_attributes_4(attr_names,Tango::DEV,dummy_cl_id);
-		else if (idl_vers == 3)
-			argout_3 = (static_cast<Device_3Impl *>(to_do.dev))->read_attributes_3(attr_names,Tango::DEV);
-		else
-			argout = to_do.dev->read_attributes(attr_names);
-	}
-	catch (Tango::DevFailed &e)
-	{
-		attr_failed = true;
-		save_except = new Tango::DevFailed(e);
+		AutoLatency latency_scope(to_do.dev,LAT_POLL,attr_names);
+
+		try
+		{
+			if (idl_vers >= 5)
+				argout_5 = (static_cast<Device_5Impl *>(to_do.dev))->read_attributes_5(attr_names,Tango::DEV,dummy_cl_id);
+			else if (idl_vers == 4)
+				argout_4 = (static_cast<Device_4Impl *>(to_do.dev))->read_attributes_4(attr_names,Tango::DEV,dummy_cl_id);
+			else if (idl_vers == 3)
+				argout_3 = (static_cast<Device_3Impl *>(to_do.dev))->read_attributes_3(attr_names,Tango::DEV);
+			else
+				argout = to_do.dev->read_attributes(attr_names);
+		}
+		catch (Tango::DevFailed &e)
+		{
+			attr_failed = true;
+			save_except = new Tango::DevFailed(e);
+		}
 	}
 
 	auto after_cmd = PollClock::now();
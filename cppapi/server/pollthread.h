@@ -41,6 +41,7 @@
 #include <tango_optional.h>
 #include <tango_clock.h>
 
+#include <atomic>
 #include <list>
 #include <utility>
 
@@ -84,6 +85,15 @@ struct WorkItem
 	PollClock::duration needed_time;    // Time needed to execute action
 };
 
+struct PollThreadStats
+{
+	std::atomic<DevULong64>	nb_polls;			// Number of polled object executions
+	std::atomic<DevULong64>	nb_late;			// Number of executions started after their wake up date
+	std::atomic<DevULong64>	late_us;			// Sum of the lateness (us)
+	std::atomic<DevULong64>	max_late_us;		// Highest lateness (us)
+	std::atomic<DevULong64>	nb_discarded;		// Number of executions discarded because the thread was late
+};
+
 enum PollCmdType
 {
 	POLL_TIME_OUT,
@@ -129,6 +139,7 @@ protected:
 	void add_insert_in_list(WorkItem &);
 	void tune_list(bool);
 	void err_out_of_sync(WorkItem &);
+	void store_lateness(const WorkItem &);
 
     template <typename T> void robb_data(T &,T &);
     template <typename T> void copy_remaining(T &,T &);
@@ -168,6 +179,8 @@ private:
 	CppClntIdent 		cci;
 
 public:
+	TANGO_IMP static PollThreadStats	stats;	// Process wide counters (all the polling threads)
+
 	static DeviceImpl 	*dev_to_del;
 	static std::string	   	name_to_del;
 	static PollObjType	type_to_del;
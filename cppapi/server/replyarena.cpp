@@ -0,0 +1,277 @@
+//====================================================================================================================
+//
+// file :               replyarena.cpp
+//
+// description :        C++ source code for the ReplyArena and AutoReplyArena classes.
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#include <tango.h>
+#include <replyarena.h>
+
+#include <omniORB4/internal/GIOP_S.h>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+namespace Tango
+{
+
+namespace
+{
+
+//
+// The arena owned by the thread (created when the thread receives its first read request), the list of alive arenas
+// and the counters of the arenas deleted with their thread
+//
+
+thread_local std::unique_ptr<ReplyArena> thread_arena;
+
+omni_mutex arena_list_mutex;
+std::vector<ReplyArena *> arena_list;
+ReplyArenaStats retired_stats = {0,0,0,0,0};
+
+const size_t ARENA_ALIGN = 16;
+
+}
+
+thread_local ReplyArena *ReplyArena::active = nullptr;
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// function :
+//		reply_arena_request
+//
+// description :
+//		The function called by the omniORB interceptor when a request is received. The previous reply sent by this
+//		thread has been marshalled and released. Its arena can be reset. The arena is armed only for the requests
+//		which use it.
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+CORBA::Boolean reply_arena_request(omni::omniInterceptors::serverReceiveRequest_T::info_T &info)
+{
+	if (ReplyArena::active != nullptr)
+		return true;
+
+	bool read_req = ::strcmp(info.giop_s.operation_name(),"read_attributes_5") == 0;
+
+	if (!thread_arena)
+	{
+		if (read_req == false)
+			return true;
+		thread_arena.reset(new ReplyArena());
+	}
+
+	thread_arena->reset();
+	thread_arena->armed = read_req;
+
+	return true;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ReplyArena::ReplyArena
+//
+// description :
+//		Constructor and destructor of the ReplyArena class. The arena is registered in the list of alive arenas.
+//		When the arena is deleted (its thread exits), its counters are kept in the retired counters.
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+ReplyArena::ReplyArena():curr_chunk(0),curr_offset(0),armed(false),
+						 nb_requests(0),nb_alloc(0),nb_heap_alloc(0),reserved_bytes(0)
+{
+	chunks.reserve(8);
+
+	omni_mutex_lock sync(arena_list_mutex);
+	arena_list.push_back(this);
+}
+
+ReplyArena::~ReplyArena()
+{
+	{
+		omni_mutex_lock sync(arena_list_mutex);
+		arena_list.erase(std::remove(arena_list.begin(),arena_list.end(),this),arena_list.end());
+
+		retired_stats.nb_requests += nb_requests;
+		retired_stats.nb_alloc += nb_alloc;
+		retired_stats.nb_heap_alloc += nb_heap_alloc;
+	}
+
+	for (auto &chunk : chunks)
+		delete [] chunk.buf;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ReplyArena::allocate
+//
+// description :
+//		Get a buffer from the arena. A new chunk is allocated from the heap only when the remaining chunks are too
+//		small.
+//
+// argument :
+//		in :
+//			- size : The buffer size (in bytes)
+//
+// return :
+//		The buffer (16 bytes aligned) or nullptr if the memory cannot be allocated
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void *ReplyArena::allocate(size_t size)
+{
+	size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+
+	while (curr_chunk < chunks.size())
+	{
+		if (curr_offset + size <= chunks[curr_chunk].size)
+		{
+			void *ptr = chunks[curr_chunk].buf + curr_offset;
+			curr_offset = curr_offset + size;
+			nb_alloc++;
+			return ptr;
+		}
+		curr_chunk++;
+		curr_offset = 0;
+	}
+
+	size_t chunk_size = std::max(size,REPLY_ARENA_CHUNK_SIZE);
+	if (chunks.empty() == false)
+		chunk_size = std::max(chunk_size,chunks.back().size << 1);
+
+	Chunk new_chunk;
+	new_chunk.buf = new (std::nothrow) unsigned char[chunk_size];
+	if (new_chunk.buf == nullptr)
+		return nullptr;
+	new_chunk.size = chunk_size;
+	chunks.push_back(new_chunk);
+
+	nb_heap_alloc++;
+	nb_alloc++;
+	reserved_bytes += chunk_size;
+
+	curr_chunk = chunks.size() - 1;
+	curr_offset = size;
+
+	return new_chunk.buf;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ReplyArena::reset
+//
+// description :
+//		Give back all the arena buffers. If several chunks were used, they are replaced by one chunk large enough for
+//		all of them. Nothing is kept if this size is above REPLY_ARENA_MAX_SIZE.
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void ReplyArena::reset()
+{
+	curr_chunk = 0;
+	curr_offset = 0;
+
+	size_t total = reserved_bytes;
+	if (chunks.size() > 1 || total > REPLY_ARENA_MAX_SIZE)
+	{
+		for (auto &chunk : chunks)
+			delete [] chunk.buf;
+		chunks.clear();
+		reserved_bytes = 0;
+
+		if (total <= REPLY_ARENA_MAX_SIZE)
+		{
+			Chunk new_chunk;
+			new_chunk.buf = new (std::nothrow) unsigned char[total];
+			if (new_chunk.buf != nullptr)
+			{
+				new_chunk.size = total;
+				chunks.push_back(new_chunk);
+				nb_heap_alloc++;
+				reserved_bytes = total;
+			}
+		}
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ReplyArena::get_stats
+//
+// description :
+//		Sum the counters of all the arenas of the process
+//
+// argument :
+//		out :
+//			- stats : The counters
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void ReplyArena::get_stats(ReplyArenaStats &stats)
+{
+	omni_mutex_lock sync(arena_list_mutex);
+
+	stats = retired_stats;
+	stats.nb_arenas = arena_list.size();
+	for (auto arena : arena_list)
+	{
+		stats.nb_requests += arena->nb_requests.load(std::memory_order_relaxed);
+		stats.nb_alloc += arena->nb_alloc.load(std::memory_order_relaxed);
+		stats.nb_heap_alloc += arena->nb_heap_alloc.load(std::memory_order_relaxed);
+		stats.reserved_bytes += arena->reserved_bytes.load(std::memory_order_relaxed);
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		AutoReplyArena::AutoReplyArena
+//
+// description :
+//		Activate the thread arena if it has been armed by the request interceptor. Otherwise (polling thread,
+//		nested call), no arena is active during the object life time.
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+AutoReplyArena::AutoReplyArena():previous(ReplyArena::active)
+{
+	ReplyArena *arena = thread_arena.get();
+	if ((arena != nullptr) && (arena->armed == true) && (previous == nullptr))
+	{
+		arena->armed = false;
+		arena->nb_requests++;
+		ReplyArena::active = arena;
+	}
+	else
+		ReplyArena::active = nullptr;
+}
+
+} // End of Tango namespace
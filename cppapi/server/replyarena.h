@@ -0,0 +1,134 @@
+//====================================================================================================================
+//
+// file :               replyarena.h
+//
+// description :        Include for the ReplyArena class. A reply arena is a per ORB thread memory area used to build
+//						the read_attributes() reply data. It is reset when the next request arrives on the same thread
+//						(the previous reply has been marshalled by then)
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _REPLYARENA_H
+#define _REPLYARENA_H
+
+#include <tango.h>
+#include <omniORB4/omniInterceptors.h>
+#include <atomic>
+#include <vector>
+
+namespace Tango
+{
+
+CORBA::Boolean reply_arena_request(omni::omniInterceptors::serverReceiveRequest_T::info_T &);
+
+//==================================================================================================================
+//
+//			The ReplyArenaStats structure
+//
+// description :
+//		Counters of all the reply arenas of the process (alive or not)
+//
+//==================================================================================================================
+
+struct ReplyArenaStats
+{
+	DevULong64			nb_arenas;			// Number of ORB threads with an arena
+	DevULong64			nb_requests;		// Number of read requests which used an arena
+	DevULong64			nb_alloc;			// Number of buffers taken from the arenas
+	DevULong64			nb_heap_alloc;		// Number of arena memory chunks allocated from the heap
+	DevULong64			reserved_bytes;		// Memory kept by the alive arenas
+};
+
+//==================================================================================================================
+//
+//			The ReplyArena class
+//
+// description :
+//		Bump allocator owned by one ORB thread. Buffers are never freed one by one. The whole arena is reset when
+//		the next read request is received by the thread. Chunks used during one request are merged at reset time
+//		so that a thread repeating the same request does not allocate memory any more.
+//		The arena is used only within the scope of an AutoReplyArena object created by the read_attributes
+//		request. It is not used by the polling thread or by collocated calls.
+//
+//==================================================================================================================
+
+class ReplyArena
+{
+public:
+	ReplyArena();
+	~ReplyArena();
+
+	void *allocate(size_t);
+	void reset();
+
+	static ReplyArena *get_active() {return active;}
+	static void get_stats(ReplyArenaStats &);
+
+protected:
+	friend class AutoReplyArena;
+	friend CORBA::Boolean reply_arena_request(omni::omniInterceptors::serverReceiveRequest_T::info_T &);
+
+	struct Chunk
+	{
+		unsigned char	*buf;
+		size_t			size;
+	};
+
+	std::vector<Chunk>				chunks;
+	size_t							curr_chunk;
+	size_t							curr_offset;
+	bool							armed;
+
+	std::atomic<DevULong64>			nb_requests;
+	std::atomic<DevULong64>			nb_alloc;
+	std::atomic<DevULong64>			nb_heap_alloc;
+	std::atomic<DevULong64>			reserved_bytes;
+
+	static thread_local ReplyArena	*active;
+};
+
+//==================================================================================================================
+//
+//			The AutoReplyArena class
+//
+// description :
+//		Make the calling thread reply arena the active one for the object life time. This is done only if the
+//		thread request is a read request received from the network. Nested scopes (collocated calls) do not get any
+//		arena.
+//
+//==================================================================================================================
+
+class AutoReplyArena
+{
+public:
+	AutoReplyArena();
+	~AutoReplyArena() {ReplyArena::active = previous;}
+
+private:
+	ReplyArena				*previous;
+};
+
+} // End of Tango namespace
+
+#endif /* _REPLYARENA_H */
@@ -125,6 +125,7 @@ namespace Tango {
 #include <except.h>
 #include <attrmanip.h>
 #include <seqvec.h>
+#include <tracing.h>
 
 #if !defined(TANGO_CLIENT)
 	#include <log4tango.h>
@@ -32,10 +32,32 @@
 #ifndef _TANGO_MONITOR_H
 #define _TANGO_MONITOR_H
 
+#include <atomic>
+#include <chrono>
 
 namespace Tango
 {
 
+//--------------------------------------------------------------------------------------------------------------------
+//
+// struct :
+//		TangoMonitorStats
+//
+// description :
+//		Process wide counters of the monitor acquisitions which had to wait for another thread
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+class MonitorProfile;
+struct MonitorProfileData;
+
+struct TangoMonitorStats
+{
+	std::atomic<DevULong64>		nb_waits;			// Number of acquisitions which had to wait
+	std::atomic<DevULong64>		wait_us;			// Sum of the waiting times (us)
+	std::atomic<DevULong64>		nb_timeouts;		// Number of acquisitions given up after the monitor timeout
+};
+
 //--------------------------------------------------------------------------------------------------------------------
 //
 // class :
@@ -43,7 +65,8 @@ namespace Tango
 //
 // description :
 //		This class is used to synchronise device access between polling thread and CORBA request. It is used only for
-//		the command_inout and read_attribute calls
+//		the command_inout and read_attribute calls. The serialization monitors (device, class and process) also
+//		record their contention profile (see monitorprofile.h)
 //
 //--------------------------------------------------------------------------------------------------------------------
 
@@ -51,10 +74,10 @@ class TangoMonitor: public omni_mutex
 {
 public :
 	TangoMonitor(const char *na):_timeout(DEFAULT_TIMEOUT),cond(this),
-			locking_thread(NULL),locked_ctr(0),name(na) {}
+			locking_thread(NULL),locked_ctr(0),name(na),profile(NULL) {}
 	TangoMonitor():_timeout(DEFAULT_TIMEOUT),cond(this),locking_thread(NULL),
-			locked_ctr(0),name("unknown") {}
-	~TangoMonitor() {}
+			locked_ctr(0),name("unknown"),profile(NULL) {}
+	~TangoMonitor();
 
 	void get_monitor();
 	void rel_monitor();
@@ -72,12 +95,23 @@ public :
 	std::string &get_name() {return name;}
 	void set_name(const std::string &na) {name = na;}
 
+	void enable_profile();
+	bool get_profile(MonitorProfileData &);
+
+	TANGO_IMP static TangoMonitorStats	stats;
+
 private :
+	void add_wait_time(const std::chrono::steady_clock::time_point &,bool);
+	void profile_acquire(DevULong64,bool);
+	void profile_timeout(DevULong64);
+	void profile_release();
+
 	long 			_timeout;
 	omni_condition 	cond;
 	omni_thread		*locking_thread;
 	long			locked_ctr;
 	std::string 			name;
+	MonitorProfile	*profile;
 };
 
 
@@ -126,9 +160,12 @@ inline void TangoMonitor::get_monitor()
 	if (locked_ctr == 0)
 	{
 		locking_thread = th;
+		if (profile != NULL)
+			profile_acquire(0,false);
 	}
 	else if (th != locking_thread)
 	{
+		auto wait_start = std::chrono::steady_clock::now();
 		while(locked_ctr > 0)
 		{
 			TANGO_LOG_DEBUG << "Thread " << th->id() << ": waiting !!" << std::endl;
@@ -138,10 +175,13 @@ inline void TangoMonitor::get_monitor()
 			if (interupted == false)
 			{
 				TANGO_LOG_DEBUG << "TIME OUT for thread " << th->id() << std::endl;
+				stats.nb_timeouts.fetch_add(1,std::memory_order_relaxed);
+				add_wait_time(wait_start,false);
 				TANGO_THROW_EXCEPTION(API_CommandTimedOut, "Not able to acquire serialization (dev, class or process) monitor");
 			}
 		}
 		locking_thread = th;
+		add_wait_time(wait_start,true);
 	}
 	else
 	{
@@ -152,6 +192,39 @@ inline void TangoMonitor::get_monitor()
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		TangoMonitor::add_wait_time
+//
+// description :
+//		Count one acquisition which had to wait for another thread and record its wait span when the requests
+//		are traced
+//
+// args :
+//		in :
+//			- wait_start : The wait start date
+//			- acquired : Set to false if the wait ended with the monitor timeout
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+inline void TangoMonitor::add_wait_time(const std::chrono::steady_clock::time_point &wait_start,bool acquired)
+{
+	auto elapsed = std::chrono::steady_clock::now() - wait_start;
+	DevULong64 us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+	stats.nb_waits.fetch_add(1,std::memory_order_relaxed);
+	stats.wait_us.fetch_add(us,std::memory_order_relaxed);
+	if (profile != NULL)
+	{
+		if (acquired == true)
+			profile_acquire(us,true);
+		else
+			profile_timeout(us);
+	}
+	if (Tracer::is_enabled() == true)
+		Tracer::record_wait(TRACE_MONITOR_WAIT,name.c_str(),std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
 //--------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -176,6 +249,8 @@ inline void TangoMonitor::rel_monitor()
 	if (locked_ctr == 0)
 	{
 		TANGO_LOG_DEBUG << "Signalling !" << std::endl;
+		if (profile != NULL)
+			profile_release();
 		locking_thread = NULL;
 		cond.signal();
 	}
@@ -34,8 +34,6 @@
 
 #include <tango.h>
 
-#include <iomanip>
-
 #include <chrono>
 
 #include <tangoappender.h>
@@ -47,13 +45,24 @@ namespace Tango
   TangoAppender::TangoAppender (const std::string& src_name,
                                 const std::string& name,
                                 const std::string& dev_name,
-                                bool open_connection)
+                                bool open_connection,
+                                size_t queue_size,
+                                size_t batch_size,
+                                long flush_period)
     : log4tango::Appender(name),
       _dev_name(dev_name),
       _src_name(src_name),
-      _dev_proxy(0)
+      _dev_proxy(0),
+      _queue_size(queue_size),
+      _batch_size(batch_size),
+      _flush_period(flush_period),
+      _cond(&_mutex),
+      _sender(0),
+      _sender_exit(false),
+      _sender_failed(false),
+      _dropped(0),
+      _dropped_not_reported(0)
   {
-    _req_ctr = 0;
     if (open_connection == true)
       reopen();
   }
@@ -86,6 +95,12 @@ namespace Tango
     return true;
   }
 
+  DevULong TangoAppender::get_dropped_count (void)
+  {
+    omni_mutex_lock sync(_mutex);
+    return _dropped;
+  }
+
   int TangoAppender::_append (const log4tango::LoggingEvent& event)
   {
     //------------------------------------------------------------
@@ -96,52 +111,150 @@ namespace Tango
       return 0;
     }
     try {
-      Tango::DevVarStringArray *dvsa = new Tango::DevVarStringArray(6);
-      if (dvsa) {
-        dvsa->length(6);
-        auto ts_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            event.timestamp.time_since_epoch()).count();
-        TangoSys_OMemStream ts_ms_str;
-
-        ts_ms_str << std::fixed
-                  << std::noshowpoint
-                  << std::setprecision(0)
-                  << ts_ms
-                  << std::ends;
-        std::string st = ts_ms_str.str();
-        (*dvsa)[0] = Tango::string_dup(st.c_str());
-
-        (*dvsa)[1] = Tango::string_dup(log4tango::Level::get_name(event.level).c_str());
-        (*dvsa)[2] = Tango::string_dup(event.logger_name.c_str());
-        (*dvsa)[3] = Tango::string_dup(event.message.c_str());
-        (*dvsa)[4] = Tango::string_dup("");
-        omni_thread* ct = omni_thread::self();
-        if (ct) {
-          TangoSys_OMemStream ctstr;
-          ctstr << "@" << std::hex << event.thread_id << " [" << ct->id() << "]"<< std::ends;
-
-          std::string st = ctstr.str();
-          (*dvsa)[5] = Tango::string_dup(st.c_str());
-        } else {
-          (*dvsa)[5] = Tango::string_dup("unknown");
+      LogRecord rec;
+      rec.ts_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+          event.timestamp.time_since_epoch()).count();
+      rec.level = event.level;
+      rec.logger_name = event.logger_name;
+      rec.message = event.message;
+      // the thread identity must be computed here (we are running in the logging thread)
+      omni_thread* ct = omni_thread::self();
+      if (ct) {
+        TangoSys_OMemStream ctstr;
+        ctstr << "@" << std::hex << event.thread_id << " [" << ct->id() << "]";
+        rec.thread = ctstr.str();
+      } else {
+        rec.thread = "unknown";
+      }
+      {
+        omni_mutex_lock sync(_mutex);
+        if (_sender_failed) {
+          // the sender thread lost the log consumer: let the logger remove this target
+          return -1;
+        }
+        if (_records.size() >= _queue_size) {
+          // drop the oldest record
+          _records.pop_front();
+          _dropped++;
+          _dropped_not_reported++;
+        }
+        _records.push_back(std::move(rec));
+        if (_records.size() >= _batch_size) {
+          _cond.signal();
+        }
+      }
+    }
+    catch (...) {
+      return -1;
+    }
+    return 0;
+  }
+
+  bool TangoAppender::send_records (std::deque<LogRecord>& records, DevULong dropped)
+  {
+    //------------------------------------------------------------
+    //- DO NOT LOG FROM THIS METHOD !!!
+    //------------------------------------------------------------
+    if (dropped != 0) {
+      LogRecord rec;
+      rec.ts_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count();
+      rec.level = log4tango::Level::WARN;
+      rec.logger_name = _src_name;
+      TangoSys_OMemStream o;
+      o << dropped << " log record(s) dropped (logging target buffer full)";
+      rec.message = o.str();
+      rec.thread = "unknown";
+      records.push_front(std::move(rec));
+    }
+    try {
+      while (!records.empty()) {
+        //- one "Log" call per batch of _batch_size records (6 strings per record)
+        size_t nb_rec = std::min(records.size(), _batch_size);
+        CORBA::ULong nb_str = static_cast<CORBA::ULong>(6 * nb_rec);
+        Tango::DevVarStringArray *dvsa = new Tango::DevVarStringArray(nb_str);
+        dvsa->length(nb_str);
+        for (size_t i = 0; i < nb_rec; i++) {
+          const LogRecord &rec = records[i];
+          std::string ts_ms_str = std::to_string(rec.ts_ms);
+          (*dvsa)[6 * i] = Tango::string_dup(ts_ms_str.c_str());
+          (*dvsa)[6 * i + 1] = Tango::string_dup(log4tango::Level::get_name(rec.level).c_str());
+          (*dvsa)[6 * i + 2] = Tango::string_dup(rec.logger_name.c_str());
+          (*dvsa)[6 * i + 3] = Tango::string_dup(rec.message.c_str());
+          (*dvsa)[6 * i + 4] = Tango::string_dup("");
+          (*dvsa)[6 * i + 5] = Tango::string_dup(rec.thread.c_str());
         }
+        records.erase(records.begin(), records.begin() + nb_rec);
         DeviceData argin;
         argin << dvsa;
 #ifdef USE_ASYNC_CALL
-        _dev_proxy->command_inout_asynch("Log", argin, false);
-        _req_ctr++;
-        if ((_req_ctr % 10) == 0)
-            _dev_proxy->cancel_all_polling_asynch_request();
+        _dev_proxy->command_inout_asynch("Log", argin, true);
 #else
         _dev_proxy->command_inout("Log", argin);
 #endif
       }
     }
     catch (...) {
-      close();
-      return -1;
+      records.clear();
+      return false;
+    }
+    return true;
+  }
+
+  void *TangoAppender::SenderThread::run_undetached (void *)
+  {
+    std::deque<LogRecord> batch;
+    bool exit_th = false;
+    while (exit_th == false) {
+      DevULong dropped;
+      {
+        omni_mutex_lock sync(appender._mutex);
+        if (appender._sender_exit == false && appender._records.size() < appender._batch_size) {
+          unsigned long s,n;
+          omni_thread::get_time(&s, &n, appender._flush_period / 1000, (appender._flush_period % 1000) * 1000000);
+          appender._cond.timedwait(s, n);
+        }
+        exit_th = appender._sender_exit;
+        batch.swap(appender._records);
+        dropped = appender._dropped_not_reported;
+        appender._dropped_not_reported = 0;
+      }
+      if (batch.empty() == false || dropped != 0) {
+        if (appender.send_records(batch, dropped) == false) {
+          omni_mutex_lock sync(appender._mutex);
+          appender._sender_failed = true;
+          appender._records.clear();
+          exit_th = true;
+        }
+      }
+    }
+    return (void *)NULL;
+  }
+
+  void TangoAppender::start_sender (void)
+  {
+    omni_mutex_lock sync(_mutex);
+    _sender_exit = false;
+    _sender_failed = false;
+    _sender = new SenderThread(*this);
+    _sender->start();
+  }
+
+  void TangoAppender::stop_sender (void)
+  {
+    SenderThread *th = 0;
+    {
+      omni_mutex_lock sync(_mutex);
+      th = _sender;
+      _sender = 0;
+      _sender_exit = true;
+      _cond.signal();
+    }
+    if (th) {
+      //- the sender flushes the pending records before exiting
+      void *dummy_ptr;
+      th->join(&dummy_ptr);
     }
-    return 0;
   }
 
   bool TangoAppender::reopen (void)
@@ -162,6 +275,7 @@ namespace Tango
       catch (...) {
 
       }
+      start_sender();
     }
     catch (...) {
       close();
@@ -172,6 +286,7 @@ namespace Tango
 
   void TangoAppender::close (void)
   {
+    stop_sender();
     if (_dev_proxy) {
       try {
         DeviceData argin;
@@ -188,6 +303,8 @@ namespace Tango
       delete _dev_proxy;
       _dev_proxy = 0;
     }
+    omni_mutex_lock sync(_mutex);
+    _records.clear();
   }
 
 } // namespace tango
@@ -29,9 +29,18 @@
 #ifndef _TANGO_APPENDER_H_
 #define _TANGO_APPENDER_H_
 
+#include <deque>
+
 namespace Tango
 {
 
+//
+// Log records are not sent to the log consumer from the logging thread. They are buffered (bounded queue,
+// oldest records dropped first) and a dedicated sender thread packs them into a single "Log" command call
+// (6 strings per record) either when the batch size is reached or when the flush period expires.
+// The number of dropped records is returned by the GetLoggingDropped admin command.
+//
+
 class TangoAppender : public log4tango::Appender
 {
 public:
@@ -41,7 +50,10 @@ public:
   TangoAppender (const std::string& src_name,
                  const std::string& name,
                  const std::string& dev_name,
-                 bool open_connection = true);
+                 bool open_connection = true,
+                 size_t queue_size = kLogDeviceQueueSize,
+                 size_t batch_size = kLogDeviceBatchSize,
+                 long flush_period = kLogDeviceFlushPeriod);
   /**
    *
    **/
@@ -72,6 +84,12 @@ public:
    **/
   virtual bool is_valid (void) const;
 
+  /**
+   * Returns the number of log records dropped since the target was opened
+   * (buffer full)
+   **/
+  DevULong get_dropped_count (void);
+
 protected:
   /**
    *
@@ -79,6 +97,51 @@ protected:
   virtual int _append (const log4tango::LoggingEvent& event);
 
 private:
+  /**
+   * A buffered log record (already converted to what the log consumer expects)
+   **/
+  struct LogRecord
+  {
+    long long     ts_ms;
+    int           level;
+    std::string   logger_name;
+    std::string   message;
+    std::string   thread;
+  };
+
+  /**
+   * The thread sending the buffered records to the log consumer
+   **/
+  class SenderThread: public omni_thread
+  {
+  public:
+    SenderThread(TangoAppender &app):appender(app) {}
+
+    void *run_undetached(void *);
+    void start() {start_undetached();}
+
+  private:
+    TangoAppender &appender;
+  };
+
+  friend class SenderThread;
+
+  /**
+   *
+   **/
+  void start_sender (void);
+
+  /**
+   *
+   **/
+  void stop_sender (void);
+
+  /**
+   * Send the records (and the dropped records notification) to the log consumer.
+   * Returns false if the log consumer is not reachable.
+   **/
+  bool send_records (std::deque<LogRecord>& records, DevULong dropped);
+
   /**
    *
    **/
@@ -93,7 +156,25 @@ private:
    *
    **/
   DeviceProxy   *_dev_proxy;
-  DevULong      _req_ctr;
+
+  /**
+   * Max buffered records, max records per "Log" call and flush period (ms)
+   **/
+  const size_t  _queue_size;
+  const size_t  _batch_size;
+  const long    _flush_period;
+
+  /**
+   * Sender thread data (protected by _mutex)
+   **/
+  omni_mutex              _mutex;
+  omni_condition          _cond;
+  std::deque<LogRecord>   _records;
+  SenderThread            *_sender;
+  bool                    _sender_exit;
+  bool                    _sender_failed;
+  DevULong                _dropped;
+  DevULong                _dropped_not_reported;
 };
 
 } // namespace tango
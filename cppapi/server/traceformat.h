@@ -0,0 +1,114 @@
+//====================================================================================================================
+//
+// file :               traceformat.h
+//
+// description :        Layout of the request tracing files. A trace file is a header followed by a ring buffer of
+//						fixed size span records. It is written (memory mapped) by the Tracer class and read by the
+//						offline tango_trace2json tool. This file must not depend on any other Tango file.
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _TRACEFORMAT_H
+#define _TRACEFORMAT_H
+
+#include <cstdint>
+
+namespace Tango
+{
+
+const char TRACE_FILE_MAGIC[8] = {'T','G','T','R','A','C','E','\0'};
+const uint32_t TRACE_FILE_VERSION = 1;
+
+//
+// The span kinds (the order is used by the trace file readers, add new kinds at the end)
+//
+
+enum TraceSpanKind
+{
+	TRACE_CLIENT_CALL = 0,		// Client call (whole Connection method)
+	TRACE_CLIENT_SEND,			// Client library time until the request is sent
+	TRACE_SERVER_REQUEST,		// Request in the server, from its reception to its reply
+	TRACE_SERVER_DISPATCH,		// ORB dispatching (argument unmarshalling) until the device method is called
+	TRACE_MONITOR_WAIT,			// Wait for a serialization monitor
+	TRACE_DEVICE_METHOD,		// Device method (e.g. command_inout_4) including the monitor wait
+	TRACE_READ_HARDWARE,		// User read_attr_hardware() method
+	TRACE_SERVER_REPLY,			// From the device method return until the reply is sent (ORB processing)
+	TRACE_KIND_NB
+};
+
+const char * const TraceSpanKindName[] = {
+	"client_call",
+	"client_send",
+	"server_request",
+	"server_dispatch",
+	"monitor_wait",
+	"device_method",
+	"read_hardware",
+	"server_reply"
+};
+
+//
+// The file header (128 bytes). The records follow the header. The record at index i in the ring buffer is valid
+// when its seq field is i + 1 (modulo the capacity, the record written last wins)
+//
+
+struct TraceFileHeader
+{
+	char				magic[8];			// TRACE_FILE_MAGIC
+	uint32_t			version;			// TRACE_FILE_VERSION
+	uint32_t			record_size;		// sizeof(TraceRecord)
+	uint64_t			capacity;			// Number of records in the ring buffer
+	uint64_t			pid;				// Process id
+	uint64_t			write_index;		// Number of records written since the file creation
+	char				reserved[24];
+	char				process_name[64];	// Process name (null terminated)
+};
+
+//
+// One span record (96 bytes). Dates are in nano-seconds since the epoch (system clock) so that the spans of
+// processes running on the same host can be compared.
+//
+
+const int TRACE_NAME_SIZE = 40;
+
+struct TraceRecord
+{
+	uint64_t			seq;				// Ring buffer index + 1 (0 while the record is being written)
+	uint64_t			trace_id;			// Trace identifier (shared by client and server spans)
+	uint64_t			span_id;			// Span identifier
+	uint64_t			parent_id;			// Parent span identifier (0 if none)
+	int64_t				start_ns;			// Span start date
+	int64_t				duration_ns;		// Span duration
+	uint32_t			thread_id;			// Thread identifier
+	uint16_t			kind;				// Span kind (TraceSpanKind)
+	uint16_t			reserved;
+	char				name[TRACE_NAME_SIZE];	// Object name (truncated, null terminated)
+};
+
+static_assert(sizeof(TraceFileHeader) == 128,"Wrong TraceFileHeader size");
+static_assert(sizeof(TraceRecord) == 96,"Wrong TraceRecord size");
+
+} // End of Tango namespace
+
+#endif /* _TRACEFORMAT_H */
@@ -0,0 +1,642 @@
+//====================================================================================================================
+//
+// file :               tracing.cpp
+//
+// description :        C++ source code for the Tracer and TraceSpan classes and for the request tracing interceptors
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#include <tango.h>
+#include <tracing.h>
+
+#include <omniORB4/callDescriptor.h>
+#include <omniORB4/internal/GIOP_C.h>
+#include <omniORB4/internal/GIOP_S.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#ifndef _TG_WINDOWS_
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace Tango
+{
+
+namespace
+{
+
+//
+// The request executed by a server thread (between the serverReceiveRequest and the serverSendReply or
+// serverSendException interceptors)
+//
+
+struct TraceRequest
+{
+	bool				active;
+	bool				dispatched;
+	uint64_t			trace_id;
+	uint64_t			parent_id;
+	uint64_t			span_id;
+	int64_t				start_ns;
+	int64_t				method_end_ns;
+	char				name[TRACE_NAME_SIZE];
+};
+
+thread_local TraceContext thread_context = {0,0,0,0};
+thread_local TraceRequest thread_request = {false,false,0,0,0,0,0,{'\0'}};
+thread_local uint32_t thread_id = 0;
+thread_local uint64_t id_state = 0;
+
+std::atomic<uint32_t> thread_ctr(0);
+std::atomic<uint64_t> seed_ctr(0);
+
+//
+// Copy a name in a record name buffer. When too long, the end of the name (the most specific part) is kept
+//
+
+void copy_name(char *dest,const char *obj,const char *member)
+{
+	char buf[256];
+	if (obj == nullptr)
+		obj = "";
+	if (member != nullptr && *member != '\0')
+		::snprintf(buf,sizeof(buf),"%s/%s",obj,member);
+	else
+		::snprintf(buf,sizeof(buf),"%s",obj);
+
+	size_t len = ::strlen(buf);
+	const char *src = buf;
+	if (len >= (size_t)TRACE_NAME_SIZE)
+		src = buf + len - (TRACE_NAME_SIZE - 1);
+	::strncpy(dest,src,TRACE_NAME_SIZE - 1);
+	dest[TRACE_NAME_SIZE - 1] = '\0';
+}
+
+//
+// The trace and span ids travel in the service context as two big endian 64 bits integers
+//
+
+void encode_id(CORBA::OctetSeq &data,CORBA::ULong offset,uint64_t id)
+{
+	for (int loop = 0;loop < 8;loop++)
+		data[offset + loop] = (CORBA::Octet)(id >> (56 - (8 * loop)));
+}
+
+uint64_t decode_id(const CORBA::OctetSeq &data,CORBA::ULong offset)
+{
+	uint64_t id = 0;
+	for (int loop = 0;loop < 8;loop++)
+		id = (id << 8) | data[offset + loop];
+	return id;
+}
+
+}
+
+std::atomic<bool> Tracer::enabled(false);
+std::string Tracer::file_name;
+TraceFileHeader *Tracer::header = nullptr;
+TraceRecord *Tracer::records = nullptr;
+size_t Tracer::map_size = 0;
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// function :
+//		trace_request_sent, trace_request_received, trace_reply_sent, trace_exception_sent
+//
+// description :
+//		The functions called by the omniORB interceptors. On the client side, the ids of the thread current span
+//		are added to the request service contexts. On the server side, they are the parent of the request span.
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+CORBA::Boolean trace_request_sent(omni::omniInterceptors::clientSendRequest_T::info_T &info)
+{
+	TraceContext &ctx = Tracer::context();
+	if (Tracer::is_enabled() == false || ctx.span_id == 0)
+		return true;
+
+	CORBA::ULong nb = info.service_contexts.length();
+	info.service_contexts.length(nb + 1);
+	IOP::ServiceContext &sc = info.service_contexts[nb];
+	sc.context_id = TRACE_SERVICE_CONTEXT_ID;
+	sc.context_data.length(16);
+	encode_id(sc.context_data,0,ctx.trace_id);
+	encode_id(sc.context_data,8,ctx.span_id);
+
+	if (ctx.kind == TRACE_CLIENT_CALL)
+	{
+		int64_t now = Tracer::now_ns();
+		Tracer::record(TRACE_CLIENT_SEND,ctx.trace_id,Tracer::new_id(),ctx.span_id,ctx.start_ns,now - ctx.start_ns,
+					   info.giop_c.calldescriptor()->op());
+	}
+
+	return true;
+}
+
+CORBA::Boolean trace_request_received(omni::omniInterceptors::serverReceiveRequest_T::info_T &info)
+{
+	if (Tracer::is_enabled() == false)
+		return true;
+
+	uint64_t trace_id = 0;
+	uint64_t parent_id = 0;
+	IOP::ServiceContextList &ctxts = info.giop_s.receive_service_contexts();
+	for (CORBA::ULong loop = 0;loop < ctxts.length();loop++)
+	{
+		if (ctxts[loop].context_id == TRACE_SERVICE_CONTEXT_ID && ctxts[loop].context_data.length() >= 16)
+		{
+			trace_id = decode_id(ctxts[loop].context_data,0);
+			parent_id = decode_id(ctxts[loop].context_data,8);
+			break;
+		}
+	}
+
+	Tracer::request_received(trace_id,parent_id,info.giop_s.operation_name());
+	return true;
+}
+
+CORBA::Boolean trace_reply_sent(TANGO_UNUSED(omni::omniInterceptors::serverSendReply_T::info_T &info))
+{
+	Tracer::request_done();
+	return true;
+}
+
+CORBA::Boolean trace_exception_sent(TANGO_UNUSED(omni::omniInterceptors::serverSendException_T::info_T &info))
+{
+	Tracer::request_done();
+	return true;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Tracer::init
+//
+// description :
+//		Open the process trace file if the TANGO_TRACE_DIR environment variable is set. The file is named
+//		tango_trace_<pid>.bin. Its ring buffer size (in spans) may be changed with the TANGO_TRACE_BUFFER_SIZE
+//		environment variable. Only the first call does something. An error disables the tracing but is not
+//		reported to the caller.
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Tracer::init()
+{
+	static std::once_flag init_flag;
+	std::call_once(init_flag,[]()
+	{
+		std::string dir;
+		if (ApiUtil::get_env_var("TANGO_TRACE_DIR",dir) != 0 || dir.empty() == true)
+			return;
+
+		size_t capacity = TRACE_DEFAULT_BUFFER_SIZE;
+		std::string var;
+		if (ApiUtil::get_env_var("TANGO_TRACE_BUFFER_SIZE",var) == 0)
+		{
+			std::istringstream iss(var);
+			size_t val = 0;
+			iss >> val;
+			if (iss && val != 0)
+				capacity = val;
+			else
+				std::cerr << "Wrong TANGO_TRACE_BUFFER_SIZE value (" << var << "), using " << capacity << std::endl;
+		}
+
+		std::stringstream o;
+#ifdef _TG_WINDOWS_
+		o << dir << "\\tango_trace_" << _getpid() << ".bin";
+#else
+		o << dir << "/tango_trace_" << ::getpid() << ".bin";
+#endif
+
+		try
+		{
+			open(o.str(),capacity);
+		}
+		catch (DevFailed &e)
+		{
+			std::cerr << "Request tracing disabled" << std::endl;
+			Except::print_exception(e);
+		}
+	});
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Tracer::install_interceptors
+//
+// description :
+//		Install the omniORB interceptors propagating the trace id. The server interceptors are installed only
+//		in a device server. This method must be called after the ORB initialisation.
+//
+// argument :
+//		in :
+//			- server : Set to true to also install the server side interceptors
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Tracer::install_interceptors(bool server)
+{
+	static std::mutex inter_mutex;
+	static bool client_installed = false;
+	static bool server_installed = false;
+
+	std::lock_guard<std::mutex> lo(inter_mutex);
+	omni::omniInterceptors *intercep = omniORB::getInterceptors();
+
+	if (client_installed == false)
+	{
+		intercep->clientSendRequest.add(trace_request_sent);
+		client_installed = true;
+	}
+
+	if (server == true && server_installed == false)
+	{
+		intercep->serverReceiveRequest.add(trace_request_received);
+		intercep->serverSendReply.add(trace_reply_sent);
+		intercep->serverSendException.add(trace_exception_sent);
+		server_installed = true;
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Tracer::open
+//
+// description :
+//		Create the trace file, map it in memory and enable the tracing
+//
+// argument :
+//		in :
+//			- name : The trace file name
+//			- capacity : The ring buffer size (in spans)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Tracer::open(const std::string &name,size_t capacity)
+{
+#ifdef _TG_WINDOWS_
+	TANGO_THROW_EXCEPTION(API_TracingFailed, "Request tracing is not supported on Windows");
+#else
+	if (header != nullptr)
+	{
+		TANGO_THROW_EXCEPTION(API_TracingFailed, "A trace file is already opened (" + file_name + ")");
+	}
+
+	if (capacity == 0)
+	{
+		TANGO_THROW_EXCEPTION(API_TracingFailed, "The trace ring buffer size must be greater than 0");
+	}
+
+	size_t size = sizeof(TraceFileHeader) + (capacity * sizeof(TraceRecord));
+	int fd = ::open(name.c_str(),O_RDWR | O_CREAT | O_TRUNC,0644);
+	if (fd == -1)
+	{
+		std::stringstream o;
+		o << "Can't create the trace file " << name << " (" << ::strerror(errno) << ")";
+		TANGO_THROW_EXCEPTION(API_TracingFailed, o.str());
+	}
+
+	void *ptr = MAP_FAILED;
+	if (::ftruncate(fd,size) == 0)
+		ptr = ::mmap(NULL,size,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+	int err = errno;
+	::close(fd);
+
+	if (ptr == MAP_FAILED)
+	{
+		::unlink(name.c_str());
+		std::stringstream o;
+		o << "Can't map the trace file " << name << " (" << ::strerror(err) << ")";
+		TANGO_THROW_EXCEPTION(API_TracingFailed, o.str());
+	}
+
+//
+// The file is zero filled by ftruncate, all records are invalid (seq = 0)
+//
+
+	TraceFileHeader *head = static_cast<TraceFileHeader *>(ptr);
+	::memcpy(head->magic,TRACE_FILE_MAGIC,sizeof(head->magic));
+	head->version = TRACE_FILE_VERSION;
+	head->record_size = sizeof(TraceRecord);
+	head->capacity = capacity;
+	head->pid = ::getpid();
+	head->write_index = 0;
+
+	std::ifstream comm("/proc/self/comm");
+	std::string proc_name;
+	if (std::getline(comm,proc_name))
+		::strncpy(head->process_name,proc_name.c_str(),sizeof(head->process_name) - 1);
+
+	header = head;
+	records = reinterpret_cast<TraceRecord *>(head + 1);
+	map_size = size;
+	file_name = name;
+	enabled.store(true,std::memory_order_release);
+#endif
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Tracer::close
+//
+// description :
+//		Disable the tracing and unmap the trace file. The caller must be sure that no thread is recording a span
+//		(the trace file is never closed by the library).
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Tracer::close()
+{
+	enabled.store(false,std::memory_order_release);
+#ifndef _TG_WINDOWS_
+	if (header != nullptr)
+		::munmap(header,map_size);
+#endif
+	header = nullptr;
+	records = nullptr;
+	map_size = 0;
+	file_name.clear();
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Tracer::now_ns, Tracer::new_id, Tracer::context
+//
+// description :
+//		The date used for the spans (system clock, ns), a new (never 0) trace or span id and the calling thread
+//		current span. The ids are generated by a per thread splitmix64 generator.
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+int64_t Tracer::now_ns()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+uint64_t Tracer::new_id()
+{
+	if (id_state == 0)
+	{
+#ifdef _TG_WINDOWS_
+		uint64_t pid = _getpid();
+#else
+		uint64_t pid = ::getpid();
+#endif
+		id_state = (uint64_t)now_ns() ^ (pid << 40) ^ (seed_ctr.fetch_add(1,std::memory_order_relaxed) * 0xD1B54A32D192ED03ULL);
+	}
+
+	uint64_t id;
+	do
+	{
+		id_state = id_state + 0x9E3779B97F4A7C15ULL;
+		id = id_state;
+		id = (id ^ (id >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		id = (id ^ (id >> 27)) * 0x94D049BB133111EBULL;
+		id = id ^ (id >> 31);
+	}
+	while (id == 0);
+
+	return id;
+}
+
+TraceContext &Tracer::context()
+{
+	return thread_context;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Tracer::record
+//
+// description :
+//		Write one span in the ring buffer. The slot is reserved by incrementing the file write index. Its sequence
+//		number is reset while the record is written, a reader must ignore a record whose sequence number is not
+//		its index + 1.
+//
+// argument :
+//		in :
+//			- kind : The span kind
+//			- trace_id : The trace id
+//			- span_id : The span id
+//			- parent_id : The parent span id (0 if none)
+//			- start : The span start date (ns)
+//			- duration : The span duration (ns)
+//			- name : The span name (may be NULL)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Tracer::record(TraceSpanKind kind,uint64_t trace_id,uint64_t span_id,uint64_t parent_id,int64_t start,
+					int64_t duration,const char *name)
+{
+	TraceFileHeader *head = header;
+	if (enabled.load(std::memory_order_acquire) == false || head == nullptr)
+		return;
+
+	if (thread_id == 0)
+		thread_id = thread_ctr.fetch_add(1,std::memory_order_relaxed) + 1;
+
+	uint64_t idx = reinterpret_cast<std::atomic<uint64_t> *>(&head->write_index)->fetch_add(1,std::memory_order_relaxed);
+	TraceRecord &rec = records[idx % head->capacity];
+	std::atomic<uint64_t> *seq = reinterpret_cast<std::atomic<uint64_t> *>(&rec.seq);
+
+	seq->store(0,std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	rec.trace_id = trace_id;
+	rec.span_id = span_id;
+	rec.parent_id = parent_id;
+	rec.start_ns = start;
+	rec.duration_ns = duration;
+	rec.thread_id = thread_id;
+	rec.kind = (uint16_t)kind;
+	rec.reserved = 0;
+	copy_name(rec.name,name,nullptr);
+
+	seq->store(idx + 1,std::memory_order_release);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Tracer::record_wait
+//
+// description :
+//		Record a span ending now, child of the thread current span (e.g. a monitor wait measured by its caller)
+//
+// argument :
+//		in :
+//			- kind : The span kind
+//			- name : The span name
+//			- duration : The span duration (ns)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Tracer::record_wait(TraceSpanKind kind,const char *name,int64_t duration)
+{
+	TraceContext &ctx = context();
+	uint64_t trace_id = ctx.trace_id != 0 ? ctx.trace_id : new_id();
+	record(kind,trace_id,new_id(),ctx.span_id,now_ns() - duration,duration,name);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Tracer::request_received, Tracer::request_done
+//
+// description :
+//		Start and end of a request in a server thread. The request span becomes the thread current span. When
+//		done, the request span and the reply span (from the device method end until now) are recorded.
+//
+// argument :
+//		in :
+//			- trace_id : The trace id sent by the client (0 if none, a new trace is then started)
+//			- parent_id : The client span id (0 if none)
+//			- op_name : The CORBA operation name
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Tracer::request_received(uint64_t trace_id,uint64_t parent_id,const char *op_name)
+{
+	TraceRequest &req = thread_request;
+
+	req.active = true;
+	req.dispatched = false;
+	req.trace_id = trace_id != 0 ? trace_id : new_id();
+	req.parent_id = parent_id;
+	req.span_id = new_id();
+	req.start_ns = now_ns();
+	req.method_end_ns = 0;
+	copy_name(req.name,op_name,nullptr);
+
+	thread_context = {req.trace_id,req.span_id,req.start_ns,TRACE_SERVER_REQUEST};
+}
+
+void Tracer::request_done()
+{
+	TraceRequest &req = thread_request;
+	if (req.active == false)
+		return;
+
+	int64_t now = now_ns();
+	if (req.method_end_ns != 0)
+		record(TRACE_SERVER_REPLY,req.trace_id,new_id(),req.span_id,req.method_end_ns,now - req.method_end_ns,req.name);
+	record(TRACE_SERVER_REQUEST,req.trace_id,req.span_id,req.parent_id,req.start_ns,now - req.start_ns,req.name);
+
+	req.active = false;
+	thread_context = {0,0,0,0};
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		TraceSpan::start, TraceSpan::stop
+//
+// description :
+//		Start and end of a span. The span is a child of the thread current span (a new trace is started if there
+//		is none) and is the thread current span until its end.
+//
+// argument :
+//		in :
+//			- k : The span kind
+//			- obj : The object name (device name...)
+//			- member : The member name (command, attribute...)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void TraceSpan::start(TraceSpanKind k,const char *obj,const char *member)
+{
+	TraceContext &ctx = Tracer::context();
+
+	kind = k;
+	saved = ctx;
+	span_id = Tracer::new_id();
+	start_ns = Tracer::now_ns();
+	copy_name(name,obj,member);
+
+//
+// The first device method span of a request ends the ORB dispatching step
+//
+
+	TraceRequest &req = thread_request;
+	if (kind == TRACE_DEVICE_METHOD && req.active == true && req.dispatched == false)
+	{
+		req.dispatched = true;
+		Tracer::record(TRACE_SERVER_DISPATCH,req.trace_id,Tracer::new_id(),req.span_id,req.start_ns,start_ns - req.start_ns,
+					   req.name);
+		::memcpy(req.name,name,sizeof(req.name));
+	}
+
+	ctx.trace_id = saved.trace_id != 0 ? saved.trace_id : Tracer::new_id();
+	ctx.span_id = span_id;
+	ctx.start_ns = start_ns;
+	ctx.kind = kind;
+}
+
+void TraceSpan::stop()
+{
+	TraceContext &ctx = Tracer::context();
+	int64_t now = Tracer::now_ns();
+
+	Tracer::record(kind,ctx.trace_id,span_id,saved.span_id,start_ns,now - start_ns,name);
+
+	TraceRequest &req = thread_request;
+	if (kind == TRACE_DEVICE_METHOD && req.active == true && req.span_id == saved.span_id)
+		req.method_end_ns = now;
+
+	ctx = saved;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		TraceSpan::set_name
+//
+// description :
+//		Change the span name. Useful when the name is not known when the span starts
+//
+// argument :
+//		in :
+//			- obj : The object name
+//			- member : The member name
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void TraceSpan::set_name(const char *obj,const char *member)
+{
+	copy_name(name,obj,member);
+}
+
+} // End of Tango namespace
@@ -0,0 +1,145 @@
+//====================================================================================================================
+//
+// file :               tracing.h
+//
+// description :        Include for the request tracing. When enabled (TANGO_TRACE_DIR environment variable), timed
+//						spans are recorded at the main steps of a request (client call, request sending, ORB
+//						dispatching, monitor wait, device method, read_attr_hardware, reply) in a memory mapped
+//						ring buffer file per process (see traceformat.h). The trace id is propagated from the client
+//						to the server in a CORBA service context. The tango_trace2json tool converts the files into
+//						a Chrome trace (Perfetto) JSON file.
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _TRACING_H
+#define _TRACING_H
+
+#include <traceformat.h>
+#include <omniORB4/omniInterceptors.h>
+#include <atomic>
+#include <string>
+
+namespace Tango
+{
+
+CORBA::Boolean trace_request_sent(omni::omniInterceptors::clientSendRequest_T::info_T &);
+CORBA::Boolean trace_request_received(omni::omniInterceptors::serverReceiveRequest_T::info_T &);
+CORBA::Boolean trace_reply_sent(omni::omniInterceptors::serverSendReply_T::info_T &);
+CORBA::Boolean trace_exception_sent(omni::omniInterceptors::serverSendException_T::info_T &);
+
+//==================================================================================================================
+//
+//			The TraceContext structure
+//
+// description :
+//		The span currently executed by a thread. Its ids are given to the spans started by the thread and sent
+//		with the requests
+//
+//==================================================================================================================
+
+struct TraceContext
+{
+	uint64_t			trace_id;
+	uint64_t			span_id;
+	int64_t				start_ns;
+	int					kind;
+};
+
+//==================================================================================================================
+//
+//			The Tracer class
+//
+// description :
+//		Static class owning the trace file of the process. The records are written without lock: the ring buffer
+//		index is atomically incremented and each record is validated by its sequence number once written.
+//
+//==================================================================================================================
+
+class Tracer
+{
+public:
+	static void init();
+	static void install_interceptors(bool);
+	static void open(const std::string &,size_t);
+	static void close();
+
+	static bool is_enabled() {return enabled.load(std::memory_order_relaxed);}
+	static const std::string &get_file_name() {return file_name;}
+
+	static int64_t now_ns();
+	static uint64_t new_id();
+	static TraceContext &context();
+
+	static void record(TraceSpanKind,uint64_t,uint64_t,uint64_t,int64_t,int64_t,const char *);
+	static void record_wait(TraceSpanKind,const char *,int64_t);
+
+	static void request_received(uint64_t,uint64_t,const char *);
+	static void request_done();
+
+	TANGO_IMP static std::atomic<bool>	enabled;
+
+private:
+	static std::string		file_name;
+	static TraceFileHeader	*header;
+	static TraceRecord		*records;
+	static size_t			map_size;
+};
+
+//==================================================================================================================
+//
+//			The TraceSpan class
+//
+// description :
+//		Records one span from its construction to its destruction when tracing is enabled. The span is the
+//		thread current span during its life time. A TRACE_DEVICE_METHOD span also records the ORB dispatching
+//		time of the request being executed and its end marks the start of the reply processing.
+//
+//==================================================================================================================
+
+class TraceSpan
+{
+public:
+	TraceSpan(TraceSpanKind k):active(Tracer::is_enabled()) {if (active == true) start(k,nullptr,nullptr);}
+	TraceSpan(TraceSpanKind k,const char *obj,const char *member = nullptr):active(Tracer::is_enabled())
+	{if (active == true) start(k,obj,member);}
+	~TraceSpan() {if (active == true) stop();}
+
+	bool is_active() {return active;}
+	void set_name(const char *,const char *);
+
+private:
+	void start(TraceSpanKind,const char *,const char *);
+	void stop();
+
+	bool				active;
+	TraceSpanKind		kind;
+	TraceContext		saved;
+	uint64_t			span_id;
+	int64_t				start_ns;
+	char				name[TRACE_NAME_SIZE];
+};
+
+} // End of Tango namespace
+
+#endif /* _TRACING_H */
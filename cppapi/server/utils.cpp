@@ -46,6 +46,8 @@
 #include <dserversignal.h>
 #include <dserverclass.h>
 #include <eventsupplier.h>
+#include <replyarena.h>
+#include <metrics.h>
 
 #ifndef _TG_WINDOWS_
 #include <unistd.h>
@@ -89,6 +91,72 @@ thread_local bool is_tango_library_thread = false;
 
 omni_thread::key_t key;
 
+namespace
+{
+
+//
+// Thread started once the startup sequence is done when the db cache has been filled from a local snapshot.
+// It gets the cache data from the database and updates the snapshot if the database content changed. The server
+// keeps running with the snapshot data: the change is logged and reported in the admin device status. The thread
+// uses the process Database object, it is joined in the server shutdown sequence.
+//
+
+class DbCacheReconcileThread: public omni_thread
+{
+public:
+	DbCacheReconcileThread(Database *d,const std::string &file,const std::string &ds,const std::string &h,
+						   const std::string &st):db(d),file_name(file),ds_name(ds),host(h),stamp(st) {}
+
+	void start() {start_undetached();}
+
+	void *run_undetached(void *)
+	{
+		is_tango_library_thread = true;
+
+		try
+		{
+			CORBA::Any_var received = db->fill_server_cache(ds_name,host);
+			const DevVarStringArray *data_list;
+			if ((received.inout() >>= data_list) == false)
+				return NULL;
+
+			if (DbCacheSnapshot::compute_stamp(*data_list) != stamp)
+			{
+				DbCacheSnapshot::write(file_name,ds_name,host,*data_list);
+
+				Util *tg = Util::instance();
+				tg->set_db_cache_snapshot_stale();
+				std::cerr << "The database configuration of " << ds_name << " has changed since the startup snapshot ";
+				std::cerr << "was taken. Snapshot updated, restart the server to use the new configuration" << std::endl;
+				DEV_WARN_STREAM(tg->get_dserver_device()) << "The database configuration has changed since the startup "
+														  << "snapshot " << file_name << " was taken. Snapshot updated, "
+														  << "restart the server to use the new configuration" << std::endl;
+			}
+			else
+				TANGO_LOG_DEBUG << "DS cache snapshot " << file_name << " is up to date" << std::endl;
+		}
+		catch (Tango::DevFailed &e)
+		{
+			TANGO_LOG_DEBUG << "Can't check the DS cache snapshot: " << e.errors[0].desc.in() << std::endl;
+		}
+		catch (...)
+		{
+			TANGO_LOG_DEBUG << "Unknown exception while checking the DS cache snapshot" << std::endl;
+		}
+
+		return NULL;
+	}
+
+private:
+	Database		*db;
+	std::string		file_name;
+	std::string		ds_name;
+	std::string		host;
+	std::string		stamp;
+};
+
+} // anonymous namespace
+
 
 //+-------------------------------------------------------------------------------------------------------------------
 //
@@ -167,7 +235,8 @@ only_one("process"),nd_event_supplier(NULL),
 db_cache(NULL),inter(NULL),svr_starting(true),svr_stopping(false),poll_pool_size(ULONG_MAX),
 conf_needs_db_upd(false),ev_loop_func(NULL),shutdown_server(false),_dummy_thread(false),
 zmq_event_supplier(NULL),endpoint_specified(false),user_pub_hwm(-1),wattr_nan_allowed(false),
-polling_bef_9_def(false)
+polling_bef_9_def(false),startup_threads(0),db_cache_reconcile_th(NULL),db_cache_snapshot_stale(false),
+metrics_exporter(NULL)
 #else
 Util::Util(int argc,char *argv[]):cl_list_ptr(NULL),ext(new UtilExt),
 heartbeat_th(NULL),heartbeat_th_id(0),poll_mon("utils_poll"),poll_on(false),ser_model(BY_DEVICE),
@@ -175,7 +244,8 @@ only_one("process"),nd_event_supplier(NULL),
 db_cache(NULL),inter(NULL),svr_starting(true),svr_stopping(false),poll_pool_size(ULONG_MAX),
 conf_needs_db_upd(false),ev_loop_func(NULL),shutdown_server(false),_dummy_thread(false),
 zmq_event_supplier(NULL),endpoint_specified(false),user_pub_hwm(-1),wattr_nan_allowed(false),
-polling_bef_9_def(false)
+polling_bef_9_def(false),startup_threads(0),db_cache_reconcile_th(NULL),db_cache_snapshot_stale(false),
+metrics_exporter(NULL)
 #endif
 {
 	shared_data.cmd_pending=false;
@@ -200,6 +270,12 @@ polling_bef_9_def(false)
 void Util::effective_job(int argc,char *argv[])
 {
 
+//
+// Record the contention profile of the process serialization monitor
+//
+
+	only_one.enable_profile();
+
 	try
 	{
 
@@ -458,11 +534,22 @@ void Util::create_CORBA_objects()
 {
 
 //
-// Install an omniORB interceptors to store client name in blackbox and allocate a key for per thread specific storage
+// Install an omniORB interceptors to store client name in blackbox, to reset the thread reply arena, to count the
+// requests for the metrics exporter, to trace the requests (if enabled) and allocate a key for per thread specific
+// storage
 //
 
 	omni::omniInterceptors *intercep = omniORB::getInterceptors();
 	intercep->serverReceiveRequest.add(get_client_addr);
+	intercep->serverReceiveRequest.add(reply_arena_request);
+	intercep->serverReceiveRequest.add(metrics_request_received);
+	intercep->serverSendReply.add(metrics_reply_sent);
+	intercep->serverSendException.add(metrics_exception_sent);
+
+	Tracer::init();
+	if (Tracer::is_enabled() == true)
+		Tracer::install_interceptors(true);
+
 	intercep->createThread.add([](omni::omniInterceptors::createThread_T::info_T &info)
 	{
 		// Mark this thread as a library thread. This will allow setting
@@ -494,7 +581,9 @@ void Util::create_CORBA_objects()
 		}
 
 		// Run the thread and wait until it exists. This is mandatory.
+		MetricsExporter::orb_stats.nb_threads.fetch_add(1,std::memory_order_relaxed);
 		info.run();
+		MetricsExporter::orb_stats.nb_threads.fetch_sub(1,std::memory_order_relaxed);
 
 		if (interceptors != nullptr)
 		{
@@ -562,7 +651,8 @@ only_one("process"),nd_event_supplier(NULL),
 db_cache(NULL),inter(NULL),svr_starting(true),svr_stopping(false),poll_pool_size(ULONG_MAX),
 conf_needs_db_upd(false),ev_loop_func(NULL),shutdown_server(false),_dummy_thread(false),
 zmq_event_supplier(NULL),endpoint_specified(false),user_pub_hwm(-1),wattr_nan_allowed(false),
-polling_bef_9_def(false)
+polling_bef_9_def(false),startup_threads(0),db_cache_reconcile_th(NULL),db_cache_snapshot_stale(false),
+metrics_exporter(NULL)
 {
 
 //
@@ -1250,28 +1340,173 @@ void Util::connect_db()
 		std::string &inst_name = get_ds_inst_name();
 		if (inst_name != "-?")
 		{
-			db->set_timeout_millis(DB_TIMEOUT * 4);
-			set_svr_starting(false);
-			try
-			{
-				db_cache = new DbServerCache(db,get_ds_name(),get_host_name());
-			}
-			catch (Tango::DevFailed &e)
+
+//
+// If the user wants it, first try to fill the cache from a local snapshot
+//
+
+			std::string snap_dir;
+			if (ApiUtil::get_env_var("TANGO_DS_CACHE_SNAPSHOT_DIR",snap_dir) == 0 && snap_dir.empty() == false)
 			{
-				std::string base_desc(e.errors[0].desc.in());
-				if (base_desc.find("TRANSIENT_CallTimedout") != std::string::npos)
-					std::cerr << "DB timeout while trying to fill the DB server cache. Will use traditional way" << std::endl;
+				db_cache_snapshot = snap_dir + '/' + get_ds_exec_name() + '_' + inst_name + ".dscache";
+
+				std::unique_ptr<DbCacheSnapshot> snap(new DbCacheSnapshot(db_cache_snapshot));
+				if (snap->is_valid() == true && snap->get_ds_name() == get_ds_name() && snap->get_host() == get_host_name())
+				{
+					try
+					{
+						db_cache = new DbServerCache(snap.release());
+						TANGO_LOG_DEBUG << "DB server cache filled from snapshot " << db_cache_snapshot << std::endl;
+					}
+					catch (...)
+					{
+						std::cerr << "Unusable DS cache snapshot " << db_cache_snapshot << ". Will use database" << std::endl;
+					}
+				}
 			}
-			catch (...)
+
+			if (db_cache == NULL)
 			{
-				std::cerr << "Unknown exception while trying to fill database cache..." << std::endl;
+				db->set_timeout_millis(DB_TIMEOUT * 4);
+				set_svr_starting(false);
+				try
+				{
+					db_cache = new DbServerCache(db,get_ds_name(),get_host_name());
+				}
+				catch (Tango::DevFailed &e)
+				{
+					std::string base_desc(e.errors[0].desc.in());
+					if (base_desc.find("TRANSIENT_CallTimedout") != std::string::npos)
+						std::cerr << "DB timeout while trying to fill the DB server cache. Will use traditional way" << std::endl;
+				}
+				catch (...)
+				{
+					std::cerr << "Unknown exception while trying to fill database cache..." << std::endl;
+				}
+				db->set_timeout_millis(DB_TIMEOUT);
+				set_svr_starting(true);
+
+//
+// Store the snapshot for the next startup
+//
+
+				if (db_cache != NULL && db_cache_snapshot.empty() == false)
+				{
+					try
+					{
+						DbCacheSnapshot::write(db_cache_snapshot,get_ds_name(),get_host_name(),*(db_cache->get_data()));
+					}
+					catch (Tango::DevFailed &e)
+					{
+						std::cerr << e.errors[0].desc.in() << std::endl;
+					}
+				}
 			}
-			db->set_timeout_millis(DB_TIMEOUT);
-			set_svr_starting(true);
 		}
 	}
 }
 
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Util::release_db_cache()
+//
+// description :
+//		Delete the db cache at the end of the startup sequence. If the cache has been filled from a local snapshot,
+//		start a thread which checks the snapshot against the database and updates it if needed
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Util::release_db_cache()
+{
+	if (db_cache == NULL)
+		return;
+
+//
+// Extract sub device information before deleting cache!
+//
+
+	get_sub_dev_diag().get_sub_devices_from_cache();
+
+	if (db_cache->from_snapshot() == true)
+	{
+		DbCacheReconcileThread *th = new DbCacheReconcileThread(db,db_cache_snapshot,get_ds_name(),get_host_name(),
+																db_cache->get_snapshot()->get_stamp());
+		th->start();
+		db_cache_reconcile_th = th;
+	}
+
+	delete db_cache;
+	db_cache = NULL;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Util::stop_db_cache_reconcile()
+//
+// description :
+//		Wait for the thread checking the DS cache snapshot against the database (if started). It uses the
+//		Database object, it must be joined before the object is deleted
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Util::stop_db_cache_reconcile()
+{
+	if (db_cache_reconcile_th != NULL)
+	{
+		db_cache_reconcile_th->join(NULL);
+		db_cache_reconcile_th = NULL;
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Util::start_metrics_exporter()
+//
+// description :
+//		Start the metrics exporter thread if an endpoint has been defined (TANGO_DS_METRICS_ENDPOINT environment
+//		variable or set_metrics_endpoint() call). An error does not prevent the server to start
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Util::start_metrics_exporter()
+{
+	if (metrics_endpoint.empty() == true || metrics_exporter != NULL)
+		return;
+
+	try
+	{
+		metrics_exporter = new MetricsExporter(metrics_endpoint);
+		metrics_exporter->start();
+		TANGO_LOG_DEBUG << "Metrics exporter listening on " << metrics_exporter->get_endpoint() << std::endl;
+	}
+	catch (DevFailed &e)
+	{
+		std::cerr << "Metrics exporter not started: " << e.errors[0].desc << std::endl;
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Util::stop_metrics_exporter()
+//
+// description :
+//		Stop the metrics exporter thread if it is running
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void Util::stop_metrics_exporter()
+{
+	if (metrics_exporter != NULL)
+	{
+		metrics_exporter->stop();
+		metrics_exporter = NULL;
+	}
+}
+
 
 void Util::reset_filedatabase()
 {
@@ -1347,6 +1582,26 @@ void Util::misc_init()
 		if (iss)
 			user_pub_hwm = pub_hwm;
 	}
+
+//
+// Check if the user wants the devices to be created by several threads
+//
+
+	if (ApiUtil::get_env_var("TANGO_DS_STARTUP_THREADS",var) == 0)
+	{
+		unsigned long th_nb = 0;
+		std::istringstream iss(var);
+		iss >> th_nb;
+		if (iss)
+			startup_threads = th_nb;
+	}
+
+//
+// Check if the user wants the metrics exporter
+//
+
+	if (ApiUtil::get_env_var("TANGO_DS_METRICS_ENDPOINT",var) == 0)
+		metrics_endpoint = var;
 }
 
 //+-------------------------------------------------------------------------------------------------------------------
@@ -1655,7 +1910,12 @@ void Util::server_already_running()
 	{
 		const Tango::DevVarLongStringArray *db_dev;
 		CORBA::Any_var received;
-		if (db_cache != NULL)
+
+//
+// The import data stored in a snapshot may be too old to detect a running server: ask the database
+//
+
+		if (db_cache != NULL && db_cache->from_snapshot() == false)
 		{
 			db_dev = db_cache->import_adm_dev();
 		}
@@ -1856,14 +2116,13 @@ void Util::server_init(TANGO_UNUSED(bool with_window))
 // Delete the db cache if it has been used
 //
 
-		if (db_cache != NULL)
-		{
-		// extract sub device information before deleting cache!
-			get_sub_dev_diag().get_sub_devices_from_cache();
+		release_db_cache();
 
-			delete db_cache;
-			db_cache = NULL;
-		}
+//
+// Start the metrics exporter if an endpoint has been defined
+//
+
+		start_metrics_exporter();
 
 //
 // In case of process with forwarded attributes with root attribute inside this process as well
@@ -3070,14 +3329,7 @@ void *Util::ORBWin32Loop::run_undetached(void *ptr)
 // Delete DB cache (if there is one)
 //
 
-	if (util->db_cache != NULL)
-	{
-		// extract sub device information before deleting cache!
-		util->get_sub_dev_diag().get_sub_devices_from_cache();
-
-		delete util->db_cache;
-		util->db_cache = NULL;
-	}
+	util->release_db_cache();
 
 	util->set_svr_starting(false);
 
@@ -38,6 +38,7 @@
 #include <pollext.h>
 #include <subdev_diag.h>
 #include <new>
+#include <atomic>
 #include <rootattreg.h>
 #include <pollthread.h>
 
@@ -60,6 +61,7 @@ class NotifdEventSupplier;
 class ZmqEventSupplier;
 class DbServerCache;
 class SubDevDiag;
+class MetricsExporter;
 
 struct PollingThreadInfo;
 struct DevDbUpd;
@@ -448,6 +450,57 @@ public:
  */
 	unsigned long get_polling_threads_pool_size() {return poll_pool_size;}
 
+/**
+ * Set the number of threads used to create the devices during the startup sequence
+ *
+ * This number is used by the DeviceClass::create_devices() method. With 0 or 1 (the default),
+ * the devices are created one after the other. It can also be set with the TANGO_DS_STARTUP_THREADS
+ * environment variable.
+ *
+ * @param thread_nb The number of threads creating the devices
+ */
+	void set_startup_threads(unsigned long thread_nb) {startup_threads = thread_nb;}
+
+/**
+ * Get the number of threads used to create the devices during the startup sequence
+ *
+ * @return The number of threads creating the devices
+ */
+	unsigned long get_startup_threads() {return startup_threads;}
+
+/**
+ * Check if the DS cache snapshot used at startup is out of date
+ *
+ * When the device server has been started from a local snapshot of its database cache (see the
+ * TANGO_DS_CACHE_SNAPSHOT_DIR environment variable), the snapshot is checked against the database once the
+ * startup sequence is done. If the database configuration has changed, the snapshot is updated but the
+ * server keeps running with the configuration read from the old snapshot until it is restarted. This is
+ * also reported in the admin device status.
+ *
+ * @return True if the database configuration has changed since the startup snapshot was taken
+ */
+	bool is_db_cache_snapshot_stale() {return db_cache_snapshot_stale;}
+
+/**
+ * Set the metrics exporter endpoint
+ *
+ * When an endpoint is defined, a thread serves the device server internal counters (ORB threads, polling
+ * lateness, events, monitors, black box and request latencies) in the OpenMetrics text format. The endpoint is
+ * "port" or "ip:port" for HTTP (the default ip is 127.0.0.1) or "unix:path" for HTTP on a Unix socket. It can also
+ * be set with the TANGO_DS_METRICS_ENDPOINT environment variable. This method has to be called before the
+ * server_init() call.
+ *
+ * @param ep The metrics exporter endpoint
+ */
+	void set_metrics_endpoint(const std::string &ep) {metrics_endpoint = ep;}
+
+/**
+ * Get the metrics exporter endpoint
+ *
+ * @return The metrics exporter endpoint (empty if the exporter is not used)
+ */
+	const std::string &get_metrics_endpoint() {return metrics_endpoint;}
+
 /**
  * Set the polling thread algorithm to the algorithum used before Tango 9
  *
@@ -755,6 +808,8 @@ public:
 	std::map <std::string,std::vector<std::string> > &get_cmd_line_name_list() {return cmd_line_name_list;}
 	void get_cmd_line_name_list(const std::string &,std::vector<std::string> &);
 	TangoMonitor &get_heartbeat_monitor() {return poll_mon;}
+	TangoMonitor &get_process_monitor() {return only_one;}
+	void set_db_cache_snapshot_stale() {db_cache_snapshot_stale = true;}
 	PollThCmd &get_heartbeat_shared_cmd() {return shared_data;}
 	bool poll_status() {return poll_on;}
 	void poll_status(bool status) {poll_on = status;}
@@ -902,6 +957,10 @@ private:
 	void init_host_name();
 	void server_perform_work();
 	void server_already_running();
+	void release_db_cache();
+	void start_metrics_exporter();
+	void stop_metrics_exporter();
+	void stop_db_cache_reconcile();
 	void print_usage(char *);
 	static void print_err_message(const char *,Tango::MessBoxType type = Tango::STOP);
 	void print_err_message(const std::string &mess,Tango::MessBoxType type = Tango::STOP)
@@ -974,6 +1033,12 @@ private:
 
 	bool                        polling_bef_9_def;      // Is polling algo requirement defined
 	bool                        polling_bef_9;          // use Tango < 9 polling algo. flag
+	unsigned long				startup_threads;		// Number of threads creating the devices at startup
+	std::string					db_cache_snapshot;		// DS cache snapshot file (empty if not used)
+	omni_thread					*db_cache_reconcile_th;	// Thread checking the snapshot against the database
+	std::atomic<bool>			db_cache_snapshot_stale;// Database configuration changed since the snapshot
+	std::string					metrics_endpoint;		// Metrics exporter endpoint (empty if not used)
+	MetricsExporter				*metrics_exporter;		// The metrics exporter thread
 };
 
 //***************************************************************************
@@ -58,6 +58,8 @@ void Util::shutdown_ds()
 //		- Mark the server as shutting down
 //		- Send kill command to the polling thread
 //		- Join with this polling thread
+//		- Stop the metrics exporter
+//		- Wait for the DS cache snapshot check
 //		- Unregister server in database
 //		- Delete devices (except the admin one)
 //		- Stop the KeepAliveThread and the EventConsumer Thread when
@@ -77,6 +79,18 @@ void Util::shutdown_ds()
 	stop_heartbeat_thread();
 	clr_heartbeat_th_ptr();
 
+//
+// Stop the metrics exporter
+//
+
+	stop_metrics_exporter();
+
+//
+// Wait for the thread checking the DS cache snapshot (it uses the database object)
+//
+
+	stop_db_cache_reconcile();
+
 //
 // Unregister the server in the database
 //
@@ -52,6 +52,7 @@ using namespace CORBA;
 namespace Tango {
 
 ZmqEventSupplier *ZmqEventSupplier::_instance = NULL;
+ZmqEventSupplierStats ZmqEventSupplier::stats;
 
 
 /************************************************************************/
@@ -1349,6 +1350,7 @@ void ZmqEventSupplier::push_event(DeviceImpl *device_impl,std::string event_type
 		zmq::message_t *endian_mess_ptr = &endian_mess;
 		zmq::message_t *event_call_mess_ptr = &event_call_mess;
 		zmq::message_t *data_mess_ptr = &data_mess;
+		size_t data_size = data_mess.size();
 
 		std::map<std::string,McastSocketPub>::iterator mcast_ite;
 		std::map<std::string,McastSocketPub>::iterator mcast_ite_end = event_mcast.end();
@@ -1495,6 +1497,9 @@ void ZmqEventSupplier::push_event(DeviceImpl *device_impl,std::string event_type
 		if (ev_cptr_ite != event_cptr.end() && inc_cptr == true)
 			ev_cptr_ite->second++;
 
+		stats.nb_events.fetch_add(1,std::memory_order_relaxed);
+		stats.nb_bytes.fetch_add(data_size,std::memory_order_relaxed);
+
 //
 // For reference counting on zmq messages which do not have a local scope
 //
@@ -0,0 +1,229 @@
+//====================================================================================================================
+//
+// file :               tango_trace2json.cpp
+//
+// description :        Convert the request tracing files (see traceformat.h) into a Chrome trace JSON file which can be
+//						loaded in Perfetto (ui.perfetto.dev) or chrome://tracing. The client and server spans of a
+//						request are linked by a flow arrow.
+//						usage: tango_trace2json [-o output_file] trace_file [trace_file...]
+//
+// project :            TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#include <traceformat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Tango;
+
+//
+// One valid record with the process it comes from
+//
+
+struct Span
+{
+	uint64_t		pid;
+	TraceRecord		rec;
+};
+
+static std::string escape(const char *str,size_t max)
+{
+	std::string ret;
+	for (size_t loop = 0;loop < max && str[loop] != '\0';loop++)
+	{
+		unsigned char c = str[loop];
+		if (c == '"' || c == '\\')
+		{
+			ret += '\\';
+			ret += c;
+		}
+		else if (c < 0x20)
+		{
+			char buf[8];
+			::snprintf(buf,sizeof(buf),"\\u%04x",c);
+			ret += buf;
+		}
+		else
+			ret += c;
+	}
+	return ret;
+}
+
+static std::string hex(uint64_t id)
+{
+	char buf[24];
+	::snprintf(buf,sizeof(buf),"%016llx",(unsigned long long)id);
+	return buf;
+}
+
+static std::string us(int64_t ns)
+{
+	char buf[32];
+	unsigned long long abs_ns = ns < 0 ? 0ULL - (unsigned long long)ns : (unsigned long long)ns;
+	::snprintf(buf,sizeof(buf),"%s%llu.%03llu",ns < 0 ? "-" : "",abs_ns / 1000,abs_ns % 1000);
+	return buf;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// function :
+//		read_file
+//
+// description :
+//		Read the valid records of one trace file. A record is valid when its sequence number matches its index in
+//		the ring buffer (a record being written while the file was copied is ignored)
+//
+// argument :
+//		in :
+//			- name : The trace file name
+//		out :
+//			- spans : The valid records
+//			- procs : The process names (key = pid)
+//
+// return :
+//		False if the file is not a trace file
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+static bool read_file(const char *name,std::vector<Span> &spans,std::map<uint64_t,std::string> &procs)
+{
+	std::ifstream in(name,std::ios::binary);
+	TraceFileHeader header;
+	if (!in.read(reinterpret_cast<char *>(&header),sizeof(header)) ||
+		::memcmp(header.magic,TRACE_FILE_MAGIC,sizeof(header.magic)) != 0 ||
+		header.version != TRACE_FILE_VERSION || header.record_size != sizeof(TraceRecord) || header.capacity == 0)
+		return false;
+
+	procs[header.pid] = escape(header.process_name,sizeof(header.process_name));
+
+	TraceRecord rec;
+	for (uint64_t loop = 0;loop < header.capacity && in.read(reinterpret_cast<char *>(&rec),sizeof(rec));loop++)
+	{
+		if (rec.seq == 0 || (rec.seq - 1) % header.capacity != loop || rec.kind >= TRACE_KIND_NB)
+			continue;
+		spans.push_back({header.pid,rec});
+	}
+	return true;
+}
+
+int main(int argc,char *argv[])
+{
+	std::string out_name;
+	int first = 1;
+	if (argc > 2 && ::strcmp(argv[1],"-o") == 0)
+	{
+		out_name = argv[2];
+		first = 3;
+	}
+	if (first >= argc)
+	{
+		std::cerr << "usage: " << argv[0] << " [-o output_file] trace_file [trace_file...]" << std::endl;
+		return 1;
+	}
+
+	int ret = 0;
+	std::vector<Span> spans;
+	std::map<uint64_t,std::string> procs;
+	for (int loop = first;loop < argc;loop++)
+	{
+		if (read_file(argv[loop],spans,procs) == false)
+		{
+			std::cerr << argv[loop] << ": not a Tango trace file" << std::endl;
+			ret = 1;
+		}
+	}
+
+	std::sort(spans.begin(),spans.end(),[](const Span &a,const Span &b){return a.rec.start_ns < b.rec.start_ns;});
+
+	std::ofstream out_file;
+	if (out_name.empty() == false)
+	{
+		out_file.open(out_name);
+		if (!out_file)
+		{
+			std::cerr << "Can't create " << out_name << std::endl;
+			return 1;
+		}
+	}
+	std::ostream &out = out_name.empty() == true ? std::cout : out_file;
+
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+	bool first_event = true;
+	auto sep = [&]() {out << (first_event == true ? "" : ",\n"); first_event = false;};
+
+	for (const auto &proc : procs)
+	{
+		sep();
+		out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << proc.first
+			<< ",\"args\":{\"name\":\"" << proc.second << " (" << proc.first << ")\"}}";
+	}
+
+	std::map<uint64_t,const Span *> by_id;
+	for (const auto &span : spans)
+	{
+		const TraceRecord &rec = span.rec;
+		by_id[rec.span_id] = &span;
+
+		sep();
+		out << "{\"name\":\"" << TraceSpanKindName[rec.kind];
+		if (rec.name[0] != '\0')
+			out << " " << escape(rec.name,sizeof(rec.name));
+		out << "\",\"cat\":\"" << TraceSpanKindName[rec.kind] << "\",\"ph\":\"X\",\"ts\":" << us(rec.start_ns)
+			<< ",\"dur\":" << us(rec.duration_ns) << ",\"pid\":" << span.pid << ",\"tid\":" << rec.thread_id
+			<< ",\"args\":{\"trace_id\":\"" << hex(rec.trace_id) << "\",\"span_id\":\"" << hex(rec.span_id)
+			<< "\",\"parent_id\":\"" << hex(rec.parent_id) << "\"}}";
+	}
+
+//
+// Flow arrows from a span to its children running in another process (the client call to the server request).
+// The arrow starts within the parent slice
+//
+
+	for (const auto &span : spans)
+	{
+		auto ite = by_id.find(span.rec.parent_id);
+		if (span.rec.parent_id == 0 || ite == by_id.end() || ite->second->pid == span.pid)
+			continue;
+
+		const Span &parent = *(ite->second);
+		int64_t start = std::min(std::max(span.rec.start_ns,parent.rec.start_ns),parent.rec.start_ns + parent.rec.duration_ns);
+
+		sep();
+		out << "{\"name\":\"request\",\"cat\":\"flow\",\"ph\":\"s\",\"id\":\"" << hex(span.rec.span_id) << "\",\"ts\":"
+			<< us(start) << ",\"pid\":" << parent.pid << ",\"tid\":" << parent.rec.thread_id << "}";
+		sep();
+		out << "{\"name\":\"request\",\"cat\":\"flow\",\"ph\":\"f\",\"bp\":\"e\",\"id\":\"" << hex(span.rec.span_id)
+			<< "\",\"ts\":" << us(span.rec.start_ns) << ",\"pid\":" << span.pid << ",\"tid\":" << span.rec.thread_id << "}";
+	}
+
+	out << "\n]}" << std::endl;
+
+	return ret;
+}
@@ -9,6 +9,7 @@ endmacro()
 
 LOG4TANGO_CHECK_INCLUDE_FILE("io.h"           HAVE_IO_H)
 LOG4TANGO_CHECK_INCLUDE_FILE("unistd.h"       HAVE_UNISTD_H)
+LOG4TANGO_CHECK_INCLUDE_FILE("sys/mman.h"     HAVE_SYS_MMAN_H)
 
 if(NOT DEFINED Threads_FOUND)
   message(FATAL_ERROR "Could not find a suitable threading library")
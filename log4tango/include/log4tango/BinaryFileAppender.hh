@@ -0,0 +1,161 @@
+//
+// BinaryFileAppender.hh
+//
+// Copyright (C) :  2004,2005,2006,2007,2008,2009,2010,2011,2012
+//					Synchrotron SOLEIL
+//                	L'Orme des Merisiers
+//                	Saint-Aubin - BP 48 - France
+//
+// This file is part of log4tango.
+//
+// Log4ango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Log4tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Log4Tango.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _LOG4TANGO_BINARYFILEAPPENDER_H
+#define _LOG4TANGO_BINARYFILEAPPENDER_H
+
+#include <log4tango/Portability.hh>
+#include <log4tango/Appender.hh>
+#include <sys/stat.h>
+#include <map>
+#include <mutex>
+
+namespace log4tango {
+
+//-----------------------------------------------------------------------------
+// The binary log file format (host byte order)
+//
+//  file header : magic "L4TB" | uint16 version | uint16 reserved | uint32 byte order mark
+//  records     : uint8 record type followed by the record body
+//    STRING    : uint32 id | uint32 length | chars
+//    EVENT     : int64 timestamp (uS since epoch) | int32 level | uint32 logger id
+//                | uint32 file id | int32 line | uint64 thread | uint32 length | message
+//    END       : (0) end of data (the remaining part of the file is zero filled)
+//
+// Logger names and file paths are interned: they are written once per file as
+// STRING records and the EVENT records only refer to their ids. Use the
+// BinaryLogReader class (or the log4tango_decode tool) to render the records
+// with a PatternLayout.
+//-----------------------------------------------------------------------------
+namespace binary_log {
+  const char MAGIC[4] = {'L', '4', 'T', 'B'};
+  const unsigned short VERSION = 1;
+  const unsigned int BYTE_ORDER_MARK = 0x01020304;
+  const size_t HEADER_SIZE = 12;
+  enum RecordType {
+    END = 0,
+    STRING = 1,
+    EVENT = 2
+  };
+} // namespace binary_log
+
+//-----------------------------------------------------------------------------
+// class : BinaryFileAppender (writes binary records to a rolling, mapped file)
+//-----------------------------------------------------------------------------
+class BinaryFileAppender : public Appender
+{
+public:
+
+  /**
+  Constructs a BinaryFileAppender.
+  The file is allocated (and memory-mapped when supported) with its maximum
+  size. An already existing file is rolled over first.
+  @param name the name of the Appender.
+  @param file_name the name of the file to which the Appender has to log.
+  @param max_fs the maximum file size (bytes).
+  @param max_bi the number of backup files kept when rolling over.
+  @param mode file mode to open the logfile with. Defaults to 00644.
+  **/
+  BinaryFileAppender(const std::string& name,
+                     const std::string& file_name,
+                     size_t max_fs = 10*1024*1024,
+                     unsigned int max_bi = 1,
+                     mode_t mode = 00644);
+
+  /**
+   Destructor
+  **/
+  virtual ~BinaryFileAppender();
+
+  /**
+  Closes the current file (trimmed to its used size) and starts a new one
+  @returns true if the reopen succeeded.
+  **/
+  virtual bool reopen (void);
+
+  /**
+  Closes the logfile.
+  **/
+  virtual void close (void);
+
+  /**
+   * Check if the appender is valid.
+   *
+   * @returns true if the appender is valid, false otherwise.
+   **/
+  virtual bool is_valid (void) const;
+
+  /**
+   * The records are formatted off-line: no layout
+   **/
+  virtual bool requires_layout (void) const;
+
+  /**
+   * No-op
+   **/
+  virtual void set_layout (Layout* layout = 0);
+
+  virtual void set_max_backup_index (unsigned int max_bi);
+
+  virtual unsigned int get_max_backup_index (void) const;
+
+  /**
+   * The new size is used for the next file
+   **/
+  virtual void set_maximum_file_size (size_t max_fs);
+
+  virtual size_t get_max_file_size (void) const;
+
+  virtual void roll_over (void);
+
+protected:
+
+  virtual int _append (const LoggingEvent& event);
+
+private:
+
+  bool open_file (void);
+
+  void close_file (void);
+
+  void rename_backups (void);
+
+  unsigned int intern (const std::string& str, std::string& record);
+
+  bool commit (const std::string& record);
+
+  const std::string _file_name;
+  size_t _max_file_size;
+  unsigned int _max_backup_index;
+  mode_t _mode;
+  int _fd;
+  char* _map;
+  size_t _map_size;
+  size_t _offset;
+  std::map<std::string, unsigned int> _strings;
+  std::mutex _mutex;
+};
+
+} // namespace log4tango
+
+#endif // _LOG4TANGO_BINARYFILEAPPENDER_H
@@ -0,0 +1,77 @@
+//
+// BinaryLogReader.hh
+//
+// Copyright (C) :  2004,2005,2006,2007,2008,2009,2010,2011,2012
+//					Synchrotron SOLEIL
+//                	L'Orme des Merisiers
+//                	Saint-Aubin - BP 48 - France
+//
+// This file is part of log4tango.
+//
+// Log4ango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Log4tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Log4Tango.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _LOG4TANGO_BINARYLOGREADER_H
+#define _LOG4TANGO_BINARYLOGREADER_H
+
+#include <log4tango/Portability.hh>
+#include <log4tango/LoggingEvent.hh>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace log4tango {
+
+//-----------------------------------------------------------------------------
+// class : BinaryLogReader (reads the files written by a BinaryFileAppender)
+//-----------------------------------------------------------------------------
+class BinaryLogReader
+{
+public:
+
+  /**
+  Loads a binary log file.
+  @param file_name the name of the file.
+  **/
+  BinaryLogReader(const std::string& file_name);
+
+  /**
+  Check if the file has been loaded and has a valid header.
+  The file must have been written on a host with the same byte order.
+  **/
+  bool is_valid (void) const;
+
+  /**
+  Reads the next event.
+  The thread_name of the returned event is set to the (hashed) id of the
+  thread which generated it: use %T to render it with a PatternLayout.
+  @returns the next event or a null pointer at the end of the file
+  **/
+  std::unique_ptr<LoggingEvent> next (void);
+
+private:
+
+  template <typename T> bool read (T& value);
+
+  bool read_string (std::string& str);
+
+  std::vector<char> _data;
+  size_t _offset;
+  bool _valid;
+  std::map<unsigned int, std::string> _strings;
+};
+
+} // namespace log4tango
+
+#endif // _LOG4TANGO_BINARYLOGREADER_H
@@ -111,14 +111,52 @@ public:
   **/
   virtual mode_t get_mode() const;
 
+  /**
+  Sets the asynchronous mode.
+  In asynchronous mode, the logging thread only pushes a copy of the
+  event into a lock-free queue. A single writer thread formats the
+  queued events and writes them to the file in large batches. The
+  layout must not be changed while the asynchronous mode is enabled.
+  @param async true to enable the asynchronous mode, false to go
+  back to synchronous writes (pending events are flushed first)
+  **/
+  virtual void set_async (bool async);
+
+  /**
+  Gets the value of the 'async' option.
+  **/
+  virtual bool get_async (void) const;
+
 protected:
 
   virtual int _append (const LoggingEvent& event);
 
+  /**
+  Writes already formatted message(s) to the logfile. This is
+  called from the logging thread in synchronous mode and from the
+  writer thread in asynchronous mode.
+  **/
+  virtual int _write (const char* data, size_t size);
+
+  /**
+  Flushes the pending events and stops the writer thread. Derived
+  classes overriding _write() must call it from their destructor.
+  **/
+  void stop_async_writer (void);
+
   const std::string _file_name;
   int _fd;
   int _flags;
   mode_t _mode;
+
+private:
+
+  class AsyncWriter;
+
+  void start_async_writer (void);
+
+  bool _async;
+  AsyncWriter* _async_writer;
 };
 
 } // namespace log4tango
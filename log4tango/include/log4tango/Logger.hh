@@ -29,11 +29,18 @@
 #define _LOG4TANGO_LOGGER_H
  
 #include <log4tango/Portability.hh>
+#include <atomic>
 #include <log4tango/AppenderAttachable.hh>
 #include <log4tango/LoggingEvent.hh>
 #include <log4tango/Level.hh>
 #include <log4tango/LoggerStream.hh>
 
+//-----------------------------------------------------------------------------
+// The most verbose level compiled in (see Logger::is_level_compiled) is
+// LOG4TANGO_COMPILED_LEVEL, defined in the generated log4tango/config.h.
+// Messages with a more verbose level are removed at compile time.
+//-----------------------------------------------------------------------------
+
 namespace log4tango {
 
 
@@ -76,17 +83,29 @@ public:
    * @return Level - the assigned Level, can be Level::NOTSET
    **/
   inline Level::Value get_level() const {
-    return _level;
+    return _level.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns true if messages with the given level are compiled in
+   * (i.e. level is not more verbose than LOG4TANGO_COMPILED_LEVEL).
+   * @param level The level to compare with.
+   * @returns whether logging can be enabled for this level.
+   **/
+  static constexpr bool is_level_compiled (Level::Value level) {
+    return level <= LOG4TANGO_COMPILED_LEVEL;
   }
 
   /** 
    * Returns true if the level of the Logger is equal to
    * or higher than given level.
+   * The compile time check is folded away when level is a constant, the
+   * runtime check is a single relaxed atomic load.
    * @param level The level to compare with.
    * @returns whether logging is enable for this level.
    **/
-  bool is_level_enabled (Level::Value level) const {
-    return _level >= level;
+  inline bool is_level_enabled (Level::Value level) const {
+    return is_level_compiled(level) && _level.load(std::memory_order_relaxed) >= level;
   }
 
   /** 
@@ -354,7 +373,7 @@ private:
   const std::string _name;
 
   /** The assigned level of this logger. */
-  Level::Value _level;
+  std::atomic<Level::Value> _level;
 
 
   /* prevent copying and assignment */
@@ -47,6 +47,8 @@ class RollingFileAppender : public FileAppender
                         bool append = true,
                         mode_t mode = 00644);
 
+    virtual ~RollingFileAppender();
+
     virtual void set_max_backup_index(unsigned int maxBackups);
 
     virtual unsigned int get_max_backup_index() const;
@@ -59,7 +61,7 @@ class RollingFileAppender : public FileAppender
 
 protected:
 
-    virtual int _append (const LoggingEvent& event);
+    virtual int _write (const char* data, size_t size);
 
     unsigned int _max_backup_index;
 
@@ -0,0 +1,301 @@
+//
+// BinaryFileAppender.cpp
+//
+// Copyright (C) :  2004,2005,2006,2007,2008,2009,2010,2011,2012
+//					Synchrotron SOLEIL
+//                	L'Orme des Merisiers
+//                	Saint-Aubin - BP 48 - France
+//
+// This file is part of log4tango.
+//
+// Log4ango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Log4tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Log4Tango.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <log4tango/Portability.hh>
+#ifdef LOG4TANGO_HAVE_IO_H
+# include <io.h>
+#endif
+#ifdef LOG4TANGO_HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+#ifdef LOG4TANGO_HAVE_SYS_MMAN_H
+# include <sys/mman.h>
+#endif
+#include <sys/types.h>
+#include <fcntl.h>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <functional>
+#include <log4tango/BinaryFileAppender.hh>
+
+namespace log4tango {
+
+#if defined(_MSC_VER)
+    #pragma warning(push)
+    #pragma warning(disable : 4996) //non compliant POSIX names (close for _close, ...)
+#endif
+
+namespace {
+
+  template <typename T> void put (std::string& record, T value)
+  {
+    record.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+} // namespace
+
+BinaryFileAppender::BinaryFileAppender (const std::string& name,
+                                        const std::string& file_name,
+                                        size_t max_fs,
+                                        unsigned int max_bi,
+                                        mode_t mode)
+ : Appender(name),
+   _file_name(file_name),
+   _max_file_size(max_fs),
+   _max_backup_index(max_bi),
+   _mode(mode),
+   _fd(-1),
+   _map(0),
+   _map_size(0),
+   _offset(0)
+{
+  struct stat st;
+  if (::stat(_file_name.c_str(), &st) == 0 && st.st_size > 0) {
+    rename_backups();
+  }
+  open_file();
+}
+
+BinaryFileAppender::~BinaryFileAppender ()
+{
+  close();
+}
+
+bool BinaryFileAppender::requires_layout (void) const
+{
+  return false;
+}
+
+void BinaryFileAppender::set_layout (Layout*)
+{
+  // no-op
+}
+
+bool BinaryFileAppender::is_valid (void) const
+{
+  return (_fd < 0) ? false : true;
+}
+
+void BinaryFileAppender::set_max_backup_index (unsigned int max_bi)
+{
+  _max_backup_index = max_bi;
+}
+
+unsigned int BinaryFileAppender::get_max_backup_index (void) const
+{
+  return _max_backup_index;
+}
+
+void BinaryFileAppender::set_maximum_file_size (size_t max_fs)
+{
+  _max_file_size = max_fs;
+}
+
+size_t BinaryFileAppender::get_max_file_size (void) const
+{
+  return _max_file_size;
+}
+
+void BinaryFileAppender::close (void)
+{
+  std::lock_guard<std::mutex> guard(_mutex);
+  close_file();
+}
+
+bool BinaryFileAppender::reopen (void)
+{
+  std::lock_guard<std::mutex> guard(_mutex);
+  close_file();
+  rename_backups();
+  return open_file();
+}
+
+void BinaryFileAppender::roll_over (void)
+{
+  reopen();
+}
+
+bool BinaryFileAppender::open_file (void)
+{
+  int flags = O_CREAT | O_TRUNC | O_RDWR;
+#ifdef _WIN32
+  // no newline translation: the records are binary
+  flags |= O_BINARY;
+#endif
+  _fd = ::open(_file_name.c_str(), flags, _mode);
+  if (_fd < 0) {
+    return false;
+  }
+  _offset = 0;
+  _strings.clear();
+#ifdef LOG4TANGO_HAVE_SYS_MMAN_H
+  // allocate the whole file (zero filled) and map it
+  size_t size = _max_file_size;
+  if (size < binary_log::HEADER_SIZE) {
+    size = binary_log::HEADER_SIZE;
+  }
+  if (::ftruncate(_fd, static_cast<off_t>(size)) == 0) {
+    void* addr = ::mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (addr != MAP_FAILED) {
+      _map = static_cast<char*>(addr);
+      _map_size = size;
+    }
+  }
+#endif
+  std::string header(binary_log::MAGIC, sizeof(binary_log::MAGIC));
+  put(header, binary_log::VERSION);
+  put(header, static_cast<unsigned short>(0));
+  put(header, binary_log::BYTE_ORDER_MARK);
+  commit(header);
+  return true;
+}
+
+void BinaryFileAppender::close_file (void)
+{
+#ifdef LOG4TANGO_HAVE_SYS_MMAN_H
+  if (_map) {
+    ::munmap(_map, _map_size);
+    _map = 0;
+    _map_size = 0;
+    // trim the file to its used size
+    if (::ftruncate(_fd, static_cast<off_t>(_offset)) != 0) {
+      // the zero filled tail is read as an END record
+    }
+  }
+#endif
+  if (_fd != -1) {
+    ::close(_fd);
+    _fd = -1;
+  }
+}
+
+void BinaryFileAppender::rename_backups (void)
+{
+  if (_max_backup_index > 0) {
+    std::string oldest = _file_name + "." + std::to_string(_max_backup_index);
+    ::remove(oldest.c_str());
+    for (unsigned int i = _max_backup_index; i > 1; i--) {
+      std::string new_name = _file_name + "." + std::to_string(i);
+      std::string old_name = _file_name + "." + std::to_string(i - 1);
+      ::rename(old_name.c_str(), new_name.c_str());
+    }
+    ::rename(_file_name.c_str(), (_file_name + ".1").c_str());
+  }
+}
+
+unsigned int BinaryFileAppender::intern (const std::string& str, std::string& record)
+{
+  std::map<std::string, unsigned int>::const_iterator it = _strings.find(str);
+  if (it != _strings.end()) {
+    return it->second;
+  }
+  unsigned int id = static_cast<unsigned int>(_strings.size());
+  _strings.insert(std::make_pair(str, id));
+  put(record, static_cast<unsigned char>(binary_log::STRING));
+  put(record, id);
+  put(record, static_cast<unsigned int>(str.size()));
+  record.append(str);
+  return id;
+}
+
+bool BinaryFileAppender::commit (const std::string& record)
+{
+  if (_map) {
+    if (_offset + record.size() > _map_size) {
+      return false;
+    }
+    ::memcpy(_map + _offset, record.data(), record.size());
+    _offset += record.size();
+    return true;
+  }
+  if (_offset > binary_log::HEADER_SIZE && _offset + record.size() > _max_file_size) {
+    return false;
+  }
+  const char* data = record.data();
+  size_t size = record.size();
+  while (size > 0) {
+    int written = ::write(_fd, data, static_cast<unsigned int>(size));
+    if (written <= 0) {
+      break;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  _offset += record.size();
+  return true;
+}
+
+int BinaryFileAppender::_append (const LoggingEvent& event)
+{
+  std::lock_guard<std::mutex> guard(_mutex);
+  if (_fd < 0) {
+    return 0;
+  }
+  long long ts = std::chrono::duration_cast<std::chrono::microseconds>(
+      event.timestamp.time_since_epoch()).count();
+  unsigned long long thread = std::hash<std::thread::id>()(event.thread_id);
+  for (int attempt = 0; attempt < 2; attempt++) {
+    std::string record;
+    size_t nb_strings = _strings.size();
+    unsigned int logger_id = intern(event.logger_name, record);
+    bool logger_added = (_strings.size() != nb_strings);
+    nb_strings = _strings.size();
+    unsigned int file_id = intern(event.file_path, record);
+    bool file_added = (_strings.size() != nb_strings);
+    put(record, static_cast<unsigned char>(binary_log::EVENT));
+    put(record, ts);
+    put(record, static_cast<int>(event.level));
+    put(record, logger_id);
+    put(record, file_id);
+    put(record, static_cast<int>(event.line_number));
+    put(record, thread);
+    put(record, static_cast<unsigned int>(event.message.size()));
+    record.append(event.message);
+    if (commit(record)) {
+      return 0;
+    }
+    // the file is full: forget the strings interned for this record and start a new file
+    if (file_added) {
+      _strings.erase(event.file_path);
+    }
+    if (logger_added) {
+      _strings.erase(event.logger_name);
+    }
+    if (attempt == 0) {
+      close_file();
+      rename_backups();
+      if (!open_file()) {
+        return -1;
+      }
+    }
+  }
+  // the record does not fit in an empty file: drop it
+  return 0;
+}
+
+#if defined(_MSC_VER)
+    #pragma warning(pop)
+#endif
+} // namespace log4tango
@@ -0,0 +1,131 @@
+//
+// BinaryLogReader.cpp
+//
+// Copyright (C) :  2004,2005,2006,2007,2008,2009,2010,2011,2012
+//					Synchrotron SOLEIL
+//                	L'Orme des Merisiers
+//                	Saint-Aubin - BP 48 - France
+//
+// This file is part of log4tango.
+//
+// Log4ango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Log4tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Log4Tango.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <log4tango/Portability.hh>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <log4tango/BinaryFileAppender.hh>
+#include <log4tango/BinaryLogReader.hh>
+
+namespace log4tango {
+
+BinaryLogReader::BinaryLogReader (const std::string& file_name)
+ : _offset(0),
+   _valid(false)
+{
+  std::ifstream in(file_name.c_str(), std::ios::in | std::ios::binary);
+  if (!in) {
+    return;
+  }
+  _data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  if (_data.size() < binary_log::HEADER_SIZE) {
+    return;
+  }
+  if (::memcmp(&_data[0], binary_log::MAGIC, sizeof(binary_log::MAGIC)) != 0) {
+    return;
+  }
+  _offset = sizeof(binary_log::MAGIC);
+  unsigned short version;
+  unsigned short reserved;
+  unsigned int bom;
+  if (!read(version) || !read(reserved) || !read(bom)) {
+    return;
+  }
+  _valid = (version == binary_log::VERSION) && (bom == binary_log::BYTE_ORDER_MARK);
+}
+
+bool BinaryLogReader::is_valid (void) const
+{
+  return _valid;
+}
+
+template <typename T> bool BinaryLogReader::read (T& value)
+{
+  if (_offset + sizeof(T) > _data.size()) {
+    return false;
+  }
+  ::memcpy(&value, &_data[_offset], sizeof(T));
+  _offset += sizeof(T);
+  return true;
+}
+
+bool BinaryLogReader::read_string (std::string& str)
+{
+  unsigned int length;
+  if (!read(length) || _offset + length > _data.size()) {
+    return false;
+  }
+  str.assign(_data.data() + _offset, length);
+  _offset += length;
+  return true;
+}
+
+std::unique_ptr<LoggingEvent> BinaryLogReader::next (void)
+{
+  while (_valid) {
+    unsigned char type;
+    if (!read(type) || type == binary_log::END) {
+      break;
+    }
+    if (type == binary_log::STRING) {
+      unsigned int id;
+      std::string str;
+      if (!read(id) || !read_string(str)) {
+        break;
+      }
+      _strings[id] = str;
+    }
+    else if (type == binary_log::EVENT) {
+      long long ts;
+      int level;
+      unsigned int logger_id;
+      unsigned int file_id;
+      int line;
+      unsigned long long thread;
+      std::string message;
+      if (!read(ts) || !read(level) || !read(logger_id) || !read(file_id)
+          || !read(line) || !read(thread) || !read_string(message)) {
+        break;
+      }
+      std::unique_ptr<LoggingEvent> event(
+          new LoggingEvent(_strings[logger_id], message, level, _strings[file_id], line));
+      event->timestamp = std::chrono::system_clock::time_point(
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(ts)));
+      std::ostringstream thread_name;
+      thread_name << std::hex << thread;
+      event->thread_name = thread_name.str();
+      return event;
+    }
+    else {
+      // unknown record: the file is corrupted
+      break;
+    }
+  }
+  _offset = _data.size();
+  return std::unique_ptr<LoggingEvent>();
+}
+
+} // namespace log4tango
@@ -34,10 +34,154 @@
 # include <unistd.h>
 #endif
 #include <fcntl.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <log4tango/FileAppender.hh>
 
 namespace log4tango {
 
+//-----------------------------------------------------------------------------
+// class : FileAppender::AsyncWriter
+//
+// Lock-free multiple producers / single consumer queue (intrusive linked list
+// with a stub node) drained by a dedicated writer thread. Producers never take
+// a lock, except to wake up the writer thread when it is sleeping.
+//-----------------------------------------------------------------------------
+class FileAppender::AsyncWriter
+{
+public:
+
+  AsyncWriter (FileAppender& appender);
+
+  ~AsyncWriter ();
+
+  void push (const LoggingEvent& event);
+
+  // protects the file descriptor against a concurrent reopen()
+  std::mutex write_mutex;
+
+private:
+
+  struct Node
+  {
+    std::atomic<Node*> next;
+    LoggingEvent* event;
+  };
+
+  // max size of the buffer written to the file in one go
+  static const size_t kBatchSize = 64 * 1024;
+  // max sleep time of the writer thread (safety net)
+  static const int kMaxSleepMs = 100;
+
+  LoggingEvent* pop (void);
+
+  void run (void);
+
+  void flush (std::string& buffer);
+
+  FileAppender& _appender;
+  std::atomic<Node*> _head;
+  Node* _tail;
+  std::atomic<bool> _exit;
+  std::atomic<bool> _waiting;
+  std::mutex _mutex;
+  std::condition_variable _cond;
+  std::thread _thread;
+};
+
+const size_t FileAppender::AsyncWriter::kBatchSize;
+const int FileAppender::AsyncWriter::kMaxSleepMs;
+
+FileAppender::AsyncWriter::AsyncWriter (FileAppender& appender)
+ : _appender(appender),
+   _exit(false),
+   _waiting(false)
+{
+  Node* stub = new Node;
+  stub->next.store(nullptr, std::memory_order_relaxed);
+  stub->event = nullptr;
+  _head.store(stub, std::memory_order_relaxed);
+  _tail = stub;
+  _thread = std::thread(&AsyncWriter::run, this);
+}
+
+FileAppender::AsyncWriter::~AsyncWriter ()
+{
+  _exit.store(true);
+  {
+    std::lock_guard<std::mutex> guard(_mutex);
+    _cond.notify_one();
+  }
+  _thread.join();
+  // the writer thread drained the queue: only the stub node is left
+  delete _tail;
+}
+
+void FileAppender::AsyncWriter::push (const LoggingEvent& event)
+{
+  Node* node = new Node;
+  node->next.store(nullptr, std::memory_order_relaxed);
+  node->event = new LoggingEvent(event);
+  Node* prev = _head.exchange(node, std::memory_order_acq_rel);
+  prev->next.store(node);
+  if (_waiting.load()) {
+    std::lock_guard<std::mutex> guard(_mutex);
+    _cond.notify_one();
+  }
+}
+
+LoggingEvent* FileAppender::AsyncWriter::pop (void)
+{
+  Node* tail = _tail;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (!next) {
+    return nullptr;
+  }
+  LoggingEvent* event = next->event;
+  next->event = nullptr;
+  _tail = next;
+  delete tail;
+  return event;
+}
+
+void FileAppender::AsyncWriter::flush (std::string& buffer)
+{
+  if (!buffer.empty()) {
+    std::lock_guard<std::mutex> guard(write_mutex);
+    _appender._write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+}
+
+void FileAppender::AsyncWriter::run (void)
+{
+  std::string buffer;
+  buffer.reserve(kBatchSize);
+  for (;;) {
+    LoggingEvent* event;
+    while ((event = pop()) != nullptr) {
+      buffer += _appender.get_layout().format(*event);
+      delete event;
+      if (buffer.size() >= kBatchSize) {
+        flush(buffer);
+      }
+    }
+    flush(buffer);
+    std::unique_lock<std::mutex> lock(_mutex);
+    _waiting.store(true);
+    if (_tail->next.load() == nullptr) {
+      if (_exit.load()) {
+        break;
+      }
+      _cond.wait_for(lock, std::chrono::milliseconds(kMaxSleepMs));
+    }
+    _waiting.store(false);
+  }
+}
+
 #if defined(_MSC_VER)
     #pragma warning(push)
     #pragma warning(disable : 4996) //non compliant POSIX names (close for _close, ...)
@@ -50,7 +194,9 @@ FileAppender::FileAppender(const std::string& name,
  : LayoutAppender(name),
    _file_name(file_name),
    _flags(O_CREAT | O_APPEND | O_WRONLY),
-  _mode(mode) 
+   _mode(mode),
+   _async(false),
+   _async_writer(0)
 {
   if (!append) {
     _flags |= O_TRUNC;
@@ -63,7 +209,9 @@ FileAppender::FileAppender (const std::string& name, int fd)
    _file_name(""),
    _fd(fd),
    _flags(O_CREAT | O_APPEND | O_WRONLY),
-   _mode(00644) 
+   _mode(00644),
+   _async(false),
+   _async_writer(0)
 {
   //no-op
 }
@@ -75,6 +223,7 @@ FileAppender::~FileAppender()
 
 void FileAppender::close (void) 
 {
+  stop_async_writer();
   if (_fd != -1) {
     ::close(_fd);
     _fd = -1;
@@ -110,12 +259,58 @@ mode_t FileAppender::get_mode (void) const
   return _mode;
 }
 
+void FileAppender::set_async (bool async)
+{
+  _async = async;
+  if (_async) {
+    start_async_writer();
+  } else {
+    stop_async_writer();
+  }
+}
+
+bool FileAppender::get_async (void) const
+{
+  return _async;
+}
+
+void FileAppender::start_async_writer (void)
+{
+  if (!_async_writer && _fd != -1) {
+    _async_writer = new AsyncWriter(*this);
+  }
+}
+
+void FileAppender::stop_async_writer (void)
+{
+  if (_async_writer) {
+    delete _async_writer;
+    _async_writer = 0;
+  }
+}
+
 int FileAppender::_append (const LoggingEvent& event) 
 {
+  if (_async_writer) {
+    _async_writer->push(event);
+    return 0;
+  }
   std::string message(get_layout().format(event));
-  // Messages longer than sizeof(uint) will be truncated.
-  if (!::write(_fd, message.data(), static_cast<unsigned int>(message.length()))) {
-    return -1;
+  return _write(message.data(), message.length());
+}
+
+int FileAppender::_write (const char* data, size_t size)
+{
+  while (size > 0) {
+    int written = ::write(_fd, data, static_cast<unsigned int>(size));
+    if (written == 0) {
+      return -1;
+    }
+    if (written < 0) {
+      break;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
   }
   return 0;
 }
@@ -127,12 +322,19 @@ bool FileAppender::reopen (void)
     if (fd < 0) {
       return false;
     } else {
+      std::unique_lock<std::mutex> guard;
+      if (_async_writer) {
+        guard = std::unique_lock<std::mutex>(_async_writer->write_mutex);
+      }
       if (_fd != -1) {
         ::close(_fd);
       }
       _fd = fd;
     }
   }
+  if (_async) {
+    start_async_writer();
+  }
   return true;
 }
 
@@ -49,14 +49,14 @@ Logger::~Logger()
 void Logger::set_level (Level::Value level)
 {
   if ((level >= Level::OFF) && (level <= Level::DEBUG)) {
-    _level = level;
+    _level.store(level, std::memory_order_relaxed);
     { //-- Begin critical section -----------------------------
       std::lock_guard<std::mutex> guard(_appendersMutex);
       if (!_appenders.empty()) {
         AppenderMapIterator i = _appenders.begin();
         AppenderMapIterator e = _appenders.end();
         for (; i != e ; ++i) {
-          i->second->level_changed(_level);
+          i->second->level_changed(level);
         }
       }
     } //-- End critical section ------------------------------
@@ -53,6 +53,11 @@ namespace log4tango {
         _max_file_size(max_fs) {
     }
 
+    RollingFileAppender::~RollingFileAppender() {
+        // the writer thread must not call _write() on a partially destroyed object
+        stop_async_writer();
+    }
+
     void RollingFileAppender::set_max_backup_index (unsigned int max_bi) { 
         _max_backup_index = max_bi; 
     }
@@ -92,8 +97,9 @@ namespace log4tango {
         _fd = ::open(_file_name.c_str(), _flags, _mode);
     }
 
-    int RollingFileAppender::_append(const LoggingEvent& event) {
-        FileAppender::_append(event);
+    int RollingFileAppender::_write(const char* data, size_t size) {
+        // in asynchronous mode, this is called (and the file rolled over) by the writer thread
+        FileAppender::_write(data, size);
         off_t offset = ::lseek(_fd, 0, SEEK_END);
         if (offset < 0) {
             return -1;
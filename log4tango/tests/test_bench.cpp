@@ -136,5 +136,46 @@ int main(int argc, char* argv[])
 
     for (int i = 0; i < num_tests; i++) std::cout << tests[i] << results[i] << " us" << std::endl;
 
+    //-- cost of a disabled log statement (what the request path pays when DEBUG is off)
+    const int num_disabled_tests = 3;
+
+    const char* disabled_tests[num_disabled_tests] = {
+	"  disabled::if log.is_debug_enabled() log.debug_stream << std:string : ",
+	"  disabled::log.debug(std:string) : ",
+	"  disabled::log.debug(buffer) : ",
+    };
+
+    float disabled_results[num_disabled_tests];
+    ::memset(disabled_results, 0, num_disabled_tests * sizeof(float));
+
+    log.set_level(log4tango::Level::INFO);
+    const int disabled_count = count * 1000;
+    {
+	std::string str(size, 'X');
+	clock.start();
+	for (int i = 0; i < disabled_count; i++)
+	  if (log.is_debug_enabled())
+	    log.debug_stream() << str;
+	clock.stop();
+	disabled_results[0] = ((float)clock.elapsed()) * 1000 / disabled_count;
+    }
+    {
+	std::string str(size, 'X');
+	clock.start();
+	for (int i = 0; i < disabled_count; i++) log.debug(__FILE__, __LINE__, str);
+	clock.stop();
+	disabled_results[1] = ((float)clock.elapsed()) * 1000 / disabled_count;
+    }
+    {
+	clock.start();
+	for (int i = 0; i < disabled_count; i++) log.debug(__FILE__, __LINE__, "%s", buffer);
+	clock.stop();
+	disabled_results[2] = ((float)clock.elapsed()) * 1000 / disabled_count;
+    }
+
+    for (int i = 0; i < num_disabled_tests; i++) std::cout << disabled_tests[i] << disabled_results[i] << " ns" << std::endl;
+
+    delete [] buffer;
+
     return 0;
 }
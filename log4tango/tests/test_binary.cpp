@@ -0,0 +1,96 @@
+//
+// Copyright (C) :  2004,2005,2006,2007,2008,2009,2010
+//					Synchrotron SOLEIL
+//                	L'Orme des Merisiers
+//                	Saint-Aubin - BP 48 - France
+//
+// This file is part of log4tango.
+//
+// Log4ango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Log4tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Log4Tango.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include <log4tango/Logger.hh>
+#include <log4tango/BinaryFileAppender.hh>
+#include <log4tango/BinaryLogReader.hh>
+#include <log4tango/PatternLayout.hh>
+
+#include "clock.hh"
+
+// -----------------------------------------------------------------------------
+int main(int /*argc*/, char** /*argv*/)
+{
+    const std::string file_name("test_binary.blog");
+    const int count = 1000;
+    std::remove(file_name.c_str());
+    std::remove((file_name + ".1").c_str());
+
+    //-- write: small files to check the roll over (each file must be self-contained)
+    {
+        log4tango::Logger log("cat");
+        log.set_level(log4tango::Level::DEBUG);
+        log.add_appender(new log4tango::BinaryFileAppender("binary", file_name, 16 * 1024, 1));
+
+        Clock clock;
+        clock.start();
+        for (int i = 0; i < count; i++) log.info(__FILE__, __LINE__, "message #%d", i);
+        clock.stop();
+        std::cout << "  binary::log.info(format, ...) : " << ((float)clock.elapsed()) / count << " us" << std::endl;
+    }
+
+    //-- read back
+    log4tango::PatternLayout layout;
+    layout.set_conversion_pattern("%p %c %m");
+
+    int ret = 0;
+    int last = -1;
+    int nb_events = 0;
+    const std::string files[2] = {file_name + ".1", file_name};
+    for (int f = 0; f < 2; f++) {
+        log4tango::BinaryLogReader reader(files[f]);
+        if (!reader.is_valid()) {
+            std::cout << "KO: " << files[f] << " is not a valid binary log file" << std::endl;
+            ret = 1;
+            continue;
+        }
+        for (std::unique_ptr<log4tango::LoggingEvent> event = reader.next(); event; event = reader.next()) {
+            int index = std::stoi(event->message.substr(event->message.find('#') + 1));
+            if (last != -1 && index != last + 1) {
+                std::cout << "KO: unexpected message " << event->message << std::endl;
+                ret = 1;
+            }
+            std::string text = layout.format(*event);
+            if (text != "INFO cat message #" + std::to_string(index)) {
+                std::cout << "KO: unexpected rendering " << text << std::endl;
+                ret = 1;
+            }
+            last = index;
+            nb_events++;
+        }
+    }
+
+    //-- the last record must be the last message
+    if (last != count - 1 || nb_events == 0 || nb_events > count) {
+        std::cout << "KO: last message is #" << last << " (" << nb_events << " records)" << std::endl;
+        ret = 1;
+    } else {
+        std::cout << "OK: " << nb_events << " records read back" << std::endl;
+    }
+
+    std::remove(file_name.c_str());
+    std::remove((file_name + ".1").c_str());
+    return ret;
+}
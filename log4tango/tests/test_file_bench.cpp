@@ -0,0 +1,146 @@
+//
+// Copyright (C) :  2004,2005,2006,2007,2008,2009,2010
+//					Synchrotron SOLEIL
+//                	L'Orme des Merisiers
+//                	Saint-Aubin - BP 48 - France
+//
+// This file is part of log4tango.
+//
+// Log4ango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Log4tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Log4Tango.  If not, see <http://www.gnu.org/licenses/>.
+
+//
+// Throughput of the file appenders in synchronous and asynchronous modes.
+// usage: test_file_bench [count per thread] [nb threads] [message size]
+//
+
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <log4tango/Logger.hh>
+#include <log4tango/FileAppender.hh>
+#include <log4tango/RollingFileAppender.hh>
+#include <log4tango/PatternLayout.hh>
+
+#include "clock.hh"
+
+// -----------------------------------------------------------------------------
+static size_t count_lines (const std::string& file_name)
+{
+    std::ifstream in(file_name.c_str());
+    size_t nb = 0;
+    std::string line;
+    while (std::getline(in, line)) nb++;
+    return nb;
+}
+
+// -----------------------------------------------------------------------------
+static float run (log4tango::FileAppender* appender, int count, int nb_threads, size_t size, usec_t& total)
+{
+    log4tango::Logger log("cat");
+    log.set_level(log4tango::Level::DEBUG);
+
+    log4tango::PatternLayout* layout = new log4tango::PatternLayout();
+    layout->set_conversion_pattern("%R %p %c %m\n");
+    appender->set_layout(layout);
+    log.add_appender(appender);
+
+    std::string str(size, 'X');
+    std::vector<usec_t> elapsed(nb_threads, 0);
+
+    Clock clock;
+    clock.start();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nb_threads; t++) {
+        threads.push_back(std::thread([&, t]() {
+            Clock th_clock;
+            th_clock.start();
+            for (int i = 0; i < count; i++) log.debug(__FILE__, __LINE__, str);
+            th_clock.stop();
+            elapsed[t] = th_clock.elapsed();
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+    //-- flush (asynchronous mode) and close the file
+    log.remove_all_appenders();
+    clock.stop();
+    total = clock.elapsed();
+
+    usec_t producers = 0;
+    for (int t = 0; t < nb_threads; t++) producers += elapsed[t];
+    return ((float)producers) / (count * nb_threads);
+}
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int nb_threads = argc > 2 ? std::atoi(argv[2]) : 4;
+    size_t size = argc > 3 ? std::atoi(argv[3]) : 128;
+
+    std::cout << "  count: " << count << " iterations"
+              << "  threads: " << nb_threads
+              << "  size: " << size << " bytes"
+              << std::endl;
+
+    const std::string sync_file("test_file_bench_sync.log");
+    const std::string async_file("test_file_bench_async.log");
+    const std::string rolling_file("test_file_bench_rolling.log");
+    std::remove(sync_file.c_str());
+    std::remove(async_file.c_str());
+    std::remove(rolling_file.c_str());
+    std::remove((rolling_file + ".1").c_str());
+
+    int ret = 0;
+    const size_t expected = static_cast<size_t>(count) * nb_threads;
+    usec_t total;
+
+    {
+        log4tango::FileAppender* appender = new log4tango::FileAppender("sync", sync_file);
+        float per_call = run(appender, count, nb_threads, size, total);
+        std::cout << "  FileAppender (sync) : " << per_call << " us per call, "
+                  << ((float)expected * 1000000 / total) << " records/s" << std::endl;
+        if (count_lines(sync_file) != expected) ret = 1;
+    }
+    {
+        log4tango::FileAppender* appender = new log4tango::FileAppender("async", async_file);
+        appender->set_async(true);
+        float per_call = run(appender, count, nb_threads, size, total);
+        std::cout << "  FileAppender (async) : " << per_call << " us per call, "
+                  << ((float)expected * 1000000 / total) << " records/s" << std::endl;
+        if (count_lines(async_file) != expected) ret = 1;
+    }
+    {
+        //-- small file size: the writer thread rolls the file over many times
+        log4tango::RollingFileAppender* appender =
+            new log4tango::RollingFileAppender("rolling", rolling_file, 256 * 1024, 1);
+        appender->set_async(true);
+        float per_call = run(appender, count, nb_threads, size, total);
+        std::cout << "  RollingFileAppender (async) : " << per_call << " us per call, "
+                  << ((float)expected * 1000000 / total) << " records/s" << std::endl;
+        if (count_lines(rolling_file) == 0) ret = 1;
+    }
+
+    std::remove(sync_file.c_str());
+    std::remove(async_file.c_str());
+    std::remove(rolling_file.c_str());
+    std::remove((rolling_file + ".1").c_str());
+
+    if (ret != 0) std::cout << "KO: unexpected number of records in log file(s)" << std::endl;
+    return ret;
+}
@@ -0,0 +1,68 @@
+//
+// log4tango_decode.cpp
+//
+// Copyright (C) :  2004,2005,2006,2007,2008,2009,2010,2011,2012
+//					Synchrotron SOLEIL
+//                	L'Orme des Merisiers
+//                	Saint-Aubin - BP 48 - France
+//
+// This file is part of log4tango.
+//
+// Log4ango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Log4tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Log4Tango.  If not, see <http://www.gnu.org/licenses/>.
+
+//
+// Renders the files written by a BinaryFileAppender as text.
+// usage: log4tango_decode [-p conversion_pattern] file [file...]
+//
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <log4tango/BinaryLogReader.hh>
+#include <log4tango/PatternLayout.hh>
+
+int main(int argc, char* argv[])
+{
+    std::string pattern = std::string(log4tango::PatternLayout::BASIC_CONVERSION_PATTERN) + "%n";
+    int first = 1;
+    if (argc > 2 && std::strcmp(argv[1], "-p") == 0) {
+        pattern = argv[2];
+        first = 3;
+    }
+    if (first >= argc) {
+        std::cerr << "usage: " << argv[0] << " [-p conversion_pattern] file [file...]" << std::endl;
+        return 1;
+    }
+
+    log4tango::PatternLayout layout;
+    if (layout.set_conversion_pattern(pattern) != 0) {
+        std::cerr << "invalid conversion pattern: " << pattern << std::endl;
+        return 1;
+    }
+
+    int ret = 0;
+    for (int i = first; i < argc; i++) {
+        log4tango::BinaryLogReader reader(argv[i]);
+        if (!reader.is_valid()) {
+            std::cerr << argv[i] << ": not a log4tango binary log file" << std::endl;
+            ret = 1;
+            continue;
+        }
+        for (std::unique_ptr<log4tango::LoggingEvent> event = reader.next(); event; event = reader.next()) {
+            std::cout << layout.format(*event);
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,180 @@
+#ifndef BatchTestSuite_h
+#define BatchTestSuite_h
+
+#include <chrono>
+#include <vector>
+
+#include "cxx_common.h"
+
+#undef SUITE_NAME
+#define SUITE_NAME BatchTestSuite
+
+// On those tests, commands and attribute writing are queued in the device batch and executed with one
+// execute_batch() call. The replies (and errors) must be returned in the batch order
+class BatchTestSuite: public CxxTest::TestSuite
+{
+protected:
+    DeviceProxy *device1;
+    string device1_name;
+
+public:
+    SUITE_NAME()
+    {
+
+//
+// Arguments check -------------------------------------------------
+//
+
+        device1_name = CxxTest::TangoPrinter::get_param("device1");
+
+        CxxTest::TangoPrinter::validate_args();
+
+//
+// Initialization --------------------------------------------------
+//
+
+        try
+        {
+            device1 = new DeviceProxy(device1_name);
+            device1->ping();
+        }
+        catch (CORBA::Exception &e)
+        {
+            Except::print_exception(e);
+            exit(-1);
+        }
+    }
+
+    virtual ~SUITE_NAME()
+    {
+        delete device1;
+    }
+
+    static SUITE_NAME *createSuite()
+    {
+        return new SUITE_NAME();
+    }
+
+    static void destroySuite(SUITE_NAME *suite)
+    {
+        delete suite;
+    }
+
+//
+// Tests -------------------------------------------------------
+//
+
+//
+// Mix of commands, failing command and attribute writing
+//
+
+    void test_batch_replies_in_order(void)
+    {
+        DeviceData din;
+        DevLong lg = 21;
+        din << lg;
+        device1->batch_command_inout("IOLong", din);
+
+        device1->batch_command_inout("IOExcept");
+
+        DeviceAttribute da("Short_attr_w", DevShort(37));
+        device1->batch_write_attribute(da);
+
+        DeviceData din_db;
+        DevDouble db = 1.5;
+        din_db << db;
+        device1->batch_command_inout("IOTemplDouble", din_db);
+
+        device1->batch_command_inout("UnknownCommand");
+
+        TS_ASSERT_EQUALS(device1->get_batch_size(), 5u);
+
+        std::vector<BatchReply> replies;
+        TS_ASSERT_THROWS_NOTHING(replies = device1->execute_batch());
+        TS_ASSERT_EQUALS(device1->get_batch_size(), 0u);
+        TS_ASSERT_EQUALS(replies.size(), 5u);
+
+        DevLong lg_out = 0;
+        TS_ASSERT_EQUALS(replies[0].get_name(), "IOLong");
+        TS_ASSERT(replies[0].has_failed() == false);
+        replies[0].get_data() >> lg_out;
+        TS_ASSERT_EQUALS(lg_out, 42);
+
+        TS_ASSERT(replies[1].has_failed() == true);
+        TS_ASSERT_EQUALS(string(replies[1].get_err_stack()[0].reason.in()), API_ThrowException);
+
+        TS_ASSERT_EQUALS(replies[2].get_name(), "Short_attr_w");
+        TS_ASSERT(replies[2].has_failed() == false);
+        replies[2].get_data().reset_exceptions(DeviceData::isempty_flag);
+        TS_ASSERT(replies[2].get_data().is_empty() == true);
+
+        DevDouble db_out = 0.0;
+        TS_ASSERT(replies[3].has_failed() == false);
+        replies[3].get_data() >> db_out;
+        TS_ASSERT_EQUALS(db_out, 3.0);
+
+        TS_ASSERT(replies[4].has_failed() == true);
+        TS_ASSERT_EQUALS(string(replies[4].get_err_stack()[0].reason.in()), API_CommandNotFound);
+
+        DeviceAttribute da_read = device1->read_attribute("Short_attr_w");
+        std::vector<DevShort> sh_read;
+        da_read.extract_set(sh_read);
+        TS_ASSERT_EQUALS(sh_read[0], 37);
+
+        TS_ASSERT_EQUALS(device1->pending_asynch_call(POLLING), 0);
+    }
+
+//
+// Cleared batch and empty batch
+//
+
+    void test_clear_batch(void)
+    {
+        device1->batch_command_inout("IOExcept");
+        TS_ASSERT_EQUALS(device1->get_batch_size(), 1u);
+        device1->clear_batch();
+        TS_ASSERT_EQUALS(device1->get_batch_size(), 0u);
+
+        std::vector<BatchReply> replies = device1->execute_batch();
+        TS_ASSERT(replies.empty() == true);
+    }
+
+//
+// Compare a batch with the same number of synchronous calls
+//
+
+    void test_batch_benchmark(void)
+    {
+        const int nb_cmd = 200;
+
+        DeviceData din;
+        DevLong lg = 10;
+        din << lg;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nb_cmd; i++)
+            device1->command_inout("IOLong", din);
+        auto synch_end = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < nb_cmd; i++)
+            device1->batch_command_inout("IOLong", din);
+        std::vector<BatchReply> replies = device1->execute_batch();
+        auto batch_end = std::chrono::steady_clock::now();
+
+        bool all_ok = true;
+        for (auto &rep : replies)
+        {
+            DevLong lg_out = 0;
+            rep.get_data() >> lg_out;
+            all_ok = all_ok && (rep.has_failed() == false) && (lg_out == 20);
+        }
+        TS_ASSERT(all_ok);
+
+        TEST_LOG << nb_cmd << " synchronous commands: "
+                 << std::chrono::duration_cast<std::chrono::microseconds>(synch_end - start).count() << " us" << endl;
+        TEST_LOG << nb_cmd << " batched commands: "
+                 << std::chrono::duration_cast<std::chrono::microseconds>(batch_end - synch_end).count() << " us" << endl;
+    }
+};
+
+#endif // BatchTestSuite_h
@@ -0,0 +1,187 @@
+#ifndef ByteSwapTestSuite_h
+#define ByteSwapTestSuite_h
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "cxx_common.h"
+#include <eventconsumer.h>
+
+#undef SUITE_NAME
+#define SUITE_NAME ByteSwapTestSuite
+
+// On those tests, the bulk byte swapping functions are checked against a byte by byte reference and attribute
+// event data are unmarshalled from CDR buffers coded with and without the host endianness. The decoding times
+// of swapped and native buffers are reported
+class ByteSwapTestSuite: public CxxTest::TestSuite
+{
+protected:
+
+//
+// Build the CDR coded AttrValUnion (discriminator, length and data) as sent in a ZMQ event. When swapped is true,
+// the buffer is coded with the endianness opposite to the host one
+//
+
+    template <typename T>
+    void build_cdr(Tango::AttributeDataType type, const std::vector<T> &val, bool swapped, std::vector<double> &buf)
+    {
+        buf.assign(1 + (val.size() * sizeof(T) + 7) / 8, 0.0);
+        unsigned char *ptr = reinterpret_cast<unsigned char *>(buf.data());
+
+        CORBA::ULong disc = type;
+        CORBA::ULong length = val.size();
+        memcpy(ptr, &disc, 4);
+        memcpy(ptr + 4, &length, 4);
+        memcpy(ptr + 8, val.data(), val.size() * sizeof(T));
+
+        if (swapped == true)
+        {
+            std::reverse(ptr, ptr + 4);
+            std::reverse(ptr + 4, ptr + 8);
+            for (size_t i = 0; i < val.size(); i++)
+                std::reverse(ptr + 8 + i * sizeof(T), ptr + 8 + (i + 1) * sizeof(T));
+        }
+    }
+
+    void decode(std::vector<double> &buf, bool swapped, Tango::ZmqAttrValUnion &un)
+    {
+        Tango::TangoCdrMemoryStream cdr(buf.data(), buf.size() * sizeof(double));
+        cdr.setByteSwapFlag(swapped == true ? !omni::myByteOrder : omni::myByteOrder);
+        cdr.set_un_marshal_type(Tango::TangoCdrMemoryStream::UN_ATT);
+        un <<= cdr;
+    }
+
+    template <typename T>
+    bool check_swap(void (*swap_func)(void *, size_t), size_t nb)
+    {
+        std::vector<T> data(nb);
+        unsigned char *bytes = reinterpret_cast<unsigned char *>(data.data());
+        for (size_t i = 0; i < nb * sizeof(T); i++)
+            bytes[i] = static_cast<unsigned char>(i * 37 + 11);
+
+        std::vector<unsigned char> ref(bytes, bytes + nb * sizeof(T));
+        for (size_t i = 0; i < nb; i++)
+            std::reverse(ref.begin() + i * sizeof(T), ref.begin() + (i + 1) * sizeof(T));
+
+        swap_func(data.data(), nb);
+        return memcmp(data.data(), ref.data(), ref.size()) == 0;
+    }
+
+public:
+    SUITE_NAME()
+    {
+
+//
+// Arguments check -------------------------------------------------
+//
+
+        CxxTest::TangoPrinter::validate_args();
+    }
+
+    virtual ~SUITE_NAME()
+    {
+    }
+
+    static SUITE_NAME *createSuite()
+    {
+        return new SUITE_NAME();
+    }
+
+    static void destroySuite(SUITE_NAME *suite)
+    {
+        delete suite;
+    }
+
+//
+// Tests -------------------------------------------------------
+//
+
+//
+// Bulk swap against the byte by byte reference, for sizes around the vector width
+//
+
+    void test_swap_functions(void)
+    {
+        bool ok = true;
+        for (size_t nb = 0; nb < 70; nb++)
+        {
+            ok = ok && check_swap<DevUShort>(Tango::byte_swap_16, nb);
+            ok = ok && check_swap<DevULong>(Tango::byte_swap_32, nb);
+            ok = ok && check_swap<DevULong64>(Tango::byte_swap_64, nb);
+        }
+        TS_ASSERT(ok);
+    }
+
+//
+// Attribute data sent with the other endianness are correctly decoded
+//
+
+    void test_decode_swapped_event_data(void)
+    {
+        std::vector<double> buf;
+        Tango::ZmqAttrValUnion un;
+
+        std::vector<DevShort> sh = {-3, 1, 2, 32000, -32000, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+        build_cdr(Tango::ATT_SHORT, sh, true, buf);
+        decode(buf, true, un);
+        TS_ASSERT_EQUALS(un.short_att_value().length(), sh.size());
+        TS_ASSERT_SAME_DATA(un.short_att_value().get_buffer(), sh.data(), sh.size() * sizeof(DevShort));
+
+        std::vector<DevLong> lg = {-100000, 1, 2, 3, 4, 5, 6, 7, 8, 9, 123456789};
+        build_cdr(Tango::ATT_LONG, lg, true, buf);
+        decode(buf, true, un);
+        TS_ASSERT_EQUALS(un.long_att_value().length(), lg.size());
+        TS_ASSERT_SAME_DATA(un.long_att_value().get_buffer(), lg.data(), lg.size() * sizeof(DevLong));
+
+        std::vector<DevDouble> db = {1.5, -2.25, 3.0e100, 4.0, 5.0, 6.125, 7.0};
+        build_cdr(Tango::ATT_DOUBLE, db, true, buf);
+        decode(buf, true, un);
+        TS_ASSERT_EQUALS(un.double_att_value().length(), db.size());
+        TS_ASSERT_SAME_DATA(un.double_att_value().get_buffer(), db.data(), db.size() * sizeof(DevDouble));
+    }
+
+//
+// Decoding times of native and swapped spectrum attribute data
+//
+
+    void test_swapped_decode_benchmark(void)
+    {
+        const size_t nb_data = 1000000;
+        const int nb_loop = 50;
+
+        std::vector<DevDouble> db(nb_data);
+        for (size_t i = 0; i < nb_data; i++)
+            db[i] = i * 0.5;
+
+        std::vector<double> native, swapped, buf;
+        build_cdr(Tango::ATT_DOUBLE, db, false, native);
+        build_cdr(Tango::ATT_DOUBLE, db, true, swapped);
+        Tango::ZmqAttrValUnion un;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nb_loop; i++)
+        {
+            buf = native;
+            decode(buf, false, un);
+        }
+        auto native_end = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < nb_loop; i++)
+        {
+            buf = swapped;
+            decode(buf, true, un);
+        }
+        auto swapped_end = std::chrono::steady_clock::now();
+
+        TS_ASSERT_SAME_DATA(un.double_att_value().get_buffer(), db.data(), nb_data * sizeof(DevDouble));
+
+        TEST_LOG << nb_loop << " native decodings of " << nb_data << " doubles: "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(native_end - start).count() << " ms" << endl;
+        TEST_LOG << nb_loop << " swapped decodings of " << nb_data << " doubles: "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(swapped_end - native_end).count() << " ms" << endl;
+    }
+};
+
+#endif // ByteSwapTestSuite_h
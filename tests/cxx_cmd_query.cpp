@@ -79,7 +79,7 @@ public:
 	void test_command_list_query(void)
 	{
 		TS_ASSERT_THROWS_NOTHING(cmd_inf_list = *dserver->command_list_query());
-		TS_ASSERT_EQUALS(cmd_inf_list.size(), 32u);
+		TS_ASSERT_EQUALS(cmd_inf_list.size(), 37u);
 	}
 
 // Test Status command
@@ -195,12 +195,25 @@ public:
 		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"Tango lib release");
 	}
 
+// Test GetLoggingDropped command_list_query
+
+	void test_command_list_query_GetLoggingDropped(void)
+	{
+//		CommandInfo cmd_inf = dserver->command_query("GetLoggingDropped");
+		CommandInfo cmd_inf = cmd_inf_list[7];
+		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"GetLoggingDropped");
+		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
+		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_LONGSTRINGARRAY);
+		TS_ASSERT_EQUALS(cmd_inf.in_type_desc,"Device name");
+		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"Lg[i]=Dropped log records. Str[i]=Device logging target");
+	}
+
 // Test GetLoggingLevel command_list_query
 
 	void test_command_list_query_GetLoggingLevel(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("GetLoggingLevel");
-		CommandInfo cmd_inf = cmd_inf_list[7];
+		CommandInfo cmd_inf = cmd_inf_list[8];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"GetLoggingLevel");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_LONGSTRINGARRAY);
@@ -213,7 +226,7 @@ public:
 	void test_command_list_query_GetLoggingTarget(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("GetLoggingTarget");
-		CommandInfo cmd_inf = cmd_inf_list[8];
+		CommandInfo cmd_inf = cmd_inf_list[9];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"GetLoggingTarget");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -226,7 +239,7 @@ public:
 	void test_command_list_query_Init(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("Init");
-		CommandInfo cmd_inf = cmd_inf_list[9];
+		CommandInfo cmd_inf = cmd_inf_list[10];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"Init");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -239,7 +252,7 @@ public:
 	void test_command_list_query_Kill(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("Kill");
-		CommandInfo cmd_inf = cmd_inf_list[10];
+		CommandInfo cmd_inf = cmd_inf_list[11];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"Kill");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -252,7 +265,7 @@ public:
 	void test_command_list_query_LockDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("LockDevice");
-		CommandInfo cmd_inf = cmd_inf_list[11];
+		CommandInfo cmd_inf = cmd_inf_list[12];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"LockDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_LONGSTRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -265,7 +278,7 @@ public:
 	void test_command_list_query_PolledDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("PolledDevice");
-		CommandInfo cmd_inf = cmd_inf_list[12];
+		CommandInfo cmd_inf = cmd_inf_list[13];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"PolledDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -278,7 +291,7 @@ public:
 	void test_command_list_query_QueryClass(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QueryClass");
-		CommandInfo cmd_inf = cmd_inf_list[13];
+		CommandInfo cmd_inf = cmd_inf_list[14];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryClass");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -291,7 +304,7 @@ public:
 	void test_command_list_query_QueryDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QueryDevice");
-		CommandInfo cmd_inf = cmd_inf_list[14];
+		CommandInfo cmd_inf = cmd_inf_list[15];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -299,12 +312,51 @@ public:
 		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"Device server device(s) list");
 	}
 
+// Test QueryLatency command_list_query
+
+	void test_command_list_query_QueryLatency(void)
+	{
+//		CommandInfo cmd_inf = dserver->command_query("QueryLatency");
+		CommandInfo cmd_inf = cmd_inf_list[16];
+		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryLatency");
+		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
+		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_DOUBLESTRINGARRAY);
+		TS_ASSERT_EQUALS(cmd_inf.in_type_desc,"Uninitialised");
+		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"3 Str and 8 Db per device attribute/command: Str = device, request type, name - Db = count, min, mean, p50, p90, p99, p99.9, max (us)");
+	}
+
+// Test QueryMonitorProfile command_list_query
+
+	void test_command_list_query_QueryMonitorProfile(void)
+	{
+//		CommandInfo cmd_inf = dserver->command_query("QueryMonitorProfile");
+		CommandInfo cmd_inf = cmd_inf_list[17];
+		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryMonitorProfile");
+		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
+		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_DOUBLESTRINGARRAY);
+		TS_ASSERT_EQUALS(cmd_inf.in_type_desc,"Uninitialised");
+		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"4 Str and 10 Db per monitor: Str = monitor type, name, longest hold request type and name - Db = acquires, waits, timeouts, wait mean, p99, max, hold mean, p50, p99, max (us)");
+	}
+
+// Test QueryReplyArena command_list_query
+
+	void test_command_list_query_QueryReplyArena(void)
+	{
+//		CommandInfo cmd_inf = dserver->command_query("QueryReplyArena");
+		CommandInfo cmd_inf = cmd_inf_list[18];
+		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryReplyArena");
+		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
+		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
+		TS_ASSERT_EQUALS(cmd_inf.in_type_desc,"Uninitialised");
+		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"Reply arenas counters");
+	}
+
 // Test QuerySubDevice command_list_query
 
 	void test_command_list_query_QuerySubDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QuerySubDevice");
-		CommandInfo cmd_inf = cmd_inf_list[15];
+		CommandInfo cmd_inf = cmd_inf_list[19];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QuerySubDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -317,7 +369,7 @@ public:
 	void test_command_list_query_QueryWizardClassProperty(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QueryWizardClassProperty");
-		CommandInfo cmd_inf = cmd_inf_list[16];
+		CommandInfo cmd_inf = cmd_inf_list[20];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryWizardClassProperty");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -330,7 +382,7 @@ public:
 	void test_command_list_query_QueryWizardDevProperty(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QueryWizardDevProperty");
-		CommandInfo cmd_inf = cmd_inf_list[17];
+		CommandInfo cmd_inf = cmd_inf_list[21];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryWizardDevProperty");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -343,7 +395,7 @@ public:
 	void test_command_list_query_ReLockDevices(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("ReLockDevices");
-		CommandInfo cmd_inf = cmd_inf_list[18];
+		CommandInfo cmd_inf = cmd_inf_list[22];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"ReLockDevices");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -356,7 +408,7 @@ public:
 	void test_command_list_query_RemObjPolling(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("RemObjPolling");
-		CommandInfo cmd_inf = cmd_inf_list[19];
+		CommandInfo cmd_inf = cmd_inf_list[23];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"RemObjPolling");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -369,7 +421,7 @@ public:
 	void test_command_list_query_RemoveLoggingTarget(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("RemoveLoggingTarget");
-		CommandInfo cmd_inf = cmd_inf_list[20];
+		CommandInfo cmd_inf = cmd_inf_list[24];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"RemoveLoggingTarget");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -382,7 +434,7 @@ public:
 	void test_command_list_query_RestartServer(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("RestartServer");
-		CommandInfo cmd_inf = cmd_inf_list[21];
+		CommandInfo cmd_inf = cmd_inf_list[25];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"RestartServer");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -395,7 +447,7 @@ public:
 	void test_command_list_query_SetLoggingLevel(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("SetLoggingLevel");
-		CommandInfo cmd_inf = cmd_inf_list[22];
+		CommandInfo cmd_inf = cmd_inf_list[26];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"SetLoggingLevel");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_LONGSTRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -408,7 +460,7 @@ public:
 	void test_command_list_query_StartLogging(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("StartLogging");
-		CommandInfo cmd_inf = cmd_inf_list[23];
+		CommandInfo cmd_inf = cmd_inf_list[27];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"StartLogging");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -421,7 +473,7 @@ public:
 	void test_command_list_query_StartPolling(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("StartPolling");
-		CommandInfo cmd_inf = cmd_inf_list[24];
+		CommandInfo cmd_inf = cmd_inf_list[28];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"StartPolling");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -434,7 +486,7 @@ public:
 	void test_command_list_query_State(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("State");
-		CommandInfo cmd_inf = cmd_inf_list[25];
+		CommandInfo cmd_inf = cmd_inf_list[29];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"State");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_STATE);
@@ -447,7 +499,7 @@ public:
 	void test_command_list_query_Status(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("Status");
-		CommandInfo cmd_inf = cmd_inf_list[26];
+		CommandInfo cmd_inf = cmd_inf_list[30];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"Status");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_STRING);
@@ -460,7 +512,7 @@ public:
 	void test_command_list_query_StopLogging(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("StopLogging");
-		CommandInfo cmd_inf = cmd_inf_list[27];
+		CommandInfo cmd_inf = cmd_inf_list[31];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"StopLogging");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -473,7 +525,7 @@ public:
 	void test_command_list_query_StopPolling(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("StopPolling");
-		CommandInfo cmd_inf = cmd_inf_list[28];
+		CommandInfo cmd_inf = cmd_inf_list[32];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"StopPolling");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -486,7 +538,7 @@ public:
 	void test_command_list_query_UnLockDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("UnLockDevice");
-		CommandInfo cmd_inf = cmd_inf_list[29];
+		CommandInfo cmd_inf = cmd_inf_list[33];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"UnLockDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_LONGSTRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_LONG);
@@ -499,7 +551,7 @@ public:
 	void test_command_list_query_list_query_UpdObjPollingPeriod(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("UpdObjPollingPeriod");
-		CommandInfo cmd_inf = cmd_inf_list[30];
+		CommandInfo cmd_inf = cmd_inf_list[34];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"UpdObjPollingPeriod");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_LONGSTRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -512,7 +564,7 @@ public:
 	void test_command_list_query_ZMQEventSubscriptionChange(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("ZmqEventSubscriptionChange");
-        CommandInfo cmd_inf = cmd_inf_list[31];
+        CommandInfo cmd_inf = cmd_inf_list[35];
         TS_ASSERT_EQUALS(cmd_inf.cmd_name, "ZmqEventSubscriptionChange");
         TS_ASSERT_EQUALS(cmd_inf.in_type, Tango::DEVVAR_STRINGARRAY);
         TS_ASSERT_EQUALS(cmd_inf.out_type, Tango::DEVVAR_LONGSTRINGARRAY);
@@ -539,5 +591,21 @@ public:
             "Lg[4] = Multicast IVL - Lg[5] = ZMQ release");
 	}
 
+// Test ZmqEventSubscriptionChanges command_list_query
+
+	void test_command_list_query_ZMQEventSubscriptionChanges(void)
+	{
+//		CommandInfo cmd_inf = dserver->command_query("ZmqEventSubscriptionChanges");
+        CommandInfo cmd_inf = cmd_inf_list[36];
+        TS_ASSERT_EQUALS(cmd_inf.cmd_name, "ZmqEventSubscriptionChanges");
+        TS_ASSERT_EQUALS(cmd_inf.in_type, Tango::DEVVAR_STRINGARRAY);
+        TS_ASSERT_EQUALS(cmd_inf.out_type, Tango::DEVVAR_LONGSTRINGARRAY);
+        TS_ASSERT_EQUALS(cmd_inf.in_type_desc, "Str[0] = dev1 name, Str[1] = att1/pipe1 name, Str[2] = action (\"subscribe\"), "
+            "Str[3] = event name, Str[4] = Tango client lib release, Str[5] = dev2 name,...");
+        TS_ASSERT_EQUALS(cmd_inf.out_type_desc, "8 Lg per subscription: Lg[0] = Error flag - Lg[1] = Str number\n"
+            "Lg[2] to Lg[7] = ZmqEventSubscriptionChange Lg[0] to Lg[5]\n"
+            "Str = ZmqEventSubscriptionChange Str or error(s) reason, desc and origin");
+	}
+
 };
 #endif // CmdQueryTestSuite_h
@@ -1,10 +1,17 @@
 #ifndef DatabaseTestSuite_h
 #define DatabaseTestSuite_h
 
+#include <chrono>
+#include <cstdio>
 #include <ctime>
 
 #include "cxx_common.h"
 
+#ifndef _TG_WINDOWS_
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #undef SUITE_NAME
 #define SUITE_NAME DatabaseTestSuite
 
@@ -15,6 +22,10 @@ protected:
 	string device1_name;
 	string dev_alias;
 	string att_alias;
+	string full_ds_name;
+	string server_host;
+	string outpath;
+	string snap_dir;
 	Database *db;
 
 public:
@@ -28,9 +39,14 @@ public:
 		device1_name = CxxTest::TangoPrinter::get_param("device1");
 		dev_alias = CxxTest::TangoPrinter::get_param("devicealias");
 		att_alias = CxxTest::TangoPrinter::get_param("attributealias");
+		full_ds_name = CxxTest::TangoPrinter::get_param("fulldsname");
+		server_host = CxxTest::TangoPrinter::get_param("serverhost");
+		outpath = CxxTest::TangoPrinter::get_param("outpath");
 
 		CxxTest::TangoPrinter::validate_args();
 
+		snap_dir = outpath + "cxx_database_snapshot";
+
 
 // Initialization --------------------------------------------------
 
@@ -55,6 +71,17 @@ public:
 // Clean up --------------------------------------------------------
 //
 
+#ifndef _TG_WINDOWS_
+		if (CxxTest::TangoPrinter::is_restore_set("Server_Snapshot"))
+		{
+			unsetenv("TANGO_DS_CACHE_SNAPSHOT_DIR");
+			CxxTest::TangoPrinter::kill_server();
+			CxxTest::TangoPrinter::start_server("test");
+		}
+		std::remove(snapshot_file().c_str());
+		rmdir(snap_dir.c_str());
+#endif
+
 		delete device1;
 		delete db;
 	}
@@ -69,6 +96,12 @@ public:
 		delete suite;
 	}
 
+	string snapshot_file()
+	{
+		string::size_type pos = full_ds_name.find('/');
+		return snap_dir + "/" + full_ds_name.substr(0,pos) + "_" + full_ds_name.substr(pos + 1) + ".dscache";
+	}
+
 //
 // Tests -------------------------------------------------------
 //
@@ -95,6 +128,95 @@ public:
 		TS_ASSERT_EQUALS(dbfi.pid, dvlsa->lvalue[1]);
 	}
 
+// The device list import call
+
+	void test_import_device_list()
+	{
+		DbDevImportInfo single = db->import_device(device1_name);
+
+		vector<string> names;
+		names.push_back(device1_name);
+		names.push_back("this/device/doesnotexist");
+		names.push_back(device1_name);
+
+		DbDevImportInfos imports;
+		TS_ASSERT_THROWS_NOTHING(imports = db->import_device(names));
+		TS_ASSERT_EQUALS(imports.size(), 3u);
+
+		TS_ASSERT_EQUALS(imports[0].name, device1_name);
+		TS_ASSERT_EQUALS(imports[0].exported, 1);
+		TS_ASSERT_EQUALS(imports[0].ior, single.ior);
+		TS_ASSERT_EQUALS(imports[0].version, single.version);
+
+		TS_ASSERT_EQUALS(imports[1].name, "this/device/doesnotexist");
+		TS_ASSERT_EQUALS(imports[1].exported, 0);
+		TS_ASSERT(imports[1].ior.empty() == true);
+
+		TS_ASSERT_EQUALS(imports[2].ior, single.ior);
+
+		TS_ASSERT(db->import_device(vector<string>()).empty() == true);
+	}
+
+// The client property cache
+
+	void test_property_cache()
+	{
+		DbData put_data;
+		DbDatum prop("CacheTestProp");
+		prop << DevLong(10);
+		put_data.push_back(prop);
+		db->put_device_property(device1_name, put_data);
+
+		db->set_property_cache(60000, 100);
+		unsigned long long hits = db->get_property_cache_hits();
+		unsigned long long misses = db->get_property_cache_misses();
+
+		DevLong val = 0;
+		DbData get_data;
+		get_data.push_back(DbDatum("CacheTestProp"));
+		db->get_device_property(device1_name, get_data);
+		get_data[0] >> val;
+		TS_ASSERT_EQUALS(val, 10);
+
+		get_data.clear();
+		get_data.push_back(DbDatum("CacheTestProp"));
+		db->get_device_property(device1_name, get_data);
+		get_data[0] >> val;
+		TS_ASSERT_EQUALS(val, 10);
+		TS_ASSERT_EQUALS(db->get_property_cache_hits(), hits + 1);
+		TS_ASSERT_EQUALS(db->get_property_cache_misses(), misses + 1);
+
+// A put invalidates the cached replies for the device
+
+		put_data[0] << DevLong(20);
+		db->put_device_property(device1_name, put_data);
+		get_data.clear();
+		get_data.push_back(DbDatum("CacheTestProp"));
+		db->get_device_property(device1_name, get_data);
+		get_data[0] >> val;
+		TS_ASSERT_EQUALS(val, 20);
+		TS_ASSERT_EQUALS(db->get_property_cache_misses(), misses + 2);
+
+// And so does a delete
+
+		db->delete_device_property(device1_name, put_data);
+		get_data.clear();
+		get_data.push_back(DbDatum("CacheTestProp"));
+		db->get_device_property(device1_name, get_data);
+		TS_ASSERT(get_data[0].value_string.empty() == true);
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0;i < 1000;i++)
+			db->get_device_property(device1_name, get_data);
+		auto end = std::chrono::steady_clock::now();
+		TEST_LOG << "1000 cached get_device_property: "
+				 << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us" << endl;
+
+		db->set_property_cache(0, 0);
+		db->get_device_property(device1_name, get_data);
+		TS_ASSERT_EQUALS(db->get_property_cache_hits(), hits + 1001);
+	}
+
 // The device alias
 
 	void test_device_alias_calls()
@@ -236,5 +358,102 @@ public:
 		TS_ASSERT_THROWS_NOTHING(db->delete_all_device_pipe_property("a/b/c",del_all));
 	}
 
+// DS cache filled from the database and from a local snapshot (startup benchmark)
+
+	void test_ds_cache_snapshot()
+	{
+		string snap_file = outpath + "cxx_database.dscache";
+
+		auto start = std::chrono::steady_clock::now();
+		DbServerCache *from_db = new DbServerCache(db,full_ds_name,server_host);
+		auto db_done = std::chrono::steady_clock::now();
+
+		TS_ASSERT_THROWS_NOTHING(DbCacheSnapshot::write(snap_file,full_ds_name,server_host,*(from_db->get_data())));
+		string stamp = DbCacheSnapshot::compute_stamp(*(from_db->get_data()));
+
+		auto snap_start = std::chrono::steady_clock::now();
+		DbCacheSnapshot *snap = new DbCacheSnapshot(snap_file);
+		TS_ASSERT_EQUALS(snap->is_valid(), true);
+		DbServerCache *from_snap = new DbServerCache(snap);
+		auto snap_done = std::chrono::steady_clock::now();
+
+		TS_ASSERT_EQUALS(from_snap->get_data_nb(), from_db->get_data_nb());
+		TS_ASSERT_EQUALS(from_snap->get_class_nb(), from_db->get_class_nb());
+		TS_ASSERT_EQUALS(snap->get_stamp(), stamp);
+		TS_ASSERT_EQUALS(DbCacheSnapshot::compute_stamp(*(from_snap->get_data())), stamp);
+
+		DevVarStringArray *names = new DevVarStringArray();
+		names->length(2);
+		(*names)[0] = Tango::string_dup(device1_name.c_str());
+		(*names)[1] = Tango::string_dup("__SubDevices");
+		const DevVarStringArray *db_res = from_db->get_dev_property(names);
+		vector<string> db_values;
+		for (unsigned int i = 0;i < db_res->length();i++)
+			db_values.push_back((*db_res)[i].in());
+		const DevVarStringArray *snap_res = from_snap->get_dev_property(names);
+		delete names;
+
+		TS_ASSERT_EQUALS(snap_res->length(), db_values.size());
+		for (unsigned int i = 0;i < snap_res->length() && i < db_values.size();i++)
+			TS_ASSERT_EQUALS(string((*snap_res)[i].in()), db_values[i]);
+
+		auto db_us = std::chrono::duration_cast<std::chrono::microseconds>(db_done - start).count();
+		auto snap_us = std::chrono::duration_cast<std::chrono::microseconds>(snap_done - snap_start).count();
+		TEST_LOG << "DS cache for " << full_ds_name << " (" << from_db->get_data_nb() << " strings): " << db_us
+				 << " us from database, " << snap_us << " us from snapshot" << endl;
+
+		delete from_snap;
+		delete from_db;
+		std::remove(snap_file.c_str());
+	}
+
+// A server restarted from its snapshot against an unchanged database does not report a stale snapshot (the import
+// data, which change at each startup, are not part of the snapshot stamp) and the snapshot is not rewritten
+
+	void test_ds_cache_snapshot_restart()
+	{
+		string dserver_name = "dserver/" + full_ds_name;
+
+//
+// First startup: the cache is filled from the database and the snapshot is written
+//
+
+		TS_ASSERT_EQUALS(mkdir(snap_dir.c_str(),0755), 0);
+		setenv("TANGO_DS_CACHE_SNAPSHOT_DIR",snap_dir.c_str(),1);
+		CxxTest::TangoPrinter::kill_server();
+		CxxTest::TangoPrinter::restore_set("Server_Snapshot");
+		CxxTest::TangoPrinter::start_server("test");
+
+		struct stat before;
+		TS_ASSERT_EQUALS(stat(snapshot_file().c_str(),&before), 0);
+
+//
+// Second startup from the snapshot. Leave time to the reconcile thread to check it
+//
+
+		sleep(1);
+		CxxTest::TangoPrinter::kill_server();
+		CxxTest::TangoPrinter::start_server("test");
+		sleep(2);
+
+		DeviceProxy dserver(dserver_name);
+		string status;
+		TS_ASSERT_THROWS_NOTHING(status = dserver.status());
+		TS_ASSERT_EQUALS(status.find("configuration has changed"), string::npos);
+
+		struct stat after;
+		TS_ASSERT_EQUALS(stat(snapshot_file().c_str(),&after), 0);
+		TS_ASSERT_EQUALS(after.st_mtime, before.st_mtime);
+
+//
+// Restart the server without snapshot
+//
+
+		unsetenv("TANGO_DS_CACHE_SNAPSHOT_DIR");
+		CxxTest::TangoPrinter::kill_server();
+		CxxTest::TangoPrinter::start_server("test");
+		CxxTest::TangoPrinter::restore_unset("Server_Snapshot");
+	}
+
 };
 #endif // DatabaseTestSuite_h
@@ -0,0 +1,360 @@
+#ifndef DbCacheTestSuite_h
+#define DbCacheTestSuite_h
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cxx_common.h"
+
+#undef SUITE_NAME
+#define SUITE_NAME DbCacheTestSuite
+
+// On those tests we build the DS cache from data looking like the ones returned by the
+// DbGetDataForServerCache command (one class with a configurable number of devices).
+// The cache content is checked and the cache construction and lookup times are reported.
+class DbCacheTestSuite: public CxxTest::TestSuite
+{
+    protected:
+
+        std::vector<std::string> data;
+        std::string snap_file;
+
+        void add(const std::string &str)
+        {
+            data.push_back(str);
+        }
+
+        void add_props(const std::string &obj_name, const std::string &prefix, int nb_prop)
+        {
+            add(obj_name);
+            add(std::to_string(nb_prop));
+            for (int i = 0; i < nb_prop; i++)
+            {
+                add(prefix + "_prop_" + std::to_string(i));
+                add("2");
+                add(obj_name + "_value_" + std::to_string(i) + "_0");
+                add(obj_name + "_value_" + std::to_string(i) + "_1");
+            }
+        }
+
+        void add_atts(const std::string &obj_name, const std::string &prefix, int nb_att)
+        {
+            add(obj_name);
+            add(std::to_string(nb_att));
+            for (int i = 0; i < nb_att; i++)
+            {
+                add(prefix + "_" + std::to_string(i));
+                add("2");
+                add("label");
+                add("1");
+                add(obj_name + "_label_" + std::to_string(i));
+                add("unit");
+                add("1");
+                add("mm");
+            }
+        }
+
+        std::string dev_name(int idx)
+        {
+            return "test/dbcache/" + std::to_string(idx);
+        }
+
+        std::unique_ptr<Tango::DevVarStringArray> build_cache_data(int nb_dev)
+        {
+            data.clear();
+
+            add("release 1.9");
+
+            // Admin device import data, notifd and DS events
+            add("dserver/dbcache/test");
+            add("IOR:000");
+            add("5");
+            add("dbcache/test");
+            add("localhost");
+            add("1");
+            add("DbCache");
+            add("1234");
+            add("notifd/localhost");
+            add("Not Found");
+            add("dserver/dbcache/test");
+            add("Not Found");
+
+            // DServer class, Default and admin device properties
+            add_props("DServer", "dserver", 2);
+            add_props("Default", "default", 0);
+            add_props("dserver/dbcache/test", "adm", 0);
+
+            // One class
+            add("dbcache/test");
+            add("1");
+            add_props("DbCache", "class", 4);
+            add_atts("DbCache", "class_att", 2);
+            add_atts("DbCache", "class_pipe", 1);
+
+            add("DbCache");
+            add(std::to_string(nb_dev));
+            for (int i = 0; i < nb_dev; i++)
+                add(dev_name(i));
+
+            for (int i = 0; i < nb_dev; i++)
+            {
+                add_props(dev_name(i), "dev", 10);
+                add_atts(dev_name(i), "att", 5);
+                add_atts(dev_name(i), "pipe", 1);
+            }
+
+            // Control system properties
+            add_props("CtrlSystem", "ctrl", 1);
+
+            std::unique_ptr<Tango::DevVarStringArray> ret(new Tango::DevVarStringArray());
+            ret->length(data.size());
+            for (size_t i = 0; i < data.size(); i++)
+                (*ret)[i] = Tango::string_dup(data[i].c_str());
+            return ret;
+        }
+
+        Tango::DevVarStringArray *request(const std::string &obj_name, const std::vector<std::string> &names)
+        {
+            Tango::DevVarStringArray *ret = new Tango::DevVarStringArray();
+            ret->length(names.size() + 1);
+            (*ret)[0] = Tango::string_dup(obj_name.c_str());
+            for (size_t i = 0; i < names.size(); i++)
+                (*ret)[i + 1] = Tango::string_dup(names[i].c_str());
+            return ret;
+        }
+
+    public:
+        SUITE_NAME()
+        {
+            //
+            // Arguments check -------------------------------------------------
+            //
+
+            snap_file = CxxTest::TangoPrinter::get_param("outpath") + "cxx_db_cache.dscache";
+
+            CxxTest::TangoPrinter::validate_args();
+
+
+            // Initialization --------------------------------------------------
+
+        }
+
+        virtual ~SUITE_NAME()
+        {
+
+            //
+            // Clean up --------------------------------------------------------
+            //
+
+            std::remove(snap_file.c_str());
+        }
+
+        static SUITE_NAME *createSuite()
+        {
+            return new SUITE_NAME();
+        }
+
+        static void destroySuite(SUITE_NAME *suite)
+        {
+            delete suite;
+        }
+
+        //
+        // Tests -------------------------------------------------------
+        //
+        // Check data returned by the cache
+        void test_cache_content()
+        {
+            std::unique_ptr<Tango::DevVarStringArray> cache_data = build_cache_data(10);
+            DbServerCache dsc(*cache_data);
+
+            TS_ASSERT_EQUALS(dsc.get_data_nb(), (int)data.size());
+            TS_ASSERT_EQUALS(dsc.get_class_nb(), 1);
+
+            // Device properties (name case is not significant, requested names are returned)
+            DevVarStringArray *names = request("TEST/DbCache/3", {"DEV_PROP_2", "unknown"});
+            const DevVarStringArray *res = dsc.get_dev_property(names);
+            delete names;
+
+            TS_ASSERT_EQUALS(res->length(), 9u);
+            TS_ASSERT_EQUALS(std::string((*res)[0].in()), "TEST/DbCache/3");
+            TS_ASSERT_EQUALS(std::string((*res)[1].in()), "2");
+            TS_ASSERT_EQUALS(std::string((*res)[2].in()), "DEV_PROP_2");
+            TS_ASSERT_EQUALS(std::string((*res)[3].in()), "2");
+            TS_ASSERT_EQUALS(std::string((*res)[4].in()), "test/dbcache/3_value_2_0");
+            TS_ASSERT_EQUALS(std::string((*res)[5].in()), "test/dbcache/3_value_2_1");
+            TS_ASSERT_EQUALS(std::string((*res)[6].in()), "unknown");
+            TS_ASSERT_EQUALS(std::string((*res)[7].in()), "0");
+            TS_ASSERT_EQUALS(std::string((*res)[8].in()), " ");
+
+            // Class properties
+            names = request("dbcache", {"class_prop_3"});
+            res = dsc.get_class_property(names);
+            delete names;
+
+            TS_ASSERT_EQUALS(res->length(), 6u);
+            TS_ASSERT_EQUALS(std::string((*res)[4].in()), "DbCache_value_3_0");
+
+            // Device attribute properties
+            names = request("test/dbcache/9", {"att_4", "unknown"});
+            res = dsc.get_dev_att_property(names);
+            delete names;
+
+            TS_ASSERT_EQUALS(res->length(), 12u);
+            TS_ASSERT_EQUALS(std::string((*res)[1].in()), "2");
+            TS_ASSERT_EQUALS(std::string((*res)[2].in()), "att_4");
+            TS_ASSERT_EQUALS(std::string((*res)[6].in()), "test/dbcache/9_label_4");
+            TS_ASSERT_EQUALS(std::string((*res)[10].in()), "unknown");
+            TS_ASSERT_EQUALS(std::string((*res)[11].in()), "0");
+
+            // Class pipe properties
+            names = request("DbCache", {"class_pipe_0"});
+            res = dsc.get_class_pipe_property(names);
+            delete names;
+
+            TS_ASSERT_EQUALS(res->length(), 10u);
+            TS_ASSERT_EQUALS(std::string((*res)[6].in()), "DbCache_label_0");
+
+            // Device list
+            names = request("dbcache/test", {"DBCACHE"});
+            res = dsc.get_dev_list(names);
+            delete names;
+
+            TS_ASSERT_EQUALS(res->length(), 10u);
+            TS_ASSERT_EQUALS(std::string((*res)[7].in()), "test/dbcache/7");
+
+            // Device property list
+            names = request("test/dbcache/1", {"dev_prop_*"});
+            res = dsc.get_device_property_list(names);
+            delete names;
+
+            TS_ASSERT_EQUALS(res->length(), 10u);
+
+            // Unknown device and class
+            names = request("test/dbcache/10", {"dev_prop_0"});
+            TS_ASSERT_THROWS_ASSERT(dsc.get_dev_property(names), Tango::DevFailed &e,
+                    TS_ASSERT_EQUALS(std::string(e.errors[0].reason.in()), Tango::DB_DeviceNotFoundInCache));
+            delete names;
+
+            names = request("UnknownClass", {"class_prop_0"});
+            TS_ASSERT_THROWS_ASSERT(dsc.get_class_property(names), Tango::DevFailed &e,
+                    TS_ASSERT_EQUALS(std::string(e.errors[0].reason.in()), Tango::DB_ClassNotFoundInCache));
+            delete names;
+        }
+
+        // Report cache construction and lookup times against the device number
+        void test_cache_benchmark()
+        {
+            const int dev_nbs[] = {100, 1000, 10000};
+
+            for (int nb_dev : dev_nbs)
+            {
+                std::unique_ptr<Tango::DevVarStringArray> cache_data = build_cache_data(nb_dev);
+
+                auto start = std::chrono::steady_clock::now();
+                DbServerCache dsc(*cache_data);
+                auto built = std::chrono::steady_clock::now();
+
+                for (int i = 0; i < nb_dev; i++)
+                {
+                    DevVarStringArray *names = request(dev_name(i), {"dev_prop_0", "dev_prop_9", "unknown"});
+                    const DevVarStringArray *res = dsc.get_dev_property(names);
+                    delete names;
+                    TS_ASSERT_EQUALS(res->length(), 13u);
+
+                    names = request(dev_name(i), {"att_0", "att_4"});
+                    res = dsc.get_dev_att_property(names);
+                    delete names;
+                    TS_ASSERT_EQUALS(res->length(), 18u);
+                }
+                auto done = std::chrono::steady_clock::now();
+
+                auto build_us = std::chrono::duration_cast<std::chrono::microseconds>(built - start).count();
+                auto lookup_us = std::chrono::duration_cast<std::chrono::microseconds>(done - built).count();
+                TEST_LOG << "   " << nb_dev << " devices (" << cache_data->length() << " strings): cache built in "
+                         << build_us << " us, " << ((double)lookup_us) / nb_dev << " us per device lookup" << endl;
+            }
+        }
+
+        // Check the local snapshot of the cache data
+        void test_cache_snapshot()
+        {
+            std::unique_ptr<Tango::DevVarStringArray> cache_data = build_cache_data(10);
+            std::string stamp = DbCacheSnapshot::compute_stamp(*cache_data);
+
+            TS_ASSERT_THROWS_NOTHING(DbCacheSnapshot::write(snap_file, "DbCache/test", "localhost", *cache_data));
+
+            DbCacheSnapshot *snap = new DbCacheSnapshot(snap_file);
+            TS_ASSERT_EQUALS(snap->is_valid(), true);
+            TS_ASSERT_EQUALS(snap->get_stamp(), stamp);
+            TS_ASSERT_EQUALS(snap->get_ds_name(), "DbCache/test");
+            TS_ASSERT_EQUALS(snap->get_host(), "localhost");
+
+            // The cache built from the snapshot returns the same data
+            DbServerCache dsc(snap);
+            TS_ASSERT_EQUALS(dsc.from_snapshot(), true);
+            TS_ASSERT_EQUALS(dsc.get_data_nb(), (int)cache_data->length());
+            TS_ASSERT_EQUALS(DbCacheSnapshot::compute_stamp(*dsc.get_data()), stamp);
+
+            DevVarStringArray *names = request("test/dbcache/3", {"dev_prop_2"});
+            const DevVarStringArray *res = dsc.get_dev_property(names);
+            delete names;
+
+            TS_ASSERT_EQUALS(res->length(), 6u);
+            TS_ASSERT_EQUALS(std::string((*res)[4].in()), "test/dbcache/3_value_2_0");
+
+            // The import data (changed at each server startup) are not part of the stamp
+            (*cache_data)[2] = Tango::string_dup("IOR:111");
+            (*cache_data)[8] = Tango::string_dup("4321");
+            TS_ASSERT_EQUALS(DbCacheSnapshot::compute_stamp(*cache_data), stamp);
+
+            // Any change in the configuration data changes the stamp
+            (*cache_data)[cache_data->length() - 1] = Tango::string_dup("changed");
+            TS_ASSERT_DIFFERS(DbCacheSnapshot::compute_stamp(*cache_data), stamp);
+
+            // Truncated or missing files are rejected
+            std::string truncated = snap_file + ".truncated";
+            {
+                std::ifstream in(snap_file.c_str(), std::ios::binary);
+                std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+                std::ofstream out(truncated.c_str(), std::ios::binary);
+                out.write(content.data(), content.size() / 2);
+            }
+            DbCacheSnapshot bad(truncated);
+            TS_ASSERT_EQUALS(bad.is_valid(), false);
+            std::remove(truncated.c_str());
+
+            DbCacheSnapshot missing(snap_file + ".missing");
+            TS_ASSERT_EQUALS(missing.is_valid(), false);
+        }
+
+        // Report the cache construction time from a snapshot and from data received from the database
+        void test_cache_snapshot_benchmark()
+        {
+            const int dev_nbs[] = {100, 1000, 10000};
+
+            for (int nb_dev : dev_nbs)
+            {
+                std::unique_ptr<Tango::DevVarStringArray> cache_data = build_cache_data(nb_dev);
+                DbCacheSnapshot::write(snap_file, "DbCache/test", "localhost", *cache_data);
+
+                auto start = std::chrono::steady_clock::now();
+                DbServerCache from_data(*cache_data);
+                auto data_done = std::chrono::steady_clock::now();
+                DbServerCache from_snap(new DbCacheSnapshot(snap_file));
+                auto snap_done = std::chrono::steady_clock::now();
+
+                TS_ASSERT_EQUALS(from_snap.get_data_nb(), from_data.get_data_nb());
+
+                auto data_us = std::chrono::duration_cast<std::chrono::microseconds>(data_done - start).count();
+                auto snap_us = std::chrono::duration_cast<std::chrono::microseconds>(snap_done - data_done).count();
+                TEST_LOG << "   " << nb_dev << " devices: cache built from received data in " << data_us
+                         << " us, from snapshot in " << snap_us << " us" << endl;
+            }
+        }
+};
+#endif // DbCacheTestSuite_h
@@ -0,0 +1,301 @@
+#ifndef DeviceLoggingTestSuite_h
+#define DeviceLoggingTestSuite_h
+
+#include <chrono>
+#include <thread>
+
+#include "cxx_common.h"
+#include <tangoappender.h>
+
+#undef SUITE_NAME
+#define SUITE_NAME DeviceLoggingTestSuite
+
+// On those tests, device2 is the log consumer of the device logging targets (see the DevTest Log command). The
+// records are buffered by the target and sent in batches (6 strings per record in each "Log" call)
+class DeviceLoggingTestSuite: public CxxTest::TestSuite
+{
+protected:
+    DeviceProxy *device2, *dserver;
+    string device1_name, device2_name, dserver_name;
+    int loglevel;
+
+//
+// Wait until the log consumer has received the given number of records (5 s max) and return what it received
+//
+
+    void wait_records(size_t nb, vector<DevLong> &calls, vector<string> &messages)
+    {
+        DeviceData dout;
+        for (int loop = 0; loop < 50; loop++)
+        {
+            dout = device2->command_inout("GetReceivedLogs");
+            dout.extract(calls, messages);
+            if (messages.size() >= nb)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+
+    void add_records(Tango::TangoAppender &appender, int nb)
+    {
+        for (int loop = 0; loop < nb; loop++)
+        {
+            log4tango::LoggingEvent event("test/log/src", "message " + to_string(loop), log4tango::Level::INFO, __FILE__, __LINE__);
+            appender.append(event);
+        }
+    }
+
+public:
+    SUITE_NAME()
+    {
+
+//
+// Arguments check -------------------------------------------------
+//
+
+        device1_name = CxxTest::TangoPrinter::get_param("device1");
+        device2_name = CxxTest::TangoPrinter::get_param("device2");
+        dserver_name = "dserver/" + CxxTest::TangoPrinter::get_param("fulldsname");
+        loglevel = atoi(CxxTest::TangoPrinter::get_param("loglevel").c_str());
+
+        CxxTest::TangoPrinter::validate_args();
+
+//
+// Initialization --------------------------------------------------
+//
+
+        try
+        {
+            device2 = new DeviceProxy(device2_name);
+            dserver = new DeviceProxy(dserver_name);
+            device2->ping();
+            dserver->ping();
+        }
+        catch (CORBA::Exception &e)
+        {
+            Except::print_exception(e);
+            exit(-1);
+        }
+    }
+
+    virtual ~SUITE_NAME()
+    {
+
+//
+// Clean up --------------------------------------------------------
+//
+
+        if (CxxTest::TangoPrinter::is_restore_set("device_logging"))
+        {
+            try
+            {
+                DeviceData din;
+                DevVarStringArray target;
+                target.length(2);
+                target[0] = device1_name.c_str();
+                target[1] = string("device::" + device2_name).c_str();
+                din << target;
+                dserver->command_inout("RemoveLoggingTarget", din);
+
+                DevVarLongStringArray level;
+                level.lvalue.length(1);
+                level.lvalue[0] = loglevel;
+                level.svalue.length(1);
+                level.svalue[0] = device1_name.c_str();
+                din << level;
+                dserver->command_inout("SetLoggingLevel", din);
+            }
+            catch (DevFailed &e)
+            {
+                TEST_LOG << endl << "Exception in suite tearDown():" << endl;
+                Except::print_exception(e);
+            }
+        }
+
+        delete device2;
+        delete dserver;
+    }
+
+    static SUITE_NAME *createSuite()
+    {
+        return new SUITE_NAME();
+    }
+
+    static void destroySuite(SUITE_NAME *suite)
+    {
+        delete suite;
+    }
+
+//
+// Tests -------------------------------------------------------
+//
+
+    void setUp()
+    {
+        device2->command_inout("ResetReceivedLogs");
+    }
+
+//
+// A full batch is sent at once in one "Log" call, without waiting for the flush period
+//
+
+    void test_full_batch(void)
+    {
+        Tango::TangoAppender appender("test/log/src", "device::" + device2_name, device2_name, true,
+                                      kLogDeviceQueueSize, kLogDeviceBatchSize, 60000);
+        add_records(appender, kLogDeviceBatchSize);
+
+        vector<DevLong> calls;
+        vector<string> messages;
+        wait_records(kLogDeviceBatchSize, calls, messages);
+
+        TS_ASSERT_EQUALS(calls.size(), 1u);
+        if (calls.size() == 1)
+            TS_ASSERT_EQUALS(calls[0], static_cast<DevLong>(kLogDeviceBatchSize));
+        TS_ASSERT_EQUALS(messages.size(), kLogDeviceBatchSize);
+        if (messages.size() == kLogDeviceBatchSize)
+        {
+            TS_ASSERT_EQUALS(messages[0], "message 0");
+            TS_ASSERT_EQUALS(messages[kLogDeviceBatchSize - 1], "message " + to_string(kLogDeviceBatchSize - 1));
+        }
+        TS_ASSERT_EQUALS(appender.get_dropped_count(), 0u);
+    }
+
+//
+// A partial batch is sent when the flush period expires
+//
+
+    void test_flush_period(void)
+    {
+        Tango::TangoAppender appender("test/log/src", "device::" + device2_name, device2_name, true,
+                                      kLogDeviceQueueSize, kLogDeviceBatchSize, 200);
+        add_records(appender, 3);
+
+        vector<DevLong> calls;
+        vector<string> messages;
+        wait_records(3, calls, messages);
+
+        TS_ASSERT_EQUALS(calls.size(), 1u);
+        if (calls.size() == 1)
+            TS_ASSERT_EQUALS(calls[0], 3);
+        TS_ASSERT_EQUALS(messages.size(), 3u);
+    }
+
+//
+// When the buffer is full, the oldest records are dropped and counted. The number of dropped records is sent
+// first with the next batch
+//
+
+    void test_queue_overflow(void)
+    {
+        {
+            Tango::TangoAppender appender("test/log/src", "device::" + device2_name, device2_name, true,
+                                          10, 1000, 60000);
+            add_records(appender, 15);
+            TS_ASSERT_EQUALS(appender.get_dropped_count(), 5u);
+
+            // the pending records are sent when the target is closed
+            appender.close();
+        }
+
+        vector<DevLong> calls;
+        vector<string> messages;
+        wait_records(11, calls, messages);
+
+        TS_ASSERT_EQUALS(messages.size(), 11u);
+        if (messages.size() == 11)
+        {
+            TS_ASSERT_EQUALS(messages[0], "5 log record(s) dropped (logging target buffer full)");
+            TS_ASSERT_EQUALS(messages[1], "message 5");
+            TS_ASSERT_EQUALS(messages[10], "message 14");
+        }
+    }
+
+//
+// The records of a device are sent to its device logging target with several records per "Log" call. The
+// number of dropped records of the target is returned by the GetLoggingDropped admin command
+//
+
+    void test_device_target(void)
+    {
+        DeviceData din, dout;
+
+        DevVarLongStringArray level;
+        level.lvalue.length(1);
+        level.lvalue[0] = 5;
+        level.svalue.length(1);
+        level.svalue[0] = device1_name.c_str();
+        din << level;
+        TS_ASSERT_THROWS_NOTHING(dserver->command_inout("SetLoggingLevel", din));
+        CxxTest::TangoPrinter::restore_set("device_logging");
+
+        DevVarStringArray target;
+        target.length(2);
+        target[0] = device1_name.c_str();
+        target[1] = string("device::" + device2_name).c_str();
+        din << target;
+        TS_ASSERT_THROWS_NOTHING(dserver->command_inout("AddLoggingTarget", din));
+
+        // each IOLong call logs 2 debug records
+        DeviceProxy device1(device1_name);
+        DeviceData cmd_in;
+        for (DevLong loop = 0; loop < 20; loop++)
+        {
+            cmd_in << loop;
+            TS_ASSERT_THROWS_NOTHING(device1.command_inout("IOLong", cmd_in));
+        }
+
+        vector<DevLong> calls;
+        vector<string> messages;
+        wait_records(40, calls, messages);
+
+        size_t nb_received = 0;
+        for (auto &mess : messages)
+        {
+            if (mess.find("[IOLong::execute] received number") == 0)
+                nb_received++;
+        }
+        TS_ASSERT_EQUALS(nb_received, 20u);
+        bool several = false;
+        for (auto nb : calls)
+        {
+            if (nb > 1)
+                several = true;
+        }
+        TS_ASSERT(several);
+
+        din << device1_name;
+        TS_ASSERT_THROWS_NOTHING(dout = dserver->command_inout("GetLoggingDropped", din));
+        const DevVarLongStringArray *dropped;
+        dout >> dropped;
+        TS_ASSERT_EQUALS(dropped->svalue.length(), 1u);
+        TS_ASSERT_EQUALS(dropped->lvalue.length(), 1u);
+        if (dropped->lvalue.length() == 1)
+        {
+            TS_ASSERT_EQUALS(dropped->lvalue[0], 0);
+            TS_ASSERT(string(dropped->svalue[0].in()).find("device::") == 0);
+        }
+
+        din << target;
+        TS_ASSERT_THROWS_NOTHING(dserver->command_inout("RemoveLoggingTarget", din));
+        level.lvalue[0] = loglevel;
+        din << level;
+        TS_ASSERT_THROWS_NOTHING(dserver->command_inout("SetLoggingLevel", din));
+        CxxTest::TangoPrinter::restore_unset("device_logging");
+    }
+
+//
+// The log consumer refuses a "Log" call which is not made of full records
+//
+
+    void test_log_command_argument(void)
+    {
+        DeviceData din;
+        vector<string> wrong(5, "a");
+        din << wrong;
+        TS_ASSERT_THROWS_ASSERT(device2->command_inout("Log", din), Tango::DevFailed & e,
+                                TS_ASSERT_EQUALS(string(e.errors[0].reason.in()), API_IncompatibleCmdArgumentType));
+    }
+};
+
+#endif // DeviceLoggingTestSuite_h
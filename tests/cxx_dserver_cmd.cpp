@@ -316,6 +316,139 @@ public:
             TS_FAIL(e.what());
         }
     }
+
+// Test that reading a writable spectrum attribute again and again does not allocate memory in the reply arena
+
+    DevULong64 reply_arena_counter(const string &name) {
+        DeviceData dout = dserver->command_inout("QueryReplyArena");
+        vector <string> counters;
+        dout >> counters;
+        for (size_t i = 0; i < counters.size(); i++) {
+            if (counters[i].find(name + " = ") == 0)
+                return stoull(counters[i].substr(name.size() + 3));
+        }
+        return 0;
+    }
+
+    void test_reply_arena_counters(void) {
+        DeviceProxy device1(device1_name);
+        DeviceAttribute da;
+        vector <DevLong> lg;
+
+        for (int i = 0; i < 5; i++)
+            da = device1.read_attribute("Long_spec_attr_rw");
+
+        DevULong64 heap_before = reply_arena_counter("Heap allocations");
+        DevULong64 alloc_before = reply_arena_counter("Arena allocations");
+
+        for (int i = 0; i < 20; i++) {
+            TS_ASSERT_THROWS_NOTHING(da = device1.read_attribute("Long_spec_attr_rw"));
+            da >> lg;
+            TS_ASSERT_EQUALS(lg[0], 88);
+            TS_ASSERT_EQUALS(lg[2], 111);
+        }
+
+        TS_ASSERT_LESS_THAN_EQUALS(1u, reply_arena_counter("Arenas"));
+        TS_ASSERT_LESS_THAN_EQUALS(alloc_before + 20, reply_arena_counter("Arena allocations"));
+        TS_ASSERT_EQUALS(heap_before, reply_arena_counter("Heap allocations"));
+    }
+
+// Latency histograms of the read and command requests done by the client. A command which does not exist is not
+// recorded
+
+    void test_latency_histograms(void) {
+        DeviceProxy device1(device1_name);
+        DeviceAttribute da;
+        DeviceData din;
+        din << DevLong(2);
+
+        for (int i = 0; i < 20; i++) {
+            TS_ASSERT_THROWS_NOTHING(da = device1.read_attribute("Long_spec_attr_rw"));
+            TS_ASSERT_THROWS_NOTHING(device1.command_inout("IOLong", din));
+            TS_ASSERT_THROWS(device1.command_inout("No_such_command_" + to_string(i)), DevFailed &);
+        }
+
+        string dev_name(device1_name);
+        transform(dev_name.begin(), dev_name.end(), dev_name.begin(), ::tolower);
+
+        DeviceData dout;
+        TS_ASSERT_THROWS_NOTHING(dout = dserver->command_inout("QueryLatency"));
+        const DevVarDoubleStringArray *lat;
+        dout >> lat;
+        TS_ASSERT_EQUALS(lat->svalue.length() * 8, lat->dvalue.length() * 3);
+
+        bool found = false;
+        for (size_t i = 0; i < lat->svalue.length() / 3; i++) {
+            if (dev_name == lat->svalue[i * 3].in() && string("read") == lat->svalue[(i * 3) + 1].in() &&
+                string("long_spec_attr_rw") == lat->svalue[(i * 3) + 2].in()) {
+                found = true;
+                TS_ASSERT_LESS_THAN_EQUALS(20.0, lat->dvalue[i * 8]);
+                TS_ASSERT_LESS_THAN_EQUALS(lat->dvalue[(i * 8) + 1], lat->dvalue[(i * 8) + 3]);
+                for (size_t j = 4; j < 8; j++)
+                    TS_ASSERT_LESS_THAN_EQUALS(lat->dvalue[(i * 8) + j - 1], lat->dvalue[(i * 8) + j]);
+            }
+        }
+        TS_ASSERT(found);
+
+        bool found_cmd = false;
+        for (size_t i = 0; i < lat->svalue.length() / 3; i++) {
+            if (dev_name == lat->svalue[i * 3].in() && string("command") == lat->svalue[(i * 3) + 1].in()) {
+                string cmd_name(lat->svalue[(i * 3) + 2].in());
+                TS_ASSERT(cmd_name.find("no_such_command") == string::npos);
+                if (cmd_name == "iolong")
+                    found_cmd = true;
+            }
+        }
+        TS_ASSERT(found_cmd);
+
+        vector <string> lat_str;
+        TS_ASSERT_THROWS_NOTHING(da = dserver->read_attribute("Latency"));
+        da >> lat_str;
+        bool found_str = false;
+        for (size_t i = 0; i < lat_str.size(); i++) {
+            if (lat_str[i].find("device=" + dev_name + " type=read name=long_spec_attr_rw ") == 0)
+                found_str = true;
+        }
+        TS_ASSERT(found_str);
+    }
+
+// Contention profile of the serialization monitors
+
+    void test_monitor_profile(void) {
+        DeviceProxy device1(device1_name);
+        DeviceAttribute da;
+
+        for (int i = 0; i < 20; i++)
+            TS_ASSERT_THROWS_NOTHING(da = device1.read_attribute("Long_spec_attr_rw"));
+
+        DeviceData dout;
+        TS_ASSERT_THROWS_NOTHING(dout = dserver->command_inout("QueryMonitorProfile"));
+        const DevVarDoubleStringArray *prof;
+        dout >> prof;
+        TS_ASSERT_EQUALS(prof->svalue.length() * 10, prof->dvalue.length() * 4);
+
+        bool found_process = false;
+        bool found_dev = false;
+        for (size_t i = 0; i < prof->svalue.length() / 4; i++) {
+            string type(prof->svalue[i * 4].in());
+            string name(prof->svalue[(i * 4) + 1].in());
+            const CORBA::Double *val = &(prof->dvalue[i * 10]);
+
+            if (type == "process")
+                found_process = true;
+            else if (type == "device" && TG_strcasecmp(name.c_str(), device1_name.c_str()) == 0) {
+                found_dev = true;
+                TS_ASSERT_LESS_THAN_EQUALS(20.0, val[0]);
+                TS_ASSERT_LESS_THAN_EQUALS(val[1], val[0]);
+                TS_ASSERT_LESS_THAN_EQUALS(val[4], val[5]);
+                TS_ASSERT_LESS_THAN_EQUALS(val[7], val[8]);
+                TS_ASSERT_LESS_THAN_EQUALS(val[8], val[9]);
+                TS_ASSERT(string(prof->svalue[(i * 4) + 2].in()).empty() == false);
+            }
+        }
+        TS_ASSERT(found_process);
+        TS_ASSERT(found_dev);
+    }
 };
 
 #endif // DServerCmdTestSuite_h
@@ -0,0 +1,259 @@
+#ifndef EncodedCodecTestSuite_h
+#define EncodedCodecTestSuite_h
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "cxx_common.h"
+
+#undef SUITE_NAME
+#define SUITE_NAME EncodedCodecTestSuite
+
+// A codec which only copies the data, to check the codec registration
+class CopyCodec: public Tango::EncodedCodec
+{
+    public:
+        std::string get_name() override {return "COPY";}
+
+        void compress(const unsigned char *data, std::size_t nb_elt, int elt_size,
+                std::vector<unsigned char> &out) override
+        {
+            out.insert(out.end(), data, data + nb_elt * elt_size);
+        }
+
+        void decompress(const unsigned char *data, std::size_t size, std::size_t nb_elt, int elt_size,
+                unsigned char *out) override
+        {
+            TS_ASSERT_EQUALS(size, nb_elt * elt_size);
+            memcpy(out, data, size);
+        }
+};
+
+// On those tests we encode and decode synthetic detector images with the lossless codecs.
+// The decoded images must be identical to the source ones. The compression ratio and the
+// encoding/decoding throughput are reported.
+class EncodedCodecTestSuite: public CxxTest::TestSuite
+{
+    protected:
+
+        const int width = 2048;
+        const int height = 2048;
+
+        std::vector<unsigned short> frame16;
+        std::vector<unsigned char> frame8;
+        std::vector<unsigned char> frame24;
+
+        void to_attribute(Tango::EncodedAttribute &enc, DeviceAttribute &da)
+        {
+            Tango::DevEncoded att_de;
+            att_de.encoded_format = Tango::string_dup(*enc.get_format());
+            Tango::DevVarCharArray data(enc.get_size(), enc.get_size(), enc.get_data(), false);
+            att_de.encoded_data = data;
+            da << att_de;
+        }
+
+        void report(const std::string &name, std::size_t raw_size, std::size_t enc_size, double enc_sec, double dec_sec)
+        {
+            TEST_LOG << name << ": ratio " << double(raw_size) / enc_size
+                     << ", encoding " << raw_size / enc_sec / 1.0e9 << " GB/s"
+                     << ", decoding " << raw_size / dec_sec / 1.0e9 << " GB/s" << endl;
+        }
+
+    public:
+        SUITE_NAME()
+        {
+            //
+            // Arguments check -------------------------------------------------
+            //
+
+            CxxTest::TangoPrinter::validate_args();
+
+            // Initialization --------------------------------------------------
+
+            // Smooth background with Poisson like noise and some bright spots, as on a detector
+            std::mt19937 gen(1234);
+            std::normal_distribution<double> noise(0.0, 1.0);
+            frame16.resize(width * height);
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    double val = 1000.0 + 800.0 * std::sin(x / 200.0) * std::cos(y / 150.0);
+                    if ((x % 256) < 4 && (y % 256) < 4)
+                        val = 60000.0;
+                    val = val + noise(gen) * std::sqrt(val) * 0.3;
+                    frame16[y * width + x] = static_cast<unsigned short>(std::min(std::max(val, 0.0), 65535.0));
+                }
+            }
+
+            frame8.resize(width * height);
+            frame24.resize(width * height * 3);
+            for (int i = 0; i < width * height; ++i)
+            {
+                frame8[i] = static_cast<unsigned char>(frame16[i] >> 4);
+                frame24[i * 3] = frame8[i];
+                frame24[i * 3 + 1] = static_cast<unsigned char>(frame16[i] >> 6);
+                frame24[i * 3 + 2] = static_cast<unsigned char>(255 - frame8[i]);
+            }
+        }
+
+        virtual ~SUITE_NAME()
+        {
+        }
+
+        static SUITE_NAME *createSuite()
+        {
+            return new SUITE_NAME();
+        }
+
+        static void destroySuite(SUITE_NAME *suite)
+        {
+            delete suite;
+        }
+
+        //
+        // Tests -------------------------------------------------------
+        //
+
+        // The built-in codec is registered
+        void test_codec_list()
+        {
+            std::vector<std::string> codecs = Tango::EncodedAttribute::get_codec_list();
+            TS_ASSERT(std::find(codecs.begin(), codecs.end(), DELTA_SHUFFLE_LZ) != codecs.end());
+        }
+
+        // 16 bits images
+        void test_gray16_codec()
+        {
+            Tango::EncodedAttribute enc;
+            auto start = std::chrono::steady_clock::now();
+            enc.encode_gray16(frame16.data(), width, height, DELTA_SHUFFLE_LZ);
+            auto end = std::chrono::steady_clock::now();
+            double enc_sec = std::chrono::duration<double>(end - start).count();
+
+            TS_ASSERT_EQUALS(std::string(*enc.get_format()), std::string(GRAY_16) + CODEC_SEP + DELTA_SHUFFLE_LZ);
+
+            DeviceAttribute da;
+            to_attribute(enc, da);
+
+            int w = 0, h = 0;
+            unsigned short *decoded = nullptr;
+            start = std::chrono::steady_clock::now();
+            enc.decode_gray16(&da, &w, &h, &decoded);
+            end = std::chrono::steady_clock::now();
+            double dec_sec = std::chrono::duration<double>(end - start).count();
+
+            TS_ASSERT_EQUALS(w, width);
+            TS_ASSERT_EQUALS(h, height);
+            TS_ASSERT_SAME_DATA(decoded, frame16.data(), width * height * 2);
+            TS_ASSERT_LESS_THAN(std::size_t(enc.get_size()), frame16.size() * 2);
+
+            report("GRAY16:" DELTA_SHUFFLE_LZ, frame16.size() * 2, enc.get_size(), enc_sec, dec_sec);
+            delete [] decoded;
+        }
+
+        // 8 bits and RGB images
+        void test_gray8_rgb24_codec()
+        {
+            Tango::EncodedAttribute enc;
+            enc.encode_gray8(frame8.data(), width, height, DELTA_SHUFFLE_LZ);
+
+            DeviceAttribute da_gray;
+            to_attribute(enc, da_gray);
+
+            int w = 0, h = 0;
+            unsigned char *gray8 = nullptr;
+            enc.decode_gray8(&da_gray, &w, &h, &gray8);
+            TS_ASSERT_EQUALS(w, width);
+            TS_ASSERT_EQUALS(h, height);
+            TS_ASSERT_SAME_DATA(gray8, frame8.data(), width * height);
+            delete [] gray8;
+
+            enc.encode_rgb24(frame24.data(), width, height, DELTA_SHUFFLE_LZ);
+
+            DeviceAttribute da_rgb;
+            to_attribute(enc, da_rgb);
+
+            unsigned char *rgb32 = nullptr;
+            enc.decode_rgb32(&da_rgb, &w, &h, &rgb32);
+            TS_ASSERT_EQUALS(w, width);
+            TS_ASSERT_EQUALS(h, height);
+            bool same = true;
+            for (int i = 0; i < width * height && same; ++i)
+                same = (memcmp(&rgb32[i * 4], &frame24[i * 3], 3) == 0);
+            TS_ASSERT(same);
+            delete [] rgb32;
+        }
+
+        // User defined codec and errors
+        void test_registered_codec()
+        {
+            std::vector<std::string> codecs = Tango::EncodedAttribute::get_codec_list();
+            if (std::find(codecs.begin(), codecs.end(), "COPY") == codecs.end())
+                Tango::EncodedAttribute::register_codec(new CopyCodec());
+
+            TS_ASSERT_THROWS_ASSERT(Tango::EncodedAttribute::register_codec(new CopyCodec()), Tango::DevFailed &e,
+                    TS_ASSERT_EQUALS(std::string(e.errors[0].reason.in()), Tango::API_WrongFormat));
+
+            Tango::EncodedAttribute enc;
+            enc.encode_gray16(frame16.data(), width, height, "COPY");
+            TS_ASSERT_EQUALS(std::string(*enc.get_format()), "GRAY16:COPY");
+            TS_ASSERT_EQUALS(std::size_t(enc.get_size()), frame16.size() * 2 + 4);
+
+            DeviceAttribute da;
+            to_attribute(enc, da);
+
+            int w = 0, h = 0;
+            unsigned short *decoded = nullptr;
+            enc.decode_gray16(&da, &w, &h, &decoded);
+            TS_ASSERT_SAME_DATA(decoded, frame16.data(), width * height * 2);
+            delete [] decoded;
+
+            TS_ASSERT_THROWS_ASSERT(enc.encode_gray16(frame16.data(), width, height, "UNKNOWN"), Tango::DevFailed &e,
+                    TS_ASSERT_EQUALS(std::string(e.errors[0].reason.in()), Tango::API_WrongFormat));
+
+            DeviceAttribute da_unknown;
+            Tango::DevEncoded att_de;
+            att_de.encoded_format = Tango::string_dup("GRAY16:UNKNOWN");
+            att_de.encoded_data.length(8);
+            da_unknown << att_de;
+            TS_ASSERT_THROWS_ASSERT(enc.decode_gray16(&da_unknown, &w, &h, &decoded), Tango::DevFailed &e,
+                    TS_ASSERT_EQUALS(std::string(e.errors[0].reason.in()), Tango::API_WrongFormat));
+        }
+
+        // Buffers still used by a reply are skipped and smaller images re-use the allocated buffers
+        void test_buffer_pool()
+        {
+            Tango::EncodedAttribute enc(2, true);
+            TS_ASSERT_EQUALS(enc.get_buffers_in_use(), 0);
+
+            enc.encode_gray16(frame16.data(), width, height);
+            Tango::DevUChar *first = enc.get_data();
+            omni_mutex *first_mutex = enc.get_mutex();
+
+            enc.encode_gray16(frame16.data(), width, height);
+            Tango::DevUChar *second = enc.get_data();
+            TS_ASSERT_DIFFERS(first, second);
+            TS_ASSERT_EQUALS(enc.get_buffers_in_use(), 2);
+
+            // The second buffer is released (reply sent) while the first one is still used
+            enc.get_mutex()->unlock();
+            TS_ASSERT_EQUALS(enc.get_buffers_in_use(), 1);
+
+            enc.encode_gray8(frame8.data(), width / 2, height / 2);
+            TS_ASSERT_EQUALS(enc.get_data(), second);
+            TS_ASSERT_EQUALS(enc.get_size(), long(width / 2 * height / 2 + 4));
+            TS_ASSERT_EQUALS(std::string(*enc.get_format()), GRAY_8);
+            TS_ASSERT_EQUALS(enc.get_buffers_in_use(), 2);
+
+            enc.get_mutex()->unlock();
+            first_mutex->unlock();
+            TS_ASSERT_EQUALS(enc.get_buffers_in_use(), 0);
+            TS_ASSERT_EQUALS(enc.get_set_value_count(), 0ULL);
+        }
+};
+#endif // EncodedCodecTestSuite_h
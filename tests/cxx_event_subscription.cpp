@@ -0,0 +1,199 @@
+#ifndef EventSubscriptionTestSuite_h
+#define EventSubscriptionTestSuite_h
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "cxx_common.h"
+#include <eventconsumer.h>
+
+#undef SUITE_NAME
+#define SUITE_NAME EventSubscriptionTestSuite
+
+class SubCallback : public Tango::CallBack
+{
+public:
+    SubCallback(): cb_executed(0), cb_err(0) {}
+
+    void push_event(Tango::EventData *ed)
+    {
+        if (ed->err)
+            cb_err++;
+        else
+            cb_executed++;
+    }
+
+    std::atomic<int> cb_executed;
+    std::atomic<int> cb_err;
+};
+
+// On those tests, a large number of subscriptions are done (and then removed) while periodic events are
+// received by another callback. The subscribe/unsubscribe times are reported and the event flow is checked
+class EventSubscriptionTestSuite: public CxxTest::TestSuite
+{
+protected:
+    DeviceProxy *device1;
+    string device1_name;
+    SubCallback flow_cb;
+    SubCallback storm_cb;
+    int flow_id;
+
+public:
+    SUITE_NAME(): flow_id(0)
+    {
+
+//
+// Arguments check -------------------------------------------------
+//
+
+        device1_name = CxxTest::TangoPrinter::get_param("device1");
+
+        CxxTest::TangoPrinter::validate_args();
+
+//
+// Initialization --------------------------------------------------
+//
+
+        try
+        {
+            device1 = new DeviceProxy(device1_name);
+            device1->poll_attribute("Short_attr", 100);
+            device1->poll_attribute("Long_attr", 100);
+        }
+        catch (CORBA::Exception &e)
+        {
+            Except::print_exception(e);
+            exit(-1);
+        }
+    }
+
+    virtual ~SUITE_NAME()
+    {
+        try
+        {
+            device1->stop_poll_attribute("Short_attr");
+            device1->stop_poll_attribute("Long_attr");
+        }
+        catch (CORBA::Exception &e)
+        {
+            Except::print_exception(e);
+        }
+
+        delete device1;
+    }
+
+    static SUITE_NAME *createSuite()
+    {
+        return new SUITE_NAME();
+    }
+
+    static void destroySuite(SUITE_NAME *suite)
+    {
+        delete suite;
+    }
+
+//
+// Tests -------------------------------------------------------
+//
+
+//
+// Subscribe and unsubscribe many times while events are flowing on another attribute
+//
+
+    void test_subscription_storm_while_events_flow(void)
+    {
+        const int nb_sub = 10000;
+
+        TS_ASSERT_THROWS_NOTHING(flow_id = device1->subscribe_event("Short_attr", Tango::PERIODIC_EVENT, &flow_cb));
+
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        int before = flow_cb.cb_executed;
+
+        std::vector<int> ids;
+        ids.reserve(nb_sub);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nb_sub; i++)
+            ids.push_back(device1->subscribe_event("Long_attr", Tango::PERIODIC_EVENT, &storm_cb));
+        auto sub_end = std::chrono::steady_clock::now();
+
+        for (auto id : ids)
+            device1->unsubscribe_event(id);
+        auto unsub_end = std::chrono::steady_clock::now();
+
+        TEST_LOG << nb_sub << " subscriptions: "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(sub_end - start).count() << " ms" << endl;
+        TEST_LOG << nb_sub << " unsubscriptions: "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(unsub_end - sub_end).count() << " ms" << endl;
+        TEST_LOG << "flow events received during the storm = " << flow_cb.cb_executed - before << endl;
+
+        TS_ASSERT_EQUALS(storm_cb.cb_err.load(), 0);
+        TS_ASSERT_LESS_THAN_EQUALS(nb_sub, storm_cb.cb_executed.load());
+
+//
+// Events are still received and all the storm ids are unknown now
+//
+
+        before = flow_cb.cb_executed;
+        std::this_thread::sleep_for(std::chrono::seconds(3));
+        TS_ASSERT_LESS_THAN_EQUALS(before + 2, flow_cb.cb_executed.load());
+        TS_ASSERT_EQUALS(flow_cb.cb_err.load(), 0);
+
+        TS_ASSERT_THROWS_ASSERT(device1->unsubscribe_event(ids[nb_sub / 2]), Tango::DevFailed &e,
+                                TS_ASSERT_EQUALS(string(e.errors[0].reason.in()), API_EventNotFound));
+
+        TS_ASSERT_THROWS_NOTHING(device1->unsubscribe_event(flow_id));
+    }
+
+//
+// Bulk subscription: one error does not stop the other subscriptions
+//
+
+    void test_bulk_subscription(void)
+    {
+        SubCallback bulk_cb;
+        std::vector<std::string> att_names = {"Short_attr", "Long_attr", "Attr_does_not_exist"};
+        std::vector<DevErrorList> errors;
+        std::vector<int> ids;
+
+        TS_ASSERT_THROWS_NOTHING(ids = device1->subscribe_events(att_names, Tango::PERIODIC_EVENT, &bulk_cb, errors));
+        TS_ASSERT_EQUALS(ids.size(), 3u);
+        TS_ASSERT_EQUALS(errors.size(), 3u);
+        TS_ASSERT_LESS_THAN(0, ids[0]);
+        TS_ASSERT_LESS_THAN(0, ids[1]);
+        TS_ASSERT_EQUALS(errors[0].length(), 0u);
+        TS_ASSERT_EQUALS(errors[1].length(), 0u);
+        TS_ASSERT_EQUALS(ids[2], 0);
+        TS_ASSERT_LESS_THAN(0u, errors[2].length());
+
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        TS_ASSERT_LESS_THAN_EQUALS(4, bulk_cb.cb_executed.load());
+        TS_ASSERT_EQUALS(bulk_cb.cb_err.load(), 0);
+
+        TS_ASSERT_THROWS_NOTHING(device1->unsubscribe_event(ids[0]));
+        TS_ASSERT_THROWS_NOTHING(device1->unsubscribe_event(ids[1]));
+
+//
+// With the event consumer API and an event queue
+//
+
+        std::vector<Tango::EventSubscriptionRequest> requests(1);
+        requests[0].device = device1;
+        requests[0].obj_name = "Long_attr";
+        requests[0].event = Tango::PERIODIC_EVENT;
+        requests[0].callback = NULL;
+        requests[0].event_queue_size = 10;
+
+        ApiUtil::instance()->get_zmq_event_consumer()->subscribe_events(requests);
+        TS_ASSERT_LESS_THAN(0, requests[0].event_id);
+        TS_ASSERT_EQUALS(requests[0].errors.length(), 0u);
+
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        TS_ASSERT_LESS_THAN(0, device1->event_queue_size(requests[0].event_id));
+        TS_ASSERT_THROWS_NOTHING(device1->unsubscribe_event(requests[0].event_id));
+    }
+};
+
+#endif // EventSubscriptionTestSuite_h
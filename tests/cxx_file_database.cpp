@@ -0,0 +1,195 @@
+#ifndef FileDatabaseTestSuite_h
+#define FileDatabaseTestSuite_h
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "cxx_common.h"
+
+#undef SUITE_NAME
+#define SUITE_NAME FileDatabaseTestSuite
+
+// On those tests, a copy of the file_database.res resource file (comments, continuation lines and arrays) is used
+// as a file database. It is parsed, modified, written and parsed again
+class FileDatabaseTestSuite: public CxxTest::TestSuite
+{
+protected:
+    string ref_file;
+    string db_file;
+
+    string load_file(const string &file_name)
+    {
+        ifstream in(file_name.c_str(), ios::binary);
+        return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    }
+
+    vector<string> dev_prop(Database &db, const string &dev_name, const string &prop_name)
+    {
+        DbData data;
+        data.push_back(DbDatum(prop_name));
+        db.get_device_property(dev_name, data);
+        vector<string> values;
+        data[0] >> values;
+        return values;
+    }
+
+    void put_dev_prop(Database &db, const string &dev_name, const string &prop_name, const string &value)
+    {
+        DbData data;
+        DbDatum datum(prop_name);
+        datum << value;
+        data.push_back(datum);
+        db.put_device_property(dev_name, data);
+    }
+
+//
+// Check the data of the resource file. test/filedb/1->simple is given as it may have been modified
+//
+
+    void check_content(Database &db, const string &simple)
+    {
+        vector<string> values = dev_prop(db, "test/filedb/1", "simple");
+        TS_ASSERT_EQUALS(values.size(), 1u);
+        if (values.size() == 1)
+            TS_ASSERT_EQUALS(values[0], simple);
+
+        values = dev_prop(db, "test/filedb/1", "array");
+        TS_ASSERT_EQUALS(values.size(), 3u);
+        if (values.size() == 3)
+        {
+            TS_ASSERT_EQUALS(values[0], "a");
+            TS_ASSERT_EQUALS(values[1], "b c");
+            TS_ASSERT_EQUALS(values[2], "d");
+        }
+
+        values = dev_prop(db, "test/filedb/2", "simple");
+        TS_ASSERT_EQUALS(values.size(), 1u);
+        if (values.size() == 1)
+            TS_ASSERT_EQUALS(values[0], "24");
+
+        DbData cl_data;
+        cl_data.push_back(DbDatum("cl_prop"));
+        db.get_class_property("FileDbTest", cl_data);
+        cl_data[0] >> values;
+        TS_ASSERT_EQUALS(values.size(), 3u);
+        if (values.size() == 3)
+        {
+            TS_ASSERT_EQUALS(values[0], "1");
+            TS_ASSERT_EQUALS(values[2], "3");
+        }
+
+        DbData att_data;
+        att_data.push_back(DbDatum("Double_att"));
+        db.get_device_attribute_property("test/filedb/1", att_data);
+        DevLong nb_prop = 0;
+        att_data[0] >> nb_prop;
+        TS_ASSERT_EQUALS(nb_prop, 1);
+        if (nb_prop == 1)
+        {
+            TS_ASSERT_EQUALS(att_data[1].name, "unit");
+            att_data[1] >> values;
+            TS_ASSERT_EQUALS(values.size(), 2u);
+            if (values.size() == 2)
+            {
+                TS_ASSERT_EQUALS(values[0], "mm");
+                TS_ASSERT_EQUALS(values[1], "per second");
+            }
+        }
+
+        DbData cl_att_data;
+        cl_att_data.push_back(DbDatum("Double_att"));
+        db.get_class_attribute_property("FileDbTest", cl_att_data);
+        nb_prop = 0;
+        cl_att_data[0] >> nb_prop;
+        TS_ASSERT_EQUALS(nb_prop, 1);
+        if (nb_prop == 1)
+        {
+            string label;
+            cl_att_data[1] >> label;
+            TS_ASSERT_EQUALS(label, "Double attribute");
+        }
+    }
+
+public:
+    SUITE_NAME()
+    {
+
+//
+// Arguments check -------------------------------------------------
+//
+
+        ref_file = CxxTest::TangoPrinter::get_param("refpath") + "/file_database.res";
+        db_file = CxxTest::TangoPrinter::get_param("outpath") + "cxx_file_database.res";
+
+        CxxTest::TangoPrinter::validate_args();
+    }
+
+    virtual ~SUITE_NAME()
+    {
+
+//
+// Clean up --------------------------------------------------------
+//
+
+        std::remove(db_file.c_str());
+    }
+
+    static SUITE_NAME *createSuite()
+    {
+        return new SUITE_NAME();
+    }
+
+    static void destroySuite(SUITE_NAME *suite)
+    {
+        delete suite;
+    }
+
+//
+// Tests -------------------------------------------------------
+//
+
+//
+// Parse the file, modify one property (the file is written) and parse the written file. Then, write the same
+// content again from a re-parsed file: the file must be identical
+//
+
+    void test_round_trip(void)
+    {
+        string ref_content = load_file(ref_file);
+        TS_ASSERT(ref_content.empty() == false);
+        {
+            ofstream out(db_file.c_str(), ios::binary | ios::trunc);
+            out << ref_content;
+        }
+
+        {
+            Database db(db_file);
+            check_content(db, "12");
+            put_dev_prop(db, "test/filedb/1", "simple", "13");
+        }
+        string written = load_file(db_file);
+        TS_ASSERT_DIFFERS(written, ref_content);
+
+        {
+            Database db(db_file);
+            check_content(db, "13");
+
+            // Storing the same value does not write the file
+            std::remove(db_file.c_str());
+            put_dev_prop(db, "test/filedb/1", "simple", "13");
+            TS_ASSERT(load_file(db_file).empty());
+
+            put_dev_prop(db, "test/filedb/1", "simple", "12");
+        }
+
+        {
+            Database db(db_file);
+            check_content(db, "12");
+            put_dev_prop(db, "test/filedb/1", "simple", "13");
+        }
+        TS_ASSERT_EQUALS(load_file(db_file), written);
+    }
+};
+
+#endif // FileDatabaseTestSuite_h
@@ -0,0 +1,185 @@
+#ifndef ImportCacheTestSuite_h
+#define ImportCacheTestSuite_h
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "cxx_common.h"
+
+#undef SUITE_NAME
+#define SUITE_NAME ImportCacheTestSuite
+
+// On those tests, many DeviceProxy instances to the same device are created with and without the device
+// import cache. The creation times are reported
+class ImportCacheTestSuite: public CxxTest::TestSuite
+{
+protected:
+    string device1_name;
+    string device1_alias;
+
+public:
+    SUITE_NAME()
+    {
+
+//
+// Arguments check -------------------------------------------------
+//
+
+        device1_name = CxxTest::TangoPrinter::get_param("device1");
+        device1_alias = CxxTest::TangoPrinter::get_param("devicealias");
+
+        CxxTest::TangoPrinter::validate_args();
+    }
+
+    virtual ~SUITE_NAME()
+    {
+        ApiUtil::instance()->set_import_cache_ttl(0);
+    }
+
+    static SUITE_NAME *createSuite()
+    {
+        return new SUITE_NAME();
+    }
+
+    static void destroySuite(SUITE_NAME *suite)
+    {
+        delete suite;
+    }
+
+//
+// Tests -------------------------------------------------------
+//
+
+//
+// Proxies created from the cache are usable
+//
+
+    void test_proxies_from_cache(void)
+    {
+        ApiUtil *au = ApiUtil::instance();
+        au->set_import_cache_ttl(60000);
+        au->clear_import_cache();
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 0u);
+
+        DeviceProxy first(device1_name);
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 1u);
+
+        DeviceProxy second(device1_name);
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 1u);
+        TS_ASSERT_EQUALS(second.get_idl_version(), first.get_idl_version());
+        TS_ASSERT_EQUALS(second.get_access_control(), first.get_access_control());
+
+        DeviceData din, dout;
+        DevLong lg = 5;
+        din << lg;
+        TS_ASSERT_THROWS_NOTHING(dout = second.command_inout("IOLong", din));
+        DevLong lg_out = 0;
+        dout >> lg_out;
+        TS_ASSERT_EQUALS(lg_out, 10);
+
+//
+// The call timeout is not shared between proxies
+//
+
+        second.set_timeout_millis(5000);
+        TS_ASSERT_EQUALS(first.get_timeout_millis(), 3000);
+        TS_ASSERT_EQUALS(second.get_timeout_millis(), 5000);
+
+//
+// Alias are not cached
+//
+
+        DeviceProxy from_alias(device1_alias);
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 1u);
+        TS_ASSERT_THROWS_NOTHING(from_alias.ping());
+    }
+
+//
+// Entries are removed when too old or when the cache is disabled
+//
+
+    void test_cache_ttl(void)
+    {
+        ApiUtil *au = ApiUtil::instance();
+        au->set_import_cache_ttl(200);
+        au->clear_import_cache();
+
+        {
+            DeviceProxy dev(device1_name);
+        }
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 1u);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        DeviceProxy dev(device1_name);
+        TS_ASSERT_THROWS_NOTHING(dev.ping());
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 1u);
+
+        au->set_import_cache_ttl(0);
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 0u);
+        DeviceProxy no_cache(device1_name);
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 0u);
+    }
+
+//
+// Proxies created after a bulk import do not query the database
+//
+
+    void test_import_devices(void)
+    {
+        ApiUtil *au = ApiUtil::instance();
+        au->set_import_cache_ttl(0);
+
+        std::vector<std::string> names;
+        names.push_back(device1_name);
+        names.push_back("this/device/doesnotexist");
+        au->import_devices(names);
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 0u);
+
+        au->set_import_cache_ttl(60000);
+        TS_ASSERT_THROWS_NOTHING(au->import_devices(names));
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 1u);
+
+        DeviceProxy dev(device1_name);
+        TS_ASSERT_THROWS_NOTHING(dev.ping());
+        TS_ASSERT_EQUALS(au->get_import_cache_size(), 1u);
+
+        AttributeProxy att(device1_name + "/Short_attr");
+        TS_ASSERT_THROWS_NOTHING(att.read());
+
+        au->set_import_cache_ttl(0);
+    }
+
+//
+// Creation times with and without the cache
+//
+
+    void test_import_cache_benchmark(void)
+    {
+        const int nb_proxy = 500;
+        ApiUtil *au = ApiUtil::instance();
+        std::vector<DeviceProxy *> proxies;
+
+        au->set_import_cache_ttl(0);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nb_proxy; i++)
+            proxies.push_back(new DeviceProxy(device1_name));
+        auto no_cache_end = std::chrono::steady_clock::now();
+
+        au->set_import_cache_ttl(60000);
+        for (int i = 0; i < nb_proxy; i++)
+            proxies.push_back(new DeviceProxy(device1_name));
+        auto cache_end = std::chrono::steady_clock::now();
+
+        TS_ASSERT_THROWS_NOTHING(proxies.back()->ping());
+        for (auto dev : proxies)
+            delete dev;
+
+        TEST_LOG << nb_proxy << " proxies without import cache: "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(no_cache_end - start).count() << " ms" << endl;
+        TEST_LOG << nb_proxy << " proxies with import cache: "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(cache_end - no_cache_end).count() << " ms" << endl;
+    }
+};
+
+#endif // ImportCacheTestSuite_h
@@ -1,6 +1,7 @@
 #ifndef JPEGEncodedTestSuite_h
 #define JPEGEncodedTestSuite_h
 
+#include <algorithm>
 #include <ctime>
 #include <cstdio>
 #include <iterator>
@@ -222,5 +223,71 @@ class JPEGEncodedTestSuite: public CxxTest::TestSuite
             delete[] gray_buffer;
 
         }
+
+        // Encode and decode a large image with several threads. The images decoded with one and
+        // several threads must be the same
+        void test_jpeg_parallel_encoding()
+        {
+#ifdef TANGO_USE_JPEG
+            const int tiles = 4;
+            const int width = 512 * tiles;
+            const int height = 512 * tiles;
+#ifdef JCS_EXTENSIONS
+            const int decoded_comp = 4;
+#else
+            const int decoded_comp = 3;
+#endif
+
+            std::vector<unsigned char> large_24bits(width * height * 3);
+            for (int row = 0; row < height; ++row)
+            {
+                for (int tile = 0; tile < tiles; ++tile)
+                {
+                    std::copy_n(raw_24bits.begin() + (row % 512) * 512 * 3, 512 * 3,
+                            large_24bits.begin() + (row * width + tile * 512) * 3);
+                }
+            }
+
+            Tango::EncodedAttribute enc;
+
+            for (int nb_threads : {1, 2, 4, 8})
+            {
+                enc.set_jpeg_threads(nb_threads);
+                TS_ASSERT_EQUALS(enc.get_jpeg_threads(), nb_threads);
+
+                enc.encode_jpeg_rgb24(large_24bits.data(), width, height, 90);
+
+                DeviceAttribute da;
+                Tango::DevEncoded att_de;
+                att_de.encoded_format = "JPEG_RGB";
+                Tango::DevVarCharArray data(enc.get_size(), enc.get_size(), enc.get_data(), false);
+                att_de.encoded_data = data;
+                da << att_de;
+
+                int w = 0, h = 0;
+                unsigned char* decoded = nullptr;
+                enc.decode_rgb32(&da, &w, &h, &decoded);
+
+                TS_ASSERT_EQUALS(w, width);
+                TS_ASSERT_EQUALS(h, height);
+
+                // Decode the same stream with one thread as reference
+                if (nb_threads != 1)
+                {
+                    Tango::EncodedAttribute seq_dec;
+                    unsigned char* seq_decoded = nullptr;
+                    seq_dec.decode_rgb32(&da, &w, &h, &seq_decoded);
+                    std::size_t decoded_size = std::size_t(w) * h * decoded_comp;
+                    TS_ASSERT_SAME_DATA(seq_decoded, decoded, decoded_size);
+                    delete[] seq_decoded;
+                }
+
+                delete[] decoded;
+            }
+
+            TS_ASSERT_THROWS_ASSERT(enc.set_jpeg_threads(0), Tango::DevFailed &e,
+                    TS_ASSERT_EQUALS(std::string(e.errors[0].reason.in()), Tango::API_WrongFormat));
+#endif
+        }
 };
 #endif // JPEGEncodedTestSuite_h
@@ -0,0 +1,210 @@
+#ifndef MetricsTestSuite_h
+#define MetricsTestSuite_h
+
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#include "cxx_common.h"
+#include <latency.h>
+#include <metrics.h>
+
+#ifndef _TG_WINDOWS_
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#undef SUITE_NAME
+#define SUITE_NAME MetricsTestSuite
+
+// On those tests, the OpenMetrics exposition built from the process counters is checked and the exporter thread
+// is queried through its HTTP endpoint
+class MetricsTestSuite: public CxxTest::TestSuite
+{
+protected:
+
+#ifndef _TG_WINDOWS_
+
+//
+// Send a request to the exporter and return the whole reply
+//
+
+    string http_request(const string &endpoint, const string &req)
+    {
+        string::size_type pos = endpoint.rfind(':');
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<unsigned short>(stoi(endpoint.substr(pos + 1))));
+        inet_pton(AF_INET, endpoint.substr(0, pos).c_str(), &addr.sin_addr);
+
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0)
+        {
+            close(fd);
+            return "";
+        }
+
+        send(fd, req.data(), req.size(), 0);
+
+        string reply;
+        char buf[4096];
+        ssize_t nb;
+        while ((nb = recv(fd, buf, sizeof(buf), 0)) > 0)
+            reply.append(buf, nb);
+        close(fd);
+
+        return reply;
+    }
+
+#endif
+
+public:
+    SUITE_NAME()
+    {
+
+//
+// Arguments check -------------------------------------------------
+//
+
+        CxxTest::TangoPrinter::validate_args();
+    }
+
+    virtual ~SUITE_NAME()
+    {
+    }
+
+    static SUITE_NAME *createSuite()
+    {
+        return new SUITE_NAME();
+    }
+
+    static void destroySuite(SUITE_NAME *suite)
+    {
+        delete suite;
+    }
+
+//
+// Tests -------------------------------------------------------
+//
+
+//
+// The exposition ends with the EOF marker, each sample is a name (with labels) followed by a number and the
+// recorded latencies are exported
+//
+
+    void test_collect_format(void)
+    {
+        Tango::LatencyRecorder::record("test/metrics/1", Tango::LAT_COMMAND, "IOLong", 100);
+        Tango::LatencyRecorder::record("test/metrics/1", Tango::LAT_COMMAND, "IOLong", 200);
+        Tango::LatencyRecorder::record("test/metrics/1", Tango::LAT_COMMAND, "IOLong", 300);
+
+        string out;
+        Tango::MetricsExporter::collect(out);
+
+        TS_ASSERT(out.size() > 6);
+        TS_ASSERT_EQUALS(out.substr(out.size() - 6), "# EOF\n");
+        TS_ASSERT(out.find("# TYPE tango_orb_requests counter\n") != string::npos);
+        TS_ASSERT(out.find("tango_request_latency_seconds_count{device=\"test/metrics/1\",type=\"command\",name=\"iolong\"} 3\n") != string::npos);
+        TS_ASSERT(out.find("tango_request_latency_seconds_sum{device=\"test/metrics/1\",type=\"command\",name=\"iolong\"} 0.0006\n") != string::npos);
+
+        istringstream iss(out);
+        string line;
+        while (getline(iss, line))
+        {
+            if (line.empty() == true || line[0] == '#')
+                continue;
+            string::size_type pos = line.rfind(' ');
+            TS_ASSERT(pos != string::npos);
+            istringstream val(line.substr(pos + 1));
+            double d = -1.0;
+            val >> d;
+            TS_ASSERT(!val.fail());
+            TS_ASSERT_LESS_THAN_EQUALS(0.0, d);
+        }
+    }
+
+//
+// The process records at most LATENCY_MAX_ENTRIES histograms whatever the number of recording threads. A thread
+// can still record an attribute/command already known by the process. The requests for the other
+// attributes/commands are counted as dropped (also once the thread has exited) and exported
+//
+
+    void test_latency_dropped(void)
+    {
+        Tango::DevULong64 dropped_before = Tango::LatencyRecorder::get_dropped();
+        vector<Tango::LatencyEntry> entries;
+        Tango::LatencyRecorder::get_entries(entries);
+        size_t nb_before = entries.size();
+
+        std::thread th1([]()
+        {
+            for (size_t i = 0; i <= Tango::LATENCY_MAX_ENTRIES; i++)
+                Tango::LatencyRecorder::record("test/metrics/2", Tango::LAT_READ, ("attr" + to_string(i)).c_str(), 10);
+        });
+        th1.join();
+
+        std::thread th2([]()
+        {
+            Tango::LatencyRecorder::record("test/metrics/2", Tango::LAT_READ, "attr0", 10);
+            for (size_t i = 0; i < 10; i++)
+                Tango::LatencyRecorder::record("test/metrics/3", Tango::LAT_READ, ("attr" + to_string(i)).c_str(), 10);
+        });
+        th2.join();
+
+        Tango::DevULong64 dropped = dropped_before + nb_before + 11;
+        TS_ASSERT_EQUALS(Tango::LatencyRecorder::get_dropped(), dropped);
+        Tango::LatencyRecorder::get_entries(entries);
+        TS_ASSERT_EQUALS(entries.size(), Tango::LATENCY_MAX_ENTRIES);
+
+        string out;
+        Tango::MetricsExporter::collect(out);
+        TS_ASSERT(out.find("# TYPE tango_request_latency_dropped counter\n") != string::npos);
+        TS_ASSERT(out.find("tango_request_latency_dropped_total " + to_string(dropped) + "\n") != string::npos);
+        TS_ASSERT(out.find("tango_request_latency_seconds_count{device=\"test/metrics/2\",type=\"read\",name=\"attr0\"} 2\n") != string::npos);
+    }
+
+//
+// Wrong endpoints are refused
+//
+
+    void test_wrong_endpoint(void)
+    {
+        TS_ASSERT_THROWS_ASSERT(new Tango::MetricsExporter("127.0.0.1:port"), Tango::DevFailed & e,
+                                TS_ASSERT_EQUALS(string(e.errors[0].reason.in()), Tango::API_MetricsExporterFailed));
+        TS_ASSERT_THROWS_ASSERT(new Tango::MetricsExporter("localhost:9100"), Tango::DevFailed & e,
+                                TS_ASSERT_EQUALS(string(e.errors[0].reason.in()), Tango::API_MetricsExporterFailed));
+    }
+
+#ifndef _TG_WINDOWS_
+
+//
+// The exporter answers on its HTTP endpoint (port chosen by the system)
+//
+
+    void test_http_endpoint(void)
+    {
+        Tango::MetricsExporter *exporter = nullptr;
+        TS_ASSERT_THROWS_NOTHING(exporter = new Tango::MetricsExporter("127.0.0.1:0"));
+        exporter->start();
+        string endpoint = exporter->get_endpoint();
+        TS_ASSERT(endpoint != "127.0.0.1:0");
+
+        string reply = http_request(endpoint, "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+        TS_ASSERT_EQUALS(reply.find("HTTP/1.0 200 OK\r\n"), 0u);
+        TS_ASSERT(reply.find("Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n") != string::npos);
+        TS_ASSERT(reply.find("tango_orb_threads ") != string::npos);
+        TS_ASSERT_EQUALS(reply.substr(reply.size() - 6), "# EOF\n");
+
+        reply = http_request(endpoint, "GET /other HTTP/1.0\r\n\r\n");
+        TS_ASSERT_EQUALS(reply.find("HTTP/1.0 404 Not Found\r\n"), 0u);
+
+        exporter->stop();
+    }
+
+#endif
+};
+
+#endif // MetricsTestSuite_h
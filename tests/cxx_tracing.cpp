@@ -0,0 +1,360 @@
+#ifndef TracingTestSuite_h
+#define TracingTestSuite_h
+
+#include <cstring>
+#include <fstream>
+
+#include "cxx_common.h"
+#include <tracing.h>
+
+#ifndef _TG_WINDOWS_
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+#undef SUITE_NAME
+#define SUITE_NAME TracingTestSuite
+
+// On those tests, spans are recorded in a trace file and the file content (span linkage, ring buffer) is checked.
+// The device server is also restarted with the tracing enabled to check the propagation of the trace id
+class TracingTestSuite: public CxxTest::TestSuite
+{
+protected:
+    string device1_name;
+    string device1_instance_name;
+    string trace_file;
+    string server_trace_dir;
+
+//
+// Read a trace file header and its ring buffer
+//
+
+    void read_trace(Tango::TraceFileHeader &header, vector<Tango::TraceRecord> &records)
+    {
+        read_trace(trace_file, header, records);
+    }
+
+    void read_trace(const string &file, Tango::TraceFileHeader &header, vector<Tango::TraceRecord> &records)
+    {
+        ifstream in(file, ios::binary);
+        in.read(reinterpret_cast<char *>(&header), sizeof(header));
+        records.resize(header.capacity);
+        in.read(reinterpret_cast<char *>(records.data()), header.capacity * sizeof(Tango::TraceRecord));
+        TS_ASSERT(in.good());
+    }
+
+public:
+    SUITE_NAME() :
+    device1_instance_name{"test"}
+    {
+
+//
+// Arguments check -------------------------------------------------
+//
+
+        device1_name = CxxTest::TangoPrinter::get_param("device1");
+
+        CxxTest::TangoPrinter::validate_args();
+
+#ifndef _TG_WINDOWS_
+        trace_file = "/tmp/cxx_tracing_" + to_string(getpid()) + ".bin";
+        server_trace_dir = "/tmp/cxx_tracing_" + to_string(getpid()) + "_server";
+#endif
+    }
+
+    virtual ~SUITE_NAME()
+    {
+
+//
+// Clean up --------------------------------------------------------
+//
+
+#ifndef _TG_WINDOWS_
+        if (CxxTest::TangoPrinter::is_restore_set("Server_Traced"))
+        {
+            unsetenv("TANGO_TRACE_DIR");
+            CxxTest::TangoPrinter::kill_server();
+            CxxTest::TangoPrinter::start_server(device1_instance_name);
+        }
+
+        unlink(trace_file.c_str());
+        DIR *dir = opendir(server_trace_dir.c_str());
+        if (dir != nullptr)
+        {
+            struct dirent *ent;
+            while ((ent = readdir(dir)) != nullptr)
+            {
+                if (ent->d_name[0] != '.')
+                    unlink((server_trace_dir + "/" + ent->d_name).c_str());
+            }
+            closedir(dir);
+            rmdir(server_trace_dir.c_str());
+        }
+#endif
+    }
+
+    static SUITE_NAME *createSuite()
+    {
+        return new SUITE_NAME();
+    }
+
+    static void destroySuite(SUITE_NAME *suite)
+    {
+        delete suite;
+    }
+
+//
+// Tests -------------------------------------------------------
+//
+
+#ifndef _TG_WINDOWS_
+
+//
+// Nested spans are children of the enclosing span and share its trace id. The thread current span is restored at
+// the end of each span
+//
+
+    void test_nested_spans(void)
+    {
+        Tango::Tracer::open(trace_file, 16);
+        TS_ASSERT(Tango::Tracer::is_enabled());
+
+        {
+            Tango::TraceSpan call(Tango::TRACE_CLIENT_CALL);
+            TS_ASSERT(call.is_active());
+            call.set_name("test/trace/1", "IOLong");
+            {
+                Tango::TraceSpan hard(Tango::TRACE_READ_HARDWARE, "test/trace/1");
+                Tango::Tracer::record_wait(Tango::TRACE_MONITOR_WAIT, "device", 1000);
+            }
+        }
+        TS_ASSERT_EQUALS(Tango::Tracer::context().span_id, 0u);
+
+        Tango::TraceFileHeader header;
+        vector<Tango::TraceRecord> records;
+        read_trace(header, records);
+        Tango::Tracer::close();
+
+        TS_ASSERT_EQUALS(memcmp(header.magic, Tango::TRACE_FILE_MAGIC, sizeof(header.magic)), 0);
+        TS_ASSERT_EQUALS(header.version, Tango::TRACE_FILE_VERSION);
+        TS_ASSERT_EQUALS(header.record_size, sizeof(Tango::TraceRecord));
+        TS_ASSERT_EQUALS(header.pid, static_cast<uint64_t>(getpid()));
+        TS_ASSERT_EQUALS(header.write_index, 3u);
+
+        Tango::TraceRecord &wait = records[0];
+        Tango::TraceRecord &hard = records[1];
+        Tango::TraceRecord &call = records[2];
+
+        TS_ASSERT_EQUALS(wait.seq, 1u);
+        TS_ASSERT_EQUALS(hard.seq, 2u);
+        TS_ASSERT_EQUALS(call.seq, 3u);
+        TS_ASSERT_EQUALS(records[3].seq, 0u);
+
+        TS_ASSERT_EQUALS(wait.kind, Tango::TRACE_MONITOR_WAIT);
+        TS_ASSERT_EQUALS(hard.kind, Tango::TRACE_READ_HARDWARE);
+        TS_ASSERT_EQUALS(call.kind, Tango::TRACE_CLIENT_CALL);
+
+        TS_ASSERT(call.trace_id != 0);
+        TS_ASSERT_EQUALS(hard.trace_id, call.trace_id);
+        TS_ASSERT_EQUALS(wait.trace_id, call.trace_id);
+        TS_ASSERT_EQUALS(call.parent_id, 0u);
+        TS_ASSERT_EQUALS(hard.parent_id, call.span_id);
+        TS_ASSERT_EQUALS(wait.parent_id, hard.span_id);
+
+        TS_ASSERT_EQUALS(string(call.name), "test/trace/1/IOLong");
+        TS_ASSERT_EQUALS(string(hard.name), "test/trace/1");
+        TS_ASSERT_EQUALS(string(wait.name), "device");
+        TS_ASSERT_EQUALS(wait.duration_ns, 1000);
+        TS_ASSERT_LESS_THAN_EQUALS(call.start_ns, hard.start_ns);
+        TS_ASSERT_LESS_THAN_EQUALS(hard.start_ns + hard.duration_ns, call.start_ns + call.duration_ns);
+    }
+
+//
+// A server request continues the client trace. The device method span ends the dispatching step and starts the
+// reply step, the request span is named after the device method
+//
+
+    void test_server_request(void)
+    {
+        Tango::Tracer::open(trace_file, 16);
+
+        Tango::Tracer::request_received(0x1234, 0x5678, "command_inout_4");
+        {
+            Tango::TraceSpan method(Tango::TRACE_DEVICE_METHOD, "test/trace/1", "IOLong");
+        }
+        Tango::Tracer::request_done();
+        TS_ASSERT_EQUALS(Tango::Tracer::context().span_id, 0u);
+
+        Tango::TraceFileHeader header;
+        vector<Tango::TraceRecord> records;
+        read_trace(header, records);
+        Tango::Tracer::close();
+
+        TS_ASSERT_EQUALS(header.write_index, 4u);
+
+        Tango::TraceRecord &dispatch = records[0];
+        Tango::TraceRecord &method = records[1];
+        Tango::TraceRecord &reply = records[2];
+        Tango::TraceRecord &request = records[3];
+
+        TS_ASSERT_EQUALS(dispatch.kind, Tango::TRACE_SERVER_DISPATCH);
+        TS_ASSERT_EQUALS(method.kind, Tango::TRACE_DEVICE_METHOD);
+        TS_ASSERT_EQUALS(reply.kind, Tango::TRACE_SERVER_REPLY);
+        TS_ASSERT_EQUALS(request.kind, Tango::TRACE_SERVER_REQUEST);
+
+        for (auto &rec : records)
+        {
+            if (rec.seq != 0)
+                TS_ASSERT_EQUALS(rec.trace_id, 0x1234u);
+        }
+        TS_ASSERT_EQUALS(request.parent_id, 0x5678u);
+        TS_ASSERT_EQUALS(dispatch.parent_id, request.span_id);
+        TS_ASSERT_EQUALS(method.parent_id, request.span_id);
+        TS_ASSERT_EQUALS(reply.parent_id, request.span_id);
+
+        TS_ASSERT_EQUALS(string(dispatch.name), "command_inout_4");
+        TS_ASSERT_EQUALS(string(request.name), "test/trace/1/IOLong");
+        TS_ASSERT_EQUALS(dispatch.start_ns, request.start_ns);
+        TS_ASSERT_EQUALS(reply.start_ns, method.start_ns + method.duration_ns);
+        TS_ASSERT_EQUALS(reply.start_ns + reply.duration_ns, request.start_ns + request.duration_ns);
+    }
+
+//
+// A command executed by the device server continues the client trace: the server request span has the client call
+// trace id and the client call span as parent
+//
+
+    void test_client_server_propagation(void)
+    {
+
+//
+// Restart the device server with the tracing enabled (its trace file is the only file in the trace directory)
+//
+
+        TS_ASSERT_EQUALS(mkdir(server_trace_dir.c_str(), 0755), 0);
+        setenv("TANGO_TRACE_DIR", server_trace_dir.c_str(), 1);
+        setenv("TANGO_TRACE_BUFFER_SIZE", "1024", 1);
+        CxxTest::TangoPrinter::kill_server();
+        CxxTest::TangoPrinter::restore_set("Server_Traced");
+        CxxTest::TangoPrinter::start_server(device1_instance_name);
+
+        Tango::Tracer::open(trace_file, 64);
+        Tango::Tracer::install_interceptors(false);
+
+        DeviceProxy device1(device1_name);
+        DeviceData din, dout;
+        din << DevLong(21);
+        TS_ASSERT_THROWS_NOTHING(dout = device1.command_inout("IOLong", din));
+        DevLong lg;
+        dout >> lg;
+        TS_ASSERT_EQUALS(lg, 42);
+
+        Tango::TraceFileHeader header;
+        vector<Tango::TraceRecord> records;
+        read_trace(header, records);
+        Tango::Tracer::close();
+
+        const Tango::TraceRecord *call = nullptr;
+        for (auto &rec : records)
+        {
+            string name(rec.name);
+            if (rec.seq != 0 && rec.kind == Tango::TRACE_CLIENT_CALL && name.size() > 7 &&
+                name.substr(name.size() - 7) == "/IOLong")
+                call = &rec;
+        }
+        TS_ASSERT(call != nullptr);
+
+        string server_file;
+        DIR *dir = opendir(server_trace_dir.c_str());
+        TS_ASSERT(dir != nullptr);
+        struct dirent *ent;
+        while ((ent = readdir(dir)) != nullptr)
+        {
+            if (ent->d_name[0] != '.')
+                server_file = server_trace_dir + "/" + ent->d_name;
+        }
+        closedir(dir);
+        TS_ASSERT(!server_file.empty());
+
+        if (call != nullptr && !server_file.empty())
+        {
+            Tango::TraceFileHeader server_header;
+            vector<Tango::TraceRecord> server_records;
+            read_trace(server_file, server_header, server_records);
+
+            const Tango::TraceRecord *request = nullptr;
+            for (auto &rec : server_records)
+            {
+                if (rec.seq != 0 && rec.kind == Tango::TRACE_SERVER_REQUEST && rec.trace_id == call->trace_id)
+                    request = &rec;
+            }
+            TS_ASSERT(request != nullptr);
+            if (request != nullptr)
+            {
+                TS_ASSERT_EQUALS(request->parent_id, call->span_id);
+                TS_ASSERT_DIFFERS(server_header.pid, static_cast<uint64_t>(getpid()));
+            }
+        }
+
+//
+// Restart the device server without tracing
+//
+
+        unsetenv("TANGO_TRACE_DIR");
+        unsetenv("TANGO_TRACE_BUFFER_SIZE");
+        CxxTest::TangoPrinter::kill_server();
+        CxxTest::TangoPrinter::start_server(device1_instance_name);
+        CxxTest::TangoPrinter::restore_unset("Server_Traced");
+    }
+
+//
+// The ring buffer keeps the last records, each slot holds its sequence number. Too long names keep their end
+//
+
+    void test_ring_buffer(void)
+    {
+        Tango::Tracer::open(trace_file, 4);
+
+        for (int loop = 0; loop < 10; loop++)
+            Tango::Tracer::record(Tango::TRACE_READ_HARDWARE, 1, loop + 1, 0, loop, 1, "a/very/long/device/name/for/the/tracing/test");
+
+        Tango::TraceFileHeader header;
+        vector<Tango::TraceRecord> records;
+        read_trace(header, records);
+        Tango::Tracer::close();
+
+        TS_ASSERT_EQUALS(header.capacity, 4u);
+        TS_ASSERT_EQUALS(header.write_index, 10u);
+        TS_ASSERT_EQUALS(records[0].seq, 9u);
+        TS_ASSERT_EQUALS(records[1].seq, 10u);
+        TS_ASSERT_EQUALS(records[2].seq, 7u);
+        TS_ASSERT_EQUALS(records[3].seq, 8u);
+        TS_ASSERT_EQUALS(records[1].span_id, 10u);
+
+        string name(records[0].name);
+        TS_ASSERT_EQUALS(name.size(), static_cast<size_t>(Tango::TRACE_NAME_SIZE - 1));
+        TS_ASSERT_EQUALS(name, string("a/very/long/device/name/for/the/tracing/test").substr(5));
+    }
+
+//
+// Nothing is recorded once the tracing is disabled and a second trace file can't be opened
+//
+
+    void test_enable_disable(void)
+    {
+        Tango::Tracer::open(trace_file, 4);
+        TS_ASSERT_THROWS_ASSERT(Tango::Tracer::open(trace_file + ".2", 4), Tango::DevFailed & e,
+                                TS_ASSERT_EQUALS(string(e.errors[0].reason.in()), Tango::API_TracingFailed));
+        Tango::Tracer::close();
+
+        TS_ASSERT(!Tango::Tracer::is_enabled());
+        Tango::TraceSpan span(Tango::TRACE_CLIENT_CALL);
+        TS_ASSERT(!span.is_active());
+        TS_ASSERT_EQUALS(Tango::Tracer::context().span_id, 0u);
+    }
+
+#endif
+};
+
+#endif // TracingTestSuite_h
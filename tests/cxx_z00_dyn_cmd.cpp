@@ -1,6 +1,9 @@
 #ifndef DynCmdSuite_h
 #define DynCmdSuite_h
 
+#include <atomic>
+#include <thread>
+
 #include "cxx_common.h"
 
 #undef SUITE_NAME
@@ -13,6 +16,8 @@ protected:
 	DeviceProxy 			*device1,*device2;
 	string 					device1_name;
 	string					device2_name;
+	string					device3_name;
+	string					dserver_name;
 
 public:
 	SUITE_NAME()
@@ -26,6 +31,8 @@ public:
 		// user arguments, obtained from the command line sequentially
 		device1_name = CxxTest::TangoPrinter::get_param("device1");
 		device2_name = CxxTest::TangoPrinter::get_param("device2");
+		device3_name = CxxTest::TangoPrinter::get_param("device3");
+		dserver_name = "dserver/" + CxxTest::TangoPrinter::get_param("fulldsname");
 
 		// always add this line, otherwise arguments will not be parsed correctly
 		CxxTest::TangoPrinter::validate_args();
@@ -183,6 +190,91 @@ public:
 
 		TS_ASSERT_THROWS_NOTHING(device1->command_inout("IORemoveCommand"));
 	}
+
+// Test dynamic commands and attributes added/removed at class level while other devices of the same class are
+// created (restarted) by other threads
+
+	void test_dynamic_objects_during_device_creation()
+	{
+		const int nb_loop = 20;
+		Tango::ConstDevString att_name = "Added_short_attr";
+		std::atomic<int> add_errors(0);
+		std::atomic<int> restart_errors(0);
+
+		auto add_remove = [&]()
+		{
+			DeviceProxy dev(device1_name);
+			DeviceData din;
+			for (int loop = 0;loop < nb_loop;loop++)
+			{
+				try
+				{
+					Tango::DevLong device_level = 0;
+					din << device_level;
+					dev.command_inout("IOAddCommand",din);
+					din << att_name;
+					dev.command_inout("IOAddAttribute",din);
+					dev.command_inout("IORemoveCommand");
+					din << att_name;
+					dev.command_inout("IORemoveAttribute",din);
+				}
+				catch (DevFailed &e)
+				{
+					Except::print_exception(e);
+					add_errors++;
+				}
+			}
+		};
+
+		auto restart = [&](const string &dev_name)
+		{
+			DeviceProxy admin(dserver_name);
+			DeviceData din;
+			for (int loop = 0;loop < nb_loop;loop++)
+			{
+				try
+				{
+					din << dev_name;
+					admin.command_inout("DevRestart",din);
+				}
+				catch (DevFailed &e)
+				{
+					Except::print_exception(e);
+					restart_errors++;
+				}
+			}
+		};
+
+		std::thread th_dyn(add_remove);
+		std::thread th_dev2(restart,device2_name);
+		std::thread th_dev3(restart,device3_name);
+		th_dyn.join();
+		th_dev2.join();
+		th_dev3.join();
+
+		TS_ASSERT_EQUALS(add_errors.load(), 0);
+		TS_ASSERT_EQUALS(restart_errors.load(), 0);
+
+		// All devices are alive and the class level objects have been removed
+
+		DeviceProxy device3(device3_name);
+		TS_ASSERT_THROWS_NOTHING(device1->ping());
+		TS_ASSERT_THROWS_NOTHING(device2->ping());
+		TS_ASSERT_THROWS_NOTHING(device3.ping());
+
+		CommandInfoList *cil = nullptr;
+		TS_ASSERT_THROWS_NOTHING(cil = device2->command_list_query());
+		bool found = false;
+		for (size_t loop = 0;cil != nullptr && loop < cil->size();loop++)
+		{
+			if ((*cil)[loop].cmd_name == "Added_cmd")
+				found = true;
+		}
+		delete cil;
+		TS_ASSERT(!found);
+
+		TS_ASSERT_THROWS(device1->get_attribute_config("Added_short_attr"), DevFailed &);
+	}
 };
 
 #endif // DynCmdTestSuite_h
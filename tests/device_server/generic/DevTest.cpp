@@ -294,6 +294,48 @@ void DevTest::IOTemplIn(Tango::DevLong received)
 	TANGO_LOG << "[DevTest::IOTemplIn] received " << received << std::endl;
 }
 
+//
+// Log consumer commands. A "Log" call carries 6 strings per record (date, level, source, message, NDC, thread)
+//
+
+void DevTest::log_consumer_register(Tango::DevString source)
+{
+	TANGO_LOG << "[DevTest::log_consumer_register] source " << source << std::endl;
+}
+
+void DevTest::log_consumer_log(const Tango::DevVarStringArray *records)
+{
+	if (records->length() == 0 || (records->length() % 6) != 0)
+	{
+		TANGO_THROW_EXCEPTION(Tango::API_IncompatibleCmdArgumentType, "A Log call must have 6 strings per log record");
+	}
+
+	log_call_records.push_back(records->length() / 6);
+	for (CORBA::ULong loop = 0;loop < records->length();loop = loop + 6)
+		log_messages.push_back((*records)[loop + 3].in());
+}
+
+Tango::DevVarLongStringArray *DevTest::get_received_logs()
+{
+	Tango::DevVarLongStringArray *argout = new Tango::DevVarLongStringArray();
+
+	argout->lvalue.length(log_call_records.size());
+	for (size_t loop = 0;loop < log_call_records.size();loop++)
+		argout->lvalue[loop] = log_call_records[loop];
+
+	argout->svalue.length(log_messages.size());
+	for (size_t loop = 0;loop < log_messages.size();loop++)
+		argout->svalue[loop] = Tango::string_dup(log_messages[loop].c_str());
+
+	return argout;
+}
+
+void DevTest::reset_received_logs()
+{
+	log_call_records.clear();
+	log_messages.clear();
+}
+
 void DevTest::IOPushEvent()
 {
 	TANGO_LOG << "[DevTest::IOPushEvent] received " << std::endl;
@@ -591,6 +633,11 @@ Tango::DevVarDoubleArray *DevTest::IOTemplInOut(Tango::DevDouble db)
     	return argout;
 }
 
+Tango::DevDouble DevTest::IODoubleInOut(Tango::DevDouble db)
+{
+	return db * 2;
+}
+
 void DevTest::IOSetWAttrLimit(const Tango::DevVarDoubleArray *in)
 {
 	Tango::WAttribute &w_attr = dev_attr->get_w_attr_by_name("Double_attr_w");
@@ -65,6 +65,7 @@ public :
 
 	Tango::DevVarLongArray *IOTemplOut();
 	Tango::DevVarDoubleArray *IOTemplInOut(Tango::DevDouble);
+	Tango::DevDouble IODoubleInOut(Tango::DevDouble);
 
 	void set_attr_long(Tango::DevLong l) {attr_long = l;}
 	void set_wattr_throw(Tango::DevShort in) {wattr_throw = in;}
@@ -73,6 +74,11 @@ public :
 	void IOSophisticatedPollInDevice();
 	Tango::DevVarStringArray *IOGetPollMess();
 
+	void log_consumer_register(Tango::DevString);
+	void log_consumer_log(const Tango::DevVarStringArray *);
+	Tango::DevVarLongStringArray *get_received_logs();
+	void reset_received_logs();
+
 //
 // Attribute related methods
 //
@@ -254,6 +260,14 @@ public :
 public:
     std::vector<std::string>                          poll_messages;
 
+//
+// Log consumer data: number of records of each "Log" call and received messages
+//
+
+protected:
+	std::vector<Tango::DevLong>		log_call_records;
+	std::vector<std::string>		log_messages;
+
 protected :
 	Tango::DevDouble 	attr_double;
 	Tango::DevShort 	attr_short;
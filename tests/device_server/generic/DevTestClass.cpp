@@ -644,6 +644,28 @@ void DevTestClass::command_factory()
 	command_list.push_back(new Tango::TemplCommandInOut<Tango::DevDouble,Tango::DevVarDoubleArray *>((const char *)"IOTemplInOutState",
 			       static_cast<Tango::DbA_CmdMethPtr_Db>(&DevTest::IOTemplInOut),
 			       static_cast<Tango::StateMethPtr>(&DevTest::templ_state)));
+
+//
+// The device may also be a log consumer (the logging target of a device)
+//
+
+	command_list.push_back(new Tango::TemplCommandIn<Tango::DevString>((const char *)"Register",
+				static_cast<Tango::CmdMethPtr_Str>(&DevTest::log_consumer_register)));
+
+	command_list.push_back(new Tango::TemplCommandIn<Tango::DevString>((const char *)"UnRegister",
+				static_cast<Tango::CmdMethPtr_Str>(&DevTest::log_consumer_register)));
+
+	command_list.push_back(new Tango::TemplCommandIn<const Tango::DevVarStringArray *>((const char *)"Log",
+				static_cast<Tango::CmdMethPtr_StrA>(&DevTest::log_consumer_log)));
+
+	command_list.push_back(new Tango::TemplCommandOut<Tango::DevVarLongStringArray *>((const char *)"GetReceivedLogs",
+				static_cast<Tango::LSA_CmdMethPtr>(&DevTest::get_received_logs)));
+
+	command_list.push_back(new Tango::TemplCommand((const char *)"ResetReceivedLogs",
+				static_cast<Tango::CmdMethPtr>(&DevTest::reset_received_logs)));
+
+	command_list.push_back(new Tango::TemplCommandInOut<Tango::DevDouble,Tango::DevDouble>((const char *)"IOTemplDouble",
+				static_cast<Tango::Db_CmdMethPtr_Db>(&DevTest::IODoubleInOut)));
 }
 
 
@@ -660,23 +682,31 @@ void DevTestClass::command_factory()
 //-----------------------------------------------------------------------------
 
 void DevTestClass::device_factory(const Tango::DevVarStringArray *devlist_ptr) {
-  for (unsigned long i = 0;i < devlist_ptr->length();i++) {
-    TANGO_LOG_DEBUG << "Device name : " << (*devlist_ptr)[i] << std::endl;
 //
-// Create device and add it into the device list
+// Create devices and add them into the device list (in parallel if
+// TANGO_DS_STARTUP_THREADS is set)
 //
 
-    device_list.push_back(new DevTest(this,
-				      (*devlist_ptr)[i]));
-
+  size_t first = device_list.size();
+  try
+  {
+    create_devices(devlist_ptr, [this](const char *name) -> Tango::DeviceImpl * {
+      return new DevTest(this, name);
+    });
+  }
+  catch (...)
+  {
     //
-    // Export device to the outside world
+    // The devices created before the failing one are kept: export them as well
     //
-    if ((Tango::Util::_UseDb == true) && (Tango::Util::_FileDb == false))
-    	export_device(device_list.back());
-    else
-    	export_device(device_list.back(),(*devlist_ptr)[i]);
+    export_devices(first);
+    throw;
   }
+
+  //
+  // Export devices to the outside world
+  //
+  export_devices(first);
 }
 
 void DevTestClass::device_name_factory(std::vector<std::string> &list_name)
@@ -0,0 +1,27 @@
+#
+# Resource file used by the FileDatabase tests (comments, continuation lines and arrays)
+#
+
+/* Devices of the server */
+FileDbTest/test/DEVICE/FileDbTest: "test/filedb/1",\
+                                   "test/filedb/2"
+
+# Class properties
+
+CLASS/FileDbTest->cl_prop: 1,\
+                           2,\
+                           3
+CLASS/FileDbTest/Double_att->label: "Double attribute"
+
+# Device test/filedb/1
+
+test/filedb/1->simple: 12
+test/filedb/1->array: a,\
+                      "b c",\
+                      d
+test/filedb/1/Double_att->unit: mm,\
+                                "per second"
+
+# Device test/filedb/2
+
+test/filedb/2->simple: 24